@@ -5,6 +5,9 @@ layout(location = 0) out vec4 fragColor;
 
 layout(binding = 0) uniform sampler2D uStateTex;
 layout(binding = 1) uniform sampler1D uColormapTex;
+layout(binding = 2) uniform sampler2D uPyramidMeanTex;
+layout(binding = 3) uniform sampler2D uPyramidExtremaTex;
+layout(binding = 4) uniform sampler2D uPostTex;
 
 uniform float uZoom;
 uniform vec2  uPan;
@@ -73,6 +76,10 @@ uniform int   uMultiChannelBlend;
 uniform vec3  uChannelWeights;
 uniform int   uUseColormapForMultichannel;
 
+uniform float uPyramidLod;
+uniform int   uPyramidMode;
+uniform int   uUsePostCache;
+
 vec3 viridis(float t) {
     vec3 c0 = vec3(0.2777, 0.0054, 0.3340);
     vec3 c1 = vec3(0.1050, 0.4114, 0.5036);
@@ -228,6 +235,88 @@ float getEdgeFade(vec2 coord) {
     return fade;
 }
 
+// Grid lines, inversion and world boundary drawn over the colorized world
+vec3 applyOverlays(vec3 col, vec2 uv) {
+    if (uShowGrid != 0 && uGridW > 0 && uGridH > 0) {
+        int spacingX = 1;
+        int spacingY = 1;
+        if (uGridSpacingMode == 1) {
+            spacingX = uGridCustomSpacing;
+            spacingY = uGridCustomSpacing;
+        }
+
+        float gW = float(uGridW) / float(spacingX);
+        float gH = float(uGridH) / float(spacingY);
+        vec2 cellUV = uv * vec2(gW, gH);
+        vec2 gridDist = abs(fract(cellUV) - 0.5);
+        float lineW = uGridLineThickness * 0.5 * uZoom;
+        float grid = 1.0 - smoothstep(0.48 - 0.02/lineW, 0.5, min(gridDist.x, gridDist.y));
+        col = mix(col, uGridLineColor, grid * uGridOpacity);
+
+        if (uGridMajorLines != 0 && uGridMajorEvery > 1) {
+            float mjW = float(uGridW) / float(spacingX * uGridMajorEvery);
+            float mjH = float(uGridH) / float(spacingY * uGridMajorEvery);
+            vec2 mjCellUV = uv * vec2(mjW, mjH);
+            vec2 mjDist = abs(fract(mjCellUV) - 0.5);
+            float mjLineW = uGridLineThickness * 1.5 * uZoom;
+            float mjGrid = 1.0 - smoothstep(0.48 - 0.03/mjLineW, 0.5, min(mjDist.x, mjDist.y));
+            col = mix(col, uGridLineColor * 0.7, mjGrid * uGridMajorOpacity);
+        }
+    }
+
+    if (uInvertColors != 0) {
+        col = vec3(1.0) - col;
+    }
+
+    if (uShowBoundary != 0) {
+        float bScale = uBoundaryThickness / (float(min(uGridW, uGridH)) * uZoom);
+        float dL = abs(uv.x);
+        float dR = abs(uv.x - 1.0);
+        float dT = abs(uv.y);
+        float dB = abs(uv.y - 1.0);
+        float minD = min(min(dL, dR), min(dT, dB));
+        
+        float line = 1.0 - smoothstep(0.0, bScale, minD);
+        
+        if (uBoundaryStyle == 1 || uBoundaryStyle == 2) {
+            float dashScale = uBoundaryDashLength / float(min(uGridW, uGridH));
+            float edgePos = 0.0;
+            if (dL <= bScale || dR <= bScale) edgePos = uv.y;
+            else edgePos = uv.x;
+            float animOffset = uBoundaryAnimate != 0 ? uTime * 0.1 : 0.0;
+            float dashPattern = mod(edgePos / dashScale + animOffset, 1.0);
+            float dashThreshold = (uBoundaryStyle == 1) ? 0.5 : 0.7;
+            line *= step(dashPattern, dashThreshold);
+        }
+        
+        if (uBoundaryStyle == 3) {
+            float innerD = minD - bScale * 0.5;
+            float innerLine = 1.0 - smoothstep(0.0, bScale * 0.3, innerD);
+            line = max(line, innerLine * 0.7);
+        }
+        
+        if (uBoundaryStyle == 4) {
+            float glow = exp(-minD * float(min(uGridW, uGridH)) * uZoom * 0.5);
+            line = max(line, glow * 0.5);
+        }
+        
+        col = mix(col, uBoundaryColor, line * uBoundaryOpacity);
+    }
+    return col;
+}
+
+// Full-resolution state, or the pre-reduced pyramid level when zoomed out
+vec4 sampleState(vec2 coord) {
+    if (uPyramidLod < 0.0) return texture(uStateTex, coord);
+    vec4 mean = textureLod(uPyramidMeanTex, coord, uPyramidLod);
+    if (uPyramidMode == 1) return mean;
+    vec2 ext = textureLod(uPyramidExtremaTex, coord, uPyramidLod).rg;
+    float target = (uPyramidMode == 2) ? ext.r : ext.g;
+    if (uMultiChannel == 0) return vec4(target, 0.0, 0.0, 0.0);
+    float peak = max(mean.r, max(mean.g, mean.b));
+    return peak > 1e-6 ? vec4(mean.rgb * (target / peak), mean.a) : mean;
+}
+
 void main() {
     vec2 uv = vUV - 0.5;
     float relAspect = uViewAspect / uGridAspect;
@@ -253,7 +342,18 @@ void main() {
 
     uv = applyEdgeMode(rawUV);
 
-    vec2 texSize = vec2(textureSize(uStateTex, 0));
+    // Effects were colorized at grid resolution by display_post.comp
+    if (uUsePostCache != 0) {
+        vec4 post = texture(uPostTex, uv);
+        vec3 col = mix(uBgColor, post.rgb, post.a);
+        if (uDisplayMode < 5 || uDisplayMode > 9)
+            col = applyOverlays(col, uv);
+        fragColor = vec4(col, 1.0);
+        return;
+    }
+
+    vec2 texSize = (uPyramidLod >= 0.0) ? vec2(textureSize(uPyramidMeanTex, int(uPyramidLod)))
+                                        : vec2(textureSize(uStateTex, 0));
     vec2 texel = 1.0 / texSize;
 
     if (uDisplayMode == 1 || uDisplayMode == 2) {
@@ -309,9 +409,9 @@ void main() {
     }
     
     if (uDisplayMode == 5) {
-        float here = texture(uStateTex, uv).r;
-        float dx = texture(uStateTex, uv + vec2(texel.x, 0.0)).r - texture(uStateTex, uv - vec2(texel.x, 0.0)).r;
-        float dy = texture(uStateTex, uv + vec2(0.0, texel.y)).r - texture(uStateTex, uv - vec2(0.0, texel.y)).r;
+        float here = sampleState(uv).r;
+        float dx = sampleState(uv + vec2(texel.x, 0.0)).r - sampleState(uv - vec2(texel.x, 0.0)).r;
+        float dy = sampleState(uv + vec2(0.0, texel.y)).r - sampleState(uv - vec2(0.0, texel.y)).r;
         vec2 grad = vec2(dx, dy) * uVectorFieldScale;
         float gridX = mod(uv.x * float(uVectorFieldDensity), 1.0);
         float gridY = mod(uv.y * float(uVectorFieldDensity), 1.0);
@@ -334,7 +434,7 @@ void main() {
     }
     
     if (uDisplayMode == 6) {
-        float val6 = texture(uStateTex, uv).r;
+        float val6 = sampleState(uv).r;
         float levelF = val6 * float(uContourLevels);
         float fracLevel = fract(levelF);
         float lineWidth = uContourThickness * 0.02;
@@ -358,7 +458,7 @@ void main() {
     }
     
     if (uDisplayMode == 7) {
-        float val7 = texture(uStateTex, uv).r;
+        float val7 = sampleState(uv).r;
         float cmapT = applyColormapDeformation(val7);
         vec3 col = inferno(cmapT);
         col = clamp((col - 0.5) * uContrast + 0.5 + uBrightness - 0.5, vec3(0.0), vec3(1.0));
@@ -367,7 +467,7 @@ void main() {
     }
     
     if (uDisplayMode == 8) {
-        vec4 raw8 = texture(uStateTex, uv);
+        vec4 raw8 = sampleState(uv);
         float activity = length(raw8.rgb);
         float cmapT = applyColormapDeformation(activity);
         vec3 col = plasma(cmapT);
@@ -377,7 +477,7 @@ void main() {
     }
     
     if (uDisplayMode == 9) {
-        float here = texture(uStateTex, uv).r;
+        float here = sampleState(uv).r;
         float diff = abs(here - 0.5) * 2.0;
         vec3 col = vec3(diff, 0.0, 1.0 - diff);
         col = clamp((col - 0.5) * uContrast + 0.5 + uBrightness - 0.5, vec3(0.0), vec3(1.0));
@@ -385,10 +485,10 @@ void main() {
         return;
     }
 
-    float val = texture(uStateTex, uv).r;
+    float val = sampleState(uv).r;
 
     bool multiCh = (uMultiChannel != 0);
-    vec4 rawPixel = texture(uStateTex, uv);
+    vec4 rawPixel = sampleState(uv);
 
     if (uClipNullCells != 0) {
         float rawVal = multiCh ? max(rawPixel.r, max(rawPixel.g, rawPixel.b)) : val;
@@ -401,23 +501,23 @@ void main() {
     if (uFilterMode == 2) {
         float center = val * 5.0;
         float neighbors = 0.0;
-        neighbors += texture(uStateTex, uv + vec2(-texel.x, 0.0)).r;
-        neighbors += texture(uStateTex, uv + vec2( texel.x, 0.0)).r;
-        neighbors += texture(uStateTex, uv + vec2(0.0, -texel.y)).r;
-        neighbors += texture(uStateTex, uv + vec2(0.0,  texel.y)).r;
+        neighbors += sampleState(uv + vec2(-texel.x, 0.0)).r;
+        neighbors += sampleState(uv + vec2( texel.x, 0.0)).r;
+        neighbors += sampleState(uv + vec2(0.0, -texel.y)).r;
+        neighbors += sampleState(uv + vec2(0.0,  texel.y)).r;
         val = clamp(center - neighbors, 0.0, 1.0);
     }
 
     float edgeVal = 0.0;
     if (uEdgeStrength > 0.0) {
-        float tl = texture(uStateTex, uv + vec2(-texel.x, -texel.y)).r;
-        float tc = texture(uStateTex, uv + vec2(    0.0, -texel.y)).r;
-        float tr = texture(uStateTex, uv + vec2( texel.x, -texel.y)).r;
-        float ml = texture(uStateTex, uv + vec2(-texel.x,     0.0)).r;
-        float mr = texture(uStateTex, uv + vec2( texel.x,     0.0)).r;
-        float bl = texture(uStateTex, uv + vec2(-texel.x,  texel.y)).r;
-        float bc = texture(uStateTex, uv + vec2(    0.0,  texel.y)).r;
-        float br = texture(uStateTex, uv + vec2( texel.x,  texel.y)).r;
+        float tl = sampleState(uv + vec2(-texel.x, -texel.y)).r;
+        float tc = sampleState(uv + vec2(    0.0, -texel.y)).r;
+        float tr = sampleState(uv + vec2( texel.x, -texel.y)).r;
+        float ml = sampleState(uv + vec2(-texel.x,     0.0)).r;
+        float mr = sampleState(uv + vec2( texel.x,     0.0)).r;
+        float bl = sampleState(uv + vec2(-texel.x,  texel.y)).r;
+        float bc = sampleState(uv + vec2(    0.0,  texel.y)).r;
+        float br = sampleState(uv + vec2( texel.x,  texel.y)).r;
 
         float gx = -tl - 2.0*ml - bl + tr + 2.0*mr + br;
         float gy = -tl - 2.0*tc - tr + bl + 2.0*bc + br;
@@ -432,7 +532,7 @@ void main() {
             for (int dx = -2; dx <= 2; ++dx) {
                 float d = float(dx*dx + dy*dy);
                 float w = exp(-d * 0.5);
-                sum += texture(uStateTex, uv + vec2(float(dx), float(dy)) * texel).r * w;
+                sum += sampleState(uv + vec2(float(dx), float(dy)) * texel).r * w;
                 wt += w;
             }
         }
@@ -512,71 +612,7 @@ void main() {
         col = mix(col, vec3(1.0), edgeVal * uEdgeStrength);
     }
 
-    if (uShowGrid != 0 && uGridW > 0 && uGridH > 0) {
-        int spacingX = 1;
-        int spacingY = 1;
-        if (uGridSpacingMode == 1) {
-            spacingX = uGridCustomSpacing;
-            spacingY = uGridCustomSpacing;
-        }
-
-        float gW = float(uGridW) / float(spacingX);
-        float gH = float(uGridH) / float(spacingY);
-        vec2 cellUV = uv * vec2(gW, gH);
-        vec2 gridDist = abs(fract(cellUV) - 0.5);
-        float lineW = uGridLineThickness * 0.5 * uZoom;
-        float grid = 1.0 - smoothstep(0.48 - 0.02/lineW, 0.5, min(gridDist.x, gridDist.y));
-        col = mix(col, uGridLineColor, grid * uGridOpacity);
-
-        if (uGridMajorLines != 0 && uGridMajorEvery > 1) {
-            float mjW = float(uGridW) / float(spacingX * uGridMajorEvery);
-            float mjH = float(uGridH) / float(spacingY * uGridMajorEvery);
-            vec2 mjCellUV = uv * vec2(mjW, mjH);
-            vec2 mjDist = abs(fract(mjCellUV) - 0.5);
-            float mjLineW = uGridLineThickness * 1.5 * uZoom;
-            float mjGrid = 1.0 - smoothstep(0.48 - 0.03/mjLineW, 0.5, min(mjDist.x, mjDist.y));
-            col = mix(col, uGridLineColor * 0.7, mjGrid * uGridMajorOpacity);
-        }
-    }
-
-    if (uInvertColors != 0) {
-        col = vec3(1.0) - col;
-    }
-
-    if (uShowBoundary != 0) {
-        float bScale = uBoundaryThickness / (float(min(uGridW, uGridH)) * uZoom);
-        float dL = abs(uv.x);
-        float dR = abs(uv.x - 1.0);
-        float dT = abs(uv.y);
-        float dB = abs(uv.y - 1.0);
-        float minD = min(min(dL, dR), min(dT, dB));
-        
-        float line = 1.0 - smoothstep(0.0, bScale, minD);
-        
-        if (uBoundaryStyle == 1 || uBoundaryStyle == 2) {
-            float dashScale = uBoundaryDashLength / float(min(uGridW, uGridH));
-            float edgePos = 0.0;
-            if (dL <= bScale || dR <= bScale) edgePos = uv.y;
-            else edgePos = uv.x;
-            float animOffset = uBoundaryAnimate != 0 ? uTime * 0.1 : 0.0;
-            float dashPattern = mod(edgePos / dashScale + animOffset, 1.0);
-            float dashThreshold = (uBoundaryStyle == 1) ? 0.5 : 0.7;
-            line *= step(dashPattern, dashThreshold);
-        }
-        
-        if (uBoundaryStyle == 3) {
-            float innerD = minD - bScale * 0.5;
-            float innerLine = 1.0 - smoothstep(0.0, bScale * 0.3, innerD);
-            line = max(line, innerLine * 0.7);
-        }
-        
-        if (uBoundaryStyle == 4) {
-            float glow = exp(-minD * float(min(uGridW, uGridH)) * uZoom * 0.5);
-            line = max(line, glow * 0.5);
-        }
-        
-        col = mix(col, uBoundaryColor, line * uBoundaryOpacity);
-    }
+    col = applyOverlays(col, uv);
 
     fragColor = vec4(col, 1.0);
 }
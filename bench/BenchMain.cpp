@@ -0,0 +1,30 @@
+/**
+ * @file BenchMain.cpp
+ * @brief Entry point of lenia_bench, the engine throughput benchmark.
+ */
+
+#include "Benchmark.hpp"
+#include "Utils/Logger.hpp"
+#include <cstdlib>
+#include <exception>
+
+int main(int argc, char** argv) {
+    lenia::BenchOptions opts;
+    if (!lenia::Benchmark::parseArgs(argc, argv, opts)) {
+        lenia::Benchmark::printUsage();
+        return EXIT_FAILURE;
+    }
+
+    lenia::Logger::init();
+    LOG_INFO("===== lenia_bench starting =====");
+    int exitCode = EXIT_FAILURE;
+    try {
+        lenia::Benchmark bench;
+        exitCode = bench.run(opts);
+    } catch (const std::exception& e) {
+        LOG_FATAL("Unhandled exception: %s", e.what());
+    }
+    LOG_INFO("===== lenia_bench exiting (code %d) =====", exitCode);
+    lenia::Logger::shutdown();
+    return exitCode;
+}
@@ -0,0 +1,483 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Implementation of the engine benchmark sweep, JSON output and baseline compare.
+ */
+
+#include "Benchmark.hpp"
+#include "LeniaEngine.hpp"
+#include "Utils/Logger.hpp"
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+
+namespace lenia {
+
+std::string BenchConfig::id() const {
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "g%dx%d_r%d_gr%d_k%d_c%dx%d%s%s%s",
+                  gridW, gridH, radius, growthType, kernelType, channels, rules,
+                  walls ? "_walls" : "", analysis ? "_analysis" : "", debug ? "_debug" : "");
+    return buf;
+}
+
+void Benchmark::printUsage() {
+    std::printf(
+        "Usage: lenia_bench [options]\n"
+        "Lists are comma separated; the first value of each list is the base configuration.\n"
+        "  --grids <N|WxH,...>       Grid sizes (default 512,128,256,1024,2048)\n"
+        "  --radii <r,...>           Kernel radii (default 13,5,26,52)\n"
+        "  --growth <id,...>         Growth types (default 0,1,3,4)\n"
+        "  --kernels <id,...>        Kernel types (default 0,1,6,7)\n"
+        "  --channels <C|CxR,...>    Channel counts with rule counts (default 1,2x2,3x3,3x9)\n"
+        "  --features <f[+f],...>    none, walls, analysis, debug (default: each alone)\n"
+        "  --product                 Run every combination instead of one axis at a time\n"
+        "  --warmup <steps>          Untimed steps per configuration (default 50)\n"
+        "  --samples <n>             Timed samples per configuration (default 30)\n"
+        "  --steps <n>               Steps per sample (default 10)\n"
+        "  --assets <dir>            Asset directory (default assets)\n"
+        "  --out <file.json>         Results file (default bench_results.json)\n"
+        "  --baseline <file.json>    Compare medians against an earlier results file\n"
+        "  --threshold <fraction>    Allowed slowdown before a regression (default 0.05)\n"
+        "Exit code 1 means the comparison found a regression, 2 that the baseline\n"
+        "could not be read.\n");
+}
+
+static bool parsePositive(const std::string& text, int& out) {
+    char* end = nullptr;
+    long v = std::strtol(text.c_str(), &end, 10);
+    if (!end || *end != '\0' || v <= 0 || v > 1000000000L) return false;
+    out = static_cast<int>(v);
+    return true;
+}
+
+static std::vector<std::string> splitList(const std::string& text, char sep = ',') {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, sep))
+        if (!item.empty()) items.push_back(item);
+    return items;
+}
+
+static bool parseIntList(const std::string& text, std::vector<int>& out, bool allowZero) {
+    out.clear();
+    for (const auto& item : splitList(text)) {
+        int v = 0;
+        if (allowZero && item == "0") v = 0;
+        else if (!parsePositive(item, v)) return false;
+        out.push_back(v);
+    }
+    return !out.empty();
+}
+
+/**
+ * @brief "N" or "AxB" items; a single number repeats as (N, N) or (N, 0) per @p squareSingle.
+ */
+static bool parsePairList(const std::string& text, std::vector<std::pair<int, int>>& out,
+                          bool squareSingle) {
+    out.clear();
+    for (const auto& item : splitList(text)) {
+        auto x = item.find('x');
+        int a = 0, b = 0;
+        if (x == std::string::npos) {
+            if (!parsePositive(item, a)) return false;
+            b = squareSingle ? a : 0;
+        } else if (!parsePositive(item.substr(0, x), a) || !parsePositive(item.substr(x + 1), b)) {
+            return false;
+        }
+        out.emplace_back(a, b);
+    }
+    return !out.empty();
+}
+
+bool Benchmark::parseArgs(int argc, char** argv, BenchOptions& out) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") { out.showHelp = true; continue; }
+        if (arg == "--product")             { out.product = true;  continue; }
+
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return false;
+        }
+        std::string value = argv[++i];
+
+        bool ok = true;
+        if (arg == "--grids") {
+            ok = parsePairList(value, out.grids, true);
+        } else if (arg == "--radii") {
+            ok = parseIntList(value, out.radii, false);
+        } else if (arg == "--growth") {
+            ok = parseIntList(value, out.growthTypes, true);
+        } else if (arg == "--kernels") {
+            ok = parseIntList(value, out.kernelTypes, true);
+        } else if (arg == "--channels") {
+            ok = parsePairList(value, out.channels, false);
+            for (auto& [c, r] : out.channels) {
+                if (c > 3 || (c > 1 && (r < 1 || r > 16))) ok = false;
+                if (c == 1) r = 0;
+            }
+        } else if (arg == "--features") {
+            out.features = splitList(value);
+            for (const auto& f : out.features)
+                for (const auto& part : splitList(f, '+'))
+                    if (part != "none" && part != "walls" && part != "analysis" && part != "debug") ok = false;
+            ok = ok && !out.features.empty();
+        } else if (arg == "--warmup") {
+            ok = (value == "0") ? (out.warmupSteps = 0, true) : parsePositive(value, out.warmupSteps);
+        } else if (arg == "--samples") {
+            ok = parsePositive(value, out.samples);
+        } else if (arg == "--steps") {
+            ok = parsePositive(value, out.stepsPerSample);
+        } else if (arg == "--assets") {
+            out.assetDir = value;
+        } else if (arg == "--out") {
+            out.outPath = value;
+        } else if (arg == "--baseline") {
+            out.baselinePath = value;
+        } else if (arg == "--threshold") {
+            char* end = nullptr;
+            out.threshold = std::strtod(value.c_str(), &end);
+            ok = end && *end == '\0' && out.threshold >= 0.0;
+        } else {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        }
+
+        if (!ok) {
+            std::fprintf(stderr, "Invalid value for %s: %s\n", arg.c_str(), value.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+static void applyFeatures(const std::string& features, BenchConfig& cfg) {
+    for (const auto& part : splitList(features, '+')) {
+        if (part == "walls")    cfg.walls = true;
+        if (part == "analysis") cfg.analysis = true;
+        if (part == "debug")    cfg.debug = true;
+    }
+}
+
+/**
+ * @brief Expand the lists into configurations, without duplicates, base first.
+ */
+std::vector<BenchConfig> Benchmark::buildSweep(const BenchOptions& opts) {
+    std::vector<BenchConfig> sweep;
+    std::set<std::string> seen;
+    auto add = [&](size_t g, size_t r, size_t gr, size_t k, size_t c, size_t f) {
+        BenchConfig cfg;
+        cfg.gridW      = opts.grids[g].first;
+        cfg.gridH      = opts.grids[g].second;
+        cfg.radius     = opts.radii[r];
+        cfg.growthType = opts.growthTypes[gr];
+        cfg.kernelType = opts.kernelTypes[k];
+        cfg.channels   = opts.channels[c].first;
+        cfg.rules      = opts.channels[c].second;
+        applyFeatures(opts.features[f], cfg);
+        if (seen.insert(cfg.id()).second) sweep.push_back(cfg);
+    };
+
+    if (opts.product) {
+        for (size_t g = 0; g < opts.grids.size(); ++g)
+        for (size_t r = 0; r < opts.radii.size(); ++r)
+        for (size_t gr = 0; gr < opts.growthTypes.size(); ++gr)
+        for (size_t k = 0; k < opts.kernelTypes.size(); ++k)
+        for (size_t c = 0; c < opts.channels.size(); ++c)
+        for (size_t f = 0; f < opts.features.size(); ++f)
+            add(g, r, gr, k, c, f);
+        return sweep;
+    }
+
+    add(0, 0, 0, 0, 0, 0);
+    for (size_t i = 1; i < opts.grids.size(); ++i)       add(i, 0, 0, 0, 0, 0);
+    for (size_t i = 1; i < opts.radii.size(); ++i)       add(0, i, 0, 0, 0, 0);
+    for (size_t i = 1; i < opts.growthTypes.size(); ++i) add(0, 0, i, 0, 0, 0);
+    for (size_t i = 1; i < opts.kernelTypes.size(); ++i) add(0, 0, 0, i, 0, 0);
+    for (size_t i = 1; i < opts.channels.size(); ++i)    add(0, 0, 0, 0, i, 0);
+    for (size_t i = 1; i < opts.features.size(); ++i)    add(0, 0, 0, 0, 0, i);
+    return sweep;
+}
+
+static double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    double pos = q * static_cast<double>(sorted.size() - 1);
+    size_t lo = static_cast<size_t>(pos);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - static_cast<double>(lo));
+}
+
+/**
+ * @brief Set up a fresh engine for @p cfg, warm up, then take timed samples.
+ *
+ * A new engine per configuration keeps state such as the wall texture or
+ * debug fields from leaking into later configurations.
+ */
+bool Benchmark::measure(const BenchConfig& cfg, const BenchOptions& opts, BenchResult& out) {
+    auto engine = std::make_unique<LeniaEngine>();
+    if (!engine->init(opts.assetDir)) return false;
+
+    LeniaParams params;
+    params.gridW      = cfg.gridW;
+    params.gridH      = cfg.gridH;
+    params.radius     = cfg.radius;
+    params.growthType = cfg.growthType;
+    params.kernelType = cfg.kernelType;
+    params.numRings   = 1;
+    params.displayMode = cfg.debug ? 1 : 0;
+
+    bool multi = cfg.channels > 1;
+    if (multi) {
+        engine->switchChannelMode(params, cfg.channels);
+        params.numKernelRules = cfg.rules;
+        for (int r = 0; r < cfg.rules; ++r) {
+            ChannelKernelRule& rule = params.kernelRules[r];
+            rule.sourceChannel = r % cfg.channels;
+            rule.destChannel   = (r + r / cfg.channels) % cfg.channels;
+            rule.kernelType    = cfg.kernelType;
+            rule.growthType    = cfg.growthType;
+            engine->regenerateRuleKernel(r, params);
+        }
+    } else {
+        engine->resizeGrid(params);
+        engine->regenerateKernel(params);
+    }
+    engine->randomizeGrid(params);
+
+    if (cfg.walls) {
+        engine->applyWallLine(0, cfg.gridH / 2, cfg.gridW - 1, cfg.gridH / 2, params);
+        engine->applyWallLine(cfg.gridW / 2, 0, cfg.gridW / 2, cfg.gridH - 1, params);
+    }
+
+    auto step = [&](int n) {
+        if (multi) engine->updateMultiChannel(params, n);
+        else       engine->update(params, n);
+        if (cfg.analysis) engine->runAnalysis(params.analysisThreshold);
+    };
+
+    for (int done = 0; done < opts.warmupSteps; done += opts.stepsPerSample)
+        step(std::min(opts.stepsPerSample, opts.warmupSteps - done));
+    glFinish();
+
+    GLuint queries[2] = {0, 0};
+    if (m_hasTimer) glCreateQueries(GL_TIMESTAMP, 2, queries);
+
+    std::vector<double> gpuMs, wallMs;
+    gpuMs.reserve(opts.samples);
+    wallMs.reserve(opts.samples);
+    for (int s = 0; s < opts.samples; ++s) {
+        auto t0 = std::chrono::steady_clock::now();
+        if (m_hasTimer) glQueryCounter(queries[0], GL_TIMESTAMP);
+        step(opts.stepsPerSample);
+        if (m_hasTimer) glQueryCounter(queries[1], GL_TIMESTAMP);
+        glFinish();
+        auto t1 = std::chrono::steady_clock::now();
+
+        wallMs.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count() / opts.stepsPerSample);
+        if (m_hasTimer) {
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &end);
+            gpuMs.push_back(end > begin ? static_cast<double>(end - begin) * 1e-6 / opts.stepsPerSample : 0.0);
+        }
+    }
+    if (m_hasTimer) glDeleteQueries(2, queries);
+
+    // Software rasterizers may expose the query but report no elapsed time
+    bool useGpu = !gpuMs.empty() && *std::max_element(gpuMs.begin(), gpuMs.end()) > 0.0;
+    std::vector<double> samples = useGpu ? gpuMs : wallMs;
+    std::sort(samples.begin(), samples.end());
+    std::sort(wallMs.begin(), wallMs.end());
+
+    double sum = 0.0;
+    for (double v : samples) sum += v;
+
+    out.config     = cfg;
+    out.timer      = useGpu ? "gpu" : "wall";
+    out.samples    = static_cast<int>(samples.size());
+    out.median     = percentile(samples, 0.5);
+    out.p10        = percentile(samples, 0.1);
+    out.p90        = percentile(samples, 0.9);
+    out.p99        = percentile(samples, 0.99);
+    out.min        = samples.front();
+    out.max        = samples.back();
+    out.mean       = sum / static_cast<double>(samples.size());
+    out.wallMedian = percentile(wallMs, 0.5);
+    out.mcellsPerSec = out.median > 0.0
+        ? static_cast<double>(cfg.gridW) * cfg.gridH / (out.median * 1e3) : 0.0;
+    return true;
+}
+
+static std::string jsonEscape(const char* text) {
+    std::string s;
+    for (const char* p = text ? text : ""; *p; ++p) {
+        if (*p == '"' || *p == '\\') s += '\\';
+        if (static_cast<unsigned char>(*p) >= 0x20) s += *p;
+    }
+    return s;
+}
+
+bool Benchmark::writeJson(const std::string& path, const BenchOptions& opts) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot write benchmark results: %s", path.c_str());
+        return false;
+    }
+
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    file << "{\n"
+         << "  \"version\": 1,\n"
+         << "  \"date\": \"" << date << "\",\n"
+         << "  \"renderer\": \"" << jsonEscape(reinterpret_cast<const char*>(glGetString(GL_RENDERER))) << "\",\n"
+         << "  \"glVersion\": \"" << jsonEscape(reinterpret_cast<const char*>(glGetString(GL_VERSION))) << "\",\n"
+         << "  \"context\": \"" << m_context.backend() << "\",\n"
+         << "  \"warmupSteps\": " << opts.warmupSteps << ",\n"
+         << "  \"samples\": " << opts.samples << ",\n"
+         << "  \"stepsPerSample\": " << opts.stepsPerSample << ",\n"
+         << "  \"units\": \"ms per step\",\n"
+         << "  \"results\": [\n";
+
+    char line[768];
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const BenchResult& r = m_results[i];
+        const BenchConfig& c = r.config;
+        std::snprintf(line, sizeof(line),
+            "    {\"id\": \"%s\", \"gridW\": %d, \"gridH\": %d, \"radius\": %d, \"growthType\": %d, "
+            "\"kernelType\": %d, \"channels\": %d, \"rules\": %d, \"walls\": %s, \"analysis\": %s, "
+            "\"debug\": %s, \"timer\": \"%s\", \"samples\": %d, \"median\": %.6f, \"p10\": %.6f, "
+            "\"p90\": %.6f, \"p99\": %.6f, \"min\": %.6f, \"max\": %.6f, \"mean\": %.6f, "
+            "\"wallMedian\": %.6f, \"mcellsPerSec\": %.3f}%s\n",
+            c.id().c_str(), c.gridW, c.gridH, c.radius, c.growthType, c.kernelType, c.channels, c.rules,
+            c.walls ? "true" : "false", c.analysis ? "true" : "false", c.debug ? "true" : "false",
+            r.timer, r.samples, r.median, r.p10, r.p90, r.p99, r.min, r.max, r.mean,
+            r.wallMedian, r.mcellsPerSec, (i + 1 < m_results.size()) ? "," : "");
+        file << line;
+    }
+    file << "  ]\n}\n";
+    return file.good();
+}
+
+/**
+ * @brief Value of "key" in a result line written by writeJson(), empty if absent.
+ */
+static std::string jsonField(const std::string& line, const char* key) {
+    std::string pattern = std::string("\"") + key + "\": ";
+    auto pos = line.find(pattern);
+    if (pos == std::string::npos) return {};
+    pos += pattern.size();
+    if (line[pos] == '"') {
+        auto end = line.find('"', pos + 1);
+        return end == std::string::npos ? std::string() : line.substr(pos + 1, end - pos - 1);
+    }
+    auto end = line.find_first_of(",}", pos);
+    return line.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+}
+
+/**
+ * @brief Print current vs. baseline medians; EXIT_REGRESSION if any slowed
+ *        beyond @p threshold, EXIT_NO_BASELINE if there is nothing to compare to.
+ */
+int Benchmark::compare(const std::string& baselinePath, double threshold) const {
+    std::ifstream file(baselinePath);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot read baseline: %s", baselinePath.c_str());
+        return EXIT_NO_BASELINE;
+    }
+
+    struct Entry { double median; std::string timer; };
+    std::map<std::string, Entry> baseline;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::string id = jsonField(line, "id");
+        std::string median = jsonField(line, "median");
+        if (id.empty() || median.empty()) continue;
+        baseline[id] = Entry{std::strtod(median.c_str(), nullptr), jsonField(line, "timer")};
+    }
+    if (baseline.empty()) {
+        LOG_ERROR("Baseline has no results: %s", baselinePath.c_str());
+        return EXIT_NO_BASELINE;
+    }
+
+    int regressions = 0;
+    std::printf("\n%-44s %12s %12s %9s  %s\n", "configuration", "base ms", "now ms", "change", "status");
+    for (const BenchResult& r : m_results) {
+        std::string id = r.config.id();
+        auto it = baseline.find(id);
+        if (it == baseline.end()) {
+            std::printf("%-44s %12s %12.4f %9s  new\n", id.c_str(), "-", r.median, "-");
+            continue;
+        }
+        const Entry& base = it->second;
+        if (base.timer != r.timer) {
+            std::printf("%-44s %12.4f %12.4f %9s  timer differs (%s vs %s)\n", id.c_str(),
+                        base.median, r.median, "-", base.timer.c_str(), r.timer);
+            continue;
+        }
+        double change = base.median > 0.0 ? r.median / base.median - 1.0 : 0.0;
+        const char* status = "ok";
+        if (change > threshold)       { status = "REGRESSION"; ++regressions; }
+        else if (change < -threshold) { status = "faster"; }
+        std::printf("%-44s %12.4f %12.4f %+8.1f%%  %s\n", id.c_str(),
+                    base.median, r.median, change * 100.0, status);
+    }
+
+    if (regressions > 0) {
+        LOG_WARN("%d configuration(s) slower than the baseline by more than %.1f%%.",
+                 regressions, threshold * 100.0);
+        return EXIT_REGRESSION;
+    }
+    LOG_INFO("No regressions against %s.", baselinePath.c_str());
+    return EXIT_SUCCESS;
+}
+
+int Benchmark::run(const BenchOptions& opts) {
+    if (opts.showHelp) {
+        printUsage();
+        return EXIT_SUCCESS;
+    }
+    if (!m_context.create()) return EXIT_FAILURE;
+
+    GLint timerBits = 0;
+    glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &timerBits);
+    m_hasTimer = timerBits > 0;
+    if (!m_hasTimer) LOG_WARN("No GL timestamp queries; timing with glFinish and the wall clock.");
+
+    std::vector<BenchConfig> sweep = buildSweep(opts);
+    LOG_INFO("Benchmark: %zu configurations, %d warmup steps, %d samples x %d steps",
+             sweep.size(), opts.warmupSteps, opts.samples, opts.stepsPerSample);
+
+    m_results.clear();
+    for (size_t i = 0; i < sweep.size(); ++i) {
+        BenchResult result;
+        if (!measure(sweep[i], opts, result)) {
+            LOG_FATAL("Engine initialisation failed for %s.", sweep[i].id().c_str());
+            return EXIT_FAILURE;
+        }
+        std::printf("[%zu/%zu] %-44s %9.4f ms/step (p10 %.4f, p90 %.4f) %9.1f Mcells/s [%s]\n",
+                    i + 1, sweep.size(), sweep[i].id().c_str(), result.median,
+                    result.p10, result.p90, result.mcellsPerSec, result.timer);
+        std::fflush(stdout);
+        m_results.push_back(result);
+    }
+
+    if (!writeJson(opts.outPath, opts)) return EXIT_FAILURE;
+    LOG_INFO("Benchmark results written to %s", opts.outPath.c_str());
+
+    if (!opts.baselinePath.empty()) return compare(opts.baselinePath, opts.threshold);
+    return EXIT_SUCCESS;
+}
+
+}
@@ -0,0 +1,106 @@
+/**
+ * @file Benchmark.hpp
+ * @brief Reproducible engine throughput sweeps for the lenia_bench target.
+ */
+
+#pragma once
+
+#include "HeadlessContext.hpp"
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief One engine configuration of a sweep.
+ */
+struct BenchConfig {
+    int  gridW{512};
+    int  gridH{512};
+    int  radius{13};
+    int  growthType{0};
+    int  kernelType{0};
+    int  channels{1};
+    int  rules{0};          // Kernel rules, only used with several channels
+    bool walls{false};      // Wall texture with a cross of obstacles
+    bool analysis{false};   // Analysis pass after every sample
+    bool debug{false};      // Write neighbour sums and growth fields
+
+    /** @brief Stable key used to match results against a baseline. */
+    std::string id() const;
+};
+
+/**
+ * @brief Per-step timing statistics of one configuration, in milliseconds.
+ */
+struct BenchResult {
+    BenchConfig config;
+    const char* timer{"gpu"};   // "gpu" (timestamp queries) or "wall" (glFinish)
+    int    samples{0};
+    double median{0.0};
+    double p10{0.0};
+    double p90{0.0};
+    double p99{0.0};
+    double min{0.0};
+    double max{0.0};
+    double mean{0.0};
+    double wallMedian{0.0};     // Wall clock including CPU work, always measured
+    double mcellsPerSec{0.0};   // From the median
+};
+
+/**
+ * @brief Sweep lists and sampling settings, parsed from the command line.
+ *
+ * The first value of every list is the base configuration. By default each
+ * list is varied on its own around that base; --product runs every
+ * combination instead.
+ */
+struct BenchOptions {
+    std::vector<std::pair<int, int>> grids{{512, 512}, {128, 128}, {256, 256}, {1024, 1024}, {2048, 2048}};
+    std::vector<int> radii{13, 5, 26, 52};
+    std::vector<int> growthTypes{0, 1, 3, 4};
+    std::vector<int> kernelTypes{0, 1, 6, 7};
+    std::vector<std::pair<int, int>> channels{{1, 0}, {2, 2}, {3, 3}, {3, 9}};  // channels x rules
+    std::vector<std::string> features{"none", "walls", "analysis", "debug"};
+    bool        product{false};
+    int         warmupSteps{50};
+    int         samples{30};
+    int         stepsPerSample{10};
+    std::string assetDir{"assets"};
+    std::string outPath{"bench_results.json"};
+    std::string baselinePath;    // Compare against this file when set
+    double      threshold{0.05}; // Allowed median slowdown before flagging
+    bool        showHelp{false};
+};
+
+/**
+ * @brief Runs a configuration sweep on an offscreen context.
+ *
+ * Every configuration gets a fresh engine, warms up, then takes GPU-timed
+ * samples of a fixed number of steps. Results are written as JSON with one
+ * result object per line, which keeps baseline files diffable and lets the
+ * compare mode read them back without a JSON library.
+ */
+class Benchmark {
+public:
+    static bool parseArgs(int argc, char** argv, BenchOptions& out);
+    static void printUsage();
+
+    static constexpr int EXIT_REGRESSION  = 1;  // Slower than the baseline
+    static constexpr int EXIT_NO_BASELINE = 2;  // Baseline file missing or unreadable
+
+    /** @brief Run the sweep; returns EXIT_REGRESSION or EXIT_NO_BASELINE when comparing fails. */
+    int run(const BenchOptions& opts);
+
+private:
+    HeadlessContext          m_context;
+    std::vector<BenchResult> m_results;
+    bool                     m_hasTimer{false};
+
+    static std::vector<BenchConfig> buildSweep(const BenchOptions& opts);
+    bool measure(const BenchConfig& cfg, const BenchOptions& opts, BenchResult& out);
+    bool writeJson(const std::string& path, const BenchOptions& opts) const;
+    int compare(const std::string& baselinePath, double threshold) const;
+};
+
+}
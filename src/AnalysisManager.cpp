@@ -4,6 +4,7 @@
  */
 
 #include "AnalysisManager.hpp"
+#include "GpuProfiler.hpp"
 #include "Utils/GLUtils.hpp"
 #include <cstring>
 #include <cmath>
@@ -37,7 +38,7 @@ bool AnalysisManager::init(const std::string& shaderPath) {
     return true;
 }
 
-void AnalysisManager::analyze(GLuint stateTexture, int gridW, int gridH, float threshold) {
+void AnalysisManager::analyze(GLuint stateTexture, int gridW, int gridH, float threshold, int cellScale) {
     AnalysisData zero{};
     glNamedBufferSubData(m_ssbo, 0, sizeof(AnalysisData), &zero);
 
@@ -50,12 +51,15 @@ void AnalysisManager::analyze(GLuint stateTexture, int gridW, int gridH, float t
     glBindBufferBase(GL_UNIFORM_BUFFER, 3, m_ubo);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_ssbo);
 
-    m_shader.use();
-    glBindTextureUnit(0, stateTexture);
-    glBindSampler(0, m_sampler);
+    {
+        GpuPassScope gpuScope(GpuPass::Analysis);
+        m_shader.use();
+        glBindTextureUnit(0, stateTexture);
+        glBindSampler(0, m_sampler);
 
-    glDispatchCompute(1, 1, 1);
-    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        glDispatchCompute(1, 1, 1);
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    }
 
     glBindSampler(0, 0);
 
@@ -65,6 +69,23 @@ void AnalysisManager::analyze(GLuint stateTexture, int gridW, int gridH, float t
         glUnmapNamedBuffer(m_ssbo);
     }
 
+    if (cellScale > 1) {
+        // Report in grid cells; alive counts whole texels above the threshold
+        float scale = static_cast<float>(cellScale);
+        int area = cellScale * cellScale;
+        m_data.totalMass   *= scale * scale;
+        m_data.aliveCount  *= area;
+        m_data.totalPixels *= area;
+        m_data.centroidX   *= scale;
+        m_data.centroidY   *= scale;
+        m_data.weightedX   *= scale * scale * scale;
+        m_data.weightedY   *= scale * scale * scale;
+        m_data.boundMinX   *= scale;
+        m_data.boundMinY   *= scale;
+        m_data.boundMaxX   *= scale;
+        m_data.boundMaxY   *= scale;
+    }
+
     m_massHistory[m_historyHead] = m_data.totalMass;
     m_aliveHistory[m_historyHead] = static_cast<float>(m_data.aliveCount);
     m_centroidXHistory[m_historyHead] = m_data.centroidX;
@@ -103,6 +124,25 @@ void AnalysisManager::analyze(GLuint stateTexture, int gridW, int gridH, float t
     }
 }
 
+/**
+ * @brief Forget all history, as if analyze() had never run.
+ */
+void AnalysisManager::resetHistory() {
+    m_data = AnalysisData{};
+    m_historyHead = 0;
+    m_historyCount = 0;
+    m_analyzeCounter = 0;
+    m_stabilized = false;
+    m_empty = false;
+    m_periodic = false;
+    m_period = 0;
+    m_periodConfidence = 0.0f;
+    m_movementSpeed = 0.0f;
+    m_movementDirection = 0.0f;
+    m_orientation = 0.0f;
+    m_hasPrevCentroid = false;
+}
+
 /**
  * @brief Detect periodic behavior using autocorrelation.
  * 
@@ -53,7 +53,9 @@ public:
     AnalysisManager& operator=(const AnalysisManager&) = delete;
 
     bool init(const std::string& shaderPath);
-    void analyze(GLuint stateTexture, int gridW, int gridH, float threshold = 0.01f);
+    /** @brief @p cellScale > 1: the texture is an overview whose texels average cellScale^2 grid cells. */
+    void analyze(GLuint stateTexture, int gridW, int gridH, float threshold = 0.01f, int cellScale = 1);
+    void resetHistory();
     const AnalysisData& data() const { return m_data; }
 
     float massHistory(int i) const { return m_massHistory[i % HISTORY_SIZE]; }
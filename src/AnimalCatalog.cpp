@@ -0,0 +1,650 @@
+/**
+ * @file AnimalCatalog.cpp
+ * @brief Streaming scan, on-disk index and RLE decoding of Lenia animal catalogs.
+ *
+ * Catalogs are the JSON files published with Lenia: an array of objects
+ * holding "code", "name", "params" (R, T, b, m, s, kn, gn, or a "kernels"
+ * list with b, m, s, h, r, c0, c1) and "cells", an RLE string or one per
+ * channel. Objects whose code starts with '>' are group headers.
+ */
+
+#include "AnimalCatalog.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace lenia {
+
+namespace {
+
+constexpr char INDEX_MAGIC[8] = {'L', 'E', 'N', 'I', 'A', 'I', 'D', 'X'};
+constexpr size_t MAX_RLE_CELLS = size_t(1) << 24;    // Guards against corrupt run counts
+
+/**
+ * @brief Forward-only reader over JSON text in the mapping; values that are
+ *        not needed are skipped without being parsed.
+ */
+struct JsonCursor {
+    const char* p;
+    const char* end;
+
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
+    }
+    bool peek(char c) {
+        skipSpace();
+        return p < end && *p == c;
+    }
+    bool consume(char c) {
+        if (!peek(c)) return false;
+        ++p;
+        return true;
+    }
+
+    /** @brief Skip a string, the cursor on its opening quote. */
+    bool skipString() {
+        ++p;
+        for (;;) {
+            const char* q = static_cast<const char*>(std::memchr(p, '"', static_cast<size_t>(end - p)));
+            if (!q) return false;
+            const char* b = q;
+            while (b > p && b[-1] == '\\') --b;
+            p = q + 1;
+            if (((q - b) & 1) == 0) return true;     // Not escaped
+        }
+    }
+
+    bool readString(std::string& out) {
+        out.clear();
+        if (!consume('"')) return false;
+        while (p < end) {
+            char c = *p++;
+            if (c == '"') return true;
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (p >= end) return false;
+            c = *p++;
+            switch (c) {
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u': {
+                    uint32_t cp = 0;
+                    if (!readHex(cp)) return false;
+                    if (cp >= 0xD800 && cp < 0xDC00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                        p += 2;
+                        uint32_t low = 0;
+                        if (!readHex(low)) return false;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, cp);
+                    break;
+                }
+                default: out.push_back(c); break;   // \" \\ \/
+            }
+        }
+        return false;
+    }
+
+    bool readHex(uint32_t& value) {
+        if (end - p < 4) return false;
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = *p++;
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') value |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') value |= static_cast<uint32_t>(c - 'A' + 10);
+            else return false;
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    bool readNumber(double& value) {
+        skipSpace();
+        char buf[64];
+        size_t n = 0;
+        while (p < end && n < sizeof(buf) - 1 && *p && std::strchr("+-.0123456789eE", *p))
+            buf[n++] = *p++;
+        buf[n] = '\0';
+        char* parsed = nullptr;
+        value = std::strtod(buf, &parsed);
+        return n > 0 && parsed == buf + n;
+    }
+
+    bool skipValue() {
+        skipSpace();
+        if (p >= end) return false;
+        if (*p == '"') return skipString();
+        if (*p != '{' && *p != '[') {
+            // Number, true, false or null
+            const char* start = p;
+            while (p < end && !std::strchr(",]} \n\r\t", *p)) ++p;
+            return p > start;
+        }
+        int depth = 0;
+        while (p < end) {
+            char c = *p;
+            if (c == '"') {
+                if (!skipString()) return false;
+                continue;
+            }
+            ++p;
+            if (c == '{' || c == '[') ++depth;
+            else if ((c == '}' || c == ']') && --depth == 0) return true;
+        }
+        return false;
+    }
+
+    /** @brief Call @p member(key) for each key of an object; it must consume the value. */
+    template <typename F>
+    bool forEachMember(F&& member) {
+        if (!consume('{')) return false;
+        if (consume('}')) return true;
+        std::string key;
+        for (;;) {
+            if (!readString(key) || !consume(':')) return false;
+            if (!member(key)) return false;
+            if (consume(',')) continue;
+            return consume('}');
+        }
+    }
+
+    /** @brief Call @p element() for each element of an array; it must consume it. */
+    template <typename F>
+    bool forEachElement(F&& element) {
+        if (!consume('[')) return false;
+        if (consume(']')) return true;
+        for (;;) {
+            if (!element()) return false;
+            if (consume(',')) continue;
+            return consume(']');
+        }
+    }
+};
+
+/** @brief Ring weights from "1,1/2,2/3" or [1, 0.5, 0.667]. */
+bool parseRings(JsonCursor& c, CatalogKernel& kernel) {
+    kernel.numRings = 0;
+    if (c.peek('"')) {
+        std::string text;
+        if (!c.readString(text)) return false;
+        size_t pos = 0;
+        while (pos <= text.size() && kernel.numRings < 16) {
+            size_t comma = text.find(',', pos);
+            std::string item = text.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+            float num = 0.0f, den = 1.0f;
+            char extra;
+            int fields = std::sscanf(item.c_str(), "%f/%f%c", &num, &den, &extra);
+            if (fields < 1 || fields > 2 || den == 0.0f) return false;
+            kernel.ringWeights[kernel.numRings++] = num / den;
+            if (comma == std::string::npos) break;
+            pos = comma + 1;
+        }
+    } else {
+        bool ok = c.forEachElement([&]() {
+            double value = 0.0;
+            if (!c.readNumber(value)) return false;
+            if (kernel.numRings < 16) kernel.ringWeights[kernel.numRings++] = static_cast<float>(value);
+            return true;
+        });
+        if (!ok) return false;
+    }
+    if (kernel.numRings == 0) {
+        kernel.numRings = 1;
+        kernel.ringWeights[0] = 1.0f;
+    }
+    return true;
+}
+
+/** @brief Keys shared by the single-kernel params and each "kernels" item. */
+bool parseKernelKey(JsonCursor& c, const std::string& key, CatalogKernel& kernel, bool& handled) {
+    handled = true;
+    if (key == "b") return parseRings(c, kernel);
+    double value = 0.0;
+    if (key == "m") { if (!c.readNumber(value)) return false; kernel.mu = static_cast<float>(value); }
+    else if (key == "s") { if (!c.readNumber(value)) return false; kernel.sigma = static_cast<float>(value); }
+    else if (key == "h") { if (!c.readNumber(value)) return false; kernel.growthStrength = static_cast<float>(value); }
+    else if (key == "r") { if (!c.readNumber(value)) return false; kernel.radiusFraction = static_cast<float>(value); }
+    else if (key == "c0") { if (!c.readNumber(value)) return false; kernel.sourceChannel = static_cast<int>(value); }
+    else if (key == "c1") { if (!c.readNumber(value)) return false; kernel.destChannel = static_cast<int>(value); }
+    else handled = false;
+    return true;
+}
+
+bool parseParams(JsonCursor& c, CatalogEntry& entry) {
+    CatalogKernel single;
+    bool ok = c.forEachMember([&](const std::string& key) {
+        bool handled = false;
+        if (!parseKernelKey(c, key, single, handled)) return false;
+        if (handled) return true;
+        double value = 0.0;
+        if (key == "R") {
+            if (!c.readNumber(value)) return false;
+            entry.radius = std::max(1, static_cast<int>(value + 0.5));
+        } else if (key == "T") {
+            if (!c.readNumber(value) || value <= 0.0) return false;
+            entry.dt = static_cast<float>(1.0 / value);
+        } else if (key == "kn") {
+            if (!c.readNumber(value)) return false;
+            entry.kernelCore = static_cast<int>(value);
+        } else if (key == "gn") {
+            if (!c.readNumber(value)) return false;
+            entry.growthFunc = static_cast<int>(value);
+        } else if (key == "kernels") {
+            entry.multiKernel = true;
+            return c.forEachElement([&]() {
+                CatalogKernel kernel;
+                bool item = c.forEachMember([&](const std::string& k) {
+                    bool known = false;
+                    if (!parseKernelKey(c, k, kernel, known)) return false;
+                    return known || c.skipValue();
+                });
+                if (item) entry.kernels.push_back(kernel);
+                return item;
+            });
+        } else {
+            return c.skipValue();
+        }
+        return true;
+    });
+    if (!ok) return false;
+    if (!entry.multiKernel) entry.kernels.push_back(single);
+    return !entry.kernels.empty();
+}
+
+/** @brief Channels held by a "cells" value, without decoding it. */
+int countChannels(JsonCursor c) {
+    if (c.peek('"')) return 1;
+    JsonCursor probe = c;
+    if (!probe.consume('[') || !probe.peek('"')) return 1;     // Nested arrays: one plane
+    int count = 0;
+    c.forEachElement([&]() { ++count; return c.skipValue(); });
+    return std::max(count, 1);
+}
+
+/** @brief One plane from nested arrays of numbers. */
+bool parseGrid(JsonCursor& c, std::vector<float>& cells, int& rows, int& cols) {
+    std::vector<std::vector<float>> lines;
+    bool ok = c.forEachElement([&]() {
+        auto& line = lines.emplace_back();
+        return c.forEachElement([&]() {
+            double value = 0.0;
+            if (!c.readNumber(value)) return false;
+            line.push_back(static_cast<float>(value));
+            return true;
+        });
+    });
+    if (!ok || lines.empty()) return false;
+    rows = static_cast<int>(lines.size());
+    cols = 0;
+    for (const auto& line : lines) cols = std::max(cols, static_cast<int>(line.size()));
+    if (cols == 0) return false;
+    cells.assign(static_cast<size_t>(rows) * cols, 0.0f);
+    for (int y = 0; y < rows; ++y)
+        std::copy(lines[y].begin(), lines[y].end(), cells.begin() + static_cast<size_t>(y) * cols);
+    return true;
+}
+
+/**
+ * @brief Planes of a "cells" value: an RLE string, a list of RLE strings,
+ *        a 2D array of numbers or a list of them; padded to one size.
+ */
+bool parseCells(JsonCursor& c, std::vector<std::vector<float>>& planes, int& rows, int& cols) {
+    planes.clear();
+    std::vector<int> planeRows, planeCols;
+    auto addRle = [&]() {
+        std::string text;
+        int r = 0, w = 0;
+        if (!c.readString(text)) return false;
+        if (!decodeLeniaRle(text.data(), text.size(), planes.emplace_back(), r, w)) return false;
+        planeRows.push_back(r);
+        planeCols.push_back(w);
+        return true;
+    };
+
+    if (c.peek('"')) {
+        if (!addRle()) return false;
+    } else {
+        JsonCursor probe = c;
+        if (!probe.consume('[')) return false;
+        bool strings = probe.peek('"');
+        bool grid = probe.consume('[') && !probe.peek('[');
+        if (!strings && grid) {
+            int r = 0, w = 0;
+            if (!parseGrid(c, planes.emplace_back(), r, w)) return false;
+            planeRows.push_back(r);
+            planeCols.push_back(w);
+        } else {
+            bool ok = c.forEachElement([&]() {
+                if (c.peek('"')) return addRle();
+                int r = 0, w = 0;
+                if (!parseGrid(c, planes.emplace_back(), r, w)) return false;
+                planeRows.push_back(r);
+                planeCols.push_back(w);
+                return true;
+            });
+            if (!ok || planes.empty()) return false;
+        }
+    }
+
+    rows = *std::max_element(planeRows.begin(), planeRows.end());
+    cols = *std::max_element(planeCols.begin(), planeCols.end());
+    for (size_t i = 0; i < planes.size(); ++i) {
+        if (planeRows[i] == rows && planeCols[i] == cols) continue;
+        std::vector<float> padded(static_cast<size_t>(rows) * cols, 0.0f);
+        for (int y = 0; y < planeRows[i]; ++y)
+            std::copy_n(planes[i].begin() + static_cast<size_t>(y) * planeCols[i], planeCols[i],
+                        padded.begin() + static_cast<size_t>(y) * cols);
+        planes[i].swap(padded);
+    }
+    return true;
+}
+
+void writeString(std::ofstream& out, const std::string& s) {
+    uint32_t n = static_cast<uint32_t>(s.size());
+    out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    out.write(s.data(), n);
+}
+
+bool readString(std::ifstream& in, std::string& s) {
+    uint32_t n = 0;
+    if (!in.read(reinterpret_cast<char*>(&n), sizeof(n)) || n > (1u << 16)) return false;
+    s.resize(n);
+    return static_cast<bool>(in.read(s.data(), n));
+}
+
+template <typename T>
+void writePod(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+}
+
+bool decodeLeniaRle(const char* text, size_t length, std::vector<float>& cells, int& rows, int& cols) {
+    std::vector<std::vector<float>> lines(1);
+    size_t total = 0;
+    size_t count = 0;
+    char prefix = 0;
+    for (size_t i = 0; i < length; ++i) {
+        char ch = text[i];
+        if (ch >= '0' && ch <= '9') {
+            count = count * 10 + static_cast<size_t>(ch - '0');
+            if (count > MAX_RLE_CELLS) return false;
+            continue;
+        }
+        if (ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t') continue;
+        if (ch >= 'p' && ch <= 'y') {
+            prefix = ch;
+            continue;
+        }
+        size_t run = std::max<size_t>(count, 1);
+        count = 0;
+        if (!prefix && (ch == '!' || ch == '%' || ch == '#')) break;    // Past the first 2D slice
+        if (!prefix && ch == '$') {
+            lines.resize(lines.size() + run);               // Repeated '$': empty rows
+            if (lines.size() > MAX_RLE_CELLS) return false;
+            continue;
+        }
+
+        int value;
+        if (prefix) {
+            if (ch < 'A' || ch > 'X') return false;
+            value = (prefix - 'p') * 24 + (ch - 'A' + 25);
+            prefix = 0;
+        } else if (ch == '.' || ch == 'b') {
+            value = 0;
+        } else if (ch == 'o') {
+            value = 255;
+        } else if (ch >= 'A' && ch <= 'X') {
+            value = ch - 'A' + 1;
+        } else {
+            return false;
+        }
+        total += run;
+        if (total > MAX_RLE_CELLS) return false;
+        lines.back().insert(lines.back().end(), run, static_cast<float>(value) / 255.0f);
+    }
+
+    cols = 0;
+    for (const auto& line : lines) cols = std::max(cols, static_cast<int>(line.size()));
+    rows = static_cast<int>(lines.size());
+    if (cols == 0) return false;
+    cells.assign(static_cast<size_t>(rows) * cols, 0.0f);
+    for (int y = 0; y < rows; ++y)
+        std::copy(lines[y].begin(), lines[y].end(), cells.begin() + static_cast<size_t>(y) * cols);
+    return true;
+}
+
+bool AnimalCatalog::open(const std::string& path) {
+    TRACE_SCOPE("AnimalCatalog::open");
+    namespace fs = std::filesystem;
+    m_path = path;
+    m_entries.clear();
+    if (!m_file.open(path)) return false;
+
+    std::error_code ec;
+    uint64_t size = m_file.size();
+    int64_t mtime = static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+    std::string indexPath = path + ".idx";
+    if (loadIndex(indexPath, size, mtime)) return true;
+
+    m_entries.clear();
+    if (!scan()) {
+        m_entries.clear();
+        return false;
+    }
+    if (!saveIndex(indexPath, size, mtime))
+        LOG_WARN("AnimalCatalog: could not write %s, the catalog is rescanned next time", indexPath.c_str());
+    LOG_INFO("AnimalCatalog: indexed %zu species in %s", m_entries.size(), path.c_str());
+    return true;
+}
+
+/**
+ * @brief One pass over the mapped catalog: parameters are parsed, cells only
+ *        located.
+ */
+bool AnimalCatalog::scan() {
+    const char* begin = reinterpret_cast<const char*>(m_file.data());
+    JsonCursor c{begin, begin + m_file.size()};
+    std::string file = std::filesystem::path(m_path).filename().string();
+    std::string category = std::filesystem::path(m_path).stem().string();
+
+    JsonCursor probe = c;
+    if (!probe.consume('[') || !probe.peek('{')) return false;      // Not a list of species
+
+    return c.forEachElement([&]() {
+        if (!c.peek('{')) return c.skipValue();
+        CatalogEntry entry;
+        bool hasParams = false;
+        bool ok = c.forEachMember([&](const std::string& key) {
+            if (key == "name" && c.peek('"')) return c.readString(entry.name);
+            if (key == "code" && c.peek('"')) return c.readString(entry.code);
+            if (key == "params" && c.peek('{')) {
+                hasParams = true;
+                return parseParams(c, entry);
+            }
+            if (key == "cells") {
+                c.skipSpace();
+                entry.cellsOffset = static_cast<uint64_t>(c.p - begin);
+                entry.channels = countChannels(c);
+                if (!c.skipValue()) return false;
+                entry.cellsLength = static_cast<uint64_t>(c.p - begin) - entry.cellsOffset;
+                return true;
+            }
+            return c.skipValue();
+        });
+        if (!ok) return false;
+
+        if (!entry.code.empty() && entry.code[0] == '>') {
+            if (!entry.name.empty()) category = entry.name;
+            return true;
+        }
+        if (!hasParams || entry.cellsLength == 0) return true;
+        for (const auto& k : entry.kernels)
+            entry.channels = std::max({entry.channels, k.sourceChannel + 1, k.destChannel + 1});
+        if (entry.name.empty()) entry.name = entry.code;
+        entry.category = category;
+        entry.reference = file + "#" + std::to_string(m_entries.size());
+        m_entries.push_back(std::move(entry));
+        return true;
+    });
+}
+
+bool AnimalCatalog::loadIndex(const std::string& indexPath, uint64_t size, int64_t mtime) {
+    std::ifstream in(indexPath, std::ios::binary);
+    if (!in) return false;
+    char magic[8];
+    uint32_t version = 0, count = 0;
+    uint64_t indexedSize = 0;
+    int64_t indexedTime = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0) return false;
+    if (!readPod(in, version) || version != INDEX_VERSION) return false;
+    if (!readPod(in, indexedSize) || !readPod(in, indexedTime) || !readPod(in, count)) return false;
+    if (indexedSize != size || indexedTime != mtime) return false;     // Stale
+
+    m_entries.resize(count);
+    for (auto& e : m_entries) {
+        uint32_t kernels = 0;
+        uint8_t multi = 0;
+        if (!readString(in, e.name) || !readString(in, e.code) || !readString(in, e.category) ||
+            !readString(in, e.reference))
+            return false;
+        if (!readPod(in, e.channels) || !readPod(in, e.radius) || !readPod(in, e.dt) ||
+            !readPod(in, e.kernelCore) || !readPod(in, e.growthFunc) || !readPod(in, multi) ||
+            !readPod(in, e.cellsOffset) || !readPod(in, e.cellsLength) || !readPod(in, kernels))
+            return false;
+        if (kernels == 0 || kernels > 256 || e.cellsOffset + e.cellsLength > size) return false;
+        e.multiKernel = multi != 0;
+        e.kernels.resize(kernels);
+        for (auto& k : e.kernels)
+            if (!readPod(in, k)) return false;
+    }
+    return true;
+}
+
+bool AnimalCatalog::saveIndex(const std::string& indexPath, uint64_t size, int64_t mtime) const {
+    std::string tmpPath = indexPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        writePod(out, INDEX_VERSION);
+        writePod(out, size);
+        writePod(out, mtime);
+        writePod(out, static_cast<uint32_t>(m_entries.size()));
+        for (const auto& e : m_entries) {
+            writeString(out, e.name);
+            writeString(out, e.code);
+            writeString(out, e.category);
+            writeString(out, e.reference);
+            writePod(out, e.channels);
+            writePod(out, e.radius);
+            writePod(out, e.dt);
+            writePod(out, e.kernelCore);
+            writePod(out, e.growthFunc);
+            writePod(out, static_cast<uint8_t>(e.multiKernel));
+            writePod(out, e.cellsOffset);
+            writePod(out, e.cellsLength);
+            writePod(out, static_cast<uint32_t>(e.kernels.size()));
+            for (const auto& k : e.kernels) writePod(out, k);
+        }
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, indexPath, ec);
+    if (ec) std::filesystem::remove(tmpPath, ec);
+    return !ec;
+}
+
+bool AnimalCatalog::decode(int index, std::vector<std::vector<float>>& channels, int& rows, int& cols) const {
+    TRACE_SCOPE("AnimalCatalog::decode");
+    if (index < 0 || index >= static_cast<int>(m_entries.size())) return false;
+    const CatalogEntry& e = m_entries[index];
+    const char* begin = reinterpret_cast<const char*>(m_file.data()) + e.cellsOffset;
+    JsonCursor c{begin, begin + e.cellsLength};
+    if (!parseCells(c, channels, rows, cols)) {
+        LOG_ERROR("AnimalCatalog: bad cells for %s (%s) in %s", e.name.c_str(), e.code.c_str(), m_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+const AnimalCatalog* AnimalCatalog::shared(const std::string& path) {
+    static std::mutex mutex;
+    static std::vector<std::unique_ptr<AnimalCatalog>> catalogs;
+    static std::vector<std::string> rejected;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& catalog : catalogs)
+        if (catalog->path() == path) return catalog.get();
+    if (std::find(rejected.begin(), rejected.end(), path) != rejected.end()) return nullptr;
+
+    auto catalog = std::make_unique<AnimalCatalog>();
+    if (!catalog->open(path)) {
+        rejected.push_back(path);
+        return nullptr;
+    }
+    catalogs.push_back(std::move(catalog));
+    return catalogs.back().get();
+}
+
+bool AnimalCatalog::decodeReference(const std::string& reference, std::vector<float>& cells,
+                                    int& rows, int& cols) {
+    size_t hash = reference.rfind('#');
+    if (hash == std::string::npos) {
+        MappedFile file;
+        if (!file.open(reference)) return false;
+        const char* begin = reinterpret_cast<const char*>(file.data());
+        JsonCursor c{begin, begin + file.size()};
+        std::vector<std::vector<float>> planes;
+        if (!parseCells(c, planes, rows, cols)) {
+            LOG_ERROR("AnimalCatalog: %s holds no cell array", reference.c_str());
+            return false;
+        }
+        cells.swap(planes[0]);
+        return true;
+    }
+
+    const AnimalCatalog* catalog = shared(reference.substr(0, hash));
+    int index = std::atoi(reference.c_str() + hash + 1);
+    std::vector<std::vector<float>> planes;
+    if (!catalog || !catalog->decode(index, planes, rows, cols)) return false;
+    cells.swap(planes[0]);
+    return true;
+}
+
+}
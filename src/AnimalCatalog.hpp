@@ -0,0 +1,108 @@
+/**
+ * @file AnimalCatalog.hpp
+ * @brief Indexed reader for Lenia animal catalogs (animals.json) with RLE cells.
+ */
+
+#pragma once
+
+#include "Utils/MappedFile.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief One kernel of a catalog species ("kernels" list, or the single
+ *        kernel of R/b/m/s params).
+ */
+struct CatalogKernel {
+    float ringWeights[16]{};  // "b", as fractions
+    int   numRings{1};
+    float mu{0.15f};          // "m"
+    float sigma{0.015f};      // "s"
+    float growthStrength{1.0f};  // "h"
+    float radiusFraction{1.0f};  // "r"
+    int   sourceChannel{0};   // "c0"
+    int   destChannel{0};     // "c1"
+};
+
+/**
+ * @brief Parameters of one species and where its cells are in the catalog.
+ */
+struct CatalogEntry {
+    std::string name;
+    std::string code;         // Catalog code, e.g. "O2u"
+    std::string category;     // Name of the last group header ("code": ">...")
+    std::string reference;    // "<file>#<index>", usable as a species file
+    int   channels{1};        // Cell channels
+    int   radius{13};         // "R"
+    float dt{0.1f};           // 1 / "T"
+    int   kernelCore{1};      // "kn": 1 polynomial, 2 exponential, 3 step, 4 staircase
+    int   growthFunc{1};      // "gn": 1 polynomial, 2 gaussian, 3 step
+    bool  multiKernel{false}; // Params came as a "kernels" list
+    std::vector<CatalogKernel> kernels;
+    uint64_t cellsOffset{0};  // Bytes of the "cells" value in the catalog
+    uint64_t cellsLength{0};
+};
+
+/**
+ * @brief A catalog file mapped read-only, with one entry per species.
+ *
+ * open() loads <file>.idx when its recorded size and modification time
+ * still match the catalog; otherwise it scans the mapped JSON once, without
+ * building a document tree, and rewrites the index. The index holds the
+ * parsed parameters and the byte range of each species' cells, so decode()
+ * only parses the RLE of the species asked for.
+ */
+class AnimalCatalog {
+public:
+    static constexpr uint32_t INDEX_VERSION = 1;
+
+    AnimalCatalog() = default;
+
+    AnimalCatalog(const AnimalCatalog&) = delete;
+    AnimalCatalog& operator=(const AnimalCatalog&) = delete;
+
+    /** @brief Map @p path and index it; false if it is not a catalog. */
+    bool open(const std::string& path);
+
+    const std::string& path() const { return m_path; }
+    const std::vector<CatalogEntry>& entries() const { return m_entries; }
+
+    /**
+     * @brief Cells of entry @p index, one rows x cols plane per channel,
+     *        all padded to the same size.
+     */
+    bool decode(int index, std::vector<std::vector<float>>& channels, int& rows, int& cols) const;
+
+    /**
+     * @brief Catalog at @p path, opened on first use and kept for the rest of
+     *        the run so presets can point into it. nullptr if it is not a catalog.
+     */
+    static const AnimalCatalog* shared(const std::string& path);
+
+    /**
+     * @brief Decode "<catalog>#<index>" (first channel), or a .json file
+     *        holding a bare nested array of cell values.
+     */
+    static bool decodeReference(const std::string& reference, std::vector<float>& cells,
+                                int& rows, int& cols);
+
+private:
+    std::string m_path;
+    MappedFile  m_file;
+    std::vector<CatalogEntry> m_entries;
+
+    bool loadIndex(const std::string& indexPath, uint64_t size, int64_t mtime);
+    bool saveIndex(const std::string& indexPath, uint64_t size, int64_t mtime) const;
+    bool scan();
+};
+
+/**
+ * @brief Decode one Lenia RLE string into rows x cols values in [0, 1];
+ *        rows are padded to the longest one. Only the first 2D slice is read.
+ */
+bool decodeLeniaRle(const char* text, size_t length, std::vector<float>& cells, int& rows, int& cols);
+
+}
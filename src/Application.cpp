@@ -11,6 +11,8 @@
 #include "Presets.hpp"
 #include "Localization.hpp"
 #include "Utils/Logger.hpp"
+#include "Utils/Timestamp.hpp"
+#include "Utils/Trace.hpp"
 #include <glad/glad.h>
 #include "Utils/GLUtils.hpp"
 #include <iostream>
@@ -39,11 +41,48 @@ static bool loadShowConsoleConfig() {
     return true;
 }
 
+static bool loadThreadedSimulationConfig() {
+    std::ifstream cfg("lenia_config.txt");
+    if (!cfg.is_open()) return false;
+    std::string line;
+    while (std::getline(cfg, line)) {
+        if (line.find("threadedSimulation=") == 0) {
+            return line.substr(19) == "1";
+        }
+    }
+    return false;
+}
+
+// Keep drawing this long after the last event so ImGui hover/tooltips settle
+static constexpr double IDLE_SETTLE_SECONDS = 1.0;
+// Redraw interval while simulating in max-speed mode
+static constexpr double MAX_SPEED_PRESENT_INTERVAL = 0.25;
+// Checkpoint written by F5 / the Grid section and restored by F8
+static constexpr const char* QUICK_CHECKPOINT = "checkpoints/quick.lckp";
+
+/**
+ * @brief Copy the grid's tiling into the params shown by the Grid section.
+ */
+static void publishGridLayout(const LeniaEngine& engine, LeniaParams& params) {
+    const TiledState& tiles = engine.tiles();
+    params.gridTilesX = tiles.tilesX();
+    params.gridTilesY = tiles.tilesY();
+    params.gridOverviewScale = tiles.active() ? tiles.factor() : 1;
+}
+
 static void glfwErrorCallback(int code, const char* description) {
     LOG_ERROR("GLFW error %d: %s", code, description);
 }
 
 Application::~Application() {
+    m_simThread.stop();
+    m_engine.pollCheckpoint(true);
+    m_engine.pollExport(true);
+    m_recorder.stop();
+    if (Tracer::enabled()) Tracer::saveTimestamped();
+    m_stepController.release();
+    m_gpuProfiler.release();
+    if (m_throttleFence) glDeleteSync(m_throttleFence);
     m_ui.shutdown();
     if (m_window) {
         glfwDestroyWindow(m_window);
@@ -58,6 +97,8 @@ bool Application::init(int width, int height, const std::string& title) {
     
     if (!initWindow(width, height, title)) return false;
     if (!initGL()) return false;
+    GpuProfiler::makeCurrent(&m_gpuProfiler);
+    Tracer::setThreadName("Main");
 
     if (!m_engine.init("assets")) {
         LOG_ERROR("Engine initialisation failed.");
@@ -77,49 +118,57 @@ bool Application::init(int width, int height, const std::string& title) {
 
     m_callbacks = {
         .onReset = [this]() {
-            m_engine.reset(m_params);
+            runOnEngine([p = m_params](LeniaEngine& e) { e.reset(p); });
         },
         .onClear = [this]() {
-            m_engine.clear();
+            runOnEngine([](LeniaEngine& e) { e.clear(); });
         },
         .onRandomize = [this]() {
-            m_engine.randomizeGrid(m_params);
+            runOnEngine([p = m_params](LeniaEngine& e) { e.randomizeGrid(p); });
         },
         .onKernelChanged = [this]() {
-            m_engine.regenerateKernel(m_params);
+            runOnEngineSync([this](LeniaEngine& e) { e.regenerateKernel(m_params); });
         },
         .onGridResized = [this]() {
-            m_engine.resizeGrid(m_params);
-            m_engine.regenerateKernel(m_params);
+            runOnEngineSync([this](LeniaEngine& e) {
+                e.resizeGrid(m_params);
+                e.regenerateKernel(m_params);
+                publishGridLayout(e, m_params);
+            });
         },
         .onPresetSelected = [this](int idx) {
-            m_engine.applyPreset(idx, m_params);
+            runOnEngineSync([this, idx](LeniaEngine& e) {
+                e.applyPreset(idx, m_params);
+                e.reset(m_params);
+                publishGridLayout(e, m_params);
+            });
             m_stepsPerFrame = 7;
-            m_engine.reset(m_params);
         },
         .onKernelPresetSelected = [this](int idx) {
-            m_engine.applyKernelPreset(idx, m_params);
+            runOnEngineSync([this, idx](LeniaEngine& e) { e.applyKernelPreset(idx, m_params); });
         },
         .onChannelModeChanged = [this](int numCh) {
-            m_engine.switchChannelMode(m_params, numCh);
+            runOnEngineSync([this, numCh](LeniaEngine& e) { e.switchChannelMode(m_params, numCh); });
         },
         .onRuleKernelChanged = [this](int ruleIdx) {
-            m_engine.regenerateRuleKernel(ruleIdx, m_params);
+            runOnEngineSync([this, ruleIdx](LeniaEngine& e) { e.regenerateRuleKernel(ruleIdx, m_params); });
         },
         .getRuleKernelInfo = [this](int ruleIdx) -> std::pair<GLuint,int> {
-            return { m_engine.ruleKernelTexture(ruleIdx), m_engine.ruleKernelDiameter(ruleIdx) };
+            if (ruleIdx < 0 || ruleIdx >= 16) return { 0, 0 };
+            StateSnapshot snap = displaySnapshot();
+            return { snap.ruleKernelTex[ruleIdx], snap.ruleKernelDiameter[ruleIdx] };
         },
         .onFlipHorizontal = [this](bool) {
-            m_engine.flipGridHorizontal();
+            runOnEngine([](LeniaEngine& e) { e.flipGridHorizontal(); });
         },
         .onFlipVertical = [this](bool) {
-            m_engine.flipGridVertical();
+            runOnEngine([](LeniaEngine& e) { e.flipGridVertical(); });
         },
         .onRotateGrid = [this](int direction) {
-            m_engine.rotateGrid(direction, m_params);
+            runOnEngineSync([this, direction](LeniaEngine& e) { e.rotateGrid(direction, m_params); });
         },
         .getCellValue = [this](int x, int y) -> float {
-            return m_engine.getCellValue(x, y);
+            return cellValueAt(x, y);
         },
         .getSpeciesPreviewData = [this](int presetIdx, int& rows, int& cols, int& channels) -> std::vector<float> {
             const auto& presets = getPresets();
@@ -129,6 +178,7 @@ bool Application::init(int width, int height, const std::string& title) {
             const auto& p = presets[presetIdx];
             bool isMC = (std::strcmp(p.category, "Multichannel") == 0);
             if (isMC) {
+                prepareCatalogPreset(presetIdx);
                 for (const auto& mcp : mcPresets) {
                     if (std::strcmp(mcp.name, p.name) == 0 && mcp.cellsCh0) {
                         rows = mcp.cellRows;
@@ -154,25 +204,37 @@ bool Application::init(int width, int height, const std::string& title) {
             return {};
         },
         .onBrushApply = [this](int x, int y, const LeniaParams& params) {
-            m_engine.applyBrush(x, y, params);
+            runOnEngine([x, y, p = params](LeniaEngine& e) { e.applyBrush(x, y, p); });
         },
         .onBrushLine = [this](int x0, int y0, int x1, int y1, const LeniaParams& params) {
-            m_engine.applyBrushLine(x0, y0, x1, y1, params);
+            runOnEngine([x0, y0, x1, y1, p = params](LeniaEngine& e) { e.applyBrushLine(x0, y0, x1, y1, p); });
         },
         .onBrushCurve = [this](const std::vector<std::pair<int,int>>& points, const LeniaParams& params) {
-            m_engine.applyBrushCurve(points, params);
+            runOnEngine([points, p = params](LeniaEngine& e) { e.applyBrushCurve(points, p); });
         },
         .onWallApply = [this](int x, int y, const LeniaParams& params) {
-            m_engine.applyWall(x, y, params);
+            runOnEngine([x, y, p = params](LeniaEngine& e) { e.applyWall(x, y, p); });
         },
         .onWallLine = [this](int x0, int y0, int x1, int y1, const LeniaParams& params) {
-            m_engine.applyWallLine(x0, y0, x1, y1, params);
+            runOnEngine([x0, y0, x1, y1, p = params](LeniaEngine& e) { e.applyWallLine(x0, y0, x1, y1, p); });
         },
         .onWallCurve = [this](const std::vector<std::pair<int,int>>& points, const LeniaParams& params) {
-            m_engine.applyWallCurve(points, params);
+            runOnEngine([points, p = params](LeniaEngine& e) { e.applyWallCurve(points, p); });
         },
         .onClearWalls = [this]() {
-            m_engine.clearWalls();
+            runOnEngine([](LeniaEngine& e) { e.clearWalls(); });
+        },
+        .onSaveTrace = []() {
+            Tracer::saveTimestamped();
+        },
+        .onSaveCheckpoint = [this]() {
+            saveCheckpoint();
+        },
+        .onLoadCheckpoint = [this]() {
+            loadCheckpoint();
+        },
+        .onExportFields = [this]() {
+            exportFields();
         },
     };
     m_ui.setCallbacks(m_callbacks);
@@ -195,6 +257,7 @@ bool Application::init(int width, int height, const std::string& title) {
     m_params.placementMode = static_cast<int>(PlacementMode::Scatter);
     m_params.placementCount = 6;
     m_params.showConsoleOnStartup = loadShowConsoleConfig();
+    m_params.threadedSimulation = loadThreadedSimulationConfig();
     m_stepsPerFrame = 8;
     m_engine.reset(m_params);
     m_paused = true;
@@ -218,22 +281,189 @@ bool Application::init(int width, int height, const std::string& title) {
     return true;
 }
 
+/**
+ * @brief Whether the loop can block on window events instead of redrawing.
+ *
+ * True while paused with nothing animating, or while minimized and paused.
+ */
+bool Application::shouldIdle() const {
+    if (m_minimized) return m_paused && !m_singleStepRequested;
+    if (!m_paused || !m_params.idleWhenPaused) return false;
+    if (m_singleStepRequested || m_isPanning || m_ui.pauseOverlayActive()) return false;
+    if (glfwGetKey(m_window, GLFW_KEY_S) == GLFW_PRESS) return false;
+    return glfwGetTime() - m_lastActivityTime > IDLE_SETTLE_SECONDS;
+}
+
+/**
+ * @brief Keep at most one simulation batch queued when frames are not presented.
+ *
+ * Without a swap the driver can buffer an unbounded amount of work, which
+ * makes the next UI refresh lag far behind.
+ */
+void Application::throttleGpuQueue() {
+    TRACE_SCOPE("Application::throttleGpuQueue");
+    if (m_throttleFence) {
+        glClientWaitSync(m_throttleFence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        glDeleteSync(m_throttleFence);
+    }
+    m_throttleFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/**
+ * @brief Start or stop the simulation thread, handing the engine over.
+ */
+void Application::setThreadedSimulation(bool enabled) {
+    if (enabled == m_simThread.running()) return;
+    if (enabled) {
+        if (!m_simThread.start(m_window, m_engine, m_params)) {
+            m_params.threadedSimulation = false;
+            return;
+        }
+        m_simThread.setStepsPerBatch(m_stepsPerFrame);
+        m_simThread.setPaused(m_paused);
+    } else {
+        m_simThread.stop();
+    }
+    m_hasFrame = false;
+    m_analyzedRevision = ~0ull;
+}
+
+/**
+ * @brief Apply an engine mutation now, or queue it on the simulation thread.
+ *
+ * The command runs later when threaded, so it must capture by value
+ * anything the main thread may change in the meantime.
+ */
+void Application::runOnEngine(SimulationThread::Command cmd) {
+    if (m_simThread.running()) m_simThread.post(std::move(cmd));
+    else cmd(m_engine);
+}
+
+/**
+ * @brief Like runOnEngine(), but waits for completion; the command may use m_params.
+ */
+void Application::runOnEngineSync(SimulationThread::Command cmd) {
+    if (m_simThread.running()) m_simThread.postAndWait(std::move(cmd), &m_params);
+    else cmd(m_engine);
+}
+
+/**
+ * @brief Queue a save of the quick checkpoint; LeniaEngine::pollReadbacks() writes it.
+ */
+void Application::saveCheckpoint() {
+    runOnEngine([p = m_params](LeniaEngine& e) { e.saveCheckpoint(QUICK_CHECKPOINT, p); });
+}
+
+/**
+ * @brief Restore the quick checkpoint into the engine and m_params.
+ */
+void Application::loadCheckpoint() {
+    runOnEngineSync([this](LeniaEngine& e) {
+        e.pollCheckpoint(true);
+        if (e.loadCheckpoint(QUICK_CHECKPOINT, m_params))
+            publishGridLayout(e, m_params);
+    });
+}
+
+/**
+ * @brief Queue a NumPy export of every field to exports/; written like a checkpoint.
+ */
+void Application::exportFields() {
+    runOnEngine([p = m_params](LeniaEngine& e) {
+        e.exportFields(timestampedPath("exports/lenia_", ".npz"), ExportOptions{}, p);
+    });
+}
+
+/**
+ * @brief Start or stop the frame recorder to follow the UI toggle.
+ */
+void Application::setRecording(bool enabled) {
+    if (enabled == m_recorder.recording()) return;
+    if (!enabled) {
+        m_recorder.stop();
+        return;
+    }
+    auto format = static_cast<RecordFormat>(m_params.recordFormat);
+    std::string path = timestampedPath("recordings/lenia_", format == RecordFormat::Y4m ? ".y4m" : "");
+    if (!m_recorder.start(path, format, m_params.recordEvery))
+        m_params.recordVideo = false;
+}
+
+/**
+ * @brief Capture the shown state or field (@p rendered false) or the rendered frame (true) when due.
+ *
+ * Frames only queue a readback here; the recorder writes them on its own thread.
+ */
+void Application::recordFrame(bool rendered) {
+    if (!m_recorder.recording()) return;
+    auto source = static_cast<RecordSource>(m_params.recordSource);
+    if (rendered == (source == RecordSource::Display)) {
+        StateSnapshot snap = displaySnapshot();
+        if (snap.stateTex && m_recorder.due(snap.stepCount)) {
+            if (source == RecordSource::Display) {
+                m_recorder.captureFramebuffer(m_windowW, m_windowH, snap.stepCount);
+            } else {
+                GLuint tex = (source == RecordSource::Potential) ? snap.neighborSumsTex :
+                             (source == RecordSource::Growth)    ? snap.growthTex : snap.stateTex;
+                float lo = (source == RecordSource::Growth) ? -1.0f : 0.0f;
+                m_recorder.captureTexture(tex, snap.gridW, snap.gridH, snap.format == GL_RGBA32F,
+                                          lo, 1.0f, snap.stepCount);
+            }
+        }
+    }
+    m_recorder.poll();
+    m_params.recordFrames = m_recorder.framesCaptured();
+    m_params.recordDropped = m_recorder.framesDropped();
+}
+
+/**
+ * @brief The state currently on screen: the acquired frame when threaded.
+ */
+StateSnapshot Application::displaySnapshot() const {
+    if (m_simThread.running()) return m_hasFrame ? m_frame.snapshot : StateSnapshot{};
+    return m_engine.snapshot();
+}
+
+float Application::cellValueAt(int x, int y) const {
+    return LeniaEngine::readCellValue(displaySnapshot(), x, y);
+}
+
 /**
  * @brief Main application loop.
  * 
  * Each frame:
- * 1. Process window events and input
- * 2. Run simulation steps (if not paused)
+ * 1. Process window events and input (or block on them when idle)
+ * 2. Run simulation steps (if not paused), or when threaded, forward
+ *    params to the simulation thread and pick up its latest state
  * 3. Run analysis (if enabled)
- * 4. Render simulation state
+ * 4. Render simulation state (skipped when minimized or between
+ *    max-speed refreshes)
  * 5. Render UI overlay
  * 6. Swap buffers
  */
 void Application::run() {
     LOG_INFO("Entering main loop.");
+    m_lastActivityTime = glfwGetTime();
     while (!glfwWindowShouldClose(m_window)) {
-        glfwPollEvents();
+        {
+            TRACE_SCOPE("Application::events");
+            if (shouldIdle()) {
+                glfwWaitEvents();
+                m_lastActivityTime = glfwGetTime();
+            } else if (m_minimized && m_simThread.running()) {
+                // Simulation continues on its own; wake only for analysis/autopause
+                glfwWaitEventsTimeout(MAX_SPEED_PRESENT_INTERVAL);
+            } else {
+                glfwPollEvents();
+            }
+        }
+        TRACE_SCOPE("Application::frame");
+        Tracer::setEnabled(m_params.traceRecording);
+        setRecording(m_params.recordVideo);
+        m_gpuProfiler.beginFrame();
         processInput();
+        setThreadedSimulation(m_params.threadedSimulation);
+        bool threaded = m_simThread.running();
 
         bool doSim = !m_paused;
 
@@ -259,20 +489,60 @@ void Application::run() {
             m_sKeyWasDown = sDown;
         }
 
-        if (doSim) {
+        // The simulation thread advances saves and exports in its own loop
+        if (!threaded) m_engine.pollReadbacks();
+
+        bool newState = doSim;
+        if (threaded) {
+            m_simThread.setStepsPerBatch(m_stepsPerFrame);
+            m_simThread.setPaused(m_paused);
+            m_simThread.setParams(m_params);
+            if (doSim && m_paused) m_simThread.requestStep();
+
+            m_hasFrame = m_simThread.acquireFrame(m_frame);
+            newState = m_hasFrame && m_frame.snapshot.revision != m_analyzedRevision;
+            if (m_hasFrame) {
+                m_simTimeMs = m_frame.simTimeMs;
+                m_params.gpuStepMs = m_frame.gpuStepMs;
+                if (m_params.autoStepsMode != 0 && m_frame.stepsPerBatch > 0)
+                    m_stepsPerFrame = m_frame.stepsPerBatch;
+            }
+        } else if (doSim) {
             int steps = m_stepsPerFrame;
-            auto t0 = std::chrono::high_resolution_clock::now();
-            if (m_params.numKernelRules > 0) {
-                m_engine.updateMultiChannel(m_params, steps);
-            } else {
-                m_engine.update(m_params, steps);
+            if (!m_paused) {
+                double now = glfwGetTime();
+                double interval = (m_lastBatchTime > 0.0) ? now - m_lastBatchTime : 1.0 / 60.0;
+                m_lastBatchTime = now;
+                steps = m_stepController.stepsForNextBatch(m_params, m_stepsPerFrame, interval);
+                if (m_params.autoStepsMode != 0 && steps > 0) m_stepsPerFrame = steps;
             }
-            auto t1 = std::chrono::high_resolution_clock::now();
-            m_simTimeMs = std::chrono::duration<float, std::milli>(t1 - t0).count();
+
+            if (steps > 0) {
+                auto t0 = std::chrono::high_resolution_clock::now();
+                m_stepController.beginBatch();
+                if (m_params.numKernelRules > 0) {
+                    m_engine.updateMultiChannel(m_params, steps);
+                } else {
+                    m_engine.update(m_params, steps);
+                }
+                m_stepController.endBatch(steps);
+                auto t1 = std::chrono::high_resolution_clock::now();
+                m_simTimeMs = std::chrono::duration<float, std::milli>(t1 - t0).count();
+                m_params.gpuStepMs = m_stepController.gpuStepMs();
+                m_params.worldResidentChunks = m_engine.world().residentCount();
+                m_params.worldCachedChunks = m_engine.world().cachedCount();
+            }
+        } else {
+            m_lastBatchTime = 0.0;
         }
 
-        if (m_params.showAnalysis && doSim) {
-            m_engine.runAnalysis(m_params.analysisThreshold);
+        if (m_params.showAnalysis && newState) {
+            if (threaded) {
+                m_engine.runAnalysis(m_frame.snapshot, m_params.analysisThreshold);
+                m_analyzedRevision = m_frame.snapshot.revision;
+            } else {
+                m_engine.runAnalysis(m_params.analysisThreshold);
+            }
             if (!m_paused && m_params.autoPause) {
                 const auto& amgr = m_engine.analysisMgr();
                 if (amgr.isEmpty() || amgr.isStabilized()) {
@@ -282,7 +552,28 @@ void Application::run() {
             }
         }
 
-        m_engine.render(m_windowW, m_windowH, m_params);
+        recordFrame(false);
+
+        bool present = !m_minimized;
+        if (present && !threaded && doSim && !m_paused && m_params.maxSpeed) {
+            double now = glfwGetTime();
+            present = now - m_lastPresentTime >= MAX_SPEED_PRESENT_INTERVAL;
+            if (present) m_lastPresentTime = now;
+        }
+        if (!present) {
+            m_gpuProfiler.endFrame();
+            if (doSim && !threaded) throttleGpuQueue();
+            continue;
+        }
+
+        if (!threaded) {
+            m_engine.render(m_windowW, m_windowH, m_params);
+        } else if (m_hasFrame) {
+            m_engine.renderSnapshot(m_frame.snapshot, m_windowW, m_windowH, m_params);
+        } else {
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+        recordFrame(true);
 
         int mouseGridX = -1, mouseGridY = -1;
         float mouseValue = 0.0f;
@@ -325,7 +616,7 @@ void Application::run() {
                 mouseGridX = wrappedX;
                 mouseGridY = wrappedY;
                 mouseInGrid = true;
-                mouseValue = m_engine.getCellValue(mouseGridX, mouseGridY);
+                mouseValue = cellValueAt(mouseGridX, mouseGridY);
             }
 
             bool canInteract = (m_params.edgeModeX == 0 && m_params.edgeModeY == 0) ||
@@ -544,16 +835,37 @@ void Application::run() {
             }
         }
 
-        m_ui.beginFrame();
-        m_ui.render(m_params, m_paused, m_stepsPerFrame, m_showUI,
-                    &m_engine.analysisData(), &m_engine.analysisMgr(),
-                    m_engine.kernelTexture(), m_engine.kernelDiameter(),
-                    m_engine.stepCount(), m_simTimeMs,
-                    mouseGridX, mouseGridY, mouseValue, mouseInGrid);
-        m_ui.renderPauseOverlay(m_windowW, m_windowH);
-        m_ui.endFrame();
+        GpuPassTimes gpuTimes = m_gpuProfiler.latest();
+        if (threaded && m_hasFrame && m_frame.gpuTimes.valid) {
+            for (int p = 0; p < static_cast<int>(GpuPass::Count); ++p) {
+                gpuTimes.ms[p]    += m_frame.gpuTimes.ms[p];
+                gpuTimes.spans[p] += m_frame.gpuTimes.spans[p];
+            }
+            gpuTimes.totalMs += m_frame.gpuTimes.totalMs;
+            gpuTimes.valid = true;
+        }
+        m_ui.setGpuTimings(gpuTimes);
+
+        StateSnapshot shown = displaySnapshot();
+        {
+            TRACE_GL_SCOPE("Application::ui");
+            m_ui.beginFrame();
+            m_ui.render(m_params, m_paused, m_stepsPerFrame, m_showUI,
+                        &m_engine.analysisData(), &m_engine.analysisMgr(),
+                        shown.kernelTex, shown.kernelDiameter,
+                        shown.stepCount, m_simTimeMs,
+                        mouseGridX, mouseGridY, mouseValue, mouseInGrid);
+            m_ui.renderPauseOverlay(m_windowW, m_windowH);
+            GpuPassScope gpuScope(GpuPass::ImGui);
+            m_ui.endFrame();
+        }
+        if (threaded && m_hasFrame) m_simThread.releaseFrame();
 
-        glfwSwapBuffers(m_window);
+        {
+            TRACE_SCOPE("Application::present");
+            glfwSwapBuffers(m_window);
+        }
+        m_gpuProfiler.endFrame();
     }
     LOG_INFO("Main loop ended.");
 }
@@ -733,6 +1045,8 @@ bool Application::initGL() {
 
 void Application::setupCallbacks() {
     glfwSetFramebufferSizeCallback(m_window, framebufferSizeCallback);
+    glfwSetWindowIconifyCallback(m_window, windowIconifyCallback);
+    glfwSetWindowRefreshCallback(m_window, windowRefreshCallback);
     glfwSetKeyCallback(m_window, keyCallback);
     glfwSetScrollCallback(m_window, scrollCallback);
     glfwSetMouseButtonCallback(m_window, mouseButtonCallback);
@@ -744,12 +1058,27 @@ void Application::framebufferSizeCallback(GLFWwindow* window, int width, int hei
     if (app) {
         app->m_windowW = width;
         app->m_windowH = height;
+        app->m_minimized = (width <= 0 || height <= 0);
+        app->m_lastActivityTime = glfwGetTime();
     }
 }
 
+void Application::windowIconifyCallback(GLFWwindow* window, int iconified) {
+    auto* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
+    if (!app) return;
+    app->m_minimized = (iconified == GLFW_TRUE);
+    app->m_lastActivityTime = glfwGetTime();
+}
+
+void Application::windowRefreshCallback(GLFWwindow* window) {
+    auto* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
+    if (app) app->m_lastActivityTime = glfwGetTime();
+}
+
 void Application::keyCallback(GLFWwindow* window, int key, int, int action, int) {
     auto* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
     if (!app) return;
+    app->m_lastActivityTime = glfwGetTime();
 
     if (action != GLFW_PRESS) return;
 
@@ -759,14 +1088,26 @@ void Application::keyCallback(GLFWwindow* window, int key, int, int action, int)
             app->m_ui.triggerPauseOverlay(app->m_paused);
             break;
         case GLFW_KEY_R:
-            app->m_engine.reset(app->m_params);
+            app->runOnEngine([p = app->m_params](LeniaEngine& e) { e.reset(p); });
             break;
         case GLFW_KEY_C:
-            app->m_engine.clear();
+            app->runOnEngine([](LeniaEngine& e) { e.clear(); });
             break;
         case GLFW_KEY_TAB:
             app->m_showUI = !app->m_showUI;
             break;
+        case GLFW_KEY_F5:
+            app->saveCheckpoint();
+            break;
+        case GLFW_KEY_F6:
+            app->exportFields();
+            break;
+        case GLFW_KEY_F8:
+            app->loadCheckpoint();
+            break;
+        case GLFW_KEY_F9:
+            if (Tracer::enabled()) Tracer::saveTimestamped();
+            break;
         case GLFW_KEY_F11:
             app->toggleFullscreen();
             break;
@@ -808,6 +1149,7 @@ void Application::keyCallback(GLFWwindow* window, int key, int, int action, int)
 void Application::scrollCallback(GLFWwindow* window, double, double yoffset) {
     auto* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
     if (!app) return;
+    app->m_lastActivityTime = glfwGetTime();
 
     ImGuiIO& io = ImGui::GetIO();
     if (io.WantCaptureMouse) return;  // UI has focus
@@ -842,6 +1184,7 @@ void Application::scrollCallback(GLFWwindow* window, double, double yoffset) {
 void Application::mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
     auto* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
     if (!app) return;
+    app->m_lastActivityTime = glfwGetTime();
 
     ImGuiIO& io = ImGui::GetIO();
     if (io.WantCaptureMouse) return;
@@ -864,6 +1207,7 @@ void Application::mouseButtonCallback(GLFWwindow* window, int button, int action
 void Application::cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
     auto* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
     if (!app) return;
+    app->m_lastActivityTime = glfwGetTime();
 
     if (!app->m_isPanning) return;
 
@@ -9,6 +9,10 @@
 #include <GLFW/glfw3.h>
 #include "LeniaEngine.hpp"
 #include "UIOverlay.hpp"
+#include "SimulationThread.hpp"
+#include "StepController.hpp"
+#include "GpuProfiler.hpp"
+#include "FrameRecorder.hpp"
 #include <string>
 
 namespace lenia {
@@ -20,7 +24,8 @@ namespace lenia {
  * - Window creation and OpenGL context setup
  * - Input handling (keyboard, mouse, zoom, pan)
  * - Coordination between simulation engine and UI
- * - Main render loop timing
+ * - Main render loop timing (idle blocking, max-speed throughput)
+ * - Optional simulation thread; engine mutations then go through runOnEngine()
  */
 class Application {
 public:
@@ -36,12 +41,20 @@ public:
 private:
     GLFWwindow*  m_window{nullptr};    // Main application window
     LeniaEngine  m_engine;             // Core simulation engine
+    SimulationThread m_simThread;      // Runs m_engine when threaded simulation is on
+    SimFrame     m_frame;              // Last frame acquired from the simulation thread
+    bool         m_hasFrame{false};
+    uint64_t     m_analyzedRevision{~0ull};  // State revision the analysis last saw
     UIOverlay    m_ui;                 // ImGui-based user interface
     LeniaParams  m_params;             // Current simulation parameters
     bool         m_paused{true};       // Simulation pause state
     bool         m_showUI{true};       // UI visibility toggle
     bool         m_fullscreen{false};  // Fullscreen mode flag
     int          m_stepsPerFrame{1};   // Simulation steps per render frame
+    StepController m_stepController;   // Auto steps when simulating on this thread
+    double       m_lastBatchTime{0.0}; // Start of the previous unpaused batch
+    GpuProfiler  m_gpuProfiler;        // Per-pass GPU times of this thread's frames
+    FrameRecorder m_recorder;          // Frames or state captured to PNG / Y4M
     int          m_windowW{960};       // Current window width
     int          m_windowH{640};       // Current window height
     int          m_savedWinX{0};       // Saved window position for fullscreen toggle
@@ -52,6 +65,12 @@ private:
     bool         m_singleStepRequested{false};  // Manual step request while paused
     double       m_lastStepTime{0.0};  // Time of last manual step (for repeat stepping)
     bool         m_sKeyWasDown{false}; // Previous frame S key state
+
+    // Frame pacing state
+    bool         m_minimized{false};   // Window iconified (nothing to present)
+    double       m_lastActivityTime{0.0};  // Last input/window event, keeps redrawing briefly
+    double       m_lastPresentTime{0.0};   // Last presented frame in max-speed mode
+    GLsync       m_throttleFence{nullptr}; // Bounds queued GPU work when not presenting
     
     // Brush drawing state
     int          m_lastBrushX{-1};     // Last brush position for continuous drawing
@@ -83,8 +102,22 @@ private:
     void setupCallbacks();
     void processInput();
     void toggleFullscreen();
+    bool shouldIdle() const;
+    void throttleGpuQueue();
+    void setThreadedSimulation(bool enabled);
+    void runOnEngine(SimulationThread::Command cmd);
+    void runOnEngineSync(SimulationThread::Command cmd);
+    void saveCheckpoint();
+    void setRecording(bool enabled);
+    void recordFrame(bool rendered);
+    void loadCheckpoint();
+    void exportFields();
+    StateSnapshot displaySnapshot() const;
+    float cellValueAt(int x, int y) const;
 
     static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
+    static void windowIconifyCallback(GLFWwindow* window, int iconified);
+    static void windowRefreshCallback(GLFWwindow* window);
     static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
     static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
     static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
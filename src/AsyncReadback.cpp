@@ -0,0 +1,105 @@
+/**
+ * @file AsyncReadback.cpp
+ * @brief Pack-buffer readbacks, fence polling and the worker thread.
+ */
+
+#include "AsyncReadback.hpp"
+#include "Utils/Logger.hpp"
+#include <algorithm>
+
+namespace lenia {
+
+AsyncReadback::~AsyncReadback() {
+    if (m_worker.joinable()) m_worker.join();
+    release();
+}
+
+bool AsyncReadback::begin(const std::vector<ReadbackSource>& sources, Work work) {
+    if (busy()) return false;
+
+    // Shader writes must land before the pack transfers read the textures
+    glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+    for (const ReadbackSource& src : sources) {
+        size_t rowBytes = static_cast<size_t>(src.w) * src.components * sizeof(float);
+        int blockRows = static_cast<int>(std::max<size_t>(1, BLOCK_BYTES / rowBytes));
+        for (int y = 0; y < src.h; y += blockRows) {
+            ReadbackBlock block;
+            block.tag = src.tag;
+            block.x = src.x;
+            block.y = src.y + y;
+            block.w = src.w;
+            block.h = std::min(blockRows, src.h - y);
+            block.components = src.components;
+            block.bytes = rowBytes * block.h;
+
+            glCreateBuffers(1, &block.buffer);
+            glNamedBufferStorage(block.buffer, static_cast<GLsizeiptr>(block.bytes), nullptr, GL_MAP_READ_BIT);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, block.buffer);
+            glGetTextureSubImage(src.tex, 0, src.texX, src.texY + y, 0, block.w, block.h, 1,
+                                 src.components == 4 ? GL_RGBA : GL_RED, GL_FLOAT,
+                                 static_cast<GLsizei>(block.bytes), nullptr);
+            m_blocks.push_back(block);
+        }
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (glGetError() == GL_OUT_OF_MEMORY) {
+        release();
+        return false;
+    }
+    m_work = std::move(work);
+    m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+    m_stage = Stage::Reading;
+    return true;
+}
+
+bool AsyncReadback::poll(bool wait) {
+    if (m_stage == Stage::Reading) {
+        GLuint64 timeout = wait ? GL_TIMEOUT_IGNORED : 0;
+        GLenum status = glClientWaitSync(m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return false;
+        glDeleteSync(m_fence);
+        m_fence = nullptr;
+
+        bool mapped = true;
+        for (ReadbackBlock& block : m_blocks) {
+            block.data = static_cast<const float*>(
+                glMapNamedBufferRange(block.buffer, 0, static_cast<GLsizeiptr>(block.bytes), GL_MAP_READ_BIT));
+            mapped = mapped && block.data;
+        }
+        if (!mapped) {
+            LOG_ERROR("Cannot map a readback buffer; nothing is written.");
+            m_succeeded = false;
+            release();
+            return true;
+        }
+        m_done = false;
+        m_stage = Stage::Working;
+        m_worker = std::thread([this]() {
+            m_ok = m_work(m_blocks);
+            m_done = true;
+        });
+    }
+
+    if (m_stage != Stage::Working) return false;
+    if (!wait && !m_done) return false;
+    m_worker.join();
+    m_succeeded = m_ok;
+    release();
+    return true;
+}
+
+void AsyncReadback::release() {
+    if (m_fence) glDeleteSync(m_fence);
+    m_fence = nullptr;
+    for (ReadbackBlock& block : m_blocks) {
+        if (block.data) glUnmapNamedBuffer(block.buffer);
+        glDeleteBuffers(1, &block.buffer);
+    }
+    m_blocks.clear();
+    m_work = nullptr;
+    m_stage = Stage::Idle;
+}
+
+}
@@ -0,0 +1,94 @@
+/**
+ * @file AsyncReadback.hpp
+ * @brief Texture readback into pixel pack buffers, handed to a worker thread.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief Part of a texture read back by an AsyncReadback.
+ */
+struct ReadbackSource {
+    GLuint   tex{0};
+    int      texX{0};            // Origin inside the texture (tiles skip their halo)
+    int      texY{0};
+    int      x{0};               // Origin in the grid
+    int      y{0};
+    int      w{0};
+    int      h{0};
+    int      components{1};      // 1 (R32F) or 4 (RGBA32F)
+    uint32_t tag{0};             // Caller's label, copied to its blocks (plane kind, export field)
+};
+
+/**
+ * @brief Rows of one source in a pack buffer, mapped while the work runs.
+ */
+struct ReadbackBlock {
+    uint32_t     tag{0};
+    GLuint       buffer{0};
+    const float* data{nullptr};
+    size_t       bytes{0};
+    int          x{0}, y{0}, w{0}, h{0};
+    int          components{1};
+};
+
+/**
+ * @brief Reads textures back without stalling the GL thread.
+ *
+ * begin() queues the readbacks, split into blocks of at most BLOCK_BYTES,
+ * plus a fence, so the data is the one at that call. poll(), on the same
+ * GL thread, maps the blocks once the fence has signalled and runs the
+ * work on a worker thread; the buffers are released when it is done. If a
+ * block cannot be mapped the work does not run and the readback fails.
+ * CheckpointWriter and FieldExporter are built on it.
+ */
+class AsyncReadback {
+public:
+    /** @brief Runs on the worker thread over the mapped blocks; returns success. */
+    using Work = std::function<bool(const std::vector<ReadbackBlock>& blocks)>;
+
+    static constexpr size_t BLOCK_BYTES = 64u << 20;     // Largest single pack buffer
+
+    AsyncReadback() = default;
+    ~AsyncReadback();
+
+    AsyncReadback(const AsyncReadback&) = delete;
+    AsyncReadback& operator=(const AsyncReadback&) = delete;
+
+    /** @brief Queue the readbacks; false, with nothing pending, when GL runs out of memory. */
+    bool begin(const std::vector<ReadbackSource>& sources, Work work);
+    /**
+     * @brief Advance a pending readback; @p wait blocks until the work is done.
+     * @return true when the work finished during this call, see succeeded()
+     */
+    bool poll(bool wait = false);
+
+    bool busy() const { return m_stage != Stage::Idle; }
+    /** @brief Outcome of the last finished work. */
+    bool succeeded() const { return m_succeeded; }
+
+private:
+    enum class Stage { Idle, Reading, Working };
+
+    Stage                      m_stage{Stage::Idle};
+    std::vector<ReadbackBlock> m_blocks;
+    Work                       m_work;
+    GLsync                     m_fence{nullptr};
+    std::thread                m_worker;
+    std::atomic<bool>          m_done{false};
+    bool                       m_ok{false};        // Written by the worker before m_done
+    bool                       m_succeeded{false};
+
+    void release();
+};
+
+}
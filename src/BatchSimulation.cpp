@@ -0,0 +1,269 @@
+/**
+ * @file BatchSimulation.cpp
+ * @brief Implementation of the texture-array batch of mini-universes.
+ */
+
+#include "BatchSimulation.hpp"
+#include "GpuProfiler.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+#include <random>
+
+namespace lenia {
+
+static_assert(sizeof(BatchUniverseParams) == 32, "BatchUniverseParams must match the std430 layout");
+static_assert(sizeof(BatchUniverseStats) == 32, "BatchUniverseStats must match the std430 layout");
+
+BatchSimulation::~BatchSimulation() {
+    release();
+    if (m_ubo) glDeleteBuffers(1, &m_ubo);
+}
+
+bool BatchSimulation::init(const std::string& shaderDir) {
+    if (!m_simShader.loadCompute(shaderDir + "sim_batch.comp")) {
+        LOG_ERROR("Failed to load sim_batch.comp"); return false;
+    }
+    if (!m_statsShader.loadCompute(shaderDir + "batch_stats.comp")) {
+        LOG_ERROR("Failed to load batch_stats.comp"); return false;
+    }
+    if (!m_kernelGen.init(shaderDir)) {
+        LOG_ERROR("Failed to load kernel_gen.comp / kernel_normalize.comp"); return false;
+    }
+    glCreateBuffers(1, &m_ubo);
+    glNamedBufferStorage(m_ubo, sizeof(GPUBatchParams), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    return true;
+}
+
+void BatchSimulation::freeUniverses() {
+    if (m_textures[0]) glDeleteTextures(2, m_textures);
+    if (m_paramsSSBO) glDeleteBuffers(1, &m_paramsSSBO);
+    if (m_statsSSBO) glDeleteBuffers(1, &m_statsSSBO);
+    m_textures[0] = m_textures[1] = 0;
+    m_paramsSSBO = m_statsSSBO = 0;
+    m_current = 0;
+    m_gridW = m_gridH = m_count = m_stepCount = 0;
+    m_params.clear();
+    m_stats.clear();
+}
+
+void BatchSimulation::release() {
+    freeUniverses();
+    if (m_kernelArray) glDeleteTextures(1, &m_kernelArray);
+    m_kernelArray = 0;
+    m_kernelDiameter = m_kernelRadius = m_kernelCount = 0;
+}
+
+/**
+ * @brief Allocate @p count universes of gridW x gridH, all zero with default parameters.
+ */
+bool BatchSimulation::allocate(int gridW, int gridH, int count) {
+    TRACE_SCOPE("BatchSimulation::allocate");
+    GLint maxLayers = 0, maxSize = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (count < 1 || count > maxLayers || gridW < 1 || gridH < 1 || gridW > maxSize || gridH > maxSize) {
+        LOG_ERROR("Batch of %d universes of %dx%d exceeds the GL limits (%d layers, %d texels).",
+                  count, gridW, gridH, maxLayers, maxSize);
+        return false;
+    }
+
+    int reach = m_kernelRadius * 2 + 1;
+    if (m_kernelCount > 0 && (reach > gridW || reach > gridH)) {
+        LOG_ERROR("Kernel radius %d does not fit a %dx%d universe.", m_kernelRadius, gridW, gridH);
+        return false;
+    }
+
+    freeUniverses();
+    m_gridW = gridW;
+    m_gridH = gridH;
+    m_count = count;
+
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 2, m_textures);
+    float zero = 0.0f;
+    for (GLuint tex : m_textures) {
+        glTextureStorage3D(tex, 1, GL_R32F, gridW, gridH, count);
+        glTextureParameteri(tex, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTextureParameteri(tex, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTextureParameteri(tex, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTextureParameteri(tex, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glClearTexImage(tex, 0, GL_RED, GL_FLOAT, &zero);
+    }
+
+    m_params.assign(count, BatchUniverseParams{});
+    glCreateBuffers(1, &m_paramsSSBO);
+    glNamedBufferStorage(m_paramsSSBO, sizeof(BatchUniverseParams) * count, m_params.data(),
+                         GL_DYNAMIC_STORAGE_BIT);
+
+    m_stats.assign(count, BatchUniverseStats{});
+    glCreateBuffers(1, &m_statsSSBO);
+    glNamedBufferStorage(m_statsSSBO, sizeof(BatchUniverseStats) * count, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    LOG_INFO("Batch allocated: %d universes of %dx%d (%.1f MB of state)", count, gridW, gridH,
+             2.0 * gridW * gridH * count * sizeof(float) / (1024.0 * 1024.0));
+    return true;
+}
+
+/**
+ * @brief Generate each kernel and copy it into its own layer of the kernel array.
+ *
+ * The kernels must share their radius, which sets the stencil, and their
+ * texture size (3x3 for GameOfLife, 2r otherwise), which sets the layers.
+ */
+bool BatchSimulation::setKernels(const std::vector<KernelConfig>& kernels) {
+    TRACE_GL_SCOPE("BatchSimulation::setKernels");
+    if (kernels.empty()) return false;
+    int radius = kernels[0].radius;
+    int diameter = kernels[0].kernelType == 4 ? 3 : radius * 2;
+    for (const auto& k : kernels) {
+        int d = k.kernelType == 4 ? 3 : k.radius * 2;
+        if (k.radius != radius || d != diameter) {
+            LOG_ERROR("Batch kernels must share one radius and size (%d/%d vs %d/%d).",
+                      k.radius, d, radius, diameter);
+            return false;
+        }
+    }
+    int reach = radius * 2 + 1;
+    if (m_count > 0 && (reach > m_gridW || reach > m_gridH)) {
+        LOG_ERROR("Kernel radius %d does not fit a %dx%d universe.", radius, m_gridW, m_gridH);
+        return false;
+    }
+
+    // Sampled like LeniaEngine's kernel sampler, so stretched kernels match a single grid
+    if (m_kernelArray) glDeleteTextures(1, &m_kernelArray);
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_kernelArray);
+    glTextureStorage3D(m_kernelArray, 1, GL_R32F, diameter, diameter, static_cast<GLsizei>(kernels.size()));
+    glTextureParameteri(m_kernelArray, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTextureParameteri(m_kernelArray, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTextureParameteri(m_kernelArray, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(m_kernelArray, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    for (size_t i = 0; i < kernels.size(); ++i) {
+        m_kernelGen.generate(kernels[i]);
+        glCopyImageSubData(m_kernelGen.texture(), GL_TEXTURE_2D, 0, 0, 0, 0,
+                           m_kernelArray, GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(i),
+                           diameter, diameter, 1);
+    }
+    m_kernelDiameter = diameter;
+    m_kernelRadius = radius;
+    m_kernelCount = static_cast<int>(kernels.size());
+    return true;
+}
+
+void BatchSimulation::setParams(const std::vector<BatchUniverseParams>& params) {
+    if (m_count == 0) return;
+    size_t n = std::min(params.size(), static_cast<size_t>(m_count));
+    std::copy(params.begin(), params.begin() + n, m_params.begin());
+    for (auto& p : m_params)
+        p.kernelLayer = std::clamp(p.kernelLayer, 0, std::max(0, m_kernelCount - 1));
+    glNamedBufferSubData(m_paramsSSBO, 0, sizeof(BatchUniverseParams) * m_count, m_params.data());
+}
+
+void BatchSimulation::seedRandom(uint32_t seed, float fraction) {
+    TRACE_SCOPE("BatchSimulation::seedRandom");
+    if (m_count == 0) return;
+    int side = std::max(1, static_cast<int>(std::min(m_gridW, m_gridH) * std::clamp(fraction, 0.0f, 1.0f)));
+    int x0 = (m_gridW - side) / 2;
+    int y0 = (m_gridH - side) / 2;
+
+    std::vector<float> data(static_cast<size_t>(m_gridW) * m_gridH * m_count, 0.0f);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (int layer = 0; layer < m_count; ++layer) {
+        std::mt19937 rng(seed + static_cast<uint32_t>(layer));
+        float* base = data.data() + static_cast<size_t>(layer) * m_gridW * m_gridH;
+        for (int y = y0; y < y0 + side; ++y)
+            for (int x = x0; x < x0 + side; ++x)
+                base[y * m_gridW + x] = dist(rng);
+    }
+    glTextureSubImage3D(m_textures[m_current], 0, 0, 0, 0, m_gridW, m_gridH, m_count,
+                        GL_RED, GL_FLOAT, data.data());
+    m_stepCount = 0;
+}
+
+void BatchSimulation::uploadPattern(int layer, const float* data, int rows, int cols) {
+    if (layer < 0 || layer >= m_count || !data) return;
+    std::vector<float> cells(static_cast<size_t>(m_gridW) * m_gridH, 0.0f);
+    int offX = (m_gridW - cols) / 2;
+    int offY = (m_gridH - rows) / 2;
+    for (int r = 0; r < rows; ++r) {
+        int y = offY + r;
+        if (y < 0 || y >= m_gridH) continue;
+        for (int c = 0; c < cols; ++c) {
+            int x = offX + c;
+            if (x >= 0 && x < m_gridW) cells[y * m_gridW + x] = data[r * cols + c];
+        }
+    }
+    glTextureSubImage3D(m_textures[m_current], 0, 0, 0, layer, m_gridW, m_gridH, 1,
+                        GL_RED, GL_FLOAT, cells.data());
+}
+
+void BatchSimulation::uploadUBO(float threshold) {
+    GPUBatchParams gpu{};
+    gpu.gridW     = m_gridW;
+    gpu.gridH     = m_gridH;
+    gpu.radius    = m_kernelRadius;
+    gpu.count     = m_count;
+    gpu.threshold = threshold;
+    glNamedBufferSubData(m_ubo, 0, sizeof(GPUBatchParams), &gpu);
+    glBindBufferBase(GL_UNIFORM_BUFFER, 6, m_ubo);
+}
+
+/**
+ * @brief Advance every universe; one dispatch over all layers per step.
+ */
+void BatchSimulation::step(int steps) {
+    TRACE_GL_SCOPE("BatchSimulation::step");
+    if (m_count == 0 || m_kernelCount == 0) return;
+
+    uploadUBO(0.0f);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_paramsSSBO);
+    m_simShader.use();
+    glBindTextureUnit(2, m_kernelArray);
+
+    GLuint groupsX = static_cast<GLuint>((m_gridW + 15) / 16);
+    GLuint groupsY = static_cast<GLuint>((m_gridH + 15) / 16);
+    for (int i = 0; i < steps; ++i) {
+        glBindTextureUnit(0, m_textures[m_current]);
+        glBindImageTexture(1, m_textures[1 - m_current], 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_R32F);
+        {
+            GpuPassScope gpuScope(GpuPass::SimStep);
+            glDispatchCompute(groupsX, groupsY, static_cast<GLuint>(m_count));
+            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+        }
+        m_current = 1 - m_current;
+        ++m_stepCount;
+    }
+}
+
+/**
+ * @brief Reduce every layer at once and read the results back.
+ */
+const std::vector<BatchUniverseStats>& BatchSimulation::computeStats(float threshold) {
+    TRACE_GL_SCOPE("BatchSimulation::computeStats");
+    if (m_count == 0) return m_stats;
+
+    uploadUBO(threshold);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_statsSSBO);
+    {
+        GpuPassScope gpuScope(GpuPass::Analysis);
+        m_statsShader.use();
+        glBindTextureUnit(0, m_textures[m_current]);
+        glDispatchCompute(static_cast<GLuint>(m_count), 1, 1);
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    }
+    glGetNamedBufferSubData(m_statsSSBO, 0, sizeof(BatchUniverseStats) * m_count, m_stats.data());
+    return m_stats;
+}
+
+/**
+ * @brief All layers as N x H x W floats.
+ */
+bool BatchSimulation::readLayers(std::vector<float>& out) const {
+    if (m_count == 0) return false;
+    out.resize(static_cast<size_t>(m_gridW) * m_gridH * m_count);
+    glGetTextureImage(m_textures[m_current], 0, GL_RED, GL_FLOAT,
+                      static_cast<GLsizei>(out.size() * sizeof(float)), out.data());
+    return true;
+}
+
+}
@@ -0,0 +1,124 @@
+/**
+ * @file BatchSimulation.hpp
+ * @brief Many small independent universes advanced together for parameter sweeps.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include "KernelManager.hpp"
+#include "Utils/Shader.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief Growth parameters of one universe (std430 layout of the params SSBO).
+ */
+struct BatchUniverseParams {
+    float   mu{0.15f};
+    float   sigma{0.015f};
+    float   dt{0.1f};
+    int32_t growthType{0};
+    float   param1{0.0f};       // Survival range for LargerThanLife
+    float   param2{0.0f};
+    int32_t kernelLayer{0};     // Index into the kernels given to setKernels()
+    int32_t _pad{0};
+};
+
+/**
+ * @brief Per-universe statistics from one reduction (std430 layout).
+ */
+struct BatchUniverseStats {
+    float   totalMass;
+    float   maxVal;
+    int32_t aliveCount;
+    float   centroidX;          // Mass-weighted, in cells
+    float   centroidY;
+    float   _pad[3];
+};
+
+/**
+ * @brief N single-channel universes in the layers of a 2D texture array.
+ *
+ * Each universe has its own growth parameters in an SSBO and picks one of
+ * a few shared kernels, which must all have the same radius and size. The
+ * convolution uses sim_spatial.comp's stencil, so a universe steps exactly
+ * like a single grid. A step is one dispatch over (W, H, N), and stats()
+ * reduces every layer in a single dispatch with one work group per
+ * universe. Boundaries are periodic; walls, debug fields and multi-channel
+ * rules are not supported.
+ *
+ * Meant for 64² to 256² worlds, where a single grid leaves most of the GPU
+ * idle: exploring a mu/sigma range becomes one batch instead of hundreds
+ * of resets.
+ */
+class BatchSimulation {
+public:
+    BatchSimulation() = default;
+    ~BatchSimulation();
+
+    BatchSimulation(const BatchSimulation&) = delete;
+    BatchSimulation& operator=(const BatchSimulation&) = delete;
+
+    bool init(const std::string& shaderDir);
+    bool allocate(int gridW, int gridH, int count);
+    bool setKernels(const std::vector<KernelConfig>& kernels);
+    void setParams(const std::vector<BatchUniverseParams>& params);
+    void release();
+
+    /** @brief Fill a centered square of side fraction * min(W, H) with noise, seeded per layer. */
+    void seedRandom(uint32_t seed, float fraction = 0.5f);
+    /** @brief Clear a layer and place a pattern at its center. */
+    void uploadPattern(int layer, const float* data, int rows, int cols);
+
+    void step(int steps = 1);
+    const std::vector<BatchUniverseStats>& computeStats(float threshold = 0.01f);
+    bool readLayers(std::vector<float>& out) const;
+
+    int count()  const { return m_count; }
+    int width()  const { return m_gridW; }
+    int height() const { return m_gridH; }
+    int stepCount() const { return m_stepCount; }
+    GLuint stateTexture() const { return m_textures[m_current]; }
+    const std::vector<BatchUniverseParams>& params() const { return m_params; }
+    const std::vector<BatchUniverseStats>& stats() const { return m_stats; }
+
+private:
+    Shader        m_simShader;
+    Shader        m_statsShader;
+    KernelManager m_kernelGen;
+    GLuint        m_textures[2]{0, 0};  // Ping-pong R32F texture arrays
+    int           m_current{0};
+    GLuint        m_kernelArray{0};     // R32F array, one layer per kernel config
+    int           m_kernelDiameter{0};  // Texture size of each layer
+    int           m_kernelRadius{0};    // Stencil: 2r taps, 2r+1 for GameOfLife growth
+    int           m_kernelCount{0};
+    GLuint        m_paramsSSBO{0};
+    GLuint        m_statsSSBO{0};
+    GLuint        m_ubo{0};
+    int           m_gridW{0};
+    int           m_gridH{0};
+    int           m_count{0};
+    int           m_stepCount{0};
+    std::vector<BatchUniverseParams> m_params;
+    std::vector<BatchUniverseStats>  m_stats;
+
+    void uploadUBO(float threshold);
+    void freeUniverses();
+
+    struct alignas(16) GPUBatchParams {
+        int32_t gridW;
+        int32_t gridH;
+        int32_t radius;
+        int32_t count;
+        float   threshold;
+        int32_t _pad0;
+        int32_t _pad1;
+        int32_t _pad2;
+    };
+};
+
+}
@@ -0,0 +1,379 @@
+/**
+ * @file Checkpoint.cpp
+ * @brief Checkpoint parameters, asynchronous writer and mapped reader.
+ */
+
+#include "Checkpoint.hpp"
+#include "ChunkedWorld.hpp"
+#include "Utils/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace lenia {
+
+/**
+ * @brief Call @p visit(key, field) for every setting a checkpoint restores.
+ *
+ * Rule keys follow the ParameterSearch names (rule<i>.mu, rule<i>.ring<j>, ...).
+ */
+template <typename Visit>
+static void visitParams(LeniaParams& p, int ruleCount, Visit&& visit) {
+    visit("mu", p.mu);
+    visit("sigma", p.sigma);
+    visit("dt", p.dt);
+    visit("radius", p.radius);
+    visit("numRings", p.numRings);
+    for (int j = 0; j < 16; ++j) visit("ring" + std::to_string(j), p.ringWeights[j]);
+    visit("kernelType", p.kernelType);
+    visit("growthType", p.growthType);
+    visit("kernelModifier", p.kernelModifier);
+    visit("kernelAnisotropy", p.kernelAnisotropy);
+    visit("kernelAnisotropyAngle", p.kernelAnisotropyAngle);
+    visit("kernelTimeVarying", p.kernelTimeVarying);
+    visit("kernelPulseFrequency", p.kernelPulseFrequency);
+
+    visit("gridW", p.gridW);
+    visit("gridH", p.gridH);
+    visit("tileSize", p.tileSize);
+    visit("inPlaceUpdate", p.inPlaceUpdate);
+    visit("edgeModeX", p.edgeModeX);
+    visit("edgeModeY", p.edgeModeY);
+    visit("edgeValueX", p.edgeValueX);
+    visit("edgeValueY", p.edgeValueY);
+    visit("edgeFadeX", p.edgeFadeX);
+    visit("edgeFadeY", p.edgeFadeY);
+
+    visit("noiseMode", p.noiseMode);
+    visit("noiseParam1", p.noiseParam1);
+    visit("noiseParam2", p.noiseParam2);
+    visit("noiseParam3", p.noiseParam3);
+    visit("noiseParam4", p.noiseParam4);
+
+    visit("wallValue", p.wallValue);
+    visit("wallType", p.wallType);
+    visit("wallAffectsAllChannels", p.wallAffectsAllChannels);
+    visit("wallAffectsCh0", p.wallAffectsCh0);
+    visit("wallAffectsCh1", p.wallAffectsCh1);
+    visit("wallAffectsCh2", p.wallAffectsCh2);
+    visit("wallDamping", p.wallDamping);
+    visit("wallReflection", p.wallReflection);
+    visit("wallAbsorption", p.wallAbsorption);
+    visit("wallSolid", p.wallSolid);
+    visit("wallPermeability", p.wallPermeability);
+
+    visit("numChannels", p.numChannels);
+    visit("numKernelRules", p.numKernelRules);
+    for (int i = 0; i < ruleCount; ++i) {
+        ChannelKernelRule& r = p.kernelRules[i];
+        std::string prefix = "rule" + std::to_string(i) + ".";
+        visit(prefix + "mu", r.mu);
+        visit(prefix + "sigma", r.sigma);
+        visit(prefix + "strength", r.growthStrength);
+        visit(prefix + "radius", r.radiusFraction);
+        visit(prefix + "rings", r.numRings);
+        visit(prefix + "source", r.sourceChannel);
+        visit(prefix + "dest", r.destChannel);
+        visit(prefix + "kernelType", r.kernelType);
+        visit(prefix + "growthType", r.growthType);
+        for (int j = 0; j < 16; ++j) visit(prefix + "ring" + std::to_string(j), r.ringWeights[j]);
+    }
+
+    visit("colormapMode", p.colormapMode);
+    visit("zoom", p.zoom);
+    visit("panX", p.panX);
+    visit("panY", p.panY);
+}
+
+std::string checkpointParams(const LeniaParams& params) {
+    LeniaParams copy = params;
+    std::ostringstream out;
+    char value[32];
+    auto put = [&](const std::string& key, auto& field) {
+        using T = std::decay_t<decltype(field)>;
+        if constexpr (std::is_same_v<T, float>)
+            std::snprintf(value, sizeof(value), "%.9g", field);   // Round-trips exactly
+        else
+            std::snprintf(value, sizeof(value), "%d", static_cast<int>(field));
+        out << key << '=' << value << '\n';
+    };
+    visitParams(copy, std::clamp(params.numKernelRules, 0, 16), put);
+    return out.str();
+}
+
+void applyCheckpointParams(const std::string& text, LeniaParams& params) {
+    std::unordered_map<std::string, std::string> values;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t eq = line.find('=');
+        if (eq != std::string::npos) values[line.substr(0, eq)] = line.substr(eq + 1);
+    }
+    auto get = [&](const std::string& key, auto& field) {
+        auto it = values.find(key);
+        if (it == values.end()) return;
+        using T = std::decay_t<decltype(field)>;
+        if constexpr (std::is_same_v<T, float>)
+            field = std::strtof(it->second.c_str(), nullptr);
+        else if constexpr (std::is_same_v<T, bool>)
+            field = std::atoi(it->second.c_str()) != 0;
+        else
+            field = std::atoi(it->second.c_str());
+    };
+    visitParams(params, 16, get);
+    params.numKernelRules = std::clamp(params.numKernelRules, 0, 16);
+}
+
+// ---------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------
+
+bool CheckpointWriter::begin(const std::string& path, const CheckpointHeader& header, std::string params,
+                             const std::vector<ReadbackSource>& sources) {
+    if (busy()) {
+        LOG_WARN("A checkpoint is still being written; %s skipped.", path.c_str());
+        return false;
+    }
+    m_path = path;
+    m_header = header;
+    m_params = std::move(params);
+    m_start = std::chrono::steady_clock::now();
+    if (!m_readback.begin(sources, [this](const std::vector<ReadbackBlock>& blocks) { return write(blocks); })) {
+        LOG_ERROR("Not enough memory to read back a %dx%d checkpoint.", header.width, header.height);
+        m_params.clear();
+        return false;
+    }
+    return true;
+}
+
+void CheckpointWriter::poll(bool wait) {
+    if (!m_readback.poll(wait)) return;
+    if (m_readback.succeeded()) {
+        double bytes = static_cast<double>(std::filesystem::file_size(m_path));
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+        LOG_INFO("Checkpoint %s: %dx%d, %.1f MB in %.0f ms.", m_path.c_str(),
+                 m_header.width, m_header.height, bytes / (1024.0 * 1024.0), ms);
+    }
+    m_params.clear();
+}
+
+/**
+ * @brief Gather rows [y0, y0 + rows) of one plane from the blocks overlapping them.
+ */
+void CheckpointWriter::extractStrip(const std::vector<ReadbackBlock>& blocks, int plane, int y0, int rows,
+                                    std::vector<float>& out) const {
+    bool walls = plane >= m_header.channels;
+    int component = walls ? plane - m_header.channels : plane;
+    int width = m_header.width;
+    out.assign(static_cast<size_t>(width) * rows, 0.0f);
+
+    for (const ReadbackBlock& block : blocks) {
+        if ((block.tag == CHECKPOINT_WALL_SOURCE) != walls) continue;
+        int top = std::max(y0, block.y);
+        int bottom = std::min(y0 + rows, block.y + block.h);
+        for (int y = top; y < bottom; ++y) {
+            const float* src = block.data + (static_cast<size_t>(y - block.y) * block.w) * block.components + component;
+            float* dst = out.data() + static_cast<size_t>(y - y0) * width + block.x;
+            for (int x = 0; x < block.w; ++x)
+                dst[x] = src[static_cast<size_t>(x) * block.components];
+        }
+    }
+}
+
+/**
+ * @brief Worker thread: assemble, encode and write every strip, then the table.
+ */
+bool CheckpointWriter::write(const std::vector<ReadbackBlock>& blocks) const {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::path target(m_path);
+    if (target.has_parent_path()) fs::create_directories(target.parent_path(), ec);
+
+    std::string tmpPath = m_path + ".tmp";
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_ERROR("Cannot write checkpoint %s.", tmpPath.c_str());
+        return false;
+    }
+
+    auto align = [&]() {
+        static const char zeros[8] = {};
+        std::streamoff pos = file.tellp();
+        if (pos % 8) file.write(zeros, 8 - pos % 8);
+    };
+
+    CheckpointHeader header = m_header;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    header.paramsOffset = static_cast<uint64_t>(file.tellp());
+    header.paramsBytes = m_params.size();
+    file.write(m_params.data(), static_cast<std::streamsize>(m_params.size()));
+
+    int strips = (header.height + header.stripRows - 1) / header.stripRows;
+    int planes = header.channels + header.wallPlanes;
+    bool compress = header.compression == static_cast<uint32_t>(CheckpointCompression::ZeroRuns);
+    std::vector<CheckpointStrip> table;
+    table.reserve(static_cast<size_t>(planes) * strips);
+    std::vector<float> cells;
+    std::vector<uint8_t> packed;
+
+    for (int p = 0; p < planes && file; ++p) {
+        for (int s = 0; s < strips && file; ++s) {
+            int y0 = s * header.stripRows;
+            extractStrip(blocks, p, y0, std::min(header.stripRows, header.height - y0), cells);
+            align();                     // Raw strips are read in place as floats
+            CheckpointStrip entry;
+            entry.offset = static_cast<uint64_t>(file.tellp());
+            if (compress) {
+                ChunkCache::compress(cells, packed);
+                file.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(packed.size()));
+                entry.bytes = packed.size();
+            } else {
+                entry.bytes = cells.size() * sizeof(float);
+                file.write(reinterpret_cast<const char*>(cells.data()), static_cast<std::streamsize>(entry.bytes));
+            }
+            table.push_back(entry);
+        }
+    }
+
+    align();
+    header.tableOffset = static_cast<uint64_t>(file.tellp());
+    file.write(reinterpret_cast<const char*>(table.data()),
+               static_cast<std::streamsize>(table.size() * sizeof(CheckpointStrip)));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (!file) {
+        LOG_ERROR("Writing checkpoint %s failed.", tmpPath.c_str());
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+
+    fs::rename(tmpPath, m_path, ec);
+    if (ec) {
+        LOG_ERROR("Cannot move checkpoint into place at %s: %s", m_path.c_str(), ec.message().c_str());
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+template <typename T>
+static void swapBytes(T& value) {
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&value);
+    std::reverse(bytes, bytes + sizeof(T));
+}
+
+static void swapHeader(CheckpointHeader& h) {
+    swapBytes(h.byteOrder);
+    swapBytes(h.version);
+    swapBytes(h.headerBytes);
+    swapBytes(h.width);
+    swapBytes(h.height);
+    swapBytes(h.channels);
+    swapBytes(h.wallPlanes);
+    swapBytes(h.stripRows);
+    swapBytes(h.compression);
+    swapBytes(h.stepCount);
+    swapBytes(h.paramsOffset);
+    swapBytes(h.paramsBytes);
+    swapBytes(h.tableOffset);
+}
+
+bool CheckpointReader::open(const std::string& path) {
+    if (!m_file.open(path)) {
+        LOG_ERROR("Cannot open checkpoint %s.", path.c_str());
+        return false;
+    }
+    const uint8_t* base = m_file.data();
+    size_t size = m_file.size();
+
+    if (size < sizeof(CheckpointHeader) || std::memcmp(base, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        LOG_ERROR("%s is not a Lenia checkpoint.", path.c_str());
+        return false;
+    }
+    std::memcpy(&m_header, base, sizeof(CheckpointHeader));
+    uint32_t other = m_header.byteOrder;
+    swapBytes(other);
+    m_swap = other == CHECKPOINT_BYTE_ORDER;
+    if (m_swap) swapHeader(m_header);
+    if (m_header.byteOrder != CHECKPOINT_BYTE_ORDER) {
+        LOG_ERROR("Checkpoint %s has no byte order mark; it predates version 2 or is damaged.", path.c_str());
+        return false;
+    }
+    if (m_header.version > CHECKPOINT_VERSION || m_header.headerBytes < sizeof(CheckpointHeader)) {
+        LOG_ERROR("Checkpoint %s has version %u; this build reads up to %u.", path.c_str(),
+                  m_header.version, CHECKPOINT_VERSION);
+        return false;
+    }
+
+    bool sane = m_header.width > 0 && m_header.height > 0 && m_header.stripRows > 0 &&
+                (m_header.channels == 1 || m_header.channels == 3) &&
+                (m_header.wallPlanes == 0 || m_header.wallPlanes == 4) &&
+                m_header.compression <= static_cast<uint32_t>(CheckpointCompression::ZeroRuns) &&
+                m_header.paramsOffset + m_header.paramsBytes <= size &&
+                m_header.tableOffset % alignof(CheckpointStrip) == 0 &&
+                m_header.tableOffset + static_cast<uint64_t>(planes()) * stripCount() * sizeof(CheckpointStrip) <= size;
+    if (!sane) {
+        LOG_ERROR("Checkpoint %s is truncated or damaged.", path.c_str());
+        return false;
+    }
+
+    m_params.assign(reinterpret_cast<const char*>(base + m_header.paramsOffset), m_header.paramsBytes);
+    m_table.resize(static_cast<size_t>(planes()) * stripCount());
+    std::memcpy(m_table.data(), base + m_header.tableOffset, m_table.size() * sizeof(CheckpointStrip));
+    if (m_swap) {
+        for (CheckpointStrip& entry : m_table) {
+            swapBytes(entry.offset);
+            swapBytes(entry.bytes);
+        }
+    }
+    return true;
+}
+
+int CheckpointReader::stripCount() const {
+    return (m_header.height + m_header.stripRows - 1) / m_header.stripRows;
+}
+
+const float* CheckpointReader::strip(int plane, int index, std::vector<float>& scratch) const {
+    const CheckpointStrip& entry = m_table[static_cast<size_t>(plane) * stripCount() + index];
+    int rows = std::min(m_header.stripRows, m_header.height - index * m_header.stripRows);
+    size_t cells = static_cast<size_t>(m_header.width) * rows;
+    if (entry.offset + entry.bytes > m_file.size()) return nullptr;
+
+    const uint8_t* data = m_file.data() + entry.offset;
+    bool raw = m_header.compression == static_cast<uint32_t>(CheckpointCompression::Raw);
+    if (raw && entry.bytes != cells * sizeof(float)) return nullptr;
+
+    // The other byte order: reverse every 4-byte word, then read as usual
+    std::vector<uint8_t> words;
+    if (m_swap) {
+        if (entry.bytes % 4 != 0) return nullptr;
+        words.resize(entry.bytes);
+        for (size_t i = 0; i < entry.bytes; i += 4)
+            for (size_t b = 0; b < 4; ++b) words[i + b] = data[i + 3 - b];
+        if (raw) {
+            scratch.resize(cells);
+            std::memcpy(scratch.data(), words.data(), entry.bytes);
+            return scratch.data();
+        }
+        data = words.data();
+    }
+
+    if (raw) {
+        if (entry.offset % alignof(float) != 0) return nullptr;
+        return reinterpret_cast<const float*>(data);
+    }
+    if (!ChunkCache::decompress(data, entry.bytes, scratch, cells)) return nullptr;
+    return scratch.data();
+}
+
+}
@@ -0,0 +1,136 @@
+/**
+ * @file Checkpoint.hpp
+ * @brief Versioned binary checkpoints of a running world.
+ */
+
+#pragma once
+
+#include "AsyncReadback.hpp"
+#include "UIOverlay.hpp"
+#include "Utils/MappedFile.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief Checkpoint file layout, in the writer's byte order:
+ *
+ *   CheckpointHeader, starting with the magic and CHECKPOINT_BYTE_ORDER
+ *   parameters as "key=value" lines (unknown keys are ignored on load)
+ *   strips: plane-major, stripRows rows of one plane each, raw floats or
+ *           ChunkCache zero-run encoding
+ *   strip table: (offset, bytes) per strip, plane-major
+ *
+ * Planes are the state channels (1, or 3 for RGB multi-channel grids)
+ * followed by the four wall channels when the grid has walls. Every value
+ * in the strips, floats and zero-run counts alike, is 4 bytes wide, so a
+ * reader of the other byte order swaps them word by word.
+ */
+static constexpr char     CHECKPOINT_MAGIC[8]  = {'L', 'E', 'N', 'I', 'A', 'C', 'K', 'P'};
+static constexpr uint32_t CHECKPOINT_VERSION   = 2;
+static constexpr uint32_t CHECKPOINT_BYTE_ORDER = 0x01020304;  // Reads as 0x04030201 in the other order
+static constexpr int      CHECKPOINT_STRIP_ROWS = 256;
+static constexpr uint32_t CHECKPOINT_WALL_SOURCE = 1;   // ReadbackSource::tag of the wall texture
+
+enum class CheckpointCompression : uint32_t {
+    Raw      = 0,        // Planes as stored floats; loads upload straight from the mapping
+    ZeroRuns = 1         // ChunkCache::compress per strip, lossless
+};
+
+struct CheckpointHeader {
+    char     magic[8];
+    uint32_t byteOrder;        // CHECKPOINT_BYTE_ORDER as the writer stored it
+    uint32_t version;
+    uint32_t headerBytes;      // sizeof(CheckpointHeader) of the writer
+    int32_t  width;
+    int32_t  height;
+    int32_t  channels;         // State planes
+    int32_t  wallPlanes;       // 0 or 4
+    int32_t  stripRows;
+    uint32_t compression;      // CheckpointCompression
+    uint32_t _pad;
+    uint64_t stepCount;
+    uint64_t paramsOffset;
+    uint64_t paramsBytes;
+    uint64_t tableOffset;
+};
+
+struct CheckpointStrip {
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+/** @brief Simulation, grid and rule settings of @p params as checkpoint text. */
+std::string checkpointParams(const LeniaParams& params);
+/** @brief Apply the settings found in checkpoint text; others keep their value. */
+void applyCheckpointParams(const std::string& text, LeniaParams& params);
+
+/**
+ * @brief Writes a checkpoint without stalling the simulation.
+ *
+ * begin() queues an AsyncReadback of every source, so the saved state is
+ * the one at that call; its worker thread assembles, optionally compresses
+ * and writes the planes. Sources tagged CHECKPOINT_WALL_SOURCE hold the
+ * walls. Files are written under a temporary name and renamed at the end.
+ */
+class CheckpointWriter {
+public:
+    CheckpointWriter() = default;
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    bool begin(const std::string& path, const CheckpointHeader& header, std::string params,
+               const std::vector<ReadbackSource>& sources);
+    /** @brief Advance a pending save; @p wait blocks until it is finished. */
+    void poll(bool wait = false);
+
+    bool busy() const { return m_readback.busy(); }
+    /** @brief Outcome of the last finished save. */
+    bool succeeded() const { return m_readback.succeeded(); }
+
+private:
+    std::string        m_path;
+    CheckpointHeader   m_header{};
+    std::string        m_params;
+    std::chrono::steady_clock::time_point m_start;
+    AsyncReadback      m_readback;         // Last: joins the worker before the fields it reads go
+
+    bool write(const std::vector<ReadbackBlock>& blocks) const;
+    void extractStrip(const std::vector<ReadbackBlock>& blocks, int plane, int y0, int rows,
+                      std::vector<float>& out) const;
+};
+
+/**
+ * @brief Read access to a mapped checkpoint.
+ */
+class CheckpointReader {
+public:
+    bool open(const std::string& path);
+
+    const CheckpointHeader& header() const { return m_header; }
+    const std::string& params() const { return m_params; }
+    int planes() const { return m_header.channels + m_header.wallPlanes; }
+    int stripCount() const;
+    /** @brief True when the file was written in the other byte order. */
+    bool swapped() const { return m_swap; }
+    /**
+     * @brief Cells of one strip of @p plane, width x rows floats.
+     *
+     * Raw files in this host's byte order return a pointer into the mapping;
+     * other strips are decoded into @p scratch. nullptr if the strip is damaged.
+     */
+    const float* strip(int plane, int index, std::vector<float>& scratch) const;
+
+private:
+    MappedFile                   m_file;
+    CheckpointHeader             m_header{};
+    std::string                  m_params;
+    std::vector<CheckpointStrip> m_table;
+    bool                         m_swap{false};
+};
+
+}
@@ -0,0 +1,573 @@
+/**
+ * @file ChunkedWorld.cpp
+ * @brief Implementation of the chunked world and its compressed chunk cache.
+ */
+
+#include "ChunkedWorld.hpp"
+#include "GpuProfiler.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace lenia {
+
+static_assert(sizeof(ChunkStats) == 32, "ChunkStats must match the std430 layout");
+
+static constexpr int MAINTENANCE_INTERVAL = 8;  // Steps between residency updates
+
+static int floorDiv(int a, int b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+// ---------------------------------------------------------------------------
+// ChunkCache
+// ---------------------------------------------------------------------------
+
+ChunkCache::~ChunkCache() {
+    clear();
+}
+
+/**
+ * @brief Encode as repeated (zero run, literal count, literals) records.
+ */
+void ChunkCache::compress(const std::vector<float>& cells, std::vector<uint8_t>& out) {
+    out.clear();
+    auto append = [&](const void* p, size_t bytes) {
+        const uint8_t* b = static_cast<const uint8_t*>(p);
+        out.insert(out.end(), b, b + bytes);
+    };
+
+    // Bitwise, so -0 stays a literal and the round trip is exact
+    auto isZero = [](float v) {
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return bits == 0;
+    };
+    size_t i = 0, n = cells.size();
+    while (i < n) {
+        uint32_t zeros = 0;
+        while (i < n && isZero(cells[i])) { ++zeros; ++i; }
+        size_t start = i;
+        while (i < n && !isZero(cells[i])) ++i;
+        uint32_t literals = static_cast<uint32_t>(i - start);
+        append(&zeros, sizeof(zeros));
+        append(&literals, sizeof(literals));
+        if (literals) append(cells.data() + start, literals * sizeof(float));
+    }
+}
+
+bool ChunkCache::decompress(const uint8_t* in, size_t bytes, std::vector<float>& cells, size_t cellCount) {
+    cells.assign(cellCount, 0.0f);
+    size_t pos = 0, cell = 0;
+    while (pos + 8 <= bytes) {
+        uint32_t zeros = 0, literals = 0;
+        std::memcpy(&zeros, in + pos, 4);
+        std::memcpy(&literals, in + pos + 4, 4);
+        pos += 8;
+        if (cell + zeros + literals > cellCount || pos + literals * sizeof(float) > bytes) return false;
+        cell += zeros;
+        std::memcpy(cells.data() + cell, in + pos, literals * sizeof(float));
+        cell += literals;
+        pos += literals * sizeof(float);
+    }
+    return pos == bytes && cell == cellCount;
+}
+
+std::string ChunkCache::spillPath(int64_t key) const {
+    int cx = static_cast<int>(key >> 32);
+    int cy = static_cast<int>(static_cast<uint32_t>(key));
+    return m_spillDir + "/chunk_" + std::to_string(cx) + "_" + std::to_string(cy) + ".bin";
+}
+
+void ChunkCache::put(int64_t key, const std::vector<float>& cells) {
+    auto it = m_memory.find(key);
+    if (it != m_memory.end()) {
+        m_bytes -= it->second.data.size();
+        m_order.erase(it->second.order);
+        m_memory.erase(it);
+    }
+    if (m_onDisk.erase(key)) {
+        std::error_code ec;
+        std::filesystem::remove(spillPath(key), ec);
+    }
+
+    Entry entry;
+    compress(cells, entry.data);
+    entry.order = m_order.insert(m_order.end(), key);
+    m_bytes += entry.data.size();
+    m_memory.emplace(key, std::move(entry));
+    if (m_bytes > m_budget) spill();
+}
+
+bool ChunkCache::take(int64_t key, std::vector<float>& cells, size_t cellCount) {
+    auto it = m_memory.find(key);
+    if (it != m_memory.end()) {
+        bool ok = decompress(it->second.data.data(), it->second.data.size(), cells, cellCount);
+        m_bytes -= it->second.data.size();
+        m_order.erase(it->second.order);
+        m_memory.erase(it);
+        return ok;
+    }
+    if (!m_onDisk.erase(key)) return false;
+
+    std::string path = spillPath(key);
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    if (!decompress(data.data(), data.size(), cells, cellCount)) {
+        LOG_WARN("Chunk cache file %s is damaged; the chunk starts empty.", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Write the oldest chunks to disk until memory use is back to 3/4 of the budget.
+ */
+void ChunkCache::spill() {
+    std::error_code ec;
+    std::filesystem::create_directories(m_spillDir, ec);
+    while (m_bytes > m_budget / 4 * 3 && !m_order.empty()) {
+        int64_t key = m_order.front();
+        auto it = m_memory.find(key);
+        std::ofstream file(spillPath(key), std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(it->second.data.data()),
+                   static_cast<std::streamsize>(it->second.data.size()));
+        if (!file.good()) {
+            LOG_WARN("Cannot spill chunks to %s; keeping them in memory.", m_spillDir.c_str());
+            return;
+        }
+        m_bytes -= it->second.data.size();
+        m_order.pop_front();
+        m_memory.erase(it);
+        m_onDisk.insert(key);
+    }
+}
+
+void ChunkCache::clear() {
+    std::error_code ec;
+    for (int64_t key : m_onDisk) std::filesystem::remove(spillPath(key), ec);
+    m_onDisk.clear();
+    m_memory.clear();
+    m_order.clear();
+    m_bytes = 0;
+}
+
+// ---------------------------------------------------------------------------
+// ChunkedWorld
+// ---------------------------------------------------------------------------
+
+ChunkedWorld::~ChunkedWorld() {
+    release();
+    if (m_ubo) glDeleteBuffers(1, &m_ubo);
+}
+
+bool ChunkedWorld::init(const std::string& shaderDir) {
+    if (!m_haloShader.loadCompute(shaderDir + "chunk_halo.comp")) {
+        LOG_ERROR("Failed to load chunk_halo.comp"); return false;
+    }
+    if (!m_simShader.loadCompute(shaderDir + "sim_chunked.comp")) {
+        LOG_ERROR("Failed to load sim_chunked.comp"); return false;
+    }
+    if (!m_statsShader.loadCompute(shaderDir + "chunk_stats.comp")) {
+        LOG_ERROR("Failed to load chunk_stats.comp"); return false;
+    }
+    glCreateBuffers(1, &m_ubo);
+    glNamedBufferStorage(m_ubo, sizeof(GPUChunkParams), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    return true;
+}
+
+void ChunkedWorld::release() {
+    if (m_arrays[0]) glDeleteTextures(2, m_arrays);
+    if (m_neighborSSBO) glDeleteBuffers(1, &m_neighborSSBO);
+    if (m_statsSSBO) glDeleteBuffers(1, &m_statsSSBO);
+    m_arrays[0] = m_arrays[1] = 0;
+    m_neighborSSBO = m_statsSSBO = 0;
+    m_current = 0;
+    m_chunkSize = m_halo = m_capacity = m_highWater = 0;
+    m_slots.clear();
+    m_index.clear();
+    m_seen.clear();
+    m_stats.clear();
+    m_cache.clear();
+}
+
+void ChunkedWorld::clear() {
+    for (auto& slot : m_slots) slot = Slot{};
+    m_index.clear();
+    m_seen.clear();
+    m_cache.clear();
+    m_highWater = 0;
+    m_neighborsDirty = true;
+    m_seed = std::random_device{}();
+    if (m_arrays[0]) {
+        float zero = 0.0f;
+        glClearTexImage(m_arrays[0], 0, GL_RED, GL_FLOAT, &zero);
+        glClearTexImage(m_arrays[1], 0, GL_RED, GL_FLOAT, &zero);
+    }
+}
+
+bool ChunkedWorld::configure(int chunkSize, int halo) {
+    if (halo > chunkSize) {
+        LOG_ERROR("A halo of %d cells needs chunks of at least that size (%d).", halo, chunkSize);
+        return false;
+    }
+    if (chunkSize != m_chunkSize) {
+        if (m_chunkSize) LOG_INFO("Chunk size changed to %d: the world starts over.", chunkSize);
+        release();
+        m_chunkSize = chunkSize;
+        m_seed = std::random_device{}();
+    }
+    if (!configured()) return reallocate(std::max(m_policy.maxResident, 9), halo);
+    if (halo != m_halo) return reallocate(m_capacity, halo);
+    return true;
+}
+
+/**
+ * @brief Recreate the arrays for @p capacity slots and @p halo, copying resident interiors over.
+ */
+bool ChunkedWorld::reallocate(int capacity, int halo) {
+    TRACE_GL_SCOPE("ChunkedWorld::reallocate");
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    capacity = std::min(capacity, static_cast<int>(maxLayers));
+    if (capacity < std::max(1, m_highWater)) return false;
+
+    int size = m_chunkSize + 2 * halo;
+    GLuint fresh[2]{0, 0};
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 2, fresh);
+    float zero = 0.0f;
+    for (int k = 0; k < 2; ++k) {
+        glTextureStorage3D(fresh[k], 1, GL_R32F, size, size, capacity);
+        glTextureParameteri(fresh[k], GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTextureParameteri(fresh[k], GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glClearTexImage(fresh[k], 0, GL_RED, GL_FLOAT, &zero);
+        if (m_arrays[k] && m_highWater > 0) {
+            glCopyImageSubData(m_arrays[k], GL_TEXTURE_2D_ARRAY, 0, m_halo, m_halo, 0,
+                               fresh[k], GL_TEXTURE_2D_ARRAY, 0, halo, halo, 0,
+                               m_chunkSize, m_chunkSize, m_highWater);
+        }
+    }
+    if (m_arrays[0]) glDeleteTextures(2, m_arrays);
+    m_arrays[0] = fresh[0];
+    m_arrays[1] = fresh[1];
+
+    if (m_neighborSSBO) glDeleteBuffers(1, &m_neighborSSBO);
+    if (m_statsSSBO) glDeleteBuffers(1, &m_statsSSBO);
+    glCreateBuffers(1, &m_neighborSSBO);
+    glNamedBufferStorage(m_neighborSSBO, sizeof(int32_t) * 9 * capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glCreateBuffers(1, &m_statsSSBO);
+    glNamedBufferStorage(m_statsSSBO, sizeof(ChunkStats) * capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    m_slots.resize(capacity);
+    m_stats.resize(capacity);
+    m_capacity = capacity;
+    m_halo = halo;
+    m_neighborsDirty = true;
+    return true;
+}
+
+void ChunkedWorld::setPolicy(const Policy& policy) {
+    m_policy = policy;
+    m_policy.maxResident = std::max(1, policy.maxResident);
+    m_policy.prefetchRadius = std::max(0, policy.prefetchRadius);
+}
+
+/**
+ * @brief Deterministic content of a chunk never stored: a noise patch in one chunk of four.
+ */
+void ChunkedWorld::seedChunk(int cx, int cy, std::vector<float>& cells) const {
+    cells.assign(static_cast<size_t>(m_chunkSize) * m_chunkSize, 0.0f);
+    uint32_t h = m_seed ^ (static_cast<uint32_t>(cx) * 73856093u) ^ (static_cast<uint32_t>(cy) * 19349663u);
+    std::mt19937 rng(h);
+    if (rng() % 4 != 0) return;
+
+    std::uniform_real_distribution<float> uni(0.0f, 1.0f);
+    int side = std::max(1, m_chunkSize / 4);
+    int x0 = static_cast<int>(rng() % static_cast<uint32_t>(m_chunkSize - side + 1));
+    int y0 = static_cast<int>(rng() % static_cast<uint32_t>(m_chunkSize - side + 1));
+    for (int y = y0; y < y0 + side; ++y)
+        for (int x = x0; x < x0 + side; ++x)
+            cells[static_cast<size_t>(y) * m_chunkSize + x] = uni(rng);
+}
+
+/**
+ * @brief Make chunk (cx, cy) resident; returns its slot, or -1 if no layer is left.
+ */
+int ChunkedWorld::pageIn(int cx, int cy) {
+    int64_t key = chunkKey(cx, cy);
+    auto found = m_index.find(key);
+    if (found != m_index.end()) return found->second;
+
+    int slot = -1;
+    for (int i = 0; i < m_capacity && slot < 0; ++i)
+        if (!m_slots[i].used) slot = i;
+    if (slot < 0) {
+        int before = m_capacity;
+        if (!reallocate(m_capacity * 2, m_halo) || m_capacity == before) {
+            LOG_WARN("No texture layer left for chunk (%d, %d).", cx, cy);
+            return -1;
+        }
+        slot = before;
+    }
+
+    Slot& s = m_slots[slot];
+    s.used = true;
+    s.pinned = false;
+    s.cx = cx;
+    s.cy = cy;
+    s.lastActive = m_stepCount;
+    m_index[key] = slot;
+    m_highWater = std::max(m_highWater, slot + 1);
+    m_neighborsDirty = true;
+
+    int size = layerSize();
+    for (GLuint tex : m_arrays)
+        glClearTexSubImage(tex, 0, 0, 0, slot, size, size, 1, GL_RED, GL_FLOAT, nullptr);
+
+    std::vector<float> cells;
+    size_t count = static_cast<size_t>(m_chunkSize) * m_chunkSize;
+    bool have = m_cache.take(key, cells, count);
+    bool unseen = m_seen.insert(key).second;
+    if (!have && unseen && m_policy.persistence == ChunkPersistence::Seed) {
+        seedChunk(cx, cy, cells);
+        have = true;
+    }
+    if (have) {
+        glTextureSubImage3D(m_arrays[m_current], 0, m_halo, m_halo, slot, m_chunkSize, m_chunkSize, 1,
+                            GL_RED, GL_FLOAT, cells.data());
+    }
+    return slot;
+}
+
+void ChunkedWorld::evict(int slot, bool keep) {
+    Slot& s = m_slots[slot];
+    if (!s.used) return;
+    if (keep) {
+        std::vector<float> cells(static_cast<size_t>(m_chunkSize) * m_chunkSize);
+        glGetTextureSubImage(m_arrays[m_current], 0, m_halo, m_halo, slot, m_chunkSize, m_chunkSize, 1,
+                             GL_RED, GL_FLOAT, static_cast<GLsizei>(cells.size() * sizeof(float)), cells.data());
+        // An empty chunk reads back as empty anyway; keep the cache for content
+        if (std::any_of(cells.begin(), cells.end(), [](float v) { return v != 0.0f; }))
+            m_cache.put(chunkKey(s.cx, s.cy), cells);
+    }
+    m_index.erase(chunkKey(s.cx, s.cy));
+    s = Slot{};
+    while (m_highWater > 0 && !m_slots[m_highWater - 1].used) --m_highWater;
+    m_neighborsDirty = true;
+}
+
+void ChunkedWorld::uploadNeighbors() {
+    std::vector<int32_t> table(static_cast<size_t>(m_highWater) * 9, -1);
+    for (int i = 0; i < m_highWater; ++i) {
+        if (!m_slots[i].used) continue;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                auto it = m_index.find(chunkKey(m_slots[i].cx + dx, m_slots[i].cy + dy));
+                if (it != m_index.end()) table[i * 9 + (dy + 1) * 3 + (dx + 1)] = it->second;
+            }
+        }
+    }
+    if (!table.empty())
+        glNamedBufferSubData(m_neighborSSBO, 0, static_cast<GLsizeiptr>(table.size() * sizeof(int32_t)), table.data());
+    m_neighborsDirty = false;
+}
+
+void ChunkedWorld::setView(const View& view) {
+    if (!configured()) return;
+    for (auto& slot : m_slots) slot.pinned = false;
+
+    auto pin = [&](int cx, int cy) {
+        int slot = pageIn(cx, cy);
+        if (slot < 0) return;
+        m_slots[slot].pinned = true;
+        m_slots[slot].lastActive = m_stepCount;
+    };
+
+    int C = m_chunkSize;
+    for (int cy = floorDiv(view.originY, C); cy <= floorDiv(view.originY + view.height - 1, C); ++cy)
+        for (int cx = floorDiv(view.originX, C); cx <= floorDiv(view.originX + view.width - 1, C); ++cx)
+            pin(cx, cy);
+    int r = m_policy.prefetchRadius;
+    for (int cy = view.centerChunkY - r; cy <= view.centerChunkY + r; ++cy)
+        for (int cx = view.centerChunkX - r; cx <= view.centerChunkX + r; ++cx)
+            pin(cx, cy);
+}
+
+void ChunkedWorld::storeView(GLuint stateTex, const View& view) {
+    if (!configured()) return;
+    int C = m_chunkSize;
+    for (int cy = floorDiv(view.originY, C); cy <= floorDiv(view.originY + view.height - 1, C); ++cy) {
+        for (int cx = floorDiv(view.originX, C); cx <= floorDiv(view.originX + view.width - 1, C); ++cx) {
+            auto it = m_index.find(chunkKey(cx, cy));
+            if (it == m_index.end()) continue;
+            int x0 = std::max(view.originX, cx * C), x1 = std::min(view.originX + view.width, cx * C + C);
+            int y0 = std::max(view.originY, cy * C), y1 = std::min(view.originY + view.height, cy * C + C);
+            glCopyImageSubData(stateTex, GL_TEXTURE_2D, 0, x0 - view.originX, y0 - view.originY, 0,
+                               m_arrays[m_current], GL_TEXTURE_2D_ARRAY, 0,
+                               m_halo + x0 - cx * C, m_halo + y0 - cy * C, it->second,
+                               x1 - x0, y1 - y0, 1);
+        }
+    }
+}
+
+void ChunkedWorld::loadView(GLuint stateTex, const View& view) {
+    if (!configured()) return;
+    int C = m_chunkSize;
+    for (int cy = floorDiv(view.originY, C); cy <= floorDiv(view.originY + view.height - 1, C); ++cy) {
+        for (int cx = floorDiv(view.originX, C); cx <= floorDiv(view.originX + view.width - 1, C); ++cx) {
+            int x0 = std::max(view.originX, cx * C), x1 = std::min(view.originX + view.width, cx * C + C);
+            int y0 = std::max(view.originY, cy * C), y1 = std::min(view.originY + view.height, cy * C + C);
+            auto it = m_index.find(chunkKey(cx, cy));
+            if (it == m_index.end()) {
+                glClearTexSubImage(stateTex, 0, x0 - view.originX, y0 - view.originY, 0,
+                                   x1 - x0, y1 - y0, 1, GL_RED, GL_FLOAT, nullptr);
+                continue;
+            }
+            glCopyImageSubData(m_arrays[m_current], GL_TEXTURE_2D_ARRAY, 0,
+                               m_halo + x0 - cx * C, m_halo + y0 - cy * C, it->second,
+                               stateTex, GL_TEXTURE_2D, 0, x0 - view.originX, y0 - view.originY, 0,
+                               x1 - x0, y1 - y0, 1);
+        }
+    }
+}
+
+void ChunkedWorld::uploadUBO(const LeniaParams& params, float threshold) {
+    GPUChunkParams gpu{};
+    gpu.chunkSize  = m_chunkSize;
+    gpu.halo       = m_halo;
+    gpu.radius     = params.radius;
+    gpu.count      = m_highWater;
+    gpu.growthType = params.growthType;
+    gpu.band       = std::clamp(std::max(2 * m_halo, m_chunkSize / 8), 1, m_chunkSize / 2);
+    gpu.threshold  = threshold;
+    gpu.mu         = params.mu;
+    gpu.sigma      = params.sigma;
+    gpu.dt         = params.dt;
+    gpu.param1     = params.noiseParam1;
+    gpu.param2     = params.noiseParam2;
+    gpu.chunkHeight = m_chunkSize;
+    glNamedBufferSubData(m_ubo, 0, sizeof(GPUChunkParams), &gpu);
+}
+
+void ChunkedWorld::step(const LeniaParams& params, GLuint kernelTex, int steps) {
+    if (!configured()) return;
+    TRACE_GL_SCOPE("ChunkedWorld::step");
+    float threshold = params.analysisThreshold;
+    int size = layerSize();
+    int groups = (m_chunkSize + 15) / 16;
+    int haloGroups = (size + 15) / 16;
+    bool dirty = true;
+
+    for (int i = 0; i < steps; ++i) {
+        if (m_neighborsDirty || dirty) {
+            uploadNeighbors();
+            uploadUBO(params, threshold);
+            dirty = false;
+        }
+        glBindBufferBase(GL_UNIFORM_BUFFER, 7, m_ubo);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_neighborSSBO);
+
+        if (m_highWater > 0) {
+            GpuPassScope gpuScope(GpuPass::SimStep);
+            m_haloShader.use();
+            glBindImageTexture(0, m_arrays[m_current], 0, GL_TRUE, 0, GL_READ_WRITE, GL_R32F);
+            glDispatchCompute(haloGroups, haloGroups, m_highWater);
+            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+
+            m_simShader.use();
+            glBindTextureUnit(0, m_arrays[m_current]);
+            glBindImageTexture(1, m_arrays[m_current ^ 1], 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_R32F);
+            glBindTextureUnit(2, kernelTex);
+            glDispatchCompute(groups, groups, m_highWater);
+            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT |
+                            GL_TEXTURE_UPDATE_BARRIER_BIT);
+            m_current ^= 1;
+        }
+
+        ++m_stepCount;
+        if (m_stepCount % MAINTENANCE_INTERVAL == 0) {
+            maintain();
+            dirty = true;
+        }
+    }
+}
+
+/**
+ * @brief Reduce every chunk, then page in, release and evict by activity.
+ */
+void ChunkedWorld::maintain() {
+    TRACE_GL_SCOPE("ChunkedWorld::maintain");
+    if (m_highWater == 0) return;
+    if (m_neighborsDirty) uploadNeighbors();
+
+    m_statsShader.use();
+    glBindBufferBase(GL_UNIFORM_BUFFER, 7, m_ubo);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_neighborSSBO);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, m_statsSSBO);
+    glBindTextureUnit(0, m_arrays[m_current]);
+    {
+        GpuPassScope gpuScope(GpuPass::Analysis);
+        glDispatchCompute(m_highWater, 1, 1);
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    }
+    glGetNamedBufferSubData(m_statsSSBO, 0, sizeof(ChunkStats) * m_highWater, m_stats.data());
+
+    // Activity near a border wants the neighbors on that side, corners included
+    std::vector<std::pair<int, int>> wanted;
+    int count = m_highWater;
+    for (int i = 0; i < count; ++i) {
+        Slot& s = m_slots[i];
+        if (!s.used) continue;
+        const ChunkStats& st = m_stats[i];
+        if (st.aliveCount > 0) s.lastActive = m_stepCount;
+        if (!m_policy.autoLoad) continue;
+
+        bool left = st.edgeAlive[0] > 0, right = st.edgeAlive[1] > 0;
+        bool down = st.edgeAlive[2] > 0, up = st.edgeAlive[3] > 0;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                bool wantX = (dx == 0) || (dx < 0 ? left : right);
+                bool wantY = (dy == 0) || (dy < 0 ? down : up);
+                if ((dx || dy) && wantX && wantY) wanted.emplace_back(s.cx + dx, s.cy + dy);
+            }
+        }
+    }
+
+    // Chunks with nothing alive that nobody needs are released; under
+    // Preserve their leftover cells below the threshold are still cached
+    bool keep = m_policy.persistence == ChunkPersistence::Preserve;
+    std::unordered_set<int64_t> wantedKeys;
+    for (const auto& w : wanted) wantedKeys.insert(chunkKey(w.first, w.second));
+    for (int i = 0; i < count; ++i) {
+        const Slot& s = m_slots[i];
+        if (s.used && !s.pinned && m_stats[i].aliveCount == 0 && !wantedKeys.count(chunkKey(s.cx, s.cy)))
+            evict(i, keep);
+    }
+
+    for (const auto& w : wanted) {
+        int slot = pageIn(w.first, w.second);
+        if (slot >= 0) m_slots[slot].lastActive = std::max(m_slots[slot].lastActive, m_stepCount);
+    }
+
+    // Over budget: the longest-quiet chunks outside the view go to the cache
+    int resident = residentCount();
+    while (resident > m_policy.maxResident) {
+        int victim = -1;
+        for (int i = 0; i < m_highWater; ++i) {
+            const Slot& s = m_slots[i];
+            if (s.used && !s.pinned && (victim < 0 || s.lastActive < m_slots[victim].lastActive)) victim = i;
+        }
+        if (victim < 0) break;
+        evict(victim, keep);
+        --resident;
+    }
+}
+
+}
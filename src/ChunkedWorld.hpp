@@ -0,0 +1,223 @@
+/**
+ * @file ChunkedWorld.hpp
+ * @brief Unbounded single-channel world made of chunks paged between VRAM and a cache.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include "UIOverlay.hpp"
+#include "Utils/Shader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief What happens to a chunk's content once it leaves VRAM.
+ * Matches LeniaParams::chunkPersistence.
+ */
+enum class ChunkPersistence : int {
+    None     = 0,        // Dropped; the area is empty when paged back in
+    Preserve = 1,        // Compressed into the chunk cache
+    Seed     = 2         // Dropped; unseen chunks are generated from the world seed
+};
+
+/**
+ * @brief Compressed chunk store in memory, spilling to disk over a budget.
+ *
+ * Chunks are stored as runs of exact zeros and literal floats, which is
+ * lossless and small for Lenia states (mostly empty space). When the
+ * in-memory total exceeds the budget, the least recently stored chunks are
+ * written to files in the spill directory and read back on demand.
+ */
+class ChunkCache {
+public:
+    ChunkCache() = default;
+    ~ChunkCache();
+
+    ChunkCache(const ChunkCache&) = delete;
+    ChunkCache& operator=(const ChunkCache&) = delete;
+
+    void setBudget(size_t bytes) { m_budget = bytes; }
+    void setSpillDir(const std::string& dir) { m_spillDir = dir; }
+
+    void put(int64_t key, const std::vector<float>& cells);
+    /** @brief Move a chunk out of the cache; false if it is not stored. */
+    bool take(int64_t key, std::vector<float>& cells, size_t cellCount);
+    void clear();
+
+    size_t count() const { return m_memory.size() + m_onDisk.size(); }
+    size_t memoryBytes() const { return m_bytes; }
+
+    static void compress(const std::vector<float>& cells, std::vector<uint8_t>& out);
+    static bool decompress(const uint8_t* in, size_t bytes, std::vector<float>& cells, size_t cellCount);
+
+private:
+    struct Entry {
+        std::vector<uint8_t> data;
+        std::list<int64_t>::iterator order;
+    };
+
+    std::unordered_map<int64_t, Entry> m_memory;
+    std::list<int64_t>                 m_order;      // Oldest first, spilled first
+    std::unordered_set<int64_t>        m_onDisk;
+    size_t      m_bytes{0};
+    size_t      m_budget{256u << 20};
+    std::string m_spillDir{"chunk_cache"};
+
+    std::string spillPath(int64_t key) const;
+    void spill();
+};
+
+/**
+ * @brief Per-chunk reduction of one maintenance pass (std430 layout).
+ */
+struct ChunkStats {
+    float   totalMass;
+    int32_t aliveCount;
+    int32_t edgeAlive[4];   // Alive cells near the -x, +x, -y, +y borders
+    int32_t _pad[2];
+};
+
+/**
+ * @brief ChunkParams block (UBO 7) of the chunk shaders, also used by TiledState.
+ */
+struct alignas(16) GPUChunkParams {
+    int32_t chunkSize;
+    int32_t halo;
+    int32_t radius;
+    int32_t _pad0;
+    int32_t count;
+    int32_t growthType;
+    int32_t band;
+    float   threshold;
+    float   mu;
+    float   sigma;
+    float   dt;
+    float   param1;
+    float   param2;
+    int32_t chunkHeight;    // Rows; equals chunkSize except for TiledState tiles
+    int32_t _pad1;
+    int32_t _pad2;
+};
+
+/**
+ * @brief Sparse world of fixed-size chunks, only the active ones resident.
+ *
+ * Resident chunks occupy layers of two ping-pong R32F texture arrays. Each
+ * layer is the chunk plus a halo as wide as the kernel radius; every step
+ * first copies the neighbors' border cells into the halos (chunk_halo.comp,
+ * missing neighbors read as empty), then updates all chunk interiors in one
+ * dispatch (sim_chunked.comp). Single-channel rules only; walls and
+ * parameter maps do not apply.
+ *
+ * Every few steps chunk_stats.comp reduces each chunk to its mass and the
+ * activity along its four borders. Activity near a border pages in the
+ * neighbor (from the cache, the seed if never seen before, or empty);
+ * chunks with nothing alive are released, and above the resident budget
+ * the chunks that have been quiet the longest are evicted. Under Preserve
+ * both go to the ChunkCache. Chunks under the view are pinned and never
+ * evicted.
+ *
+ * The engine's grid is a window onto the world: storeView() writes edits
+ * made on it back into the chunks and loadView() refreshes it after steps.
+ */
+class ChunkedWorld {
+public:
+    struct Policy {
+        int  maxResident{25};           // LRU budget; chunks under the view are never evicted
+        int  prefetchRadius{2};         // Chunks kept around the view chunk
+        bool autoLoad{true};            // Follow activity into new chunks
+        ChunkPersistence persistence{ChunkPersistence::None};
+    };
+
+    struct View {
+        int originX{0};                 // World cell at the grid's (0, 0)
+        int originY{0};
+        int width{0};
+        int height{0};
+        int centerChunkX{0};
+        int centerChunkY{0};
+    };
+
+    ChunkedWorld() = default;
+    ~ChunkedWorld();
+
+    ChunkedWorld(const ChunkedWorld&) = delete;
+    ChunkedWorld& operator=(const ChunkedWorld&) = delete;
+
+    bool init(const std::string& shaderDir);
+    /** @brief Set chunk size and halo; a new chunk size clears the world, a new halo keeps it. */
+    bool configure(int chunkSize, int halo);
+    void release();
+    /** @brief Drop every resident and cached chunk and pick a new seed. */
+    void clear();
+
+    void setPolicy(const Policy& policy);
+    /** @brief Pin and page in the chunks under @p view and around its center chunk. */
+    void setView(const View& view);
+
+    void storeView(GLuint stateTex, const View& view);
+    void loadView(GLuint stateTex, const View& view);
+    void step(const LeniaParams& params, GLuint kernelTex, int steps);
+
+    bool configured() const { return m_arrays[0] != 0; }
+    int chunkSize() const { return m_chunkSize; }
+    int halo() const { return m_halo; }
+    int residentCount() const { return static_cast<int>(m_index.size()); }
+    int cachedCount() const { return static_cast<int>(m_cache.count()); }
+    size_t cacheBytes() const { return m_cache.memoryBytes(); }
+    ChunkCache& cache() { return m_cache; }
+
+    static int64_t chunkKey(int cx, int cy) {
+        return (static_cast<int64_t>(cx) << 32) | static_cast<uint32_t>(cy);
+    }
+
+private:
+    struct Slot {
+        bool    used{false};
+        bool    pinned{false};
+        int     cx{0};
+        int     cy{0};
+        int64_t lastActive{0};           // Step of the last pass that found it alive
+    };
+
+    Shader m_haloShader;
+    Shader m_simShader;
+    Shader m_statsShader;
+    GLuint m_arrays[2]{0, 0};            // Ping-pong R32F arrays, one layer per slot
+    int    m_current{0};
+    GLuint m_neighborSSBO{0};            // 9 slot indices per slot (3x3, -1 = absent)
+    GLuint m_statsSSBO{0};
+    GLuint m_ubo{0};
+    int    m_chunkSize{0};
+    int    m_halo{0};
+    int    m_capacity{0};
+    int    m_highWater{0};               // Slots [0, m_highWater) are dispatched
+    bool   m_neighborsDirty{true};
+    int64_t m_stepCount{0};
+    uint32_t m_seed{1};
+    Policy m_policy;
+    std::vector<Slot>                m_slots;
+    std::unordered_map<int64_t, int> m_index;    // chunkKey -> slot
+    std::unordered_set<int64_t>      m_seen;     // Chunks ever paged in (Seed generates the others)
+    std::vector<ChunkStats>          m_stats;
+    ChunkCache                       m_cache;
+
+    int  layerSize() const { return m_chunkSize + 2 * m_halo; }
+    bool reallocate(int capacity, int halo);
+    int  pageIn(int cx, int cy);
+    void evict(int slot, bool keep);
+    void seedChunk(int cx, int cy, std::vector<float>& cells) const;
+    void uploadNeighbors();
+    void maintain();
+    void uploadUBO(const LeniaParams& params, float threshold);
+};
+
+}
@@ -0,0 +1,268 @@
+/**
+ * @file FieldExporter.cpp
+ * @brief Field readbacks, creature search and .npy / .npz writing.
+ */
+
+#include "FieldExporter.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/NpyLoader.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+#include <filesystem>
+
+namespace lenia {
+
+static const char* fieldName(ExportField field) {
+    switch (field) {
+        case EXPORT_WALLS:     return "walls";
+        case EXPORT_POTENTIAL: return "potential";
+        case EXPORT_GROWTH:    return "growth";
+        default:               return "state";
+    }
+}
+
+bool FieldExporter::begin(const std::string& path, const ExportOptions& options, const ExportGrid& grid,
+                          const std::vector<ReadbackSource>& sources) {
+    TRACE_GL_SCOPE("FieldExporter::begin");
+    if (busy()) {
+        LOG_WARN("An export is still being written; %s skipped.", path.c_str());
+        return false;
+    }
+    if (sources.empty()) {
+        LOG_ERROR("Export %s: none of the requested fields is available.", path.c_str());
+        return false;
+    }
+    m_path = path;
+    m_options = options;
+    m_grid = grid;
+    m_start = std::chrono::steady_clock::now();
+    if (!m_readback.begin(sources, [this](const std::vector<ReadbackBlock>& blocks) { return write(blocks); })) {
+        LOG_ERROR("Not enough memory to read back a %dx%d export.", grid.width, grid.height);
+        return false;
+    }
+    return true;
+}
+
+void FieldExporter::poll(bool wait) {
+    if (!m_readback.poll(wait) || !m_readback.succeeded()) return;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    LOG_INFO("Export %s: %dx%d at step %lld in %.0f ms.", m_path.c_str(), m_grid.width, m_grid.height,
+             static_cast<long long>(m_grid.stepCount), ms);
+}
+
+/**
+ * @brief Gather one field from its blocks into a (H, W, channels) array.
+ *
+ * Walls keep the alpha channel, the wall mask; the other fields keep their
+ * first @p channels components.
+ */
+void FieldExporter::assemble(const std::vector<ReadbackBlock>& blocks, ExportField field, int channels,
+                             std::vector<float>& out) const {
+    int width = m_grid.width;
+    out.assign(static_cast<size_t>(width) * m_grid.height * channels, 0.0f);
+    for (const ReadbackBlock& block : blocks) {
+        if (block.tag != field) continue;
+        int first = (field == EXPORT_WALLS) ? block.components - 1 : 0;
+        int keep = std::min(channels, block.components - first);
+        for (int y = 0; y < block.h; ++y) {
+            const float* src = block.data + static_cast<size_t>(y) * block.w * block.components + first;
+            float* dst = out.data() + (static_cast<size_t>(block.y + y) * width + block.x) * channels;
+            for (int x = 0; x < block.w; ++x)
+                for (int c = 0; c < keep; ++c)
+                    dst[static_cast<size_t>(x) * channels + c] = src[static_cast<size_t>(x) * block.components + c];
+        }
+    }
+}
+
+/**
+ * @brief Flood-fill the live cells in 8-connected groups and keep the heaviest.
+ *
+ * Cells are visited in unwrapped coordinates, so a group crossing a
+ * periodic edge gets one contiguous bounding box; a box wider than the grid
+ * (a group wrapping all the way round) is cut to the grid.
+ */
+FieldExporter::Creature FieldExporter::findCreature(const std::vector<float>& state) const {
+    TRACE_SCOPE("FieldExporter::findCreature");
+    int width = m_grid.width;
+    int height = m_grid.height;
+    int channels = m_grid.channels;
+    auto live = [&](size_t i) {
+        float sum = 0.0f;
+        for (int c = 0; c < channels; ++c) sum += state[i * channels + c];
+        return sum > m_options.threshold;
+    };
+
+    Creature best;
+    std::vector<bool> visited(static_cast<size_t>(width) * height, false);
+    std::vector<std::pair<int, int>> stack;
+    for (int sy = 0; sy < height; ++sy) {
+        for (int sx = 0; sx < width; ++sx) {
+            size_t seed = static_cast<size_t>(sy) * width + sx;
+            if (visited[seed] || !live(seed)) continue;
+            visited[seed] = true;
+            stack.assign(1, {sx, sy});
+            int minX = sx, maxX = sx, minY = sy, maxY = sy;
+            double mass = 0.0;
+            while (!stack.empty()) {
+                auto [ux, uy] = stack.back();
+                stack.pop_back();
+                int x = ((ux % width) + width) % width;
+                int y = ((uy % height) + height) % height;
+                for (int c = 0; c < channels; ++c)
+                    mass += state[(static_cast<size_t>(y) * width + x) * channels + c];
+                minX = std::min(minX, ux);
+                maxX = std::max(maxX, ux);
+                minY = std::min(minY, uy);
+                maxY = std::max(maxY, uy);
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        int nx = x + dx, ny = y + dy;
+                        if (nx < 0 || nx >= width) {
+                            if (!m_grid.wrapX) continue;
+                            nx = (nx + width) % width;
+                        }
+                        if (ny < 0 || ny >= height) {
+                            if (!m_grid.wrapY) continue;
+                            ny = (ny + height) % height;
+                        }
+                        size_t n = static_cast<size_t>(ny) * width + nx;
+                        if (visited[n] || !live(n)) continue;
+                        visited[n] = true;
+                        stack.push_back({ux + dx, uy + dy});
+                    }
+                }
+            }
+            if (mass > best.mass) {
+                best.x = minX;
+                best.y = minY;
+                best.w = std::min(maxX - minX + 1, width);
+                best.h = std::min(maxY - minY + 1, height);
+                best.mass = mass;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Worker thread: assemble the arrays, crop the creature, write the output.
+ */
+bool FieldExporter::write(const std::vector<ReadbackBlock>& blocks) const {
+    TRACE_SCOPE("FieldExporter::write");
+    namespace fs = std::filesystem;
+    int width = m_grid.width;
+    int height = m_grid.height;
+    int channels = m_grid.channels;
+    auto shapeOf = [&](int h, int w, int c) {
+        std::vector<int> shape = {h, w};
+        if (c > 1) shape.push_back(c);
+        return shape;
+    };
+
+    std::vector<std::vector<float>> storage;
+    std::vector<NpyRecord> arrays;
+    storage.reserve(5);
+    int stateIndex = -1;
+    for (ExportField field : {EXPORT_STATE, EXPORT_WALLS, EXPORT_POTENTIAL, EXPORT_GROWTH}) {
+        bool present = std::any_of(blocks.begin(), blocks.end(),
+                                   [&](const ReadbackBlock& b) { return b.tag == field; });
+        if (!present) continue;
+        int fieldChannels = (field == EXPORT_WALLS) ? 1 : channels;
+        std::vector<float>& data = storage.emplace_back();
+        assemble(blocks, field, fieldChannels, data);
+        if (field == EXPORT_STATE) {
+            stateIndex = static_cast<int>(storage.size()) - 1;
+            if (!(m_options.fields & EXPORT_STATE)) continue;   // Read for the creature only
+        }
+        NpyRecord array;
+        array.name = fieldName(field);
+        array.shape = shapeOf(height, width, fieldChannels);
+        array.data = data.data();
+        arrays.push_back(array);
+    }
+
+    int64_t step = m_grid.stepCount;
+    int64_t box[4] = {};
+    NpyRecord stepArray;
+    stepArray.name = "step";
+    stepArray.descr = "<i8";
+    stepArray.data = &step;
+    arrays.push_back(stepArray);
+
+    if ((m_options.fields & EXPORT_CREATURE) && stateIndex >= 0) {
+        const std::vector<float>& state = storage[stateIndex];
+        Creature creature = findCreature(state);
+        if (creature.mass <= 0.0) {
+            LOG_WARN("Export %s: no cell above %.3f, creature crop skipped.", m_path.c_str(), m_options.threshold);
+        } else {
+            int margin = std::max(0, m_options.margin);
+            int x0 = creature.x - margin, y0 = creature.y - margin;
+            int w = creature.w + 2 * margin, h = creature.h + 2 * margin;
+            if (m_grid.wrapX) {
+                w = std::min(w, width);
+            } else {
+                x0 = std::max(0, x0);
+                w = std::min(creature.x + creature.w + margin, width) - x0;
+            }
+            if (m_grid.wrapY) {
+                h = std::min(h, height);
+            } else {
+                y0 = std::max(0, y0);
+                h = std::min(creature.y + creature.h + margin, height) - y0;
+            }
+            x0 = ((x0 % width) + width) % width;
+            y0 = ((y0 % height) + height) % height;
+
+            std::vector<float>& crop = storage.emplace_back(static_cast<size_t>(w) * h * channels);
+            for (int y = 0; y < h; ++y) {
+                int gy = (y0 + y) % height;
+                for (int x = 0; x < w; ++x) {
+                    int gx = (x0 + x) % width;
+                    const float* src = state.data() + (static_cast<size_t>(gy) * width + gx) * channels;
+                    std::copy(src, src + channels, crop.data() + (static_cast<size_t>(y) * w + x) * channels);
+                }
+            }
+            box[0] = x0;
+            box[1] = y0;
+            box[2] = w;
+            box[3] = h;
+
+            NpyRecord cropArray;
+            cropArray.name = "creature";
+            cropArray.shape = shapeOf(h, w, channels);
+            cropArray.data = crop.data();
+            arrays.push_back(cropArray);
+            NpyRecord boxArray;
+            boxArray.name = "creature_box";
+            boxArray.descr = "<i8";
+            boxArray.shape = {4};
+            boxArray.data = box;
+            arrays.push_back(boxArray);
+        }
+    }
+
+    std::error_code ec;
+    fs::path target(m_path);
+    bool archive = target.extension() == ".npz";
+    if (!archive) {
+        fs::create_directories(target, ec);
+        for (const NpyRecord& array : arrays)
+            if (!saveNpy((target / (array.name + ".npy")).string(), array)) return false;
+        return true;
+    }
+
+    if (target.has_parent_path()) fs::create_directories(target.parent_path(), ec);
+    std::string tmpPath = m_path + ".tmp";
+    if (!saveNpz(tmpPath, arrays)) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    fs::rename(tmpPath, m_path, ec);
+    if (ec) {
+        LOG_ERROR("Cannot move export into place at %s: %s", m_path.c_str(), ec.message().c_str());
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,89 @@
+/**
+ * @file FieldExporter.hpp
+ * @brief One-shot NumPy export of the state, walls and diagnostic fields.
+ */
+
+#pragma once
+
+#include "AsyncReadback.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+enum ExportField : uint32_t {
+    EXPORT_STATE     = 1u << 0,
+    EXPORT_WALLS     = 1u << 1,      // Wall mask (alpha of the wall texture)
+    EXPORT_POTENTIAL = 1u << 2,      // Neighbor sums
+    EXPORT_GROWTH    = 1u << 3,
+    EXPORT_CREATURE  = 1u << 4,      // State cropped around the largest creature
+    EXPORT_ALL       = (1u << 5) - 1
+};
+
+struct ExportOptions {
+    uint32_t fields{EXPORT_ALL};     // ExportField mask
+    float    threshold{0.1f};        // Creature cells: state, summed over channels, above this
+    int      margin{8};              // Cells kept around the creature's bounding box
+};
+
+/**
+ * @brief Layout of the grid being exported.
+ */
+struct ExportGrid {
+    int     width{0};
+    int     height{0};
+    int     channels{1};             // State, potential and growth values per cell
+    bool    wrapX{true};             // Creatures may cross periodic edges
+    bool    wrapY{true};
+    int64_t stepCount{0};
+};
+
+/**
+ * @brief Writes the selected fields as one .npz archive or a directory of .npy files.
+ *
+ * Arrays are (H, W), or (H, W, C) for multi-channel grids; the archive also
+ * holds "step" and, with the creature crop, "creature_box" = (x, y, w, h)
+ * in grid cells, x and y wrapped into the grid. Sources are tagged with
+ * their ExportField. begin() only queues an AsyncReadback; its worker
+ * thread assembles the arrays, finds the largest creature and writes the
+ * files.
+ */
+class FieldExporter {
+public:
+    FieldExporter() = default;
+
+    FieldExporter(const FieldExporter&) = delete;
+    FieldExporter& operator=(const FieldExporter&) = delete;
+
+    /** @brief Start an export to @p path: a file ending in .npz, otherwise a directory. */
+    bool begin(const std::string& path, const ExportOptions& options, const ExportGrid& grid,
+               const std::vector<ReadbackSource>& sources);
+    /** @brief Advance a pending export; @p wait blocks until it is written. */
+    void poll(bool wait = false);
+
+    bool busy() const { return m_readback.busy(); }
+    /** @brief Outcome of the last finished export. */
+    bool succeeded() const { return m_readback.succeeded(); }
+
+private:
+    /** @brief Bounding box of the heaviest connected group of live cells. */
+    struct Creature {
+        int    x{0}, y{0}, w{0}, h{0};
+        double mass{0.0};
+    };
+
+    std::string        m_path;
+    ExportOptions      m_options;
+    ExportGrid         m_grid;
+    std::chrono::steady_clock::time_point m_start;
+    AsyncReadback      m_readback;         // Last: joins the worker before the fields it reads go
+
+    bool write(const std::vector<ReadbackBlock>& blocks) const;
+    void assemble(const std::vector<ReadbackBlock>& blocks, ExportField field, int channels,
+                  std::vector<float>& out) const;
+    Creature findCreature(const std::vector<float>& state) const;
+};
+
+}
@@ -0,0 +1,376 @@
+/**
+ * @file FrameRecorder.cpp
+ * @brief Pixel pack buffer ring, writer thread, PNG and Y4M encoding.
+ */
+
+#include "FrameRecorder.hpp"
+#include "Utils/Crc32.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace lenia {
+
+FrameRecorder::~FrameRecorder() {
+    stop();
+}
+
+bool FrameRecorder::start(const std::string& path, RecordFormat format, int every) {
+    stop();
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::path target(path);
+    if (format == RecordFormat::Png) {
+        fs::create_directories(target, ec);
+        if (ec) {
+            LOG_ERROR("Cannot create recording directory %s: %s", path.c_str(), ec.message().c_str());
+            return false;
+        }
+    } else {
+        if (target.has_parent_path()) fs::create_directories(target.parent_path(), ec);
+        m_y4m.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_y4m.is_open()) {
+            LOG_ERROR("Cannot write recording %s", path.c_str());
+            return false;
+        }
+    }
+
+    m_path = path;
+    m_format = format;
+    m_every = std::max(1, every);
+    m_lastStep = 0;
+    m_captured = m_dropped = 0;
+    m_written = m_writeErrors = m_sizeMismatches = 0;
+    m_y4mWidth = m_y4mHeight = m_y4mComponents = 0;
+    m_stopping = false;
+    m_recording = true;
+    m_writer = std::thread([this]() { writerLoop(); });
+    LOG_INFO("Recording to %s", path.c_str());
+    return true;
+}
+
+void FrameRecorder::stop() {
+    if (!m_recording) return;
+    poll(true);
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_writer.join();
+    if (m_y4m.is_open()) m_y4m.close();
+    release();
+    m_recording = false;
+
+    int dropped = m_dropped + m_sizeMismatches;
+    LOG_INFO("Recorded %d frames to %s (%d dropped).", m_written, m_path.c_str(), dropped);
+    if (m_writeErrors > 0) LOG_WARN("%d frames of %s could not be written.", m_writeErrors, m_path.c_str());
+    if (m_sizeMismatches > 0) LOG_WARN("%d frames changed size and were left out of %s.", m_sizeMismatches, m_path.c_str());
+}
+
+bool FrameRecorder::due(int stepCount) const {
+    return m_recording && (m_captured + m_dropped == 0 || stepCount - m_lastStep >= m_every);
+}
+
+/**
+ * @brief Next free ring slot sized for @p bytes, or nullptr (and a drop) if all are in flight.
+ */
+FrameRecorder::Slot* FrameRecorder::beginCapture(const Frame& layout, size_t bytes, int stepCount) {
+    poll();
+    m_lastStep = stepCount;
+    if (m_inFlight == RING_SIZE) {
+        ++m_dropped;
+        return nullptr;
+    }
+    Slot& slot = m_slots[m_next];
+    if (slot.capacity < bytes) {
+        if (slot.buffer) glDeleteBuffers(1, &slot.buffer);
+        glCreateBuffers(1, &slot.buffer);
+        glNamedBufferStorage(slot.buffer, static_cast<GLsizeiptr>(bytes), nullptr, GL_MAP_READ_BIT);
+        slot.capacity = bytes;
+    }
+    slot.frame = layout;
+    slot.frame.index = m_captured;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    return &slot;
+}
+
+void FrameRecorder::captureTexture(GLuint tex, int width, int height, bool rgb, float lo, float hi, int stepCount) {
+    TRACE_GL_SCOPE("FrameRecorder::captureTexture");
+    if (!m_recording) return;
+    if (tex == 0) {
+        drop(stepCount);
+        return;
+    }
+    Frame layout;
+    layout.width = width;
+    layout.height = height;
+    layout.components = rgb ? 3 : 1;
+    layout.floats = true;
+    layout.lo = lo;
+    layout.hi = hi;
+    size_t bytes = static_cast<size_t>(width) * height * layout.components * sizeof(float);
+    Slot* slot = beginCapture(layout, bytes, stepCount);
+    if (!slot) return;
+
+    // Compute shader writes must land before the pack transfer reads the texture
+    glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+    glGetTextureImage(tex, 0, rgb ? GL_RGB : GL_RED, GL_FLOAT, static_cast<GLsizei>(bytes), nullptr);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_next = (m_next + 1) % RING_SIZE;
+    ++m_inFlight;
+    ++m_captured;
+}
+
+void FrameRecorder::captureFramebuffer(int width, int height, int stepCount) {
+    TRACE_GL_SCOPE("FrameRecorder::captureFramebuffer");
+    if (!m_recording) return;
+    Frame layout;
+    layout.width = width;
+    layout.height = height;
+    layout.components = 3;
+    layout.flip = true;
+    size_t bytes = static_cast<size_t>(width) * height * 3;
+    Slot* slot = beginCapture(layout, bytes, stepCount);
+    if (!slot) return;
+
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_next = (m_next + 1) % RING_SIZE;
+    ++m_inFlight;
+    ++m_captured;
+}
+
+/**
+ * @brief Queue the frame held back by a full writer queue; false if there is still no room.
+ */
+bool FrameRecorder::pushPending() {
+    if (!m_hasPending) return true;
+    if (!m_queue.push(m_pending)) return false;
+    m_hasPending = false;
+    m_wake.notify_one();
+    return true;
+}
+
+void FrameRecorder::poll(bool wait) {
+    while (!pushPending()) {
+        if (!wait) return;
+        std::this_thread::yield();
+    }
+    while (m_inFlight > 0) {
+        Slot& slot = m_slots[m_oldest];
+        GLuint64 timeout = wait ? GL_TIMEOUT_IGNORED : 0;
+        GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return;
+
+        const Frame& layout = slot.frame;
+        size_t bytes = static_cast<size_t>(layout.width) * layout.height * layout.components *
+                       (layout.floats ? sizeof(float) : 1);
+        m_pending = layout;
+        m_pending.data.resize(bytes);
+        const void* mapped = glMapNamedBufferRange(slot.buffer, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_READ_BIT);
+        if (mapped) {
+            std::memcpy(m_pending.data.data(), mapped, bytes);
+            glUnmapNamedBuffer(slot.buffer);
+            m_hasPending = true;
+        } else {
+            ++m_dropped;
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        m_oldest = (m_oldest + 1) % RING_SIZE;
+        --m_inFlight;
+
+        // A full writer queue holds the copy back and leaves later readbacks in their slots
+        while (!pushPending()) {
+            if (!wait) return;
+            std::this_thread::yield();
+        }
+    }
+}
+
+void FrameRecorder::release() {
+    for (Slot& slot : m_slots) {
+        if (slot.fence) glDeleteSync(slot.fence);
+        if (slot.buffer) glDeleteBuffers(1, &slot.buffer);
+        slot = Slot{};
+    }
+    m_next = m_oldest = m_inFlight = 0;
+    m_pending = Frame{};
+    m_hasPending = false;
+}
+
+// ---------------------------------------------------------------------------
+// Writer thread
+// ---------------------------------------------------------------------------
+
+void FrameRecorder::writerLoop() {
+    Frame frame;
+    for (;;) {
+        if (m_queue.pop(frame)) {
+            writeFrame(frame);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        if (m_stopping && m_queue.empty()) return;
+        m_wake.wait_for(lock, std::chrono::milliseconds(50),
+                        [this]() { return m_stopping || !m_queue.empty(); });
+    }
+}
+
+/**
+ * @brief Convert a frame to top-down 8-bit pixels and encode it.
+ */
+void FrameRecorder::writeFrame(const Frame& frame) {
+    TRACE_SCOPE("FrameRecorder::writeFrame");
+    size_t rowValues = static_cast<size_t>(frame.width) * frame.components;
+    std::vector<uint8_t> pixels(rowValues * frame.height);
+    float scale = 255.0f / std::max(frame.hi - frame.lo, 1e-6f);
+    for (int y = 0; y < frame.height; ++y) {
+        int srcY = frame.flip ? frame.height - 1 - y : y;
+        uint8_t* dst = pixels.data() + static_cast<size_t>(y) * rowValues;
+        if (frame.floats) {
+            const float* src = reinterpret_cast<const float*>(frame.data.data()) + static_cast<size_t>(srcY) * rowValues;
+            for (size_t i = 0; i < rowValues; ++i) {
+                float v = std::clamp((src[i] - frame.lo) * scale, 0.0f, 255.0f);
+                dst[i] = static_cast<uint8_t>(v + 0.5f);
+            }
+        } else {
+            std::memcpy(dst, frame.data.data() + static_cast<size_t>(srcY) * rowValues, rowValues);
+        }
+    }
+
+    if (m_format == RecordFormat::Png) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%06d.png", frame.index);
+        std::string path = (std::filesystem::path(m_path) / name).string();
+        if (writePng(path, pixels, frame.width, frame.height, frame.components)) ++m_written;
+        else ++m_writeErrors;
+    } else {
+        writeY4m(pixels, frame.width, frame.height, frame.components);
+    }
+}
+
+static void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 24));
+    out.push_back(static_cast<uint8_t>(v >> 16));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+static void putChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& body) {
+    putU32(out, static_cast<uint32_t>(body.size()));
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), body.begin(), body.end());
+    putU32(out, crc32(0, out.data() + start, out.size() - start));
+}
+
+/**
+ * @brief Minimal PNG writer: 8-bit gray or RGB, zlib stream of stored blocks.
+ *
+ * Frames are left uncompressed so the writer keeps up with the capture
+ * rate; re-encode the sequence (e.g. with ffmpeg) for smaller files.
+ */
+bool FrameRecorder::writePng(const std::string& path, const std::vector<uint8_t>& pixels,
+                             int width, int height, int components) {
+    size_t rowBytes = static_cast<size_t>(width) * components;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (int y = 0; y < height; ++y) {
+        raw.push_back(0);                            // Filter: none
+        raw.insert(raw.end(), pixels.begin() + y * rowBytes, pixels.begin() + (y + 1) * rowBytes);
+    }
+
+    std::vector<uint8_t> zlib;
+    zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    uint32_t a = 1, b = 0;
+    for (size_t pos = 0; pos < raw.size(); ) {
+        size_t n = std::min<size_t>(65535, raw.size() - pos);
+        bool last = pos + n == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(n));
+        zlib.push_back(static_cast<uint8_t>(n >> 8));
+        zlib.push_back(static_cast<uint8_t>(~n));
+        zlib.push_back(static_cast<uint8_t>(~n >> 8));
+        zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + n);
+        for (size_t i = pos; i < pos + n; ++i) {
+            a = (a + raw[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        pos += n;
+    }
+    putU32(zlib, (b << 16) | a);
+
+    std::vector<uint8_t> header;
+    putU32(header, static_cast<uint32_t>(width));
+    putU32(header, static_cast<uint32_t>(height));
+    header.push_back(8);                             // Bit depth
+    header.push_back(components == 3 ? 2 : 0);       // Truecolor or grayscale
+    header.push_back(0);
+    header.push_back(0);
+    header.push_back(0);
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<uint8_t> out(signature, signature + 8);
+    out.reserve(zlib.size() + 64);
+    putChunk(out, "IHDR", header);
+    putChunk(out, "IDAT", zlib);
+    putChunk(out, "IEND", {});
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    return file.good();
+}
+
+/**
+ * @brief Append one frame; the stream header is written with the first one.
+ *
+ * Grayscale goes out as Cmono, color as full-resolution BT.601 C444.
+ */
+void FrameRecorder::writeY4m(const std::vector<uint8_t>& pixels, int width, int height, int components) {
+    if (m_y4mWidth == 0) {
+        m_y4mWidth = width;
+        m_y4mHeight = height;
+        m_y4mComponents = components;
+        m_y4m << "YUV4MPEG2 W" << width << " H" << height << " F" << Y4M_FPS << ":1 Ip A1:1 "
+              << (components == 1 ? "Cmono" : "C444") << '\n';
+    } else if (width != m_y4mWidth || height != m_y4mHeight || components != m_y4mComponents) {
+        ++m_sizeMismatches;
+        return;
+    }
+
+    m_y4m << "FRAME\n";
+    size_t cells = static_cast<size_t>(width) * height;
+    if (components == 1) {
+        m_y4m.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(cells));
+    } else {
+        std::vector<uint8_t> planes(cells * 3);
+        for (size_t i = 0; i < cells; ++i) {
+            float r = pixels[i * 3], g = pixels[i * 3 + 1], b = pixels[i * 3 + 2];
+            float y = 16.0f + 0.257f * r + 0.504f * g + 0.098f * b;
+            float u = 128.0f - 0.148f * r - 0.291f * g + 0.439f * b;
+            float v = 128.0f + 0.439f * r - 0.368f * g - 0.071f * b;
+            planes[i]             = static_cast<uint8_t>(std::clamp(y + 0.5f, 0.0f, 255.0f));
+            planes[cells + i]     = static_cast<uint8_t>(std::clamp(u + 0.5f, 0.0f, 255.0f));
+            planes[cells * 2 + i] = static_cast<uint8_t>(std::clamp(v + 0.5f, 0.0f, 255.0f));
+        }
+        m_y4m.write(reinterpret_cast<const char*>(planes.data()), static_cast<std::streamsize>(planes.size()));
+    }
+    if (m_y4m.good()) ++m_written;
+    else ++m_writeErrors;
+}
+
+}
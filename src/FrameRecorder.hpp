@@ -0,0 +1,134 @@
+/**
+ * @file FrameRecorder.hpp
+ * @brief Records frames or state textures to PNG sequences and Y4M video.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include "Utils/SpscQueue.hpp"
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lenia {
+
+enum class RecordSource {
+    Display   = 0,   // Rendered frame, without the UI
+    State     = 1,   // Raw state texture, grayscale or RGB
+    Potential = 2,   // Neighbor sums (debug output)
+    Growth    = 3    // Growth field (debug output), -1..1
+};
+
+enum class RecordFormat {
+    Png = 0,         // Directory of frame_NNNNNN.png
+    Y4m = 1          // Single YUV4MPEG2 file (Cmono or C444)
+};
+
+/**
+ * @brief Asynchronous frame capture.
+ *
+ * Every capture only queues a readback into the next pixel pack buffer of
+ * a small ring, followed by a fence. poll(), on the same GL thread, copies
+ * the buffers whose fence has signalled (one or more frames later) into a
+ * queue drained by a writer thread, which converts to 8 bits and encodes.
+ * When every ring buffer is still in flight the capture is dropped rather
+ * than waited for; drops are counted and reported when recording stops.
+ */
+class FrameRecorder {
+public:
+    static constexpr int RING_SIZE = 3;      // Readbacks in flight
+    static constexpr int QUEUE_SIZE = 9;     // Frames waiting for the writer, plus one
+    static constexpr int Y4M_FPS = 30;
+
+    FrameRecorder() = default;
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    /** @brief Start writing to @p path: a directory for PNG, a file for Y4M. */
+    bool start(const std::string& path, RecordFormat format, int every);
+    /** @brief Finish pending readbacks, flush the writer and close the output. */
+    void stop();
+    bool recording() const { return m_recording; }
+
+    /** @brief True when at least @c every steps passed since the last capture. */
+    bool due(int stepCount) const;
+    /** @brief Queue a readback of a state or field texture (R32F or RGBA32F), mapping [lo, hi] to 0..255. */
+    void captureTexture(GLuint tex, int width, int height, bool rgb, float lo, float hi, int stepCount);
+    /** @brief Queue a readback of the bound draw framebuffer's back buffer. */
+    void captureFramebuffer(int width, int height, int stepCount);
+    /** @brief Count a frame that was due but could not be captured. */
+    void drop(int stepCount) { ++m_dropped; m_lastStep = stepCount; }
+    /** @brief Hand finished readbacks to the writer; @p wait blocks on all of them. */
+    void poll(bool wait = false);
+
+    int framesCaptured() const { return m_captured; }
+    int framesDropped() const { return m_dropped; }
+
+private:
+    struct Frame {
+        std::vector<uint8_t> data;
+        int   width{0};
+        int   height{0};
+        int   components{1};       // 1 gray, 3 RGB
+        bool  floats{false};       // data holds floats mapped from [lo, hi]
+        float lo{0.0f};
+        float hi{1.0f};
+        bool  flip{false};         // Rows bottom-up (framebuffer reads)
+        int   index{0};
+    };
+
+    struct Slot {
+        GLuint buffer{0};
+        size_t capacity{0};
+        GLsync fence{nullptr};
+        Frame  frame;              // Layout of the pending readback, data empty
+    };
+
+    std::array<Slot, RING_SIZE> m_slots{};
+    int  m_next{0};                // Slot of the next capture
+    int  m_oldest{0};              // Oldest slot in flight
+    int  m_inFlight{0};
+    Frame m_pending;               // Copied readback waiting for room in the queue
+    bool  m_hasPending{false};
+
+    bool        m_recording{false};
+    RecordFormat m_format{RecordFormat::Png};
+    std::string m_path;
+    int         m_every{1};
+    int         m_lastStep{0};
+    int         m_captured{0};
+    int         m_dropped{0};
+
+    SpscQueue<Frame, QUEUE_SIZE> m_queue;
+    std::thread             m_writer;
+    std::mutex              m_wakeMutex;
+    std::condition_variable m_wake;
+    bool                    m_stopping{false};  // Guarded by m_wakeMutex
+
+    // Writer thread only
+    std::ofstream m_y4m;
+    int           m_y4mWidth{0};
+    int           m_y4mHeight{0};
+    int           m_y4mComponents{0};
+    int           m_written{0};
+    int           m_writeErrors{0};
+    int           m_sizeMismatches{0};
+
+    Slot* beginCapture(const Frame& layout, size_t bytes, int stepCount);
+    bool  pushPending();
+    void  writerLoop();
+    void  writeFrame(const Frame& frame);
+    bool  writePng(const std::string& path, const std::vector<uint8_t>& pixels, int width, int height, int components);
+    void  writeY4m(const std::vector<uint8_t>& pixels, int width, int height, int components);
+    void  release();
+};
+
+}
@@ -0,0 +1,148 @@
+/**
+ * @file GpuProfiler.cpp
+ * @brief Implementation of the timestamp-query GPU pass profiler.
+ */
+
+#include "GpuProfiler.hpp"
+#include "Utils/Trace.hpp"
+#include <cstddef>
+
+namespace lenia {
+
+static thread_local GpuProfiler* s_currentProfiler = nullptr;
+
+GpuProfiler* GpuProfiler::current() {
+    return s_currentProfiler;
+}
+
+void GpuProfiler::makeCurrent(GpuProfiler* profiler) {
+    s_currentProfiler = profiler;
+}
+
+const char* GpuProfiler::passName(GpuPass pass) {
+    switch (pass) {
+        case GpuPass::KernelGen: return "GPU KernelGen";
+        case GpuPass::SimStep:   return "GPU SimStep";
+        case GpuPass::Obstacles: return "GPU Obstacles";
+        case GpuPass::Analysis:  return "GPU Analysis";
+        case GpuPass::Render:    return "GPU Render";
+        case GpuPass::ImGui:     return "GPU ImGui";
+        default:                 return "GPU";
+    }
+}
+
+void GpuProfiler::release() {
+    for (auto& f : m_frames) {
+        if (!f.queries.empty()) glDeleteQueries(static_cast<GLsizei>(f.queries.size()), f.queries.data());
+        f = FrameQueries{};
+    }
+    m_frame = 0;
+    m_inFrame = false;
+    m_depth = 0;
+    m_recording = false;
+    m_latest = GpuPassTimes{};
+    if (s_currentProfiler == this) s_currentProfiler = nullptr;
+}
+
+/**
+ * @brief Collect finished frames and start recording into the next ring slot.
+ */
+void GpuProfiler::beginFrame() {
+    // Oldest first, so m_latest ends up with the newest finished frame
+    for (int i = 1; i <= FRAME_LATENCY; ++i) {
+        FrameQueries& f = m_frames[(m_frame + i) % FRAME_LATENCY];
+        if (f.pending) resolve(f);
+    }
+
+    FrameQueries& f = m_frames[m_frame];
+    f.pending = false;  // Still unresolved after a full ring: drop it
+    f.passes.clear();
+    for (int& c : f.spanCounts) c = 0;
+    f.traced = Tracer::enabled();
+    if (f.traced) {
+        GLint64 gpuNow = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+        f.clockOffsetNs = Tracer::nowNs() - gpuNow;
+    }
+    m_inFrame = true;
+    m_depth = 0;
+    m_recording = false;
+}
+
+void GpuProfiler::endFrame() {
+    if (!m_inFrame) return;
+    FrameQueries& f = m_frames[m_frame];
+    f.pending = !f.passes.empty();
+    m_inFrame = false;
+    m_frame = (m_frame + 1) % FRAME_LATENCY;
+}
+
+/**
+ * @brief Open a span; a span directly following one of the same pass extends it.
+ */
+void GpuProfiler::beginSpan(GpuPass pass) {
+    if (m_depth++ > 0 || !m_inFrame) return;  // Nested scopes are ignored
+
+    FrameQueries& f = m_frames[m_frame];
+    f.spanCounts[static_cast<int>(pass)]++;
+    m_recording = true;
+    if (!f.passes.empty() && f.passes.back() == pass) return;
+
+    if (static_cast<int>(f.passes.size()) >= MAX_SPANS) {
+        m_recording = false;
+        return;
+    }
+
+    size_t needed = (f.passes.size() + 1) * 2;
+    if (f.queries.size() < needed) {
+        size_t old = f.queries.size();
+        f.queries.resize(needed);
+        glGenQueries(static_cast<GLsizei>(needed - old), f.queries.data() + old);
+    }
+    glQueryCounter(f.queries[f.passes.size() * 2], GL_TIMESTAMP);
+    f.passes.push_back(pass);
+}
+
+void GpuProfiler::endSpan() {
+    if (m_depth == 0 || --m_depth > 0) return;
+    if (!m_recording) return;
+    m_recording = false;
+
+    FrameQueries& f = m_frames[m_frame];
+    glQueryCounter(f.queries[f.passes.size() * 2 - 1], GL_TIMESTAMP);
+}
+
+/**
+ * @brief Read a frame's timestamps if its last query is available.
+ *
+ * Timestamps complete in submission order, so one availability check on the
+ * final query covers the whole frame.
+ */
+void GpuProfiler::resolve(FrameQueries& f) {
+    size_t count = f.passes.size();
+    GLuint available = 0;
+    glGetQueryObjectuiv(f.queries[count * 2 - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return;
+
+    GpuPassTimes times;
+    for (size_t i = 0; i < count; ++i) {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(f.queries[i * 2], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(f.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+        if (end <= begin) continue;
+        times.ms[static_cast<int>(f.passes[i])] += static_cast<float>((end - begin) * 1e-6);
+        if (f.traced && Tracer::enabled()) {
+            Tracer::record(passName(f.passes[i]), static_cast<int64_t>(begin) + f.clockOffsetNs,
+                           static_cast<int64_t>(end - begin), true);
+        }
+    }
+    for (int p = 0; p < static_cast<int>(GpuPass::Count); ++p) {
+        times.spans[p] = f.spanCounts[p];
+        times.totalMs += times.ms[p];
+    }
+    times.valid = true;
+    m_latest = times;
+    f.pending = false;
+}
+
+}
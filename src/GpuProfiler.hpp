@@ -0,0 +1,119 @@
+/**
+ * @file GpuProfiler.hpp
+ * @brief Per-pass GPU timing with timestamp queries.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief GPU passes timed by GpuProfiler.
+ */
+enum class GpuPass : int {
+    KernelGen = 0,  // Kernel texture generation and normalization
+    SimStep,        // Simulation dispatches (each step, or each rule pass)
+    Obstacles,      // Wall/obstacle enforcement
+    Analysis,       // Statistics reduction
+    Render,         // State display (pyramid, post cache, fullscreen pass)
+    ImGui,          // UI draw data
+    Count
+};
+
+/**
+ * @brief GPU milliseconds per pass for one resolved frame.
+ */
+struct GpuPassTimes {
+    float ms[static_cast<int>(GpuPass::Count)]{};     // Time spent in each pass
+    int   spans[static_cast<int>(GpuPass::Count)]{};  // Number of times each pass ran
+    float totalMs{0.0f};
+    bool  valid{false};
+};
+
+/**
+ * @brief Records glQueryCounter timestamp pairs around GPU passes.
+ *
+ * Each frame gets its own set of query objects from a ring several frames
+ * deep; a frame is read back only once its last query is available, and
+ * dropped if it is still pending when its slot comes around again, so
+ * profiling never stalls the pipeline. Back-to-back spans of the same pass
+ * are merged into one timestamp pair to keep query counts low.
+ *
+ * Query objects are per-context, so each GL thread owns its profiler and
+ * makes it current for that thread; GpuPassScope records into the current
+ * one and does nothing when there is none.
+ *
+ * While the Tracer is recording, each frame also samples GL_TIMESTAMP
+ * against the CPU trace clock, and resolved spans are added to the trace
+ * on that clock.
+ */
+class GpuProfiler {
+public:
+    GpuProfiler() = default;
+    ~GpuProfiler() = default;
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    void beginFrame();
+    void endFrame();
+    void beginSpan(GpuPass pass);
+    void endSpan();
+    void release();
+
+    /** @brief Latest resolved frame (a few frames behind the current one). */
+    const GpuPassTimes& latest() const { return m_latest; }
+
+    static GpuProfiler* current();
+    static void makeCurrent(GpuProfiler* profiler);
+    static const char* passName(GpuPass pass);
+
+    static constexpr int MAX_SPANS = 1024;   // Per frame; extra spans are not timed
+    static constexpr int FRAME_LATENCY = 4;  // Frames in flight before results are read
+
+private:
+    struct FrameQueries {
+        std::vector<GLuint>  queries;  // Begin/end pairs, grown on demand
+        std::vector<GpuPass> passes;   // Pass of each recorded span
+        int  spanCounts[static_cast<int>(GpuPass::Count)]{};
+        bool pending{false};
+        bool traced{false};         // Spans go to the Tracer when resolved
+        int64_t clockOffsetNs{0};   // CPU trace clock minus GPU timestamp clock
+    };
+
+    FrameQueries m_frames[FRAME_LATENCY];
+    int          m_frame{0};
+    bool         m_inFrame{false};
+    int          m_depth{0};         // Open scopes; only the outermost is timed
+    bool         m_recording{false}; // Outermost scope got a timestamp pair
+    GpuPassTimes m_latest;
+
+    void resolve(FrameQueries& f);
+};
+
+/**
+ * @brief RAII span on the current thread's GpuProfiler.
+ *
+ * Only the outermost open scope is timed; nested scopes are ignored.
+ */
+class GpuPassScope {
+public:
+    explicit GpuPassScope(GpuPass pass) : m_profiler(GpuProfiler::current()) {
+        if (m_profiler) m_profiler->beginSpan(pass);
+    }
+    ~GpuPassScope() {
+        if (m_profiler) m_profiler->endSpan();
+    }
+
+    GpuPassScope(const GpuPassScope&) = delete;
+    GpuPassScope& operator=(const GpuPassScope&) = delete;
+
+private:
+    GpuProfiler* m_profiler;
+};
+
+}
@@ -0,0 +1,216 @@
+/**
+ * @file HeadlessContext.cpp
+ * @brief Implementation of the EGL surfaceless / hidden-window GL context.
+ */
+
+#include "HeadlessContext.hpp"
+#include "Utils/Logger.hpp"
+#include <glad/glad.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <dlfcn.h>
+#endif
+
+namespace lenia {
+
+#if defined(__linux__)
+// Minimal EGL 1.5 declarations, so the build needs no EGL headers and the
+// binary no libEGL unless headless mode is actually used
+namespace egl {
+using Display = void*;
+using Context = void*;
+using Config  = void*;
+using Int     = int32_t;
+using Enum    = unsigned int;
+using Boolean = unsigned int;
+
+constexpr Int  NONE                         = 0x3038;
+constexpr Int  RENDERABLE_TYPE              = 0x3040;
+constexpr Int  OPENGL_BIT                   = 0x0008;
+constexpr Enum OPENGL_API                   = 0x30A2;
+constexpr Int  CONTEXT_MAJOR_VERSION        = 0x3098;
+constexpr Int  CONTEXT_MINOR_VERSION        = 0x30FB;
+constexpr Int  CONTEXT_OPENGL_PROFILE_MASK  = 0x30FD;
+constexpr Int  CONTEXT_OPENGL_CORE_PROFILE_BIT = 0x0001;
+constexpr Enum PLATFORM_SURFACELESS_MESA    = 0x31DD;
+
+using GetProcAddressFn     = void* (*)(const char*);
+using GetPlatformDisplayFn = Display (*)(Enum, void*, const Int*);
+using GetDisplayFn         = Display (*)(void*);
+using InitializeFn         = Boolean (*)(Display, Int*, Int*);
+using TerminateFn          = Boolean (*)(Display);
+using BindAPIFn            = Boolean (*)(Enum);
+using ChooseConfigFn       = Boolean (*)(Display, const Int*, Config*, Int, Int*);
+using CreateContextFn      = Context (*)(Display, Config, Context, const Int*);
+using DestroyContextFn     = Boolean (*)(Display, Context);
+using MakeCurrentFn        = Boolean (*)(Display, void*, void*, Context);
+
+struct Api {
+    GetProcAddressFn getProcAddress{nullptr};
+    GetDisplayFn     getDisplay{nullptr};
+    InitializeFn     initialize{nullptr};
+    TerminateFn      terminate{nullptr};
+    BindAPIFn        bindAPI{nullptr};
+    ChooseConfigFn   chooseConfig{nullptr};
+    CreateContextFn  createContext{nullptr};
+    DestroyContextFn destroyContext{nullptr};
+    MakeCurrentFn    makeCurrent{nullptr};
+};
+
+static Api s_api;
+
+static void* eglLoader(const char* name) {
+    return s_api.getProcAddress(name);
+}
+}
+#endif
+
+HeadlessContext::~HeadlessContext() {
+    destroy();
+}
+
+bool HeadlessContext::create() {
+    if (!createEGL() && !createGLFW()) {
+        LOG_FATAL("Could not create an offscreen OpenGL 4.5 context.");
+        return false;
+    }
+
+    const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    const char* version  = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    LOG_INFO("Headless context: %s", m_backend);
+    LOG_INFO("GL Renderer: %s", renderer ? renderer : "(null)");
+    LOG_INFO("GL Version:  %s", version  ? version  : "(null)");
+    return true;
+}
+
+void HeadlessContext::destroy() {
+#if defined(__linux__)
+    if (m_eglContext) {
+        egl::s_api.makeCurrent(m_eglDisplay, nullptr, nullptr, nullptr);
+        egl::s_api.destroyContext(m_eglDisplay, m_eglContext);
+        m_eglContext = nullptr;
+    }
+    if (m_eglDisplay) {
+        egl::s_api.terminate(m_eglDisplay);
+        m_eglDisplay = nullptr;
+    }
+    if (m_eglLib) {
+        dlclose(m_eglLib);
+        m_eglLib = nullptr;
+    }
+#endif
+    if (m_window) {
+        glfwDestroyWindow(static_cast<GLFWwindow*>(m_window));
+        glfwTerminate();
+        m_window = nullptr;
+    }
+    m_backend = "";
+}
+
+/**
+ * @brief Surfaceless EGL context; fails quietly when EGL is unavailable.
+ */
+bool HeadlessContext::createEGL() {
+#if defined(__linux__)
+    m_eglLib = dlopen("libEGL.so.1", RTLD_NOW | RTLD_LOCAL);
+    if (!m_eglLib) {
+        LOG_WARN("libEGL.so.1 not found; falling back to a hidden window.");
+        return false;
+    }
+
+    auto& api = egl::s_api;
+    api.getProcAddress = reinterpret_cast<egl::GetProcAddressFn>(dlsym(m_eglLib, "eglGetProcAddress"));
+    api.getDisplay     = reinterpret_cast<egl::GetDisplayFn>(dlsym(m_eglLib, "eglGetDisplay"));
+    api.initialize     = reinterpret_cast<egl::InitializeFn>(dlsym(m_eglLib, "eglInitialize"));
+    api.terminate      = reinterpret_cast<egl::TerminateFn>(dlsym(m_eglLib, "eglTerminate"));
+    api.bindAPI        = reinterpret_cast<egl::BindAPIFn>(dlsym(m_eglLib, "eglBindAPI"));
+    api.chooseConfig   = reinterpret_cast<egl::ChooseConfigFn>(dlsym(m_eglLib, "eglChooseConfig"));
+    api.createContext  = reinterpret_cast<egl::CreateContextFn>(dlsym(m_eglLib, "eglCreateContext"));
+    api.destroyContext = reinterpret_cast<egl::DestroyContextFn>(dlsym(m_eglLib, "eglDestroyContext"));
+    api.makeCurrent    = reinterpret_cast<egl::MakeCurrentFn>(dlsym(m_eglLib, "eglMakeCurrent"));
+    if (!api.getProcAddress || !api.getDisplay || !api.initialize || !api.terminate || !api.bindAPI ||
+        !api.chooseConfig || !api.createContext || !api.destroyContext || !api.makeCurrent) {
+        LOG_WARN("libEGL is missing required entry points.");
+        destroy();
+        return false;
+    }
+
+    auto getPlatformDisplay = reinterpret_cast<egl::GetPlatformDisplayFn>(
+        api.getProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay)
+        m_eglDisplay = getPlatformDisplay(egl::PLATFORM_SURFACELESS_MESA, nullptr, nullptr);
+    if (!m_eglDisplay || !api.initialize(m_eglDisplay, nullptr, nullptr)) {
+        m_eglDisplay = api.getDisplay(nullptr);
+        if (!m_eglDisplay || !api.initialize(m_eglDisplay, nullptr, nullptr)) {
+            LOG_WARN("No usable EGL display.");
+            m_eglDisplay = nullptr;
+            destroy();
+            return false;
+        }
+    }
+    api.bindAPI(egl::OPENGL_API);
+
+    const egl::Int ctxAttribs[] = {
+        egl::CONTEXT_MAJOR_VERSION, 4,
+        egl::CONTEXT_MINOR_VERSION, 5,
+        egl::CONTEXT_OPENGL_PROFILE_MASK, egl::CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        egl::NONE
+    };
+    // Config-less contexts (EGL_KHR_no_config_context) first, then any GL config
+    m_eglContext = api.createContext(m_eglDisplay, nullptr, nullptr, ctxAttribs);
+    if (!m_eglContext) {
+        const egl::Int cfgAttribs[] = { egl::RENDERABLE_TYPE, egl::OPENGL_BIT, egl::NONE };
+        egl::Config config = nullptr;
+        egl::Int numConfigs = 0;
+        if (api.chooseConfig(m_eglDisplay, cfgAttribs, &config, 1, &numConfigs) && numConfigs > 0)
+            m_eglContext = api.createContext(m_eglDisplay, config, nullptr, ctxAttribs);
+    }
+    if (!m_eglContext || !api.makeCurrent(m_eglDisplay, nullptr, nullptr, m_eglContext)) {
+        LOG_WARN("EGL could not create a surfaceless OpenGL 4.5 core context.");
+        destroy();
+        return false;
+    }
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(egl::eglLoader))) {
+        LOG_ERROR("GLAD loader failed on the EGL context.");
+        destroy();
+        return false;
+    }
+    m_backend = "EGL surfaceless";
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool HeadlessContext::createGLFW() {
+    if (!glfwInit()) {
+        LOG_ERROR("GLFW initialisation failed (no display?).");
+        return false;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(1, 1, "Lenia Headless", nullptr, nullptr);
+    if (!window) {
+        LOG_ERROR("Could not create a hidden OpenGL 4.5 window.");
+        glfwTerminate();
+        return false;
+    }
+    m_window = window;
+    glfwMakeContextCurrent(window);
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
+        LOG_ERROR("GLAD loader failed on the hidden window.");
+        destroy();
+        return false;
+    }
+    m_backend = "GLFW hidden window";
+    return true;
+}
+
+}
@@ -0,0 +1,47 @@
+/**
+ * @file HeadlessContext.hpp
+ * @brief Offscreen OpenGL 4.5 context for running without a display.
+ */
+
+#pragma once
+
+namespace lenia {
+
+/**
+ * @brief Creates and owns a GL context that needs no window system.
+ *
+ * On Linux, EGL is loaded at runtime (libEGL.so.1) and a surfaceless
+ * context is created on the Mesa surfaceless platform, or on the default
+ * display if that platform is missing. This works on GPU-less hosts with
+ * Mesa's llvmpipe (set LIBGL_ALWAYS_SOFTWARE=1 to force it). Elsewhere, or
+ * when EGL is unavailable, a hidden GLFW window is used instead, which
+ * does need a display.
+ *
+ * The context is current on the creating thread and GLAD is loaded.
+ */
+class HeadlessContext {
+public:
+    HeadlessContext() = default;
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    bool create();
+    void destroy();
+
+    /** @brief "EGL surfaceless", "GLFW hidden window", or "" before create(). */
+    const char* backend() const { return m_backend; }
+
+private:
+    void*       m_eglLib{nullptr};
+    void*       m_eglDisplay{nullptr};
+    void*       m_eglContext{nullptr};
+    void*       m_window{nullptr};      // GLFWwindow when using the GLFW fallback
+    const char* m_backend{""};
+
+    bool createEGL();
+    bool createGLFW();
+};
+
+}
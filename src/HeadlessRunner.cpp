@@ -0,0 +1,641 @@
+/**
+ * @file HeadlessRunner.cpp
+ * @brief Implementation of the windowless command-line simulation mode.
+ */
+
+#include "HeadlessRunner.hpp"
+#include "BatchSimulation.hpp"
+#include "FrameRecorder.hpp"
+#include "Presets.hpp"
+#include "SpeciesAtlas.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/NpyLoader.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace lenia {
+
+bool HeadlessRunner::wantsHeadless(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i)
+        if (std::strcmp(argv[i], "--headless") == 0) return true;
+    return false;
+}
+
+void HeadlessRunner::printUsage() {
+    std::printf(
+        "Usage: Lenia --headless [options]\n"
+        "  --preset <index|name>  Preset to load (default 0)\n"
+        "  --grid <W>x<H>         Override the preset grid size\n"
+        "  --tile <n>             Store grids larger than n cells per side as tiles\n"
+        "  --in-place             Update a single state texture in bands (less memory)\n"
+        "  --steps <n>            Steps to simulate (default 1000)\n"
+        "  --batch <n>            Steps per GPU submission (default 50)\n"
+        "  --assets <dir>         Asset directory (default assets)\n"
+        "  --out <file.npy>       Save the final state\n"
+        "  --checkpoint <file>    Write a checkpoint (state, walls, parameters) at the end\n"
+        "  --checkpoint-every <n> Also rewrite it every n steps\n"
+        "  --restore <file>       Start from a checkpoint; its grid and parameters replace the preset's\n"
+        "  --record <dir|file.y4m> Record frames as a PNG sequence, or a Y4M video\n"
+        "  --record-every <n>     Steps between recorded frames (default 1)\n"
+        "  --record-source <s>    state, potential or growth (default state)\n"
+        "  --trajectory <dir>     Stream fields every K steps to <dir>/<field>.npy, shape (T, H, W[, 3])\n"
+        "  --trajectory-every <k> Steps between trajectory frames (default 10)\n"
+        "  --trajectory-fields <list>  Comma-separated state, potential, growth (default state)\n"
+        "  --trajectory-roi <x,y,w,h>  Region of interest in cells (default whole grid)\n"
+        "  --trajectory-downsample <n> Average n x n cells per value (default 1)\n"
+        "  --trajectory-bits <8|16|32> Quantize to uint8/uint16, or keep float32 (default)\n"
+        "  --export <file.npz|dir> Save the final fields as one archive, or one .npy each\n"
+        "  --export-fields <list> Comma-separated state, walls, potential, growth, creature (default all)\n"
+        "  --export-threshold <v> Creature cells: state above v (default 0.1)\n"
+        "  --stats <file.csv>     Write analysis statistics\n"
+        "  --stats-every <n>      Steps between statistics rows (default 100)\n"
+        "  --sweep-mu <a:b:n>     Run n universes with mu from a to b as one batch\n"
+        "  --sweep-sigma <a:b:n>  Same for sigma; combined with --sweep-mu as a grid\n"
+        "  --seed <n>             Noise seed of batch universes and searches (default 1)\n"
+        "  --field <p:axis:a:b[:n]>  Vary p (mu, sigma or dt) from a to b along x or y across\n"
+        "                         the grid, in n constant tiles if given; repeatable\n"
+        "  --search <strategy>    Parameter search: grid, random or evolve\n"
+        "  --range <p:a:b[:n]>    Search p from a to b (n grid values, default 5); repeatable.\n"
+        "                         p: mu, sigma, dt, radius, ring<j>, rule<i>.mu|sigma|strength|radius|ring<j>\n"
+        "  --budget <n>           Candidates to evaluate (default 200), --steps each at most\n"
+        "  --population <n>       Candidates per evolve generation (default 16)\n"
+        "  --search-log <file>    Per-candidate log (default search_log.csv)\n"
+        "  --ranked <file>        Results by score (default search_ranked.csv)\n"
+        "  --resume               Continue the search recorded in the log\n"
+        "  --list-presets         Print preset indices and names\n"
+        "Set LIBGL_ALWAYS_SOFTWARE=1 to force Mesa's software rasterizer.\n");
+}
+
+static bool parsePositive(const char* text, int& out) {
+    char* end = nullptr;
+    long v = std::strtol(text, &end, 10);
+    if (!end || *end != '\0' || v <= 0 || v > 1000000000L) return false;
+    out = static_cast<int>(v);
+    return true;
+}
+
+/**
+ * @brief "a:b:n" as n evenly spaced values from a to b, or a single "a".
+ */
+static bool parseRange(const std::string& text, std::vector<float>& out) {
+    out.clear();
+    float lo = 0.0f, hi = 0.0f;
+    int n = 0;
+    char tail = 0;
+    if (std::sscanf(text.c_str(), "%f:%f:%d%c", &lo, &hi, &n, &tail) == 3 && n >= 1 && n <= 65536) {
+        for (int i = 0; i < n; ++i)
+            out.push_back(n == 1 ? lo : lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(n - 1));
+        return true;
+    }
+    if (std::sscanf(text.c_str(), "%f%c", &lo, &tail) == 1) {
+        out.push_back(lo);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief "name:min:max" or "name:min:max:count" for --range.
+ */
+static bool parseSearchRange(const std::string& text, SearchRange& out) {
+    size_t colon = text.find(':');
+    if (colon == std::string::npos) return false;
+    out.name = text.substr(0, colon);
+    if (!ParameterSearch::isKnownParam(out.name)) return false;
+
+    char tail = 0;
+    int fields = std::sscanf(text.c_str() + colon + 1, "%f:%f:%d%c", &out.min, &out.max, &out.count, &tail);
+    return (fields == 2 || fields == 3) && out.count >= 1 && out.count <= 65536;
+}
+
+/**
+ * @brief "param:axis:from:to" or "param:axis:from:to:tiles" for --field.
+ */
+static bool parseField(const std::string& text, FieldSpec& out) {
+    char name[16] = {0};
+    char axis = 0;
+    char tail = 0;
+    out.tiles = 0;
+    int fields = std::sscanf(text.c_str(), "%15[a-z]:%c:%f:%f:%d%c",
+                             name, &axis, &out.from, &out.to, &out.tiles, &tail);
+    if (fields != 4 && fields != 5) return false;
+    if (fields == 5 && out.tiles < 1) return false;
+    if (axis != 'x' && axis != 'y') return false;
+    out.axis = (axis == 'x') ? 0 : 1;
+
+    std::string param = name;
+    if      (param == "mu")    out.param = FieldParam::Mu;
+    else if (param == "sigma") out.param = FieldParam::Sigma;
+    else if (param == "dt")    out.param = FieldParam::Dt;
+    else return false;
+    return true;
+}
+
+/**
+ * @brief Parse options; prints the problem and returns false on bad input.
+ */
+bool HeadlessRunner::parseArgs(int argc, char** argv, HeadlessOptions& out) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        auto needValue = [&]() {
+            if (!value) std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return value != nullptr;
+        };
+
+        bool ok = true;
+        if (arg == "--headless") {
+            continue;
+        } else if (arg == "--list-presets") {
+            out.listPresets = true;
+            continue;
+        } else if (arg == "--help" || arg == "-h") {
+            out.showHelp = true;
+            continue;
+        } else if (arg == "--preset") {
+            if (!needValue()) return false;
+            out.preset = value;
+        } else if (arg == "--grid") {
+            if (!needValue()) return false;
+            ok = std::sscanf(value, "%dx%d", &out.gridW, &out.gridH) == 2 &&
+                 out.gridW > 0 && out.gridH > 0;
+        } else if (arg == "--tile") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.tileSize);
+        } else if (arg == "--in-place") {
+            out.inPlace = true;
+            continue;
+        } else if (arg == "--steps") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.steps);
+        } else if (arg == "--batch") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.batch);
+        } else if (arg == "--assets") {
+            if (!needValue()) return false;
+            out.assetDir = value;
+        } else if (arg == "--out") {
+            if (!needValue()) return false;
+            out.statePath = value;
+        } else if (arg == "--checkpoint") {
+            if (!needValue()) return false;
+            out.checkpointPath = value;
+        } else if (arg == "--checkpoint-every") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.checkpointEvery);
+        } else if (arg == "--restore") {
+            if (!needValue()) return false;
+            out.restorePath = value;
+        } else if (arg == "--record") {
+            if (!needValue()) return false;
+            out.recordPath = value;
+        } else if (arg == "--record-every") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.recordEvery);
+        } else if (arg == "--record-source") {
+            if (!needValue()) return false;
+            std::string source = value;
+            if      (source == "state")     out.recordSource = static_cast<int>(RecordSource::State);
+            else if (source == "potential") out.recordSource = static_cast<int>(RecordSource::Potential);
+            else if (source == "growth")    out.recordSource = static_cast<int>(RecordSource::Growth);
+            else ok = false;
+        } else if (arg == "--trajectory") {
+            if (!needValue()) return false;
+            out.trajectory.dir = value;
+        } else if (arg == "--trajectory-every") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.trajectory.every);
+        } else if (arg == "--trajectory-fields") {
+            if (!needValue()) return false;
+            out.trajectory.fields = 0;
+            std::stringstream list(value);
+            std::string name;
+            while (ok && std::getline(list, name, ',')) {
+                if      (name == "state")     out.trajectory.fields |= TRAJ_STATE;
+                else if (name == "potential") out.trajectory.fields |= TRAJ_POTENTIAL;
+                else if (name == "growth")    out.trajectory.fields |= TRAJ_GROWTH;
+                else ok = false;
+            }
+            ok = ok && out.trajectory.fields != 0;
+        } else if (arg == "--trajectory-roi") {
+            if (!needValue()) return false;
+            TrajectoryOptions& t = out.trajectory;
+            ok = std::sscanf(value, "%d,%d,%d,%d", &t.roiX, &t.roiY, &t.roiW, &t.roiH) == 4 &&
+                 t.roiX >= 0 && t.roiY >= 0 && t.roiW > 0 && t.roiH > 0;
+        } else if (arg == "--trajectory-downsample") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.trajectory.downsample);
+        } else if (arg == "--trajectory-bits") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.trajectory.bits) &&
+                 (out.trajectory.bits == 8 || out.trajectory.bits == 16 || out.trajectory.bits == 32);
+        } else if (arg == "--export") {
+            if (!needValue()) return false;
+            out.exportPath = value;
+        } else if (arg == "--export-fields") {
+            if (!needValue()) return false;
+            out.exportOptions.fields = 0;
+            std::stringstream list(value);
+            std::string name;
+            while (ok && std::getline(list, name, ',')) {
+                if      (name == "state")     out.exportOptions.fields |= EXPORT_STATE;
+                else if (name == "walls")     out.exportOptions.fields |= EXPORT_WALLS;
+                else if (name == "potential") out.exportOptions.fields |= EXPORT_POTENTIAL;
+                else if (name == "growth")    out.exportOptions.fields |= EXPORT_GROWTH;
+                else if (name == "creature")  out.exportOptions.fields |= EXPORT_CREATURE;
+                else ok = false;
+            }
+            ok = ok && out.exportOptions.fields != 0;
+        } else if (arg == "--export-threshold") {
+            if (!needValue()) return false;
+            char tail = 0;
+            ok = std::sscanf(value, "%f%c", &out.exportOptions.threshold, &tail) == 1;
+        } else if (arg == "--stats") {
+            if (!needValue()) return false;
+            out.statsPath = value;
+        } else if (arg == "--stats-every") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.statsEvery);
+        } else if (arg == "--sweep-mu" || arg == "--sweep-sigma") {
+            if (!needValue()) return false;
+            std::vector<float> values;
+            ok = parseRange(value, values);
+            (arg == "--sweep-mu" ? out.sweepMu : out.sweepSigma) = value;
+        } else if (arg == "--seed") {
+            if (!needValue()) return false;
+            int seed = 0;
+            ok = parsePositive(value, seed) || std::strcmp(value, "0") == 0;
+            out.seed = static_cast<uint32_t>(seed);
+            out.search.seed = out.seed;
+        } else if (arg == "--field") {
+            if (!needValue()) return false;
+            FieldSpec field;
+            ok = parseField(value, field);
+            if (ok) out.fields.push_back(field);
+        } else if (arg == "--search") {
+            if (!needValue()) return false;
+            std::string strategy = value;
+            out.runSearch = true;
+            if      (strategy == "grid")   out.search.strategy = SearchStrategy::Grid;
+            else if (strategy == "random") out.search.strategy = SearchStrategy::Random;
+            else if (strategy == "evolve") out.search.strategy = SearchStrategy::Evolve;
+            else ok = false;
+        } else if (arg == "--range") {
+            if (!needValue()) return false;
+            SearchRange range;
+            ok = parseSearchRange(value, range);
+            if (ok) out.search.ranges.push_back(range);
+        } else if (arg == "--budget") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.search.budget);
+        } else if (arg == "--population") {
+            if (!needValue()) return false;
+            ok = parsePositive(value, out.search.population);
+        } else if (arg == "--search-log") {
+            if (!needValue()) return false;
+            out.search.logPath = value;
+        } else if (arg == "--ranked") {
+            if (!needValue()) return false;
+            out.search.rankedPath = value;
+        } else if (arg == "--resume") {
+            out.search.resume = true;
+            continue;
+        } else {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        }
+
+        if (!ok) {
+            std::fprintf(stderr, "Invalid value for %s: %s\n", arg.c_str(), value);
+            return false;
+        }
+        ++i;
+    }
+    return true;
+}
+
+/**
+ * @brief Preset index from a number or a case-insensitive name, -1 if none.
+ */
+int HeadlessRunner::findPreset(const std::string& nameOrIndex) {
+    const auto& presets = getPresets();
+    int index = 0;
+    if (parsePositive(nameOrIndex.c_str(), index) || nameOrIndex == "0") {
+        return index < static_cast<int>(presets.size()) ? index : -1;
+    }
+
+    auto lower = [](std::string s) {
+        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+        return s;
+    };
+    std::string wanted = lower(nameOrIndex);
+    for (int i = 0; i < static_cast<int>(presets.size()); ++i)
+        if (lower(presets[i].name) == wanted) return i;
+    return -1;
+}
+
+/**
+ * @brief Read back the state as (H, W) or (H, W, channels) float32.
+ */
+bool HeadlessRunner::saveState(const std::string& path) {
+    const TiledState& tiles = m_engine.tiles();
+    if (tiles.active()) {
+        // Full resolution, not the overview the snapshot holds
+        std::vector<float> data(static_cast<size_t>(tiles.width()) * tiles.height());
+        tiles.readRegion(0, 0, tiles.width(), tiles.height(), data.data());
+        return saveNpy(path, data.data(), tiles.height(), tiles.width(), 1);
+    }
+
+    StateSnapshot snap = m_engine.snapshot();
+    size_t cells = static_cast<size_t>(snap.gridW) * snap.gridH;
+
+    if (snap.format != GL_RGBA32F) {
+        std::vector<float> data(cells);
+        glGetTextureImage(snap.stateTex, 0, GL_RED, GL_FLOAT,
+                          static_cast<GLsizei>(data.size() * sizeof(float)), data.data());
+        return saveNpy(path, data.data(), snap.gridH, snap.gridW, 1);
+    }
+
+    std::vector<float> rgba(cells * 4);
+    glGetTextureImage(snap.stateTex, 0, GL_RGBA, GL_FLOAT,
+                      static_cast<GLsizei>(rgba.size() * sizeof(float)), rgba.data());
+    int channels = std::clamp(m_params.numChannels, 1, 3);
+    std::vector<float> data(cells * channels);
+    for (size_t i = 0; i < cells; ++i)
+        for (int c = 0; c < channels; ++c)
+            data[i * channels + c] = rgba[i * 4 + c];
+    return saveNpy(path, data.data(), snap.gridH, snap.gridW, channels);
+}
+
+int HeadlessRunner::run(const HeadlessOptions& opts) {
+    if (opts.showHelp) {
+        printUsage();
+        return EXIT_SUCCESS;
+    }
+    if (opts.listPresets) {
+        const auto& presets = getPresets();
+        for (int i = 0; i < static_cast<int>(presets.size()); ++i)
+            std::printf("%3d  %-12s  %s\n", i, presets[i].category, presets[i].name);
+        return EXIT_SUCCESS;
+    }
+
+    int presetIndex = findPreset(opts.preset);
+    if (presetIndex < 0) {
+        LOG_FATAL("Unknown preset: %s (use --list-presets)", opts.preset.c_str());
+        return EXIT_FAILURE;
+    }
+
+    if (!m_context.create()) return EXIT_FAILURE;
+    if (!opts.sweepMu.empty() || !opts.sweepSigma.empty()) return runSweep(opts, presetIndex);
+    if (!m_engine.init(opts.assetDir)) {
+        LOG_FATAL("Engine initialisation failed.");
+        return EXIT_FAILURE;
+    }
+
+    m_params.tileSize = opts.tileSize;
+    m_params.inPlaceUpdate = opts.inPlace;
+    m_engine.applyPreset(presetIndex, m_params);
+    if (opts.gridW > 0 && opts.gridH > 0) {
+        m_params.gridW = opts.gridW;
+        m_params.gridH = opts.gridH;
+        m_engine.resizeGrid(m_params);
+        m_engine.regenerateKernel(m_params);
+    }
+    if (opts.runSearch) {
+        LOG_INFO("Parameter search around preset %d (%s), %dx%d",
+                 presetIndex, getPresets()[presetIndex].name, m_params.gridW, m_params.gridH);
+        return ParameterSearch(m_engine).run(opts.search, m_params, opts.steps);
+    }
+    m_engine.reset(m_params);
+    if (!opts.restorePath.empty() && !m_engine.loadCheckpoint(opts.restorePath, m_params)) {
+        LOG_FATAL("Cannot restore checkpoint: %s", opts.restorePath.c_str());
+        return EXIT_FAILURE;
+    }
+    if (!opts.fields.empty() && (m_engine.tiles().active() || m_params.infiniteWorldMode)) {
+        LOG_WARN("Parameter maps only apply to grids in a single texture; --field ignored on this %s grid.",
+                 m_params.infiniteWorldMode ? "infinite" : "tiled");
+    } else if (!opts.fields.empty()) {
+        // Multi-channel grids get the same map on every channel
+        ParameterField& field = m_engine.parameterField();
+        int channels = (m_params.numKernelRules > 0) ? ParameterField::MAX_CHANNELS : 1;
+        for (const FieldSpec& f : opts.fields) {
+            for (int c = 0; c < channels; ++c) {
+                if (f.tiles > 0) field.fillTiles(f.param, c, f.from, f.to, f.tiles, f.axis);
+                else             field.fillGradient(f.param, c, f.from, f.to, f.axis);
+            }
+        }
+    }
+    LOG_INFO("Headless run: preset %d (%s), %dx%d, %d steps",
+             presetIndex, getPresets()[presetIndex].name, m_params.gridW, m_params.gridH, opts.steps);
+
+    std::ofstream stats;
+    if (!opts.statsPath.empty()) {
+        stats.open(opts.statsPath, std::ios::out | std::ios::trunc);
+        if (!stats.is_open()) {
+            LOG_FATAL("Cannot write statistics file: %s", opts.statsPath.c_str());
+            return EXIT_FAILURE;
+        }
+        stats << "step,mass,alive,centroidX,centroidY,speed,direction,stabilized,empty\n";
+    }
+
+    int checkpointEvery = opts.checkpointPath.empty() ? 0 : opts.checkpointEvery;
+    FrameRecorder recorder;
+    if (!opts.recordPath.empty()) {
+        bool y4m = opts.recordPath.size() > 4 && opts.recordPath.compare(opts.recordPath.size() - 4, 4, ".y4m") == 0;
+        if (!recorder.start(opts.recordPath, y4m ? RecordFormat::Y4m : RecordFormat::Png, opts.recordEvery))
+            return EXIT_FAILURE;
+        m_params.recordVideo = true;
+        m_params.recordSource = opts.recordSource;
+    }
+    auto record = [&]() {
+        if (!recorder.due(m_engine.stepCount())) return;
+        StateSnapshot snap = m_engine.snapshot();
+        auto source = static_cast<RecordSource>(opts.recordSource);
+        GLuint tex = (source == RecordSource::Potential) ? snap.neighborSumsTex :
+                     (source == RecordSource::Growth)    ? snap.growthTex : snap.stateTex;
+        recorder.captureTexture(tex, snap.gridW, snap.gridH, snap.format == GL_RGBA32F,
+                                source == RecordSource::Growth ? -1.0f : 0.0f, 1.0f, snap.stepCount);
+    };
+    if (recorder.recording() && opts.recordSource == static_cast<int>(RecordSource::State)) record();
+
+    TrajectoryWriter trajectory;
+    if (!opts.exportPath.empty())
+        m_params.keepDebugFields = (opts.exportOptions.fields & (EXPORT_POTENTIAL | EXPORT_GROWTH)) != 0;
+    if (!opts.trajectory.dir.empty()) {
+        m_params.keepDebugFields |= (opts.trajectory.fields & (TRAJ_POTENTIAL | TRAJ_GROWTH)) != 0;
+        TrajectoryOptions trajectoryOptions = opts.trajectory;
+        trajectoryOptions.potentialHi = m_engine.potentialBound(m_params);
+        trajectoryOptions.growthHi = m_engine.growthBound(m_params);
+        if (!trajectory.start(trajectoryOptions, m_engine.snapshot())) return EXIT_FAILURE;
+        trajectory.capture(m_engine.snapshot());
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    int done = 0;
+    while (done < opts.steps) {
+        int n = std::min(opts.batch, opts.steps - done);
+        if (stats.is_open()) n = std::min(n, opts.statsEvery - done % opts.statsEvery);
+        if (checkpointEvery > 0) n = std::min(n, checkpointEvery - done % checkpointEvery);
+        if (recorder.recording()) n = std::min(n, opts.recordEvery - done % opts.recordEvery);
+        if (trajectory.recording()) n = std::min(n, opts.trajectory.every - done % opts.trajectory.every);
+
+        if (m_params.numKernelRules > 0) m_engine.updateMultiChannel(m_params, n);
+        else                             m_engine.update(m_params, n);
+        done += n;
+
+        m_engine.pollCheckpoint();
+        if (recorder.recording()) record();
+        if (trajectory.due(m_engine.stepCount())) trajectory.capture(m_engine.snapshot());
+        if (checkpointEvery > 0 && done % checkpointEvery == 0 && done < opts.steps)
+            m_engine.saveCheckpoint(opts.checkpointPath, m_params);
+
+        if (stats.is_open() && (done % opts.statsEvery == 0 || done == opts.steps)) {
+            m_engine.runAnalysis(m_params.analysisThreshold);
+            const AnalysisData& a = m_engine.analysisData();
+            const AnalysisManager& mgr = m_engine.analysisMgr();
+            stats << done << ',' << a.totalMass << ',' << a.aliveCount << ','
+                  << a.centroidX << ',' << a.centroidY << ','
+                  << mgr.movementSpeed() << ',' << mgr.movementDirection() << ','
+                  << (mgr.isStabilized() ? 1 : 0) << ',' << (mgr.isEmpty() ? 1 : 0) << '\n';
+        }
+    }
+    glFinish();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    double cellsPerSec = static_cast<double>(m_params.gridW) * m_params.gridH * opts.steps / std::max(seconds, 1e-9);
+    LOG_INFO("Simulated %d steps in %.3f s (%.1f steps/s, %.2f Mcells/s)",
+             opts.steps, seconds, opts.steps / std::max(seconds, 1e-9), cellsPerSec / 1e6);
+
+    recorder.stop();
+    trajectory.stop();
+    if (!opts.statePath.empty() && !saveState(opts.statePath)) return EXIT_FAILURE;
+    if (!opts.checkpointPath.empty()) {
+        m_engine.pollCheckpoint(true);
+        if (!m_engine.saveCheckpoint(opts.checkpointPath, m_params)) return EXIT_FAILURE;
+        m_engine.pollCheckpoint(true);
+        if (!m_engine.checkpointSucceeded()) return EXIT_FAILURE;
+    }
+    if (!opts.exportPath.empty()) {
+        if (!m_engine.exportFields(opts.exportPath, opts.exportOptions, m_params)) return EXIT_FAILURE;
+        m_engine.pollExport(true);
+        if (!m_engine.exportSucceeded()) return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Run the preset as one batch of universes over a mu x sigma grid.
+ *
+ * Universes default to 128x128 (--grid overrides) and start from the
+ * preset's species pattern when it has one, otherwise from seeded noise.
+ */
+int HeadlessRunner::runSweep(const HeadlessOptions& opts, int presetIndex) {
+    const Preset& preset = getPresets()[presetIndex];
+    std::vector<float> mus{preset.mu}, sigmas{preset.sigma};
+    if (!opts.sweepMu.empty()) parseRange(opts.sweepMu, mus);
+    if (!opts.sweepSigma.empty()) parseRange(opts.sweepSigma, sigmas);
+
+    int gridW = opts.gridW > 0 ? opts.gridW : 128;
+    int gridH = opts.gridH > 0 ? opts.gridH : 128;
+    int count = static_cast<int>(mus.size() * sigmas.size());
+
+    KernelConfig kernel;
+    kernel.radius     = preset.radius;
+    kernel.numRings   = preset.numRings;
+    kernel.kernelType = static_cast<int>(preset.kernelType);
+    for (int i = 0; i < 16; ++i) kernel.ringWeights[i] = preset.ringWeights[i];
+
+    BatchSimulation batch;
+    if (!batch.init(opts.assetDir + "/shaders/") || !batch.setKernels({kernel}) ||
+        !batch.allocate(gridW, gridH, count)) {
+        LOG_FATAL("Batch initialisation failed.");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<BatchUniverseParams> params(count);
+    for (int i = 0; i < count; ++i) {
+        params[i].mu         = mus[i / sigmas.size()];
+        params[i].sigma      = sigmas[i % sigmas.size()];
+        params[i].dt         = preset.dt;
+        params[i].growthType = static_cast<int>(preset.growthType);
+        params[i].param1     = preset.initParam1;
+        params[i].param2     = preset.initParam2;
+    }
+    batch.setParams(params);
+
+    NpyArray pattern;
+    if (preset.cellData && preset.cellRows > 0 && preset.cellCols > 0) {
+        pattern.rows = preset.cellRows;
+        pattern.cols = preset.cellCols;
+        pattern.data.assign(preset.cellData, preset.cellData + pattern.rows * pattern.cols);
+    } else if (preset.speciesFile) {
+        // Same decoding as the engine's species library: .npy or a catalog reference
+        std::string path = std::string("Initialisation/") + preset.speciesFile;
+        if (!SpeciesAtlas::decode(path, pattern.data, pattern.rows, pattern.cols)) {
+            LOG_WARN("Cannot load species %s; universes start from noise.", path.c_str());
+            pattern.data.clear();
+        }
+    }
+    if (!pattern.data.empty()) {
+        for (int i = 0; i < count; ++i)
+            batch.uploadPattern(i, pattern.data.data(), pattern.rows, pattern.cols);
+    } else {
+        batch.seedRandom(opts.seed);
+    }
+
+    LOG_INFO("Batch sweep: preset %d (%s), %d universes (%zu mu x %zu sigma) of %dx%d, %d steps",
+             presetIndex, preset.name, count, mus.size(), sigmas.size(), gridW, gridH, opts.steps);
+
+    std::ofstream stats;
+    if (!opts.statsPath.empty()) {
+        stats.open(opts.statsPath, std::ios::out | std::ios::trunc);
+        if (!stats.is_open()) {
+            LOG_FATAL("Cannot write statistics file: %s", opts.statsPath.c_str());
+            return EXIT_FAILURE;
+        }
+        stats << "step,universe,mu,sigma,mass,alive,centroidX,centroidY,maxValue\n";
+    }
+    auto writeStats = [&](int step) {
+        const auto& st = batch.computeStats(0.01f);
+        for (int i = 0; i < count; ++i) {
+            stats << step << ',' << i << ',' << params[i].mu << ',' << params[i].sigma << ','
+                  << st[i].totalMass << ',' << st[i].aliveCount << ',' << st[i].centroidX << ','
+                  << st[i].centroidY << ',' << st[i].maxVal << '\n';
+        }
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    int done = 0;
+    while (done < opts.steps) {
+        int n = std::min(opts.batch, opts.steps - done);
+        if (stats.is_open()) n = std::min(n, opts.statsEvery - done % opts.statsEvery);
+        batch.step(n);
+        done += n;
+        if (stats.is_open() && (done % opts.statsEvery == 0 || done == opts.steps)) writeStats(done);
+    }
+    glFinish();
+    double seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(), 1e-9);
+    double cells = static_cast<double>(gridW) * gridH * count * opts.steps;
+    LOG_INFO("Simulated %d x %d universe steps in %.3f s (%.1f universe-steps/s, %.2f Mcells/s)",
+             count, opts.steps, seconds, count * opts.steps / seconds, cells / seconds / 1e6);
+
+    const auto& finalStats = batch.computeStats(0.01f);
+    int alive = 0;
+    for (const auto& st : finalStats) alive += st.aliveCount > 0 ? 1 : 0;
+    LOG_INFO("%d of %d universes still alive.", alive, count);
+
+    if (!opts.statePath.empty()) {
+        std::vector<float> layers;
+        // Written as shape (universes, H, W)
+        if (!batch.readLayers(layers) || !saveNpy(opts.statePath, layers.data(), count, gridH, gridW))
+            return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+}
@@ -0,0 +1,97 @@
+/**
+ * @file HeadlessRunner.hpp
+ * @brief Command-line simulation without a window or UI.
+ */
+
+#pragma once
+
+#include "HeadlessContext.hpp"
+#include "LeniaEngine.hpp"
+#include "ParameterSearch.hpp"
+#include "TrajectoryWriter.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief A --field option: one parameter map filled over the grid.
+ */
+struct FieldSpec {
+    FieldParam param{FieldParam::Mu};
+    int   axis{0};           // 0 = x, 1 = y
+    float from{0.0f};
+    float to{0.0f};
+    int   tiles{0};          // 0 = continuous gradient
+};
+
+/**
+ * @brief Options of a headless run, parsed from the command line.
+ */
+struct HeadlessOptions {
+    std::string preset{"0"};       // Preset index or name
+    int         gridW{0};          // Grid override, 0 keeps the preset size
+    int         gridH{0};
+    int         tileSize{0};       // Tile grids larger than this (0 = only past the texture limit)
+    bool        inPlace{false};    // One state texture updated in bands
+    int         steps{1000};       // Total steps to simulate
+    int         batch{50};         // Steps per engine update call
+    std::string assetDir{"assets"};
+    std::string statePath;         // Final state as .npy, empty = not saved
+    std::string statsPath;         // Analysis CSV, empty = not written
+    std::string checkpointPath;    // Checkpoint written at the end, empty = none
+    int         checkpointEvery{0};// Steps between intermediate checkpoints, 0 = only at the end
+    std::string restorePath;       // Checkpoint to start from instead of the preset state
+    std::string recordPath;        // PNG directory or .y4m file, empty = not recorded
+    int         recordEvery{1};    // Steps between recorded frames
+    int         recordSource{1};   // RecordSource: State, Potential or Growth
+    TrajectoryOptions trajectory;  // Field time series, written when trajectory.dir is set
+    std::string exportPath;        // Final fields as .npz or a directory of .npy, empty = none
+    ExportOptions exportOptions;
+    int         statsEvery{100};   // Steps between CSV rows
+    std::string sweepMu;           // "min:max:count" runs a batch of universes
+    std::string sweepSigma;        // Same for sigma; the grid is mu x sigma
+    uint32_t    seed{1};           // Noise seed of batch universes and of the search
+    std::vector<FieldSpec> fields; // Per-cell parameter maps (--field)
+    bool        runSearch{false};  // Set by --search: explore search.ranges instead
+    SearchOptions search;
+    bool        listPresets{false};
+    bool        showHelp{false};
+};
+
+/**
+ * @brief Drives LeniaEngine directly on an offscreen context.
+ *
+ * Started with `Lenia --headless [options]`; see printUsage(). Intended for
+ * batch servers and CI, including GPU-less hosts using Mesa's llvmpipe.
+ * With --sweep-mu / --sweep-sigma the preset is instead run as a batch of
+ * small universes (BatchSimulation), one per parameter pair, and with
+ * --search it drives a ParameterSearch over the given --range options.
+ */
+class HeadlessRunner {
+public:
+    HeadlessRunner() = default;
+    ~HeadlessRunner() = default;
+
+    HeadlessRunner(const HeadlessRunner&) = delete;
+    HeadlessRunner& operator=(const HeadlessRunner&) = delete;
+
+    static bool wantsHeadless(int argc, char** argv);
+    static bool parseArgs(int argc, char** argv, HeadlessOptions& out);
+    static void printUsage();
+
+    /** @brief Run to completion; returns the process exit code. */
+    int run(const HeadlessOptions& opts);
+
+private:
+    HeadlessContext m_context;   // Declared first: outlives the engine's GL objects
+    LeniaEngine     m_engine;
+    LeniaParams     m_params;
+
+    static int  findPreset(const std::string& nameOrIndex);
+    bool saveState(const std::string& path);
+    int  runSweep(const HeadlessOptions& opts, int presetIndex);
+};
+
+}
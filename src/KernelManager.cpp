@@ -4,43 +4,110 @@
  */
 
 #include "KernelManager.hpp"
+#include "GpuProfiler.hpp"
 #include "Utils/GLUtils.hpp"
+#include "Utils/Trace.hpp"
+#include <cstddef>
 #include <cstring>
 
 namespace lenia {
 
-KernelManager::~KernelManager() {
-    destroyTexture();
-    if (m_ubo) glDeleteBuffers(1, &m_ubo);
+/** @brief GoL kernel is always 3x3, others use 2*radius. */
+static int kernelDiameter(const KernelConfig& cfg) {
+    return cfg.kernelType == 4 ? 3 : cfg.radius * 2;
 }
 
-bool KernelManager::init(const std::string& shaderPath) {
-    if (!m_shader.loadCompute(shaderPath)) return false;
-    ensureUBO();
-    return true;
+KernelCache::~KernelCache() {
+    for (auto& e : m_entries)
+        glDeleteTextures(1, &e.texture);
+    if (m_ubo) glDeleteBuffers(1, &m_ubo);
+    if (m_sumBuffer) glDeleteBuffers(1, &m_sumBuffer);
 }
 
-void KernelManager::ensureUBO() {
+bool KernelCache::init(const std::string& shaderDir) {
+    if (!m_shader.loadCompute(shaderDir + "kernel_gen.comp")) return false;
+    if (!m_normalizeShader.loadCompute(shaderDir + "kernel_normalize.comp")) return false;
     if (!m_ubo) {
         glCreateBuffers(1, &m_ubo);
         glNamedBufferStorage(m_ubo, sizeof(GPUKernelParams), nullptr, GL_DYNAMIC_STORAGE_BIT);
     }
+    if (!m_sumBuffer) {
+        glCreateBuffers(1, &m_sumBuffer);
+        glNamedBufferStorage(m_sumBuffer, sizeof(float), nullptr, 0);
+    }
+    return true;
+}
+
+GLuint KernelCache::acquire(const KernelConfig& cfg, int& diameter) {
+    size_t hash = cfg.hash();
+    auto range = m_index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->config != cfg) continue;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        Entry& e = m_entries.front();
+        ++e.refs;
+        ++m_hits;
+        diameter = e.diameter;
+        return e.texture;
+    }
+
+    TRACE_GL_SCOPE("KernelCache::generate");
+    ++m_misses;
+    Entry e;
+    e.config = cfg;
+    e.hash = hash;
+    e.diameter = kernelDiameter(cfg);
+    e.texture = createTexture2D(e.diameter, e.diameter, GL_R32F);
+    e.refs = 1;
+    render(cfg, e.texture, e.diameter);
+    m_entries.push_front(e);
+    m_bytes += static_cast<size_t>(e.diameter) * e.diameter * sizeof(float);
+    m_index.emplace(hash, m_entries.begin());
+    evict();
+    diameter = e.diameter;
+    return e.texture;
+}
+
+void KernelCache::release(GLuint texture) {
+    for (auto& e : m_entries) {
+        if (e.texture != texture) continue;
+        if (e.refs > 0) --e.refs;
+        break;
+    }
+    evict();
+}
+
+/**
+ * @brief Delete the least recently used kernels nobody holds until the
+ *        cache is back within BUDGET.
+ */
+void KernelCache::evict() {
+    auto it = m_entries.end();
+    while (m_bytes > BUDGET && it != m_entries.begin()) {
+        --it;
+        if (it->refs > 0) continue;
+        auto range = m_index.equal_range(it->hash);
+        for (auto idx = range.first; idx != range.second; ++idx) {
+            if (idx->second == it) {
+                m_index.erase(idx);
+                break;
+            }
+        }
+        glDeleteTextures(1, &it->texture);
+        m_bytes -= static_cast<size_t>(it->diameter) * it->diameter * sizeof(float);
+        it = m_entries.erase(it);
+    }
 }
 
 /**
  * @brief Generate kernel texture using compute shader.
  * 
- * Creates a 2D texture representing the convolution kernel.
- * The kernel is then normalized so all values sum to 1.0.
+ * Writes the kernel shape into @p texture, then normalizes it so all
+ * values sum to 1.0: one workgroup reduces the texels to their sum in a
+ * storage buffer, and a scale pass divides by it (and applies the pulse
+ * factor), with no readback. Game of Life kernels are left unnormalized.
  */
-void KernelManager::generate(const KernelConfig& cfg) {
-    m_config = cfg;
-    // GoL kernel is always 3x3, others use 2*radius
-    m_diameter = cfg.kernelType == 4 ? 3 : cfg.radius * 2;
-
-    destroyTexture();
-    m_texture = createTexture2D(m_diameter, m_diameter, GL_R32F);
-
+void KernelCache::render(const KernelConfig& cfg, GLuint texture, int diameter) {
     GPUKernelParams gpu{};
     gpu.radius              = cfg.radius;
     gpu.numRings            = cfg.numRings;
@@ -50,6 +117,9 @@ void KernelManager::generate(const KernelConfig& cfg) {
     gpu.anisotropyAngle     = cfg.anisotropyAngle;
     gpu.timePhase           = cfg.timePhase;
     gpu.pulseFrequency      = cfg.pulseFrequency;
+    gpu.diameter            = diameter;
+    gpu.normalize           = cfg.kernelType != 4 ? 1 : 0;
+    gpu.pass                = 0;
     for (int i = 0; i < 16; ++i) {
         gpu.ringWeights[i][0] = cfg.ringWeights[i];
         gpu.ringWeights[i][1] = 0.0f;
@@ -60,81 +130,82 @@ void KernelManager::generate(const KernelConfig& cfg) {
     glNamedBufferSubData(m_ubo, 0, sizeof(GPUKernelParams), &gpu);
     glBindBufferBase(GL_UNIFORM_BUFFER, 0, m_ubo);
 
+    GpuPassScope gpuScope(GpuPass::KernelGen);
     m_shader.use();
-    glBindImageTexture(0, m_texture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    glBindImageTexture(0, texture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
 
-    dispatchCompute2D(m_diameter, m_diameter);
+    dispatchCompute2D(diameter, diameter);
     glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
 
-    if (cfg.kernelType != 4) {
-        normalizeKernel();
+    bool pulse = cfg.pulseFrequency > 0.001f;
+    if (!gpu.normalize && !pulse) return;
+
+    m_normalizeShader.use();
+    glBindImageTexture(0, texture, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, m_sumBuffer);
+    if (gpu.normalize) {
+        glDispatchCompute(1, 1, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
     }
+    gpu.pass = 1;
+    glNamedBufferSubData(m_ubo, offsetof(GPUKernelParams, pass), sizeof(gpu.pass), &gpu.pass);
+    dispatchCompute2D(diameter, diameter);
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
 }
 
-void KernelManager::updateTimePhase(float phase) {
-    if (!m_ubo) return;
-    m_config.timePhase = phase;
-    
-    GPUKernelParams gpu{};
-    gpu.radius              = m_config.radius;
-    gpu.numRings            = m_config.numRings;
-    gpu.kernelType          = m_config.kernelType;
-    gpu.kernelModifier      = m_config.kernelModifier;
-    gpu.anisotropyStrength  = m_config.anisotropyStrength;
-    gpu.anisotropyAngle     = m_config.anisotropyAngle;
-    gpu.timePhase           = phase;
-    gpu.pulseFrequency      = m_config.pulseFrequency;
-    for (int i = 0; i < 16; ++i) {
-        gpu.ringWeights[i][0] = m_config.ringWeights[i];
-        gpu.ringWeights[i][1] = 0.0f;
-        gpu.ringWeights[i][2] = 0.0f;
-        gpu.ringWeights[i][3] = 0.0f;
-    }
+KernelManager::~KernelManager() {
+    releaseTexture();
+}
 
-    glNamedBufferSubData(m_ubo, 0, sizeof(GPUKernelParams), &gpu);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 0, m_ubo);
+bool KernelManager::init(const std::string& shaderDir) {
+    m_ownCache = std::make_unique<KernelCache>();
+    m_cache = m_ownCache.get();
+    return m_cache->init(shaderDir);
+}
 
-    m_shader.use();
-    glBindImageTexture(0, m_texture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+void KernelManager::init(KernelCache& cache) {
+    releaseTexture();
+    m_ownCache.reset();
+    m_cache = &cache;
+}
 
-    dispatchCompute2D(m_diameter, m_diameter);
-    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+void KernelManager::generate(const KernelConfig& cfg) {
+    if (!m_cache) return;
+    if (m_texture && !m_private && cfg == m_config) return;    // Already holding it
+    m_config = cfg;
 
-    if (m_config.kernelType != 4) {
-        normalizeKernel();
+    if (cfg.pulseFrequency > 0.001f) {
+        int diameter = kernelDiameter(cfg);
+        if (!m_private || diameter != m_diameter) {
+            releaseTexture();
+            m_texture = createTexture2D(diameter, diameter, GL_R32F);
+            m_private = true;
+            m_diameter = diameter;
+        }
+        m_cache->render(cfg, m_texture, m_diameter);
+        return;
     }
+
+    // Acquire before releasing, so a kernel shared with another slot survives
+    GLuint old = m_private ? 0 : m_texture;
+    if (m_private) releaseTexture();
+    m_texture = m_cache->acquire(cfg, m_diameter);
+    if (old) m_cache->release(old);
 }
 
-/**
- * @brief Normalize kernel so all values sum to 1.0.
- * 
- * This ensures the convolution produces values in the expected
- * range regardless of kernel size or ring weights.
- */
-void KernelManager::normalizeKernel() {
-    int count = m_diameter * m_diameter;
-    std::vector<float> data(count);
-    glGetTextureImage(m_texture, 0, GL_RED, GL_FLOAT,
-                      count * sizeof(float), data.data());
-
-    // Sum all kernel values
-    double sum = 0.0;
-    for (float v : data) sum += v;
-
-    // Divide by sum to normalize
-    if (sum > 1e-9) {
-        float invSum = static_cast<float>(1.0 / sum);
-        for (float& v : data) v *= invSum;
-        glTextureSubImage2D(m_texture, 0, 0, 0, m_diameter, m_diameter,
-                            GL_RED, GL_FLOAT, data.data());
-    }
+void KernelManager::updateTimePhase(float phase) {
+    if (!m_cache || !m_private) return;
+    m_config.timePhase = phase;
+    m_cache->render(m_config, m_texture, m_diameter);
 }
 
-void KernelManager::destroyTexture() {
+void KernelManager::releaseTexture() {
     if (m_texture) {
-        glDeleteTextures(1, &m_texture);
+        if (m_private) glDeleteTextures(1, &m_texture);
+        else if (m_cache) m_cache->release(m_texture);
         m_texture = 0;
     }
+    m_private = false;
 }
 
 }
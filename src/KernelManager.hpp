@@ -10,6 +10,9 @@
 
 #include <glad/glad.h>
 #include "Utils/Shader.hpp"
+#include <list>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <cstdint>
 
@@ -39,6 +42,101 @@ struct KernelConfig {
         return true;
     }
     bool operator!=(const KernelConfig& o) const { return !(*this == o); }
+
+    /** @brief Hash of the fields operator== compares (FNV-1a). */
+    size_t hash() const {
+        uint64_t h = 1469598103934665603ull;
+        auto mix = [&h](const void* data, size_t size) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i) h = (h ^ bytes[i]) * 1099511628211ull;
+        };
+        auto mixFloat = [&mix](float v) { v += 0.0f; mix(&v, sizeof(v)); };   // -0 hashes as 0
+        int ints[4] = {radius, numRings, kernelType, kernelModifier};
+        mix(ints, sizeof(ints));
+        mixFloat(anisotropyStrength);
+        mixFloat(anisotropyAngle);
+        mixFloat(pulseFrequency);
+        for (int i = 0; i < numRings && i < 16; ++i) mixFloat(ringWeights[i]);
+        return static_cast<size_t>(h);
+    }
+};
+
+/**
+ * @brief Generated kernel textures, shared by every KernelManager that asks
+ *        for an equal KernelConfig.
+ *
+ * Entries are looked up by KernelConfig::hash() and kept in least recently
+ * used order; once their textures take more than BUDGET bytes, the oldest
+ * ones no manager holds are deleted. Switching back to a preset or a slider value seen
+ * before then costs no generation at all.
+ */
+class KernelCache {
+public:
+    static constexpr size_t BUDGET = size_t(64) << 20;    // Texture bytes kept, including kernels in use
+
+    KernelCache() = default;
+    ~KernelCache();
+
+    KernelCache(const KernelCache&) = delete;
+    KernelCache& operator=(const KernelCache&) = delete;
+
+    /** @brief Load kernel_gen.comp and kernel_normalize.comp from @p shaderDir. */
+    bool init(const std::string& shaderDir);
+
+    /**
+     * @brief Texture for @p cfg, generated on a miss. The caller holds a
+     *        reference until release().
+     */
+    GLuint acquire(const KernelConfig& cfg, int& diameter);
+    void release(GLuint texture);
+
+    /**
+     * @brief Run kernel_gen.comp for @p cfg into @p texture, then normalize
+     *        it and apply the pulse factor on the GPU.
+     */
+    void render(const KernelConfig& cfg, GLuint texture, int diameter);
+
+    int size() const { return static_cast<int>(m_entries.size()); }
+    size_t bytes() const { return m_bytes; }
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+
+private:
+    struct Entry {
+        KernelConfig config;
+        size_t hash{0};
+        GLuint texture{0};
+        int    diameter{0};
+        int    refs{0};                    // KernelManagers using it
+    };
+
+    Shader m_shader;
+    Shader m_normalizeShader;
+    GLuint m_ubo{0};
+    GLuint m_sumBuffer{0};                 // Kernel sum between the two normalize passes
+    std::list<Entry> m_entries;            // Most recently used first
+    std::unordered_multimap<size_t, std::list<Entry>::iterator> m_index;
+    size_t   m_bytes{0};
+    uint64_t m_hits{0};
+    uint64_t m_misses{0};
+
+    void evict();
+
+    struct alignas(16) GPUKernelParams {
+        int32_t radius;
+        int32_t numRings;
+        int32_t kernelType;
+        int32_t kernelModifier;
+        float   ringWeights[16][4];
+        float   anisotropyStrength;
+        float   anisotropyAngle;
+        float   timePhase;
+        float   pulseFrequency;
+        int32_t diameter;
+        int32_t normalize;                 // Divide by the kernel sum
+        int32_t pass;                      // kernel_normalize.comp: 0 sum, 1 scale
+        int32_t _pad0;
+    };
 };
 
 /**
@@ -52,6 +150,13 @@ struct KernelConfig {
  * - Gaussian shell: exp(-(r/R - 0.5)^2 / (2σ^2))
  * - Multi-ring: Multiple concentric Gaussian shells
  * - Game of Life: 3x3 Moore neighborhood
+ *
+ * Textures come from a KernelCache, shared between managers or owned by
+ * this one. Time-varying kernels are rewritten in place every step, so
+ * they get a texture of their own instead.
+ *
+ * Pulsing kernels are scaled by 0.5 + 0.5 sin(2π f t) after normalization,
+ * so the pulse changes the potential instead of being normalized away.
  */
 class KernelManager {
 public:
@@ -61,7 +166,10 @@ public:
     KernelManager(const KernelManager&) = delete;
     KernelManager& operator=(const KernelManager&) = delete;
 
-    bool init(const std::string& shaderPath);
+    /** @brief Standalone: generate through a cache of its own. */
+    bool init(const std::string& shaderDir);
+    /** @brief Share @p cache, which must outlive this manager. */
+    void init(KernelCache& cache);
     void generate(const KernelConfig& cfg);
     void updateTimePhase(float phase);
 
@@ -72,27 +180,14 @@ public:
     bool needsTimeUpdate() const { return m_config.pulseFrequency > 0.001f; }
 
 private:
-    Shader       m_shader;
+    std::unique_ptr<KernelCache> m_ownCache;
+    KernelCache* m_cache{nullptr};
     GLuint       m_texture{0};
-    GLuint       m_ubo{0};
+    bool         m_private{false};    // m_texture is ours, not the cache's
     int          m_diameter{0};
     KernelConfig m_config{};
 
-    void destroyTexture();
-    void ensureUBO();
-    void normalizeKernel();
-
-    struct alignas(16) GPUKernelParams {
-        int32_t radius;
-        int32_t numRings;
-        int32_t kernelType;
-        int32_t kernelModifier;
-        float   ringWeights[16][4];
-        float   anisotropyStrength;
-        float   anisotropyAngle;
-        float   timePhase;
-        float   pulseFrequency;
-    };
+    void releaseTexture();
 };
 
 }
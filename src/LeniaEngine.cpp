@@ -16,9 +16,10 @@
 
 #include "LeniaEngine.hpp"
 #include "Presets.hpp"
+#include "GpuProfiler.hpp"
 #include "Utils/GLUtils.hpp"
 #include "Utils/Logger.hpp"
-#include "Utils/NpyLoader.hpp"
+#include "Utils/Trace.hpp"
 #include <random>
 #include <chrono>
 #include <cstring>
@@ -44,14 +45,12 @@ bool LeniaEngine::init(const std::string& assetDir) {
 
     m_initDir = "Initialisation";
 
-    if (!m_kernelMgr.init(shaderDir + "kernel_gen.comp")) {
-        LOG_ERROR("Failed to load kernel_gen.comp"); return false;
-    }
-    for (int i = 0; i < 16; ++i) {
-        if (!m_ruleKernels[i].init(shaderDir + "kernel_gen.comp")) {
-            LOG_ERROR("Failed to init rule kernel %d", i); return false;
-        }
+    if (!m_kernelCache.init(shaderDir)) {
+        LOG_ERROR("Failed to load kernel_gen.comp / kernel_normalize.comp"); return false;
     }
+    m_kernelMgr.init(m_kernelCache);
+    for (int i = 0; i < 16; ++i)
+        m_ruleKernels[i].init(m_kernelCache);
     if (!m_simShader.loadCompute(shaderDir + "sim_spatial.comp")) {
         LOG_ERROR("Failed to load sim_spatial.comp"); return false;
     }
@@ -61,12 +60,19 @@ bool LeniaEngine::init(const std::string& assetDir) {
     if (!m_noiseShader.loadCompute(shaderDir + "sim_noise.comp")) {
         LOG_ERROR("Failed to load sim_noise.comp"); return false;
     }
-    if (!m_renderer.init(shaderDir + "display.vert", shaderDir + "display.frag")) {
+    if (!m_renderer.init(shaderDir + "display.vert", shaderDir + "display.frag",
+                         shaderDir + "display_post.comp")) {
         LOG_ERROR("Failed to load display shaders"); return false;
     }
     if (!m_analysisMgr.init(shaderDir + "analysis.comp")) {
         LOG_ERROR("Failed to load analysis.comp"); return false;
     }
+    if (!m_pyramid.init(shaderDir + "state_pyramid.comp")) {
+        LOG_ERROR("Failed to load state_pyramid.comp"); return false;
+    }
+    if (!m_world.init(shaderDir)) return false;
+    if (!m_tiles.init(shaderDir)) return false;
+    if (!m_placer.init(shaderDir)) return false;
 
     LOG_INFO("All shaders loaded successfully.");
     createUBOs();
@@ -89,6 +95,12 @@ bool LeniaEngine::init(const std::string& assetDir) {
     glSamplerParameteri(m_debugSampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glSamplerParameteri(m_debugSampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
+    std::vector<std::string> speciesFiles;
+    for (const auto& preset : getPresets())
+        if (preset.speciesFile && !std::strchr(preset.speciesFile, '#'))     // Catalog species decode when used
+            speciesFiles.push_back(preset.speciesFile);
+    m_species.start(m_initDir, speciesFiles);
+
     LeniaParams defaults;
     m_state.init(defaults.gridW, defaults.gridH);
     applyPreset(0, defaults);
@@ -120,6 +132,19 @@ void LeniaEngine::createUBOs() {
  * @param steps Number of simulation steps to run
  */
 void LeniaEngine::update(const LeniaParams& params, int steps) {
+    TRACE_GL_SCOPE("LeniaEngine::update");
+    m_species.poll();
+    if (params.infiniteWorldMode && stepInfiniteWorld(params, steps)) return;
+    if (m_worldActive) {
+        m_world.release();
+        m_worldActive = false;
+    }
+    m_state.setSingleBuffer(params.inPlaceUpdate);
+    if (m_tiles.active()) {
+        stepTiled(params, steps);
+        return;
+    }
+    ++m_stateRevision;
     // Configure texture wrapping based on edge mode
     // 0 = Periodic (wrap), 1 = Clamp, 2 = Mirror
     GLenum wrapX = (params.edgeModeX == 0) ? GL_REPEAT : 
@@ -142,17 +167,28 @@ void LeniaEngine::update(const LeniaParams& params, int steps) {
     gpu.param2      = params.noiseParam2;
     gpu.wallValue   = params.wallValue;
     gpu.wallEnabled = (m_wallTex != 0) ? 1 : 0;
+    gpu.paramMask   = bindParameterField() & 7u;   // Channel 0 maps
+    gpu.bandY       = 0;
+    gpu.bandRows    = m_state.height();
+    gpu.readY       = 0;
 
     glNamedBufferSubData(m_simUBO, 0, sizeof(GPUSimParams), &gpu);
     glBindBufferBase(GL_UNIFORM_BUFFER, 1, m_simUBO);
 
     m_simShader.use();
 
-    bool wantDebug = (params.displayMode != 0);
+    bool inPlace = m_state.singleBuffer();
+    bool wantDebug = params.displayMode != 0 || debugField(params) != 0 || params.keepDebugFields;
     if (wantDebug)
         ensureDebugTextures(m_state.width(), m_state.height());
+    else if (inPlace)
+        releaseDebugTextures();
 
     for (int i = 0; i < steps; ++i) {
+        if (m_kernelMgr.needsTimeUpdate()) {
+            advanceKernelPhase(params);
+            m_simShader.use();
+        }
         glBindTextureUnit(0, m_state.currentTexture());
         glBindSampler(0, m_stateSampler);
         glBindImageTexture(1, m_state.nextTexture(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
@@ -164,13 +200,32 @@ void LeniaEngine::update(const LeniaParams& params, int steps) {
             glBindTextureUnit(3, m_wallTex);
         }
 
-        if (wantDebug) {
+        if (wantDebug || inPlace) {
             glBindImageTexture(4, m_neighborSumsTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
             glBindImageTexture(5, m_growthTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
         }
 
-        dispatchCompute2D(m_state.width(), m_state.height());
-        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+        if (inPlace) {
+            // Each band reads its pre-step rows from the window and writes the state itself
+            m_state.beginBands(SimulationState::DEFAULT_BAND_ROWS, params.radius + 1, wrapY);
+            glBindTextureUnit(0, m_state.windowTexture());
+            glBindImageTexture(1, m_state.currentTexture(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+            for (int b = 0; b < m_state.bandCount(); ++b) {
+                SimulationState::Band band = m_state.loadBand(b);
+                gpu.bandY    = band.y;
+                gpu.bandRows = band.rows;
+                gpu.readY    = band.readY;
+                glNamedBufferSubData(m_simUBO, 0, sizeof(GPUSimParams), &gpu);
+
+                GpuPassScope gpuScope(GpuPass::SimStep);
+                dispatchCompute2D(m_state.width(), band.rows);
+                glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+            }
+        } else {
+            GpuPassScope gpuScope(GpuPass::SimStep);
+            dispatchCompute2D(m_state.width(), m_state.height());
+            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+        }
 
         m_state.swap();
         
@@ -183,19 +238,238 @@ void LeniaEngine::update(const LeniaParams& params, int steps) {
     glBindSampler(2, 0);
 }
 
-void LeniaEngine::render(int viewportW, int viewportH, const LeniaParams& params) {
+/**
+ * @brief Step every tile of a grid too large for one texture, then refresh the overview.
+ */
+void LeniaEngine::stepTiled(const LeniaParams& params, int steps) {
+    TRACE_GL_SCOPE("LeniaEngine::stepTiled");
+    ++m_stateRevision;
+    m_tiles.setHalo(params.radius + 1);
+    // A pulsing kernel changes every step, so the tiles then step one at a time
+    int batch = m_kernelMgr.needsTimeUpdate() ? 1 : steps;
+    glBindSampler(2, m_kernelSampler);  // sim_chunked.comp samples the kernel like sim_spatial.comp
+    for (int done = 0; done < steps; done += batch) {
+        advanceKernelPhase(params);
+        m_tiles.step(params, m_kernelMgr.texture(), batch);
+        m_stepCount += batch;
+    }
+    glBindSampler(2, 0);
+    m_tiles.refreshOverview(m_state.currentTexture());
+}
+
+/**
+ * @brief Pulsing kernels: regenerate the main kernel on the GPU for the
+ *        simulated time, step count × dt.
+ */
+void LeniaEngine::advanceKernelPhase(const LeniaParams& params) {
+    if (!m_kernelMgr.needsTimeUpdate()) return;
+    // Wrapped to one period in double, so long runs keep the phase exact
+    double period = 1.0 / m_kernelMgr.config().pulseFrequency;
+    double time = static_cast<double>(m_stepCount) * params.dt;
+    m_kernelMgr.updateTimePhase(static_cast<float>(std::fmod(time, period)));
+}
+
+/**
+ * @brief Grid placement in the world: the view chunk centered in the grid.
+ */
+ChunkedWorld::View LeniaEngine::worldViewFor(const LeniaParams& params) const {
+    ChunkedWorld::View view;
+    int chunk = params.chunkSize;
+    view.width        = m_state.width();
+    view.height       = m_state.height();
+    view.centerChunkX = params.viewChunkX;
+    view.centerChunkY = params.viewChunkY;
+    view.originX      = params.viewChunkX * chunk + chunk / 2 - view.width / 2;
+    view.originY      = params.viewChunkY * chunk + chunk / 2 - view.height / 2;
+    return view;
+}
+
+/**
+ * @brief Write grid edits back to the world, then show the area the params point at.
+ */
+void LeniaEngine::syncWorldView(const LeniaParams& params) {
     GLuint tex = m_state.currentTexture();
-    if (params.displayMode == 1 || params.displayMode == 2) {
+    if (m_worldView.width == m_state.width() && m_worldView.height == m_state.height()) {
+        m_world.setView(m_worldView);
+        m_world.storeView(tex, m_worldView);
+    }
+
+    ChunkedWorld::View view = worldViewFor(params);
+    bool moved = view.originX != m_worldView.originX || view.originY != m_worldView.originY ||
+                 view.width != m_worldView.width || view.height != m_worldView.height;
+    m_world.setView(view);
+    m_worldView = view;
+    if (moved) {
+        m_world.loadView(tex, view);
+        ++m_stateRevision;
+    }
+}
+
+/**
+ * @brief Step the chunked world around the grid; false if it cannot run (grid stays finite).
+ *
+ * The grid is the window: it is written into the world before the steps
+ * (so brush strokes and resets take effect) and read back after them.
+ */
+bool LeniaEngine::stepInfiniteWorld(const LeniaParams& params, int steps) {
+    if (m_state.format() != GL_R32F || m_tiles.active() || params.radius + 1 > params.chunkSize) return false;
+    TRACE_GL_SCOPE("LeniaEngine::stepInfiniteWorld");
+
+    ChunkedWorld::Policy policy;
+    policy.maxResident    = params.maxLoadedChunks;
+    policy.prefetchRadius = params.loadedChunksRadius;
+    policy.autoLoad       = params.autoLoadChunks;
+    policy.persistence    = static_cast<ChunkPersistence>(std::clamp(params.chunkPersistence, 0, 2));
+    m_world.setPolicy(policy);
+
+    bool newWorld = !m_worldActive || m_world.chunkSize() != params.chunkSize;
+    if (!m_world.configure(params.chunkSize, params.radius + 1)) return false;
+    if (newWorld) {
+        // Start from the grid as it is
+        m_world.clear();
+        m_worldView = worldViewFor(params);
+        m_worldActive = true;
+    }
+
+    ++m_stateRevision;
+    syncWorldView(params);
+    int batch = m_kernelMgr.needsTimeUpdate() ? 1 : steps;
+    glBindSampler(2, m_kernelSampler);
+    for (int done = 0; done < steps; done += batch) {
+        advanceKernelPhase(params);
+        m_world.step(params, m_kernelMgr.texture(), batch);
+        m_stepCount += batch;
+    }
+    glBindSampler(2, 0);
+    m_world.loadView(m_state.currentTexture(), m_worldView);
+    return true;
+}
+
+/**
+ * @brief Bind the parameter maps to unit 8 and return their mask (0 if none).
+ */
+uint32_t LeniaEngine::bindParameterField() {
+    if (!m_paramField.active()) return 0;
+    m_paramField.resize(m_state.width(), m_state.height());  // Drops maps of an old grid size
+    if (!m_paramField.active()) return 0;
+    glBindTextureUnit(8, m_paramField.texture());
+    return m_paramField.mask();
+}
+
+void LeniaEngine::render(int viewportW, int viewportH, const LeniaParams& params) {
+    if (m_worldActive && params.infiniteWorldMode) {
+        // Navigation while paused: show the new area without waiting for a step
+        ChunkedWorld::View view = worldViewFor(params);
+        if (view.originX != m_worldView.originX || view.originY != m_worldView.originY)
+            syncWorldView(params);
+    }
+    if (params.displayMode == 1 || params.displayMode == 2)
         ensureDebugTextures(m_state.width(), m_state.height());
-        tex = (params.displayMode == 1) ? m_neighborSumsTex : m_growthTex;
+    renderSnapshot(snapshot(), viewportW, viewportH, params);
+}
+
+/**
+ * @brief Draw a state snapshot, which may be a copy published by another thread.
+ */
+void LeniaEngine::renderSnapshot(const StateSnapshot& snap, int viewportW, int viewportH,
+                                 const LeniaParams& params) {
+    TRACE_GL_SCOPE("LeniaEngine::renderSnapshot");
+    GLuint tex = snap.stateTex;
+    if (params.displayMode == 1 || params.displayMode == 2) {
+        tex = (params.displayMode == 1) ? snap.neighborSumsTex : snap.growthTex;
     } else if (params.displayMode == 3) {
-        tex = m_kernelMgr.texture();
+        tex = snap.kernelTex;
+    }
+    if (!tex) return;
+
+    // A tiled grid is drawn from its overview, so describe that texture
+    LeniaParams overview;
+    if (snap.cellScale > 1) {
+        overview = params;
+        overview.gridW = snap.gridW;
+        overview.gridH = snap.gridH;
+    }
+    const LeniaParams& view = (snap.cellScale > 1) ? overview : params;
+
+    // Reduce the state only while several cells share a pixel, once per change
+    GpuPassScope gpuScope(GpuPass::Render);
+    const StatePyramid* pyramid = nullptr;
+    if (tex == snap.stateTex && params.displayPyramid != 0 &&
+        Renderer::minificationLod(viewportW, viewportH, view) >= 1.0f) {
+        m_pyramid.build(tex, snap.gridW, snap.gridH, snap.format == GL_RGBA32F, snap.revision);
+        pyramid = &m_pyramid;
+    }
+    m_renderer.draw(tex, viewportW, viewportH, view, pyramid, snap.revision);
+}
+
+StateSnapshot LeniaEngine::snapshot() const {
+    StateSnapshot snap;
+    snap.stateTex        = m_state.currentTexture();
+    snap.gridW           = m_state.width();
+    snap.gridH           = m_state.height();
+    snap.cellScale       = m_tiles.active() ? m_tiles.factor() : 1;
+    snap.format          = m_state.format();
+    snap.revision        = m_stateRevision;
+    snap.stepCount       = m_stepCount;
+    snap.neighborSumsTex = m_neighborSumsTex;
+    snap.growthTex       = m_growthTex;
+    snap.kernelTex       = m_kernelMgr.texture();
+    snap.kernelDiameter  = m_kernelMgr.diameter();
+    for (int i = 0; i < 16; ++i) {
+        snap.ruleKernelTex[i]      = m_ruleKernels[i].texture();
+        snap.ruleKernelDiameter[i] = m_ruleKernels[i].diameter();
     }
-    m_renderer.draw(tex, viewportW, viewportH, params);
+    return snap;
+}
+
+/**
+ * @brief Total weight of a kernel as a step samples it over @p diameter taps per axis.
+ *
+ * Normalized kernels sum to 1. The Game of Life kernel (type 4) is a 3x3
+ * ring of ones; stretched over the stencil each texel covers the taps that
+ * land in its third, so it counts up to diameter^2 minus the center's taps.
+ */
+static float sampledKernelTotal(int kernelType, int diameter) {
+    if (kernelType != 4) return 1.0f;
+    int center = 0;
+    for (int k = 0; k < diameter; ++k)
+        if (static_cast<int>((k + 0.5f) * 3.0f / diameter) == 1) ++center;
+    return static_cast<float>(diameter * diameter - center * center);
+}
+
+float LeniaEngine::potentialBound(const LeniaParams& params) const {
+    if (params.numChannels <= 1) {
+        int diameter = (params.growthType == 2) ? params.radius * 2 + 1 : params.radius * 2;
+        return sampledKernelTotal(params.kernelType, diameter);
+    }
+    // Multi-channel rules add |strength| x potential into their destination channel
+    float sums[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < params.numKernelRules; ++i) {
+        const ChannelKernelRule& rule = params.kernelRules[i];
+        int ruleR = std::max(1, static_cast<int>(params.radius * rule.radiusFraction));
+        sums[std::clamp(rule.destChannel, 0, 2)] +=
+            std::fabs(rule.growthStrength) * sampledKernelTotal(rule.kernelType, ruleR * 2);
+    }
+    return std::max({1.0f, sums[0], sums[1], sums[2]});
+}
+
+float LeniaEngine::growthBound(const LeniaParams& params) const {
+    // Single-channel growth is a state change or dt x a growth in -1..1
+    if (params.numChannels <= 1) return std::max(1.0f, std::fabs(params.dt));
+    float sums[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < params.numKernelRules; ++i) {
+        const ChannelKernelRule& rule = params.kernelRules[i];
+        sums[std::clamp(rule.destChannel, 0, 2)] += std::fabs(params.dt * rule.growthStrength);
+    }
+    return std::max({1.0f, sums[0], sums[1], sums[2]});
 }
 
 void LeniaEngine::reset(const LeniaParams& params) {
+    TRACE_GL_SCOPE("LeniaEngine::reset");
+    ++m_stateRevision;
+    if (m_worldActive) m_world.clear();
     if (params.numChannels > 1) {
+        prepareCatalogPreset(static_cast<int>(params.noiseParam3));
         const auto& mcPresets = getMultiChannelPresets();
         int mcIdx = static_cast<int>(params.noiseParam4);
         if (mcIdx >= 0 && mcIdx < static_cast<int>(mcPresets.size())) {
@@ -213,7 +487,7 @@ void LeniaEngine::reset(const LeniaParams& params) {
 
     if (params.noiseMode == static_cast<int>(InitMode::Species)) {
         if (params.placementClearFirst)
-            m_state.clear();
+            clearCells();
 
         const auto& presets = getPresets();
         int presetIdx = static_cast<int>(params.noiseParam3);
@@ -233,23 +507,60 @@ void LeniaEngine::reset(const LeniaParams& params) {
         std::chrono::steady_clock::now().time_since_epoch().count() & 0xFFFFFFFF);
 
     GPUNoiseParams gpu{};
-    gpu.gridW  = m_state.width();
-    gpu.gridH  = m_state.height();
+    gpu.gridW  = gridWidth();
+    gpu.gridH  = gridHeight();
     gpu.mode   = params.noiseMode;
     gpu.seed   = seed;
     gpu.param1 = params.noiseParam1;
     gpu.param2 = params.noiseParam2;
     gpu.param3 = params.noiseParam3;
     gpu.param4 = params.noiseParam4;
+    dispatchNoise(gpu);
+}
 
-    glNamedBufferSubData(m_noiseUBO, 0, sizeof(GPUNoiseParams), &gpu);
+/**
+ * @brief Run sim_noise.comp over the whole grid, one dispatch per tile when tiled.
+ */
+void LeniaEngine::dispatchNoise(GPUNoiseParams& gpu) {
     glBindBufferBase(GL_UNIFORM_BUFFER, 2, m_noiseUBO);
-
     m_noiseShader.use();
-    glBindImageTexture(0, m_state.currentTexture(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
 
-    dispatchCompute2D(m_state.width(), m_state.height());
-    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    if (!m_tiles.active()) {
+        glNamedBufferSubData(m_noiseUBO, 0, sizeof(GPUNoiseParams), &gpu);
+        glBindImageTexture(0, m_state.currentTexture(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        dispatchCompute2D(m_state.width(), m_state.height());
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        return;
+    }
+
+    for (int i = 0; i < m_tiles.tileCount(); ++i) {
+        const TiledState::Tile& t = m_tiles.tile(i);
+        gpu.originX     = t.x;
+        gpu.originY     = t.y;
+        gpu.storeOffset = m_tiles.halo();
+        gpu.extentW     = t.w;
+        gpu.extentH     = t.h;
+        glNamedBufferSubData(m_noiseUBO, 0, sizeof(GPUNoiseParams), &gpu);
+        glBindImageTexture(0, m_tiles.currentTexture(i), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        dispatchCompute2D(t.w, t.h);
+        m_tiles.markDirty(i);
+    }
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+    m_tiles.refreshOverview(m_state.currentTexture());
+}
+
+void LeniaEngine::uploadCells(int x, int y, int w, int h, const float* data) {
+    if (!m_tiles.active()) {
+        m_state.uploadRegion(x, y, w, h, data);
+        return;
+    }
+    m_tiles.uploadRegion(x, y, w, h, data);
+    m_tiles.refreshOverview(m_state.currentTexture());
+}
+
+void LeniaEngine::clearCells() {
+    m_state.clear();
+    m_tiles.clear();
 }
 
 void LeniaEngine::loadSpeciesAndPlace(const LeniaParams& params) {
@@ -263,21 +574,14 @@ void LeniaEngine::loadSpeciesAndPlace(const LeniaParams& params) {
     }
 
     const char* speciesFile = nullptr;
-    PlacementMode placement = static_cast<PlacementMode>(params.placementMode);
+    PlacementLayout layout = placementLayout(params);
     bool flipH = params.placementFlipH;
     bool flipV = params.placementFlipV;
-    bool randomFlip = params.placementRandomFlip;
-    int count = std::max(1, params.placementCount);
-    float spacing = params.placementSpacing;
-    float margin = params.placementMargin;
-    float scale = params.placementScale;
-    int rotation = params.placementRotation;
-    int minSep = params.placementMinSeparation;
 
     if (idx >= 0) {
         speciesFile = presets[idx].speciesFile;
         if (params.placementMode == 0 && presets[idx].placement != PlacementMode::Center) {
-            placement = presets[idx].placement;
+            layout.mode = presets[idx].placement;
         }
         if (presets[idx].flipInit && !flipH && !flipV) {
             flipV = true;
@@ -286,254 +590,42 @@ void LeniaEngine::loadSpeciesAndPlace(const LeniaParams& params) {
 
     if (!speciesFile) {
         GPUNoiseParams gpu{};
-        gpu.gridW = m_state.width();
-        gpu.gridH = m_state.height();
+        gpu.gridW = gridWidth();
+        gpu.gridH = gridHeight();
         gpu.mode = 1;
         gpu.seed = 42;
-        glNamedBufferSubData(m_noiseUBO, 0, sizeof(GPUNoiseParams), &gpu);
-        glBindBufferBase(GL_UNIFORM_BUFFER, 2, m_noiseUBO);
-        m_noiseShader.use();
-        glBindImageTexture(0, m_state.currentTexture(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
-        dispatchCompute2D(m_state.width(), m_state.height());
-        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        dispatchNoise(gpu);
         return;
     }
 
-    std::string path = m_initDir + "/" + speciesFile;
-    NpyArray arr;
-    if (!loadNpy(path, arr)) {
-        LOG_ERROR("Failed to load species file: %s", path.c_str());
+    const SpeciesAtlas::Entry* species = m_species.find(speciesFile);
+    if (!species) {
+        LOG_ERROR("Failed to load species file: %s/%s", m_initDir.c_str(), speciesFile);
         return;
     }
 
-    int gw = m_state.width();
-    int gh = m_state.height();
-
-    auto applyFlips = [&](std::vector<float>& data, int rows, int cols, bool fh, bool fv) {
-        if (fv) {
-            for (int r = 0; r < rows / 2; ++r)
-                for (int c = 0; c < cols; ++c)
-                    std::swap(data[r * cols + c], data[(rows - 1 - r) * cols + c]);
-        }
-        if (fh) {
-            for (int r = 0; r < rows; ++r)
-                for (int c = 0; c < cols / 2; ++c)
-                    std::swap(data[r * cols + c], data[r * cols + (cols - 1 - c)]);
-        }
-    };
-
-    auto rotate90 = [](const std::vector<float>& data, int& rows, int& cols) {
-        std::vector<float> rotated(rows * cols);
-        for (int r = 0; r < rows; ++r)
-            for (int c = 0; c < cols; ++c)
-                rotated[c * rows + (rows - 1 - r)] = data[r * cols + c];
-        int tmp = rows;
-        rows = cols;
-        cols = tmp;
-        return rotated;
-    };
-
-    for (int r = 0; r < rotation; ++r) {
-        arr.data = rotate90(arr.data, arr.rows, arr.cols);
-    }
-
-    if (scale != 1.0f && scale > 0.0f) {
-        int newRows = std::max(1, static_cast<int>(arr.rows * scale));
-        int newCols = std::max(1, static_cast<int>(arr.cols * scale));
-        std::vector<float> scaled(newRows * newCols);
-        for (int r = 0; r < newRows; ++r) {
-            for (int c = 0; c < newCols; ++c) {
-                float srcR = static_cast<float>(r) / scale;
-                float srcC = static_cast<float>(c) / scale;
-                int sr = std::clamp(static_cast<int>(srcR), 0, arr.rows - 1);
-                int sc = std::clamp(static_cast<int>(srcC), 0, arr.cols - 1);
-                scaled[r * newCols + c] = arr.data[sr * arr.cols + sc];
-            }
-        }
-        arr.data = std::move(scaled);
-        arr.rows = newRows;
-        arr.cols = newCols;
-    }
-
-    if (flipH || flipV) {
-        applyFlips(arr.data, arr.rows, arr.cols, flipH, flipV);
-    }
-
-    int marginPxX = static_cast<int>(margin * gw);
-    int marginPxY = static_cast<int>(margin * gh);
-
-    auto placeOnGrid = [&](int dstX, int dstY, const std::vector<float>& src, int srcCols, int srcRows) {
-        int x0 = dstX;
-        int y0 = dstY;
-        int w = srcCols;
-        int h = srcRows;
-        if (x0 < 0) { w += x0; x0 = 0; }
-        if (y0 < 0) { h += y0; y0 = 0; }
-        if (x0 + w > gw) w = gw - x0;
-        if (y0 + h > gh) h = gh - y0;
-        if (w <= 0 || h <= 0) return;
-
-        int srcOffX = x0 - dstX;
-        int srcOffY = y0 - dstY;
-        std::vector<float> region(w * h);
-        for (int r = 0; r < h; ++r)
-            for (int c = 0; c < w; ++c)
-                region[r * w + c] = src[(r + srcOffY) * srcCols + (c + srcOffX)];
-
-        m_state.uploadRegion(x0, y0, w, h, region.data());
-    };
-
-    std::mt19937 rng(static_cast<unsigned>(
-        std::chrono::steady_clock::now().time_since_epoch().count()));
-
-    auto placeSingle = [&](int dstX, int dstY) {
-        if (randomFlip && count > 1) {
-            std::vector<float> copy = arr.data;
-            applyFlips(copy, arr.rows, arr.cols, rng() % 2 == 0, rng() % 2 == 0);
-            placeOnGrid(dstX, dstY, copy, arr.cols, arr.rows);
-        } else {
-            placeOnGrid(dstX, dstY, arr.data, arr.cols, arr.rows);
-        }
-    };
-
-    auto getPosition = [&](PlacementMode pm) -> std::pair<int, int> {
-        switch (pm) {
-            case PlacementMode::Center:
-                return {(gw - arr.cols) / 2, (gh - arr.rows) / 2};
-            case PlacementMode::TopLeft:
-                return {marginPxX, marginPxY};
-            case PlacementMode::TopRight:
-                return {gw - marginPxX - arr.cols, marginPxY};
-            case PlacementMode::BottomLeft:
-                return {marginPxX, gh - marginPxY - arr.rows};
-            case PlacementMode::BottomRight:
-                return {gw - marginPxX - arr.cols, gh - marginPxY - arr.rows};
-            case PlacementMode::Top:
-                return {(gw - arr.cols) / 2, marginPxY};
-            case PlacementMode::Bottom:
-                return {(gw - arr.cols) / 2, gh - marginPxY - arr.rows};
-            case PlacementMode::Left:
-                return {marginPxX, (gh - arr.rows) / 2};
-            case PlacementMode::Right:
-                return {gw - marginPxX - arr.cols, (gh - arr.rows) / 2};
-            default:
-                return {(gw - arr.cols) / 2, (gh - arr.rows) / 2};
-        }
-    };
-
-    switch (placement) {
-        case PlacementMode::Center:
-        case PlacementMode::TopLeft:
-        case PlacementMode::TopRight:
-        case PlacementMode::BottomLeft:
-        case PlacementMode::BottomRight:
-        case PlacementMode::Top:
-        case PlacementMode::Bottom:
-        case PlacementMode::Left:
-        case PlacementMode::Right: {
-            if (count == 1) {
-                auto [px, py] = getPosition(placement);
-                placeSingle(std::max(0, px), std::max(0, py));
-            } else {
-                auto [bx, by] = getPosition(placement);
-                int spacePx = static_cast<int>(spacing * static_cast<float>(std::min(gw, gh)));
-                for (int i = 0; i < count; ++i) {
-                    int ox = bx + i * spacePx;
-                    int oy = by;
-                    if (ox + arr.cols > gw) {
-                        ox = bx;
-                        oy += (i * spacePx);
-                    }
-                    placeSingle(std::max(0, ox), std::max(0, oy));
-                }
-            }
-            break;
-        }
-        case PlacementMode::Random: {
-            int rangeX = std::max(1, gw - arr.cols - 2 * marginPxX);
-            int rangeY = std::max(1, gh - arr.rows - 2 * marginPxY);
-            for (int i = 0; i < count; ++i) {
-                int x = marginPxX + static_cast<int>(rng() % static_cast<unsigned>(rangeX));
-                int y = marginPxY + static_cast<int>(rng() % static_cast<unsigned>(rangeY));
-                std::vector<float> copy = arr.data;
-                if (randomFlip) {
-                    applyFlips(copy, arr.rows, arr.cols, rng() % 2 == 0, rng() % 2 == 0);
-                }
-                placeOnGrid(x, y, copy, arr.cols, arr.rows);
-            }
-            break;
-        }
-        case PlacementMode::Grid: {
-            int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
-            int cellW = gw / side;
-            int cellH = gh / side;
-            int placed = 0;
-            for (int gy2 = 0; gy2 < side && placed < count; ++gy2) {
-                for (int gx2 = 0; gx2 < side && placed < count; ++gx2) {
-                    int cx = gx2 * cellW + (cellW - arr.cols) / 2;
-                    int cy = gy2 * cellH + (cellH - arr.rows) / 2;
-                    std::vector<float> copy = arr.data;
-                    if (randomFlip) {
-                        applyFlips(copy, arr.rows, arr.cols, rng() % 2 == 0, rng() % 2 == 0);
-                    }
-                    placeOnGrid(std::max(0, cx), std::max(0, cy), copy, arr.cols, arr.rows);
-                    placed++;
-                }
-            }
-            break;
-        }
-        case PlacementMode::TwoPlace: {
-            auto [p1x, p1y] = getPosition(PlacementMode::TopLeft);
-            placeSingle(p1x, p1y);
-            auto [p2x, p2y] = getPosition(PlacementMode::BottomRight);
-            if (p2x > 0 && p2y > 0) {
-                std::vector<float> copy = arr.data;
-                if (randomFlip) {
-                    applyFlips(copy, arr.rows, arr.cols, rng() % 2 == 0, rng() % 2 == 0);
-                }
-                placeOnGrid(p2x, p2y, copy, arr.cols, arr.rows);
-            }
-            break;
-        }
-        case PlacementMode::Scatter: {
-            struct PlacedRect { int x, y, w, h; };
-            std::vector<PlacedRect> placed;
-            int rangeX = std::max(1, gw - arr.cols - 2 * marginPxX);
-            int rangeY = std::max(1, gh - arr.rows - 2 * marginPxY);
-            int maxAttempts = count * 200;
-            int attempts = 0;
-            while (static_cast<int>(placed.size()) < count && attempts < maxAttempts) {
-                attempts++;
-                int x = marginPxX + static_cast<int>(rng() % static_cast<unsigned>(rangeX));
-                int y = marginPxY + static_cast<int>(rng() % static_cast<unsigned>(rangeY));
-                bool overlaps = false;
-                for (auto& pr : placed) {
-                    int sepX = std::abs((x + arr.cols / 2) - (pr.x + pr.w / 2)) - (arr.cols + pr.w) / 2;
-                    int sepY = std::abs((y + arr.rows / 2) - (pr.y + pr.h / 2)) - (arr.rows + pr.h) / 2;
-                    int sep = std::max(sepX, sepY);
-                    if (sep < minSep) {
-                        overlaps = true;
-                        break;
-                    }
-                }
-                if (overlaps) continue;
-                std::vector<float> copy = arr.data;
-                if (randomFlip) {
-                    applyFlips(copy, arr.rows, arr.cols, rng() % 2 == 0, rng() % 2 == 0);
-                }
-                placeOnGrid(x, y, copy, arr.cols, arr.rows);
-                placed.push_back({x, y, arr.cols, arr.rows});
-            }
-            break;
-        }
+    PlacementSource source;
+    if (species->inAtlas) {
+        source.texture = m_species.texture();
+        source.x = species->x;
+        source.y = species->y;
+        source.w = species->cols;
+        source.h = species->rows;
+    } else {
+        const float* channels[1] = {species->data()};
+        source = m_placer.stage(channels, 1, species->rows, species->cols);
     }
+    placePattern(source, layout, params, flipH, flipV);
 }
 
 void LeniaEngine::clear() {
-    m_state.clear();
+    ++m_stateRevision;
+    clearCells();
+    if (m_worldActive) m_world.clear();
 }
 
 void LeniaEngine::randomizeGrid(const LeniaParams& params) {
+    ++m_stateRevision;
     bool isBinary = (params.growthType == static_cast<int>(GrowthType::GameOfLife) ||
                      params.growthType == static_cast<int>(GrowthType::LargerThanLife));
 
@@ -558,514 +650,91 @@ void LeniaEngine::randomizeGrid(const LeniaParams& params) {
         std::chrono::steady_clock::now().time_since_epoch().count() & 0xFFFFFFFF);
 
     GPUNoiseParams gpu{};
-    gpu.gridW  = m_state.width();
-    gpu.gridH  = m_state.height();
+    gpu.gridW  = gridWidth();
+    gpu.gridH  = gridHeight();
     gpu.mode   = isBinary ? 7 : 0;
     gpu.seed   = seed;
     gpu.param1 = 0.0f;
     gpu.param2 = 0.0f;
     gpu.param3 = 0.0f;
     gpu.param4 = 0.0f;
-
-    glNamedBufferSubData(m_noiseUBO, 0, sizeof(GPUNoiseParams), &gpu);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 2, m_noiseUBO);
-
-    m_noiseShader.use();
-    glBindImageTexture(0, m_state.currentTexture(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
-
-    dispatchCompute2D(m_state.width(), m_state.height());
-    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    dispatchNoise(gpu);
 }
 
 void LeniaEngine::loadCellData(const float* data, int rows, int cols, const LeniaParams& params) {
+    ++m_stateRevision;
     if (!data || rows <= 0 || cols <= 0) return;
 
-    int gw = m_state.width();
-    int gh = m_state.height();
-
-    PlacementMode placement = static_cast<PlacementMode>(params.placementMode);
-    bool flipH = params.placementFlipH;
-    bool flipV = params.placementFlipV;
-    bool randomFlip = params.placementRandomFlip;
-    int count = std::max(1, params.placementCount);
-    float margin = params.placementMargin;
-    float scale = params.placementScale;
-    int rotation = params.placementRotation;
-    int minSep = params.placementMinSeparation;
-
-    int arrRows = rows;
-    int arrCols = cols;
-    std::vector<float> arrData(data, data + rows * cols);
-
-    auto applyFlips = [](std::vector<float>& d, int r, int c, bool fh, bool fv) {
-        if (fv) {
-            for (int row = 0; row < r / 2; ++row)
-                for (int col = 0; col < c; ++col)
-                    std::swap(d[row * c + col], d[(r - 1 - row) * c + col]);
-        }
-        if (fh) {
-            for (int row = 0; row < r; ++row)
-                for (int col = 0; col < c / 2; ++col)
-                    std::swap(d[row * c + col], d[row * c + (c - 1 - col)]);
-        }
-    };
-
-    auto rotate90 = [](const std::vector<float>& d, int& r, int& c) {
-        std::vector<float> rotated(r * c);
-        for (int row = 0; row < r; ++row)
-            for (int col = 0; col < c; ++col)
-                rotated[col * r + (r - 1 - row)] = d[row * c + col];
-        int tmp = r;
-        r = c;
-        c = tmp;
-        return rotated;
-    };
-
-    for (int r = 0; r < rotation; ++r)
-        arrData = rotate90(arrData, arrRows, arrCols);
-
-    if (scale != 1.0f && scale > 0.0f) {
-        int newRows = std::max(1, static_cast<int>(arrRows * scale));
-        int newCols = std::max(1, static_cast<int>(arrCols * scale));
-        std::vector<float> scaled(newRows * newCols);
-        for (int r = 0; r < newRows; ++r) {
-            for (int c = 0; c < newCols; ++c) {
-                float srcR = static_cast<float>(r) / scale;
-                float srcC = static_cast<float>(c) / scale;
-                int sr = std::clamp(static_cast<int>(srcR), 0, arrRows - 1);
-                int sc = std::clamp(static_cast<int>(srcC), 0, arrCols - 1);
-                scaled[r * newCols + c] = arrData[sr * arrCols + sc];
-            }
-        }
-        arrData = std::move(scaled);
-        arrRows = newRows;
-        arrCols = newCols;
-    }
-
-    if (flipH || flipV)
-        applyFlips(arrData, arrRows, arrCols, flipH, flipV);
-
-    int marginPxX = static_cast<int>(margin * gw);
-    int marginPxY = static_cast<int>(margin * gh);
-
-    auto placeOnGrid = [&](int dstX, int dstY, const std::vector<float>& src, int srcCols, int srcRows) {
-        int x0 = dstX;
-        int y0 = dstY;
-        int w = srcCols;
-        int h = srcRows;
-        if (x0 < 0) { w += x0; x0 = 0; }
-        if (y0 < 0) { h += y0; y0 = 0; }
-        if (x0 + w > gw) w = gw - x0;
-        if (y0 + h > gh) h = gh - y0;
-        if (w <= 0 || h <= 0) return;
-
-        int srcOffX = x0 - dstX;
-        int srcOffY = y0 - dstY;
-        std::vector<float> region(w * h);
-        for (int r = 0; r < h; ++r)
-            for (int c = 0; c < w; ++c)
-                region[r * w + c] = src[(r + srcOffY) * srcCols + (c + srcOffX)];
-
-        m_state.uploadRegion(x0, y0, w, h, region.data());
-    };
-
-    std::mt19937 rng(static_cast<unsigned>(
-        std::chrono::steady_clock::now().time_since_epoch().count()));
-
-    auto placeSingle = [&](int dstX, int dstY) {
-        if (randomFlip && count > 1) {
-            std::vector<float> copy = arrData;
-            applyFlips(copy, arrRows, arrCols, rng() % 2 == 0, rng() % 2 == 0);
-            placeOnGrid(dstX, dstY, copy, arrCols, arrRows);
-        } else {
-            placeOnGrid(dstX, dstY, arrData, arrCols, arrRows);
-        }
-    };
-
-    auto getPosition = [&](PlacementMode pm) -> std::pair<int, int> {
-        switch (pm) {
-            case PlacementMode::Center:
-                return {(gw - arrCols) / 2, (gh - arrRows) / 2};
-            case PlacementMode::TopLeft:
-                return {marginPxX, marginPxY};
-            case PlacementMode::TopRight:
-                return {gw - marginPxX - arrCols, marginPxY};
-            case PlacementMode::BottomLeft:
-                return {marginPxX, gh - marginPxY - arrRows};
-            case PlacementMode::BottomRight:
-                return {gw - marginPxX - arrCols, gh - marginPxY - arrRows};
-            case PlacementMode::Top:
-                return {(gw - arrCols) / 2, marginPxY};
-            case PlacementMode::Bottom:
-                return {(gw - arrCols) / 2, gh - marginPxY - arrRows};
-            case PlacementMode::Left:
-                return {marginPxX, (gh - arrRows) / 2};
-            case PlacementMode::Right:
-                return {gw - marginPxX - arrCols, (gh - arrRows) / 2};
-            default:
-                return {(gw - arrCols) / 2, (gh - arrRows) / 2};
-        }
-    };
-
-    switch (placement) {
-        case PlacementMode::Center:
-        case PlacementMode::TopLeft:
-        case PlacementMode::TopRight:
-        case PlacementMode::BottomLeft:
-        case PlacementMode::BottomRight:
-        case PlacementMode::Top:
-        case PlacementMode::Bottom:
-        case PlacementMode::Left:
-        case PlacementMode::Right: {
-            if (count == 1) {
-                auto [px, py] = getPosition(placement);
-                placeSingle(std::max(0, px), std::max(0, py));
-            } else {
-                auto [bx, by] = getPosition(placement);
-                int spacePx = static_cast<int>(params.placementSpacing * static_cast<float>(std::min(gw, gh)));
-                for (int i = 0; i < count; ++i) {
-                    int ox = bx + i * spacePx;
-                    int oy = by;
-                    if (ox + arrCols > gw) {
-                        ox = bx;
-                        oy += (i * spacePx);
-                    }
-                    placeSingle(std::max(0, ox), std::max(0, oy));
-                }
-            }
-            break;
-        }
-        case PlacementMode::Random: {
-            int rangeX = std::max(1, gw - arrCols - 2 * marginPxX);
-            int rangeY = std::max(1, gh - arrRows - 2 * marginPxY);
-            for (int i = 0; i < count; ++i) {
-                int x = marginPxX + static_cast<int>(rng() % static_cast<unsigned>(rangeX));
-                int y = marginPxY + static_cast<int>(rng() % static_cast<unsigned>(rangeY));
-                std::vector<float> copy = arrData;
-                if (randomFlip)
-                    applyFlips(copy, arrRows, arrCols, rng() % 2 == 0, rng() % 2 == 0);
-                placeOnGrid(x, y, copy, arrCols, arrRows);
-            }
-            break;
-        }
-        case PlacementMode::Grid: {
-            int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
-            int cellW = gw / side;
-            int cellH = gh / side;
-            int placed2 = 0;
-            for (int gy2 = 0; gy2 < side && placed2 < count; ++gy2) {
-                for (int gx2 = 0; gx2 < side && placed2 < count; ++gx2) {
-                    int cx = gx2 * cellW + (cellW - arrCols) / 2;
-                    int cy = gy2 * cellH + (cellH - arrRows) / 2;
-                    std::vector<float> copy = arrData;
-                    if (randomFlip)
-                        applyFlips(copy, arrRows, arrCols, rng() % 2 == 0, rng() % 2 == 0);
-                    placeOnGrid(std::max(0, cx), std::max(0, cy), copy, arrCols, arrRows);
-                    placed2++;
-                }
-            }
-            break;
-        }
-        case PlacementMode::TwoPlace: {
-            auto [p1x, p1y] = getPosition(PlacementMode::TopLeft);
-            placeSingle(p1x, p1y);
-            auto [p2x, p2y] = getPosition(PlacementMode::BottomRight);
-            if (p2x > 0 && p2y > 0) {
-                std::vector<float> copy = arrData;
-                if (randomFlip)
-                    applyFlips(copy, arrRows, arrCols, rng() % 2 == 0, rng() % 2 == 0);
-                placeOnGrid(p2x, p2y, copy, arrCols, arrRows);
-            }
-            break;
-        }
-        case PlacementMode::Scatter: {
-            struct PlacedRect { int x, y, w, h; };
-            std::vector<PlacedRect> placedRects;
-            int rangeX = std::max(1, gw - arrCols - 2 * marginPxX);
-            int rangeY = std::max(1, gh - arrRows - 2 * marginPxY);
-            int maxAttempts = count * 200;
-            int attempts = 0;
-            while (static_cast<int>(placedRects.size()) < count && attempts < maxAttempts) {
-                attempts++;
-                int x = marginPxX + static_cast<int>(rng() % static_cast<unsigned>(rangeX));
-                int y = marginPxY + static_cast<int>(rng() % static_cast<unsigned>(rangeY));
-                bool overlaps = false;
-                for (auto& pr : placedRects) {
-                    int sepX = std::abs((x + arrCols / 2) - (pr.x + pr.w / 2)) - (arrCols + pr.w) / 2;
-                    int sepY = std::abs((y + arrRows / 2) - (pr.y + pr.h / 2)) - (arrRows + pr.h) / 2;
-                    int sep = std::max(sepX, sepY);
-                    if (sep < minSep) { overlaps = true; break; }
-                }
-                if (overlaps) continue;
-                std::vector<float> copy = arrData;
-                if (randomFlip)
-                    applyFlips(copy, arrRows, arrCols, rng() % 2 == 0, rng() % 2 == 0);
-                placeOnGrid(x, y, copy, arrCols, arrRows);
-                placedRects.push_back({x, y, arrCols, arrRows});
-            }
-            break;
-        }
-    }
+    const float* channels[1] = {data};
+    PlacementSource source = m_placer.stage(channels, 1, rows, cols);
+    placePattern(source, placementLayout(params), params, params.placementFlipH, params.placementFlipV);
 }
 
 void LeniaEngine::loadMultiChannelCellData(const MultiChannelPreset& mcp, const LeniaParams& params) {
-    int gw = m_state.width();
-    int gh = m_state.height();
-
+    ++m_stateRevision;
     if (params.placementClearFirst)
         m_state.clear();
+    if (mcp.cellRows <= 0 || mcp.cellCols <= 0) return;
 
-    PlacementMode placement = static_cast<PlacementMode>(params.placementMode);
-    bool flipH = params.placementFlipH;
-    bool flipV = params.placementFlipV;
-    bool randomFlip = params.placementRandomFlip;
-    int count = std::max(1, params.placementCount);
-    float margin = params.placementMargin;
-    float scale = params.placementScale;
-    int rotation = params.placementRotation;
-    int minSep = params.placementMinSeparation;
-
-    int arrRows = mcp.cellRows;
-    int arrCols = mcp.cellCols;
-    int numPixels = arrRows * arrCols;
-
-    std::vector<float> ch0(numPixels, 0.0f);
-    std::vector<float> ch1(numPixels, 0.0f);
-    std::vector<float> ch2(numPixels, 0.0f);
-    if (mcp.cellsCh0) std::copy(mcp.cellsCh0, mcp.cellsCh0 + numPixels, ch0.begin());
-    if (mcp.cellsCh1) std::copy(mcp.cellsCh1, mcp.cellsCh1 + numPixels, ch1.begin());
-    if (mcp.cellsCh2) std::copy(mcp.cellsCh2, mcp.cellsCh2 + numPixels, ch2.begin());
-
-    auto applyFlipsVec = [](std::vector<float>& d, int r, int c, bool fh, bool fv) {
-        if (fv) {
-            for (int row = 0; row < r / 2; ++row)
-                for (int col = 0; col < c; ++col)
-                    std::swap(d[row * c + col], d[(r - 1 - row) * c + col]);
-        }
-        if (fh) {
-            for (int row = 0; row < r; ++row)
-                for (int col = 0; col < c / 2; ++col)
-                    std::swap(d[row * c + col], d[row * c + (c - 1 - col)]);
-        }
-    };
+    const float* channels[3] = {mcp.cellsCh0, mcp.cellsCh1, mcp.cellsCh2};
+    PlacementSource source = m_placer.stage(channels, 3, mcp.cellRows, mcp.cellCols);
+    placePattern(source, placementLayout(params), params, params.placementFlipH, params.placementFlipV);
+}
 
-    auto rotate90Vec = [](const std::vector<float>& d, int r, int c) {
-        std::vector<float> rotated(r * c);
-        for (int row = 0; row < r; ++row)
-            for (int col = 0; col < c; ++col)
-                rotated[col * r + (r - 1 - row)] = d[row * c + col];
-        return rotated;
-    };
+PlacementLayout LeniaEngine::placementLayout(const LeniaParams& params) {
+    PlacementLayout layout;
+    layout.mode          = static_cast<PlacementMode>(params.placementMode);
+    layout.count         = std::max(1, params.placementCount);
+    layout.spacing       = params.placementSpacing;
+    layout.margin        = params.placementMargin;
+    layout.minSeparation = params.placementMinSeparation;
+    layout.randomFlip    = params.placementRandomFlip;
+    return layout;
+}
 
-    for (int r = 0; r < rotation; ++r) {
-        ch0 = rotate90Vec(ch0, arrRows, arrCols);
-        ch1 = rotate90Vec(ch1, arrRows, arrCols);
-        ch2 = rotate90Vec(ch2, arrRows, arrCols);
-        int tmp = arrRows;
-        arrRows = arrCols;
-        arrCols = tmp;
-    }
-
-    if (scale != 1.0f && scale > 0.0f) {
-        int newRows = std::max(1, static_cast<int>(arrRows * scale));
-        int newCols = std::max(1, static_cast<int>(arrCols * scale));
-        auto scaleChannel = [&](const std::vector<float>& src) {
-            std::vector<float> dst(newRows * newCols);
-            for (int r = 0; r < newRows; ++r)
-                for (int c = 0; c < newCols; ++c) {
-                    int sr = std::clamp(static_cast<int>(static_cast<float>(r) / scale), 0, arrRows - 1);
-                    int sc = std::clamp(static_cast<int>(static_cast<float>(c) / scale), 0, arrCols - 1);
-                    dst[r * newCols + c] = src[sr * arrCols + sc];
-                }
-            return dst;
-        };
-        ch0 = scaleChannel(ch0);
-        ch1 = scaleChannel(ch1);
-        ch2 = scaleChannel(ch2);
-        arrRows = newRows;
-        arrCols = newCols;
-    }
-
-    if (flipH || flipV) {
-        applyFlipsVec(ch0, arrRows, arrCols, flipH, flipV);
-        applyFlipsVec(ch1, arrRows, arrCols, flipH, flipV);
-        applyFlipsVec(ch2, arrRows, arrCols, flipH, flipV);
-    }
-
-    int marginPxX = static_cast<int>(margin * gw);
-    int marginPxY = static_cast<int>(margin * gh);
-
-    auto placeRGBA = [&](int dstX, int dstY, const std::vector<float>& c0,
-                         const std::vector<float>& c1, const std::vector<float>& c2,
-                         int srcCols, int srcRows) {
-        int x0 = dstX, y0 = dstY, w = srcCols, h = srcRows;
-        if (x0 < 0) { w += x0; x0 = 0; }
-        if (y0 < 0) { h += y0; y0 = 0; }
-        if (x0 + w > gw) w = gw - x0;
-        if (y0 + h > gh) h = gh - y0;
-        if (w <= 0 || h <= 0) return;
-
-        int srcOffX = x0 - dstX;
-        int srcOffY = y0 - dstY;
-        std::vector<float> region(w * h * 4);
-        for (int r = 0; r < h; ++r)
-            for (int c2i = 0; c2i < w; ++c2i) {
-                int si = (r + srcOffY) * srcCols + (c2i + srcOffX);
-                int di = (r * w + c2i) * 4;
-                region[di + 0] = c0[si];
-                region[di + 1] = c1[si];
-                region[di + 2] = c2[si];
-                region[di + 3] = 1.0f;
-            }
-        m_state.uploadRegionRGBA(x0, y0, w, h, region.data());
-    };
+/**
+ * @brief Stamp the copies of @p source laid out by @p layout, turned by the
+ *        placement rotation and scaled, in one dispatch per target texture:
+ *        the state, or each tile the copies touch.
+ *
+ * Like the noise fill, only the current texture is written; the next step
+ * overwrites the other one entirely.
+ */
+void LeniaEngine::placePattern(const PlacementSource& source, const PlacementLayout& layout,
+                               const LeniaParams& params, bool flipH, bool flipV) {
+    TRACE_GL_SCOPE("LeniaEngine::placePattern");
+    if (!source.texture) return;
+
+    float angle = static_cast<float>(params.placementRotation) * 1.57079632679f;
+    float scale = params.placementScale > 0.0f ? params.placementScale : 1.0f;
+    int footW, footH;
+    SpeciesPlacer::footprint(source.w, source.h, angle, scale, footW, footH);
 
     std::mt19937 rng(static_cast<unsigned>(
         std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::vector<PlacementSpot> spots = SpeciesPlacer::layout(layout, footW, footH, gridWidth(), gridHeight(), rng);
+    m_placer.setInstances(source, spots, angle, scale, flipH, flipV);
 
-    auto placeSingle = [&](int dstX, int dstY) {
-        if (randomFlip && count > 1) {
-            auto c0 = ch0, c1 = ch1, c2 = ch2;
-            bool fh = rng() % 2 == 0, fv = rng() % 2 == 0;
-            applyFlipsVec(c0, arrRows, arrCols, fh, fv);
-            applyFlipsVec(c1, arrRows, arrCols, fh, fv);
-            applyFlipsVec(c2, arrRows, arrCols, fh, fv);
-            placeRGBA(dstX, dstY, c0, c1, c2, arrCols, arrRows);
-        } else {
-            placeRGBA(dstX, dstY, ch0, ch1, ch2, arrCols, arrRows);
-        }
-    };
-
-    auto getPosition = [&](PlacementMode pm) -> std::pair<int, int> {
-        switch (pm) {
-            case PlacementMode::Center:      return {(gw - arrCols) / 2, (gh - arrRows) / 2};
-            case PlacementMode::TopLeft:     return {marginPxX, marginPxY};
-            case PlacementMode::TopRight:    return {gw - marginPxX - arrCols, marginPxY};
-            case PlacementMode::BottomLeft:  return {marginPxX, gh - marginPxY - arrRows};
-            case PlacementMode::BottomRight: return {gw - marginPxX - arrCols, gh - marginPxY - arrRows};
-            case PlacementMode::Top:         return {(gw - arrCols) / 2, marginPxY};
-            case PlacementMode::Bottom:      return {(gw - arrCols) / 2, gh - marginPxY - arrRows};
-            case PlacementMode::Left:        return {marginPxX, (gh - arrRows) / 2};
-            case PlacementMode::Right:       return {gw - marginPxX - arrCols, (gh - arrRows) / 2};
-            default:                         return {(gw - arrCols) / 2, (gh - arrRows) / 2};
-        }
-    };
+    if (!m_tiles.active()) {
+        m_placer.dispatch(m_state.currentTexture(), m_state.format(), 0, 0, m_state.width(), m_state.height(), 0);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+        return;
+    }
 
-    switch (placement) {
-        case PlacementMode::Center:
-        case PlacementMode::TopLeft:
-        case PlacementMode::TopRight:
-        case PlacementMode::BottomLeft:
-        case PlacementMode::BottomRight:
-        case PlacementMode::Top:
-        case PlacementMode::Bottom:
-        case PlacementMode::Left:
-        case PlacementMode::Right: {
-            if (count == 1) {
-                auto [px, py] = getPosition(placement);
-                placeSingle(std::max(0, px), std::max(0, py));
-            } else {
-                auto [bx, by] = getPosition(placement);
-                int spacePx = static_cast<int>(params.placementSpacing * static_cast<float>(std::min(gw, gh)));
-                for (int i = 0; i < count; ++i) {
-                    int ox = bx + i * spacePx;
-                    int oy = by;
-                    if (ox + arrCols > gw) { ox = bx; oy += (i * spacePx); }
-                    placeSingle(std::max(0, ox), std::max(0, oy));
-                }
-            }
-            break;
-        }
-        case PlacementMode::Random: {
-            int rangeX = std::max(1, gw - arrCols - 2 * marginPxX);
-            int rangeY = std::max(1, gh - arrRows - 2 * marginPxY);
-            for (int i = 0; i < count; ++i) {
-                int x = marginPxX + static_cast<int>(rng() % static_cast<unsigned>(rangeX));
-                int y = marginPxY + static_cast<int>(rng() % static_cast<unsigned>(rangeY));
-                auto c0 = ch0, c1 = ch1, c2 = ch2;
-                if (randomFlip) {
-                    bool fh = rng() % 2 == 0, fv = rng() % 2 == 0;
-                    applyFlipsVec(c0, arrRows, arrCols, fh, fv);
-                    applyFlipsVec(c1, arrRows, arrCols, fh, fv);
-                    applyFlipsVec(c2, arrRows, arrCols, fh, fv);
-                }
-                placeRGBA(x, y, c0, c1, c2, arrCols, arrRows);
-            }
-            break;
-        }
-        case PlacementMode::Grid: {
-            int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
-            int cellW = gw / side;
-            int cellH = gh / side;
-            int placed = 0;
-            for (int gy2 = 0; gy2 < side && placed < count; ++gy2) {
-                for (int gx2 = 0; gx2 < side && placed < count; ++gx2) {
-                    int cx = gx2 * cellW + (cellW - arrCols) / 2;
-                    int cy = gy2 * cellH + (cellH - arrRows) / 2;
-                    auto c0 = ch0, c1 = ch1, c2 = ch2;
-                    if (randomFlip) {
-                        bool fh = rng() % 2 == 0, fv = rng() % 2 == 0;
-                        applyFlipsVec(c0, arrRows, arrCols, fh, fv);
-                        applyFlipsVec(c1, arrRows, arrCols, fh, fv);
-                        applyFlipsVec(c2, arrRows, arrCols, fh, fv);
-                    }
-                    placeRGBA(std::max(0, cx), std::max(0, cy), c0, c1, c2, arrCols, arrRows);
-                    placed++;
-                }
-            }
-            break;
-        }
-        case PlacementMode::TwoPlace: {
-            auto [p1x, p1y] = getPosition(PlacementMode::TopLeft);
-            placeSingle(p1x, p1y);
-            auto [p2x, p2y] = getPosition(PlacementMode::BottomRight);
-            if (p2x > 0 && p2y > 0) {
-                auto c0 = ch0, c1 = ch1, c2 = ch2;
-                if (randomFlip) {
-                    bool fh = rng() % 2 == 0, fv = rng() % 2 == 0;
-                    applyFlipsVec(c0, arrRows, arrCols, fh, fv);
-                    applyFlipsVec(c1, arrRows, arrCols, fh, fv);
-                    applyFlipsVec(c2, arrRows, arrCols, fh, fv);
-                }
-                placeRGBA(p2x, p2y, c0, c1, c2, arrCols, arrRows);
-            }
-            break;
-        }
-        case PlacementMode::Scatter: {
-            struct PlacedRect { int x, y, w, h; };
-            std::vector<PlacedRect> placedRects;
-            int rangeX = std::max(1, gw - arrCols - 2 * marginPxX);
-            int rangeY = std::max(1, gh - arrRows - 2 * marginPxY);
-            int maxAttempts = count * 200;
-            int attempts = 0;
-            while (static_cast<int>(placedRects.size()) < count && attempts < maxAttempts) {
-                attempts++;
-                int x = marginPxX + static_cast<int>(rng() % static_cast<unsigned>(rangeX));
-                int y = marginPxY + static_cast<int>(rng() % static_cast<unsigned>(rangeY));
-                bool overlaps = false;
-                for (auto& pr : placedRects) {
-                    int sepX = std::abs((x + arrCols / 2) - (pr.x + pr.w / 2)) - (arrCols + pr.w) / 2;
-                    int sepY = std::abs((y + arrRows / 2) - (pr.y + pr.h / 2)) - (arrRows + pr.h) / 2;
-                    int sep = std::max(sepX, sepY);
-                    if (sep < minSep) { overlaps = true; break; }
-                }
-                if (overlaps) continue;
-                auto c0 = ch0, c1 = ch1, c2 = ch2;
-                if (randomFlip) {
-                    bool fh = rng() % 2 == 0, fv = rng() % 2 == 0;
-                    applyFlipsVec(c0, arrRows, arrCols, fh, fv);
-                    applyFlipsVec(c1, arrRows, arrCols, fh, fv);
-                    applyFlipsVec(c2, arrRows, arrCols, fh, fv);
-                }
-                placeRGBA(x, y, c0, c1, c2, arrCols, arrRows);
-                placedRects.push_back({x, y, arrCols, arrRows});
-            }
-            break;
-        }
+    int x0, y0, x1, y1;
+    if (!m_placer.bounds(x0, y0, x1, y1)) return;
+    for (int i = 0; i < m_tiles.tileCount(); ++i) {
+        const TiledState::Tile& t = m_tiles.tile(i);
+        if (t.x >= x1 || t.y >= y1 || t.x + t.w <= x0 || t.y + t.h <= y0) continue;
+        m_placer.dispatch(m_tiles.currentTexture(i), GL_R32F, t.x, t.y, t.w, t.h, m_tiles.halo());
+        m_tiles.markDirty(i);
     }
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+    m_tiles.refreshOverview(m_state.currentTexture());
 }
 
 void LeniaEngine::regenerateKernel(const LeniaParams& params) {
+    TRACE_GL_SCOPE("LeniaEngine::regenerateKernel");
     KernelConfig cfg;
     cfg.radius              = params.radius;
     cfg.numRings            = params.numRings;
@@ -1081,6 +750,7 @@ void LeniaEngine::regenerateKernel(const LeniaParams& params) {
 }
 
 void LeniaEngine::regenerateRuleKernel(int ruleIndex, const LeniaParams& params) {
+    TRACE_GL_SCOPE("LeniaEngine::regenerateRuleKernel");
     if (ruleIndex < 0 || ruleIndex >= params.numKernelRules) return;
     const auto& rule = params.kernelRules[ruleIndex];
     int ruleR = std::max(1, static_cast<int>(params.radius * rule.radiusFraction));
@@ -1093,11 +763,66 @@ void LeniaEngine::regenerateRuleKernel(int ruleIndex, const LeniaParams& params)
     m_ruleKernels[ruleIndex].generate(cfg);
 }
 
+/**
+ * @brief Resize the grid, keeping its content centered.
+ *
+ * Single-channel grids past GL_MAX_TEXTURE_SIZE (or past params.tileSize when
+ * one is set) are stored as a TiledState and m_state becomes their overview.
+ * Content is carried over between a plain and a tiled grid; resizing from one
+ * tiled size to another starts empty, since it could mean copying gigabytes.
+ */
 void LeniaEngine::resizeGrid(const LeniaParams& params) {
+    TRACE_GL_SCOPE("LeniaEngine::resizeGrid");
+    ++m_stateRevision;
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    int edge = (params.tileSize > 0) ? params.tileSize : TiledState::DEFAULT_TILE;
+    edge = std::clamp(edge, 256, static_cast<int>(maxSize) - 2 * TiledState::MAX_HALO);
+    bool tiled = m_state.format() == GL_R32F &&
+                 (params.gridW > maxSize || params.gridH > maxSize ||
+                  (params.tileSize > 0 && (params.gridW > edge || params.gridH > edge)));
+
+    auto centered = [](int from, int to) { return (to - std::min(from, to)) / 2; };
+    if (tiled) {
+        int oldW = m_state.width(), oldH = m_state.height();
+        std::vector<float> old;
+        if (!m_tiles.active()) {
+            old.resize(static_cast<size_t>(oldW) * oldH);
+            glGetTextureImage(m_state.currentTexture(), 0, GL_RED, GL_FLOAT,
+                              static_cast<GLsizei>(old.size() * sizeof(float)), old.data());
+        }
+        if (m_tiles.allocate(params.gridW, params.gridH, edge, params.radius + 1)) {
+            if (!old.empty()) {
+                int w = std::min(oldW, params.gridW), h = std::min(oldH, params.gridH);
+                int srcX = centered(params.gridW, oldW), srcY = centered(params.gridH, oldH);
+                std::vector<float> region(static_cast<size_t>(w) * h);
+                for (int y = 0; y < h; ++y)
+                    std::copy_n(old.begin() + static_cast<size_t>(srcY + y) * oldW + srcX, w,
+                                region.begin() + static_cast<size_t>(y) * w);
+                m_tiles.uploadRegion(centered(oldW, params.gridW), centered(oldH, params.gridH), w, h, region.data());
+            }
+            m_state.resize(m_tiles.overviewWidth(), m_tiles.overviewHeight());
+            m_tiles.refreshOverview(m_state.currentTexture());
+            return;
+        }
+    }
+
+    if (m_tiles.active()) {
+        int w = std::min(m_tiles.width(), params.gridW), h = std::min(m_tiles.height(), params.gridH);
+        std::vector<float> region(static_cast<size_t>(w) * h);
+        m_tiles.readRegion(centered(params.gridW, m_tiles.width()), centered(params.gridH, m_tiles.height()),
+                           w, h, region.data());
+        m_tiles.release();
+        m_state.init(params.gridW, params.gridH, GL_R32F);
+        m_state.uploadRegion(centered(w, params.gridW), centered(h, params.gridH), w, h, region.data());
+        return;
+    }
     m_state.resize(params.gridW, params.gridH);
 }
 
 void LeniaEngine::applyPreset(int index, LeniaParams& params) {
+    TRACE_GL_SCOPE("LeniaEngine::applyPreset");
+    ++m_stateRevision;
     const auto& presets = getPresets();
     if (index < 0 || index >= static_cast<int>(presets.size())) return;
 
@@ -1130,6 +855,7 @@ void LeniaEngine::applyPreset(int index, LeniaParams& params) {
 
         const auto& mcp = mcPresets[mcIdx];
         params.numChannels = mcp.numChannels;
+        m_tiles.release();
         if (params.numChannels > 1) {
             m_state.init(p.gridW, p.gridH, GL_RGBA32F);
         } else {
@@ -1202,10 +928,18 @@ void LeniaEngine::applyKernelPreset(int index, LeniaParams& params) {
 }
 
 void LeniaEngine::runAnalysis(float threshold) {
-    m_analysisMgr.analyze(m_state.currentTexture(), m_state.width(), m_state.height(), threshold);
+    m_analysisMgr.analyze(m_state.currentTexture(), m_state.width(), m_state.height(), threshold,
+                          m_tiles.active() ? m_tiles.factor() : 1);
+}
+
+void LeniaEngine::runAnalysis(const StateSnapshot& snap, float threshold) {
+    TRACE_GL_SCOPE("LeniaEngine::runAnalysis");
+    m_analysisMgr.analyze(snap.stateTex, snap.gridW, snap.gridH, threshold, snap.cellScale);
 }
 
 void LeniaEngine::updateMultiChannel(const LeniaParams& params, int steps) {
+    TRACE_GL_SCOPE("LeniaEngine::updateMultiChannel");
+    ++m_stateRevision;
     GLenum wrapX = (params.edgeModeX == 0) ? GL_REPEAT : 
                    (params.edgeModeX == 2) ? GL_MIRRORED_REPEAT : GL_CLAMP_TO_EDGE;
     GLenum wrapY = (params.edgeModeY == 0) ? GL_REPEAT : 
@@ -1214,25 +948,27 @@ void LeniaEngine::updateMultiChannel(const LeniaParams& params, int steps) {
     glSamplerParameteri(m_stateSampler, GL_TEXTURE_WRAP_T, wrapY);
 
     m_multiChannelShader.use();
-    ensureDebugTextures(m_state.width(), m_state.height());
+    // Rules accumulate into the debug textures, which in place are only kept while shown
+    bool inPlace = m_state.singleBuffer();
+    bool wantDebug = !inPlace || debugField(params) != 0 || params.keepDebugFields;
+    if (wantDebug)
+        ensureDebugTextures(m_state.width(), m_state.height());
+    else
+        releaseDebugTextures();
 
     glBindSampler(0, m_stateSampler);
     glBindSampler(3, m_stateSampler);
     glBindSampler(6, m_debugSampler);
     glBindSampler(7, m_debugSampler);
+    uint32_t fieldMask = bindParameterField();
 
-    for (int s = 0; s < steps; ++s) {
-        glCopyImageSubData(
-            m_state.currentTexture(), GL_TEXTURE_2D, 0, 0, 0, 0,
-            m_state.nextTexture(), GL_TEXTURE_2D, 0, 0, 0, 0,
-            m_state.width(), m_state.height(), 1);
-
-        float zero[4] = {0, 0, 0, 0};
-        glClearTexImage(m_neighborSumsTex, 0, GL_RGBA, GL_FLOAT, zero);
-        glClearTexImage(m_growthTex, 0, GL_RGBA, GL_FLOAT, zero);
-        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    int halo = 1;
+    for (int r = 0; r < params.numKernelRules; ++r)
+        halo = std::max(halo, static_cast<int>(params.radius * params.kernelRules[r].radiusFraction) + 1);
 
-        glBindTextureUnit(0, m_state.currentTexture());
+    // One pass per rule over rows [band.y, band.y + band.rows), reading readTex
+    auto runRules = [&](GLuint readTex, GLuint accumTex, const SimulationState::Band& band) {
+        glBindTextureUnit(0, readTex);
         glBindTextureUnit(6, m_neighborSumsTex);
         glBindTextureUnit(7, m_growthTex);
 
@@ -1253,20 +989,54 @@ void LeniaEngine::updateMultiChannel(const LeniaParams& params, int steps) {
             gpu.growthStrength = rule.growthStrength;
             gpu.rulePass = r;
             gpu.numRules = params.numKernelRules;
+            gpu.paramMask = fieldMask;
+            gpu.bandY = band.y;
+            gpu.bandRows = band.rows;
+            gpu.readY = band.readY;
 
             glNamedBufferSubData(m_multiUBO, 0, sizeof(GPUMultiChannelParams), &gpu);
             glBindBufferBase(GL_UNIFORM_BUFFER, 1, m_multiUBO);
 
-            glBindTextureUnit(3, m_state.nextTexture());
-            glBindImageTexture(1, m_state.nextTexture(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
+            glBindTextureUnit(3, accumTex);
+            glBindImageTexture(1, accumTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
             glBindTextureUnit(2, m_ruleKernels[r].texture());
             glBindSampler(2, m_kernelSampler);
             glBindImageTexture(4, m_neighborSumsTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
             glBindImageTexture(5, m_growthTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
 
-            dispatchCompute2D(m_state.width(), m_state.height());
+            GpuPassScope gpuScope(GpuPass::SimStep);
+            dispatchCompute2D(m_state.width(), band.rows);
             glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
         }
+    };
+
+    for (int s = 0; s < steps; ++s) {
+        {
+            GpuPassScope gpuScope(GpuPass::SimStep);
+            if (!inPlace)
+                glCopyImageSubData(
+                    m_state.currentTexture(), GL_TEXTURE_2D, 0, 0, 0, 0,
+                    m_state.nextTexture(), GL_TEXTURE_2D, 0, 0, 0, 0,
+                    m_state.width(), m_state.height(), 1);
+
+            if (wantDebug) {
+                float zero[4] = {0, 0, 0, 0};
+                glClearTexImage(m_neighborSumsTex, 0, GL_RGBA, GL_FLOAT, zero);
+                glClearTexImage(m_growthTex, 0, GL_RGBA, GL_FLOAT, zero);
+            }
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        }
+
+        if (inPlace) {
+            // The state is its own accumulator; rules read the band's pre-step window
+            m_state.beginBands(SimulationState::DEFAULT_BAND_ROWS, halo, wrapY);
+            for (int b = 0; b < m_state.bandCount(); ++b)
+                runRules(m_state.windowTexture(), m_state.currentTexture(), m_state.loadBand(b));
+        } else {
+            SimulationState::Band whole;
+            whole.rows = m_state.height();
+            runRules(m_state.currentTexture(), m_state.nextTexture(), whole);
+        }
 
         m_state.swap();
         
@@ -1283,6 +1053,12 @@ void LeniaEngine::updateMultiChannel(const LeniaParams& params, int steps) {
 }
 
 void LeniaEngine::switchChannelMode(LeniaParams& params, int numChannels) {
+    if (numChannels > 1 && m_tiles.active()) {
+        LOG_WARN("A %dx%d grid is tiled and single-channel; shrink it for multi-channel rules.",
+                 m_tiles.width(), m_tiles.height());
+        return;
+    }
+    ++m_stateRevision;
     params.numChannels = numChannels;
     GLenum fmt = (numChannels > 1) ? GL_RGBA32F : GL_R32F;
     if (m_state.format() != fmt) {
@@ -1290,6 +1066,22 @@ void LeniaEngine::switchChannelMode(LeniaParams& params, int numChannels) {
     }
 }
 
+void LeniaEngine::releaseDebugTextures() {
+    if (m_neighborSumsTex) glDeleteTextures(1, &m_neighborSumsTex);
+    if (m_growthTex)       glDeleteTextures(1, &m_growthTex);
+    m_neighborSumsTex = 0;
+    m_growthTex = 0;
+    m_debugTexW = 0;
+    m_debugTexH = 0;
+}
+
+int LeniaEngine::debugField(const LeniaParams& params) {
+    if (params.displayMode == 1 || params.displayMode == 2) return params.displayMode;
+    if (params.recordVideo && (params.recordSource == 2 || params.recordSource == 3))
+        return params.recordSource - 1;
+    return 0;
+}
+
 void LeniaEngine::ensureDebugTextures(int w, int h) {
     if (m_debugTexW == w && m_debugTexH == h && m_neighborSumsTex && m_growthTex) return;
     if (m_neighborSumsTex) glDeleteTextures(1, &m_neighborSumsTex);
@@ -1309,6 +1101,8 @@ void LeniaEngine::ensureDebugTextures(int w, int h) {
 }
 
 void LeniaEngine::flipGridHorizontal() {
+    if (m_tiles.active()) return;      // Tiled grids are not transformed as a whole
+    ++m_stateRevision;
     int w = m_state.width();
     int h = m_state.height();
     bool isRGB = (m_state.format() == GL_RGBA32F);
@@ -1333,6 +1127,8 @@ void LeniaEngine::flipGridHorizontal() {
 }
 
 void LeniaEngine::flipGridVertical() {
+    if (m_tiles.active()) return;      // Tiled grids are not transformed as a whole
+    ++m_stateRevision;
     int w = m_state.width();
     int h = m_state.height();
     bool isRGB = (m_state.format() == GL_RGBA32F);
@@ -1357,6 +1153,8 @@ void LeniaEngine::flipGridVertical() {
 }
 
 void LeniaEngine::rotateGrid(int direction, LeniaParams& params) {
+    if (m_tiles.active()) return;      // Tiled grids are not transformed as a whole
+    ++m_stateRevision;
     int w = m_state.width();
     int h = m_state.height();
     bool isRGB = (m_state.format() == GL_RGBA32F);
@@ -1398,25 +1196,37 @@ void LeniaEngine::rotateGrid(int direction, LeniaParams& params) {
 }
 
 float LeniaEngine::getCellValue(int x, int y) const {
-    int w = m_state.width();
-    int h = m_state.height();
-    if (x < 0 || x >= w || y < 0 || y >= h) return 0.0f;
+    if (m_tiles.active()) return m_tiles.valueAt(x, y);
+    return readCellValue(snapshot(), x, y);
+}
 
-    bool isRGB = (m_state.format() == GL_RGBA32F);
-    int components = isRGB ? 4 : 1;
-    int idx = (y * w + x) * components;
-    std::vector<float> pixels(w * h * components);
+/**
+ * @brief Read one cell back from the GPU (channel average for RGB state).
+ *
+ * Only the requested texel is transferred, so this is cheap enough to call
+ * every frame for the cursor readout. (x, y) are grid cells; for a tiled
+ * grid the snapshot holds the overview, so the covering texel is read.
+ */
+float LeniaEngine::readCellValue(const StateSnapshot& snap, int x, int y) {
+    x /= snap.cellScale;
+    y /= snap.cellScale;
+    if (!snap.stateTex || x < 0 || x >= snap.gridW || y < 0 || y >= snap.gridH) return 0.0f;
 
-    glGetTextureImage(m_state.currentTexture(), 0, isRGB ? GL_RGBA : GL_RED, GL_FLOAT,
-                      static_cast<GLsizei>(pixels.size() * sizeof(float)), pixels.data());
+    float px[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    bool isRGB = (snap.format == GL_RGBA32F);
+    glGetTextureSubImage(snap.stateTex, 0, x, y, 0, 1, 1, 1,
+                         isRGB ? GL_RGBA : GL_RED, GL_FLOAT, sizeof(px), px);
 
     if (isRGB) {
-        return (pixels[idx] + pixels[idx+1] + pixels[idx+2]) / 3.0f;
+        return (px[0] + px[1] + px[2]) / 3.0f;
     }
-    return pixels[idx];
+    return px[0];
 }
 
 void LeniaEngine::applyBrush(int cx, int cy, const LeniaParams& params) {
+    TRACE_GL_SCOPE("LeniaEngine::applyBrush");
+    if (m_tiles.active()) return;      // Drawing works on a single-texture grid
+    ++m_stateRevision;
     int w = m_state.width();
     int h = m_state.height();
 
@@ -1715,6 +1525,9 @@ void LeniaEngine::applyBrushCurve(const std::vector<std::pair<int,int>>& points,
 }
 
 void LeniaEngine::applyWall(int cx, int cy, const LeniaParams& params) {
+    TRACE_GL_SCOPE("LeniaEngine::applyWall");
+    if (m_tiles.active()) return;      // Drawing works on a single-texture grid
+    ++m_stateRevision;
     int w = m_state.width();
     int h = m_state.height();
 
@@ -1954,6 +1767,7 @@ void LeniaEngine::applyWallCurve(const std::vector<std::pair<int,int>>& points,
 }
 
 void LeniaEngine::clearWalls() {
+    ++m_stateRevision;
     if (m_wallTex != 0) {
         GLint w, h;
         glGetTextureLevelParameteriv(m_wallTex, 0, GL_TEXTURE_WIDTH, &w);
@@ -1963,7 +1777,248 @@ void LeniaEngine::clearWalls() {
     }
 }
 
+/**
+ * @brief Start a checkpoint of the grid at full resolution, with its walls.
+ *
+ * Only the readbacks are issued here; the state saved is the current one
+ * even if steps run before the file is written. Infinite worlds are not
+ * covered (their chunks live outside the grid).
+ */
+bool LeniaEngine::saveCheckpoint(const std::string& path, const LeniaParams& params, bool compress) {
+    TRACE_GL_SCOPE("LeniaEngine::saveCheckpoint");
+    if (m_worldActive) {
+        LOG_WARN("Checkpoints cover finite grids; %s not written for the infinite world.", path.c_str());
+        return false;
+    }
+    bool tiled = m_tiles.active();
+    bool rgb = (m_state.format() == GL_RGBA32F);
+
+    CheckpointHeader header{};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.byteOrder   = CHECKPOINT_BYTE_ORDER;
+    header.version     = CHECKPOINT_VERSION;
+    header.headerBytes = sizeof(CheckpointHeader);
+    header.width       = tiled ? m_tiles.width() : m_state.width();
+    header.height      = tiled ? m_tiles.height() : m_state.height();
+    header.channels    = rgb ? 3 : 1;
+    header.stripRows   = CHECKPOINT_STRIP_ROWS;
+    header.compression = static_cast<uint32_t>(compress ? CheckpointCompression::ZeroRuns
+                                                        : CheckpointCompression::Raw);
+    header.stepCount   = static_cast<uint64_t>(m_stepCount);
+
+    std::vector<ReadbackSource> sources;
+    if (tiled) {
+        for (int i = 0; i < m_tiles.tileCount(); ++i) {
+            const TiledState::Tile& t = m_tiles.tile(i);
+            ReadbackSource src;
+            src.tex  = m_tiles.currentTexture(i);
+            src.texX = src.texY = m_tiles.halo();
+            src.x = t.x;
+            src.y = t.y;
+            src.w = t.w;
+            src.h = t.h;
+            sources.push_back(src);
+        }
+    } else {
+        ReadbackSource src;
+        src.tex = m_state.currentTexture();
+        src.w = header.width;
+        src.h = header.height;
+        src.components = rgb ? 4 : 1;
+        sources.push_back(src);
+    }
+
+    if (m_wallTex != 0 && !tiled) {
+        GLint texW, texH;
+        glGetTextureLevelParameteriv(m_wallTex, 0, GL_TEXTURE_WIDTH, &texW);
+        glGetTextureLevelParameteriv(m_wallTex, 0, GL_TEXTURE_HEIGHT, &texH);
+        if (texW == header.width && texH == header.height) {
+            ReadbackSource src;
+            src.tex = m_wallTex;
+            src.w = texW;
+            src.h = texH;
+            src.components = 4;
+            src.tag = CHECKPOINT_WALL_SOURCE;
+            sources.push_back(src);
+            header.wallPlanes = 4;
+        }
+    }
+
+    LeniaParams saved = params;
+    saved.gridW = header.width;
+    saved.gridH = header.height;
+    return m_checkpoint.begin(path, header, checkpointParams(saved), sources);
+}
+
+/**
+ * @brief Restore a checkpoint: its settings into @p params, then grid, walls and step count.
+ *
+ * Strips go to the GPU straight from the file mapping, through a strip-sized
+ * buffer only when they are compressed or have to be interleaved (RGB, walls).
+ */
+bool LeniaEngine::loadCheckpoint(const std::string& path, LeniaParams& params) {
+    TRACE_GL_SCOPE("LeniaEngine::loadCheckpoint");
+    CheckpointReader reader;
+    if (!reader.open(path)) return false;
+    const CheckpointHeader& header = reader.header();
+
+    applyCheckpointParams(reader.params(), params);
+    params.gridW = header.width;
+    params.gridH = header.height;
+    params.infiniteWorldMode = false;
+    if (header.channels == 1) params.numChannels = 1;
+    else params.numChannels = std::max(2, params.numChannels);
+
+    ++m_stateRevision;
+    if (m_worldActive) {
+        m_world.release();
+        m_worldActive = false;
+    }
+    if (header.channels > 1) {
+        m_tiles.release();
+        m_state.init(params.gridW, params.gridH, GL_RGBA32F);
+    } else {
+        if (m_state.format() != GL_R32F)
+            m_state.init(m_state.width(), m_state.height(), GL_R32F);
+        resizeGrid(params);
+    }
+    regenerateKernel(params);
+    for (int i = 0; i < params.numKernelRules; ++i)
+        regenerateRuleKernel(i, params);
+
+    if (m_wallTex) glDeleteTextures(1, &m_wallTex);
+    m_wallTex = 0;
+    bool walls = header.wallPlanes == 4 && !m_tiles.active();
+    if (walls) {
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_wallTex);
+        glTextureStorage2D(m_wallTex, 1, GL_RGBA32F, header.width, header.height);
+    }
+
+    // Interleave planes [first, first + count) into rgba; missing components read as alpha 1
+    std::vector<float> scratch, rgba;
+    auto interleave = [&](int first, int count, int strip, size_t cells) {
+        rgba.assign(cells * 4, 1.0f);
+        for (int c = 0; c < count; ++c) {
+            const float* plane = reader.strip(first + c, strip, scratch);
+            if (!plane) return false;
+            for (size_t i = 0; i < cells; ++i) rgba[i * 4 + c] = plane[i];
+        }
+        return true;
+    };
+
+    int width = header.width;
+    for (int s = 0; s < reader.stripCount(); ++s) {
+        int y0 = s * header.stripRows;
+        int rows = std::min(header.stripRows, header.height - y0);
+        size_t cells = static_cast<size_t>(width) * rows;
+        bool ok = true;
+        if (header.channels == 1) {
+            const float* plane = reader.strip(0, s, scratch);
+            ok = plane != nullptr;
+            if (ok && m_tiles.active()) m_tiles.uploadRegion(0, y0, width, rows, plane);
+            else if (ok)                m_state.uploadRegion(0, y0, width, rows, plane);
+        } else {
+            ok = interleave(0, header.channels, s, cells);
+            if (ok) m_state.uploadRegionRGBA(0, y0, width, rows, rgba.data());
+        }
+        if (ok && walls) {
+            ok = interleave(header.channels, 4, s, cells);
+            if (ok) glTextureSubImage2D(m_wallTex, 0, 0, y0, width, rows, GL_RGBA, GL_FLOAT, rgba.data());
+        }
+        if (!ok) {
+            LOG_ERROR("Checkpoint %s: rows %d-%d are damaged; the grid is only partly restored.",
+                      path.c_str(), y0, y0 + rows - 1);
+            return false;
+        }
+    }
+    if (m_tiles.active()) m_tiles.refreshOverview(m_state.currentTexture());
+
+    m_stepCount = static_cast<int>(header.stepCount);
+    LOG_INFO("Checkpoint %s restored: %dx%d at step %llu.", path.c_str(), header.width, header.height,
+             static_cast<unsigned long long>(header.stepCount));
+    return true;
+}
+
+/**
+ * @brief Start a NumPy export of the grid, its walls, the debug fields and a creature crop.
+ *
+ * Potential and growth come from the debug outputs, so they are exported
+ * only while the engine writes them every step (shown, recorded, or
+ * keepDebugFields); tiled grids export the state alone.
+ */
+bool LeniaEngine::exportFields(const std::string& path, const ExportOptions& options, const LeniaParams& params) {
+    TRACE_GL_SCOPE("LeniaEngine::exportFields");
+    if (m_worldActive) {
+        LOG_WARN("Exports cover finite grids; %s not written for the infinite world.", path.c_str());
+        return false;
+    }
+    bool tiled = m_tiles.active();
+    bool rgb = (m_state.format() == GL_RGBA32F);
+
+    ExportGrid grid;
+    grid.width     = tiled ? m_tiles.width() : m_state.width();
+    grid.height    = tiled ? m_tiles.height() : m_state.height();
+    grid.channels  = rgb ? std::clamp(params.numChannels, 1, 3) : 1;
+    grid.wrapX     = params.edgeModeX == 0;
+    grid.wrapY     = params.edgeModeY == 0;
+    grid.stepCount = m_stepCount;
+
+    std::vector<ReadbackSource> sources;
+    auto addTexture = [&](ExportField field, GLuint tex, int components) {
+        ReadbackSource src;
+        src.tag = field;
+        src.tex = tex;
+        src.w = grid.width;
+        src.h = grid.height;
+        src.components = components;
+        sources.push_back(src);
+    };
+
+    if (options.fields & (EXPORT_STATE | EXPORT_CREATURE)) {
+        if (tiled) {
+            for (int i = 0; i < m_tiles.tileCount(); ++i) {
+                const TiledState::Tile& t = m_tiles.tile(i);
+                ReadbackSource src;
+                src.tag  = EXPORT_STATE;
+                src.tex  = m_tiles.currentTexture(i);
+                src.texX = src.texY = m_tiles.halo();
+                src.x = t.x;
+                src.y = t.y;
+                src.w = t.w;
+                src.h = t.h;
+                sources.push_back(src);
+            }
+        } else {
+            addTexture(EXPORT_STATE, m_state.currentTexture(), rgb ? 4 : 1);
+        }
+    }
+
+    if ((options.fields & EXPORT_WALLS) && m_wallTex != 0 && !tiled) {
+        GLint texW, texH;
+        glGetTextureLevelParameteriv(m_wallTex, 0, GL_TEXTURE_WIDTH, &texW);
+        glGetTextureLevelParameteriv(m_wallTex, 0, GL_TEXTURE_HEIGHT, &texH);
+        if (texW == grid.width && texH == grid.height) addTexture(EXPORT_WALLS, m_wallTex, 4);
+    }
+
+    if (options.fields & (EXPORT_POTENTIAL | EXPORT_GROWTH)) {
+        bool written = params.keepDebugFields || debugField(params) != 0 ||
+                       (params.numKernelRules > 0 ? !m_state.singleBuffer() : params.displayMode != 0);
+        bool current = !tiled && written && m_neighborSumsTex && m_growthTex &&
+                       m_debugTexW == grid.width && m_debugTexH == grid.height;
+        if (!current) {
+            LOG_WARN("Export %s: potential and growth are only exported while the engine keeps them "
+                     "(shown, recorded, or Keep Potential/Growth, untiled grids); skipped.", path.c_str());
+        } else {
+            if (options.fields & EXPORT_POTENTIAL) addTexture(EXPORT_POTENTIAL, m_neighborSumsTex, 4);
+            if (options.fields & EXPORT_GROWTH)    addTexture(EXPORT_GROWTH, m_growthTex, 4);
+        }
+    }
+
+    return m_exporter.begin(path, options, grid, sources);
+}
+
 void LeniaEngine::enforceObstacles(const LeniaParams& params) {
+    ++m_stateRevision;
     if (m_wallTex == 0) return;
     
     int w = m_state.width();
@@ -1974,6 +2029,8 @@ void LeniaEngine::enforceObstacles(const LeniaParams& params) {
     glGetTextureLevelParameteriv(m_wallTex, 0, GL_TEXTURE_HEIGHT, &texH);
     if (texW != w || texH != h) return;
     
+    TRACE_GL_SCOPE("LeniaEngine::enforceObstacles");
+    GpuPassScope gpuScope(GpuPass::Obstacles);
     std::vector<float> wallPixels(w * h * 4);
     glGetTextureImage(m_wallTex, 0, GL_RGBA, GL_FLOAT,
                       static_cast<GLsizei>(wallPixels.size() * sizeof(float)), wallPixels.data());
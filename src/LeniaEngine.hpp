@@ -13,6 +13,14 @@
 #include "KernelManager.hpp"
 #include "Renderer.hpp"
 #include "AnalysisManager.hpp"
+#include "Checkpoint.hpp"
+#include "ChunkedWorld.hpp"
+#include "FieldExporter.hpp"
+#include "ParameterField.hpp"
+#include "SpeciesAtlas.hpp"
+#include "SpeciesPlacer.hpp"
+#include "StatePyramid.hpp"
+#include "TiledState.hpp"
 #include "UIOverlay.hpp"
 #include "Utils/Shader.hpp"
 #include <string>
@@ -133,6 +141,28 @@ struct KernelPreset {
     int         radius;
 };
 
+/**
+ * @brief Textures and counters describing one displayable simulation state.
+ *
+ * Rendering and analysis only read through a snapshot, so they can work
+ * on a published copy while the simulation keeps stepping elsewhere.
+ */
+struct StateSnapshot {
+    GLuint   stateTex{0};           // Current state (R32F or RGBA32F)
+    int      gridW{0};              // stateTex size, the overview of a tiled grid
+    int      gridH{0};
+    int      cellScale{1};          // Grid cells per stateTex texel along each axis
+    GLenum   format{GL_R32F};
+    uint64_t revision{0};           // Changes whenever stateTex content changes
+    int      stepCount{0};
+    GLuint   neighborSumsTex{0};    // Debug outputs, 0 until first requested
+    GLuint   growthTex{0};
+    GLuint   kernelTex{0};
+    int      kernelDiameter{0};
+    GLuint   ruleKernelTex[16]{};
+    int      ruleKernelDiameter[16]{};
+};
+
 /**
  * @brief Core simulation engine implementing Lenia cellular automaton.
  * 
@@ -164,6 +194,7 @@ public:
     void update(const LeniaParams& params, int steps = 1);
     void updateMultiChannel(const LeniaParams& params, int steps = 1);
     void render(int viewportW, int viewportH, const LeniaParams& params);
+    void renderSnapshot(const StateSnapshot& snap, int viewportW, int viewportH, const LeniaParams& params);
     void reset(const LeniaParams& params);
     void clear();
     void regenerateKernel(const LeniaParams& params);
@@ -175,11 +206,13 @@ public:
     void loadCellData(const float* data, int rows, int cols, const LeniaParams& params);
     void loadMultiChannelCellData(const struct MultiChannelPreset& mcp, const LeniaParams& params);
     void runAnalysis(float threshold = 0.01f);
+    void runAnalysis(const StateSnapshot& snap, float threshold);
     void switchChannelMode(LeniaParams& params, int numChannels);
     void flipGridHorizontal();
     void flipGridVertical();
     void rotateGrid(int direction, LeniaParams& params);
     float getCellValue(int x, int y) const;
+    static float readCellValue(const StateSnapshot& snap, int x, int y);
     void applyBrush(int x, int y, const LeniaParams& params);
     void applyBrushLine(int x0, int y0, int x1, int y1, const LeniaParams& params);
     void applyBrushCurve(const std::vector<std::pair<int,int>>& points, const LeniaParams& params);
@@ -188,15 +221,48 @@ public:
     void applyWallCurve(const std::vector<std::pair<int,int>>& points, const LeniaParams& params);
     GLuint wallTexture() const { return m_wallTex; }
     void clearWalls();
+    /** @brief Queue a checkpoint of grid, walls, settings and step count; pollCheckpoint() writes it. */
+    bool saveCheckpoint(const std::string& path, const LeniaParams& params, bool compress = true);
+    /** @brief Finish a pending checkpoint once its readback is done; @p wait blocks until written. */
+    void pollCheckpoint(bool wait = false) { m_checkpoint.poll(wait); }
+    bool checkpointPending() const { return m_checkpoint.busy(); }
+    bool checkpointSucceeded() const { return m_checkpoint.succeeded(); }
+    bool loadCheckpoint(const std::string& path, LeniaParams& params);
+    /** @brief Queue a NumPy export of the selected fields (.npz file or .npy directory); pollExport() writes it. */
+    bool exportFields(const std::string& path, const ExportOptions& options, const LeniaParams& params);
+    void pollExport(bool wait = false) { m_exporter.poll(wait); }
+    bool exportPending() const { return m_exporter.busy(); }
+    bool exportSucceeded() const { return m_exporter.succeeded(); }
+    /**
+     * @brief Advance pending checkpoint and export writes; called once per
+     *        frame by the thread that owns the engine's context.
+     */
+    void pollReadbacks() {
+        m_checkpoint.poll();
+        m_exporter.poll();
+    }
+    bool readbacksPending() const { return checkpointPending() || exportPending(); }
 
     SimulationState& state() { return m_state; }
+    StateSnapshot snapshot() const;
+    /** @brief Largest potential (neighbor sum) the rules of @p params reach on a 0..1 state. */
+    float potentialBound(const LeniaParams& params) const;
+    /** @brief Largest growth magnitude the rules of @p params write per step. */
+    float growthBound(const LeniaParams& params) const;
     const AnalysisData& analysisData() const { return m_analysisMgr.data(); }
     const AnalysisManager& analysisMgr() const { return m_analysisMgr; }
+    void resetAnalysis() { m_analysisMgr.resetHistory(); }
+    const ChunkedWorld& world() const { return m_world; }
+    const TiledState& tiles() const { return m_tiles; }
+    /** @brief Per-cell mu/sigma/dt maps, sized to the current grid on access. */
+    ParameterField& parameterField() { m_paramField.resize(m_state.width(), m_state.height()); return m_paramField; }
     GLuint kernelTexture() const { return m_kernelMgr.texture(); }
     int kernelDiameter() const { return m_kernelMgr.diameter(); }
     GLuint ruleKernelTexture(int idx) const { return (idx >= 0 && idx < 16) ? m_ruleKernels[idx].texture() : 0; }
     int ruleKernelDiameter(int idx) const { return (idx >= 0 && idx < 16) ? m_ruleKernels[idx].diameter() : 0; }
     GLuint neighborSumsTexture() const { return m_neighborSumsTex; }
+    /** @brief Debug output shown or recorded: 1 neighbor sums, 2 growth, 0 none. */
+    static int debugField(const LeniaParams& params);
     GLuint growthTexture() const { return m_growthTex; }
     int stepCount() const { return m_stepCount; }
     void resetStepCount() { m_stepCount = 0; }
@@ -207,10 +273,21 @@ public:
 
 private:
     SimulationState  m_state;
+    KernelCache      m_kernelCache;         // Before the managers holding its textures
     KernelManager    m_kernelMgr;
     KernelManager    m_ruleKernels[16];
     Renderer         m_renderer;
+    StatePyramid     m_pyramid;
     AnalysisManager  m_analysisMgr;
+    ParameterField   m_paramField;
+    TiledState       m_tiles;               // Active when the grid is larger than one texture
+    ChunkedWorld     m_world;
+    CheckpointWriter m_checkpoint;
+    FieldExporter    m_exporter;
+    SpeciesAtlas     m_species;             // Decoded species library
+    SpeciesPlacer    m_placer;
+    ChunkedWorld::View m_worldView;        // World area the grid showed at the last sync
+    bool             m_worldActive{false};
     Shader           m_simShader;
     Shader           m_multiChannelShader;
     Shader           m_noiseShader;
@@ -227,6 +304,7 @@ private:
     int              m_debugTexH{0};
     std::string      m_initDir;
     int              m_stepCount{0};
+    uint64_t         m_stateRevision{0};   // Bumped by anything that writes the grid
 
     struct alignas(16) GPUSimParams {
         int32_t gridW;
@@ -240,7 +318,11 @@ private:
         float   param2;
         float   wallValue;
         int32_t wallEnabled;
-        int32_t _pad2;
+        uint32_t paramMask;
+        int32_t bandY;        // Rows updated by one dispatch; the whole grid unless in place
+        int32_t bandRows;
+        int32_t readY;        // Grid row in row 0 of the texture read
+        int32_t _pad0;
     };
 
     struct alignas(16) GPUMultiChannelParams {
@@ -256,6 +338,10 @@ private:
         float   growthStrength;
         int32_t rulePass;
         int32_t numRules;
+        uint32_t paramMask;
+        int32_t bandY;
+        int32_t bandRows;
+        int32_t readY;
     };
 
     struct alignas(16) GPUNoiseParams {
@@ -267,12 +353,35 @@ private:
         float    param2;
         float    param3;
         float    param4;
+        int32_t  originX;       // Tiled grids: one dispatch per tile
+        int32_t  originY;
+        int32_t  storeOffset;
+        int32_t  extentW;       // 0 = whole grid
+        int32_t  extentH;
+        int32_t  _pad0;
+        int32_t  _pad1;
+        int32_t  _pad2;
     };
 
     void createUBOs();
+    int  gridWidth() const { return m_tiles.active() ? m_tiles.width() : m_state.width(); }
+    int  gridHeight() const { return m_tiles.active() ? m_tiles.height() : m_state.height(); }
+    void dispatchNoise(GPUNoiseParams& gpu);
+    void uploadCells(int x, int y, int w, int h, const float* data);
+    void clearCells();
+    void stepTiled(const LeniaParams& params, int steps);
+    void advanceKernelPhase(const LeniaParams& params);
     void loadSpeciesAndPlace(const LeniaParams& params);
+    static PlacementLayout placementLayout(const LeniaParams& params);
+    void placePattern(const PlacementSource& source, const PlacementLayout& layout,
+                      const LeniaParams& params, bool flipH, bool flipV);
     void ensureDebugTextures(int w, int h);
+    void releaseDebugTextures();
     void enforceObstacles(const LeniaParams& params);
+    uint32_t bindParameterField();
+    bool stepInfiniteWorld(const LeniaParams& params, int steps);
+    void syncWorldView(const LeniaParams& params);
+    ChunkedWorld::View worldViewFor(const LeniaParams& params) const;
 };
 
 }
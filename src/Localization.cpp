@@ -143,7 +143,8 @@ void Localization::initEnglish() {
         "+/-: Zoom | Arrows: Pan\n"
         "Home: Reset View | Tab: Toggle UI\n"
         "1-5: Set steps/frame\n"
-        "F11: Fullscreen | Esc: Quit";
+        "F5: Save checkpoint | F8: Load checkpoint\n"
+        "F9: Save trace | F11: Fullscreen | Esc: Quit";
     
     // Theory section
     texts[static_cast<int>(TextId::TheoryHeader)] = "Theory";
@@ -265,6 +266,39 @@ void Localization::initEnglish() {
     texts[static_cast<int>(TextId::PerfFrameTimeGraphTitle)] = "Frame Time";
     texts[static_cast<int>(TextId::PerfFrameTimeGraphXLabel)] = "frames";
     texts[static_cast<int>(TextId::PerfFrameTimeGraphYLabel)] = "ms";
+    texts[static_cast<int>(TextId::PerfGpuPasses)] = "GPU Passes";
+    texts[static_cast<int>(TextId::PerfGpuPassesTooltip)] = "GPU time per pass from timestamp queries, a few frames behind. The count is how many times the pass ran.";
+    texts[static_cast<int>(TextId::PerfGpuPassKernelGen)] = "Kernel:";
+    texts[static_cast<int>(TextId::PerfGpuPassSimStep)] = "Simulation:";
+    texts[static_cast<int>(TextId::PerfGpuPassObstacles)] = "Obstacles:";
+    texts[static_cast<int>(TextId::PerfGpuPassAnalysis)] = "Analysis:";
+    texts[static_cast<int>(TextId::PerfGpuPassRender)] = "Render:";
+    texts[static_cast<int>(TextId::PerfGpuPassImGui)] = "UI:";
+    texts[static_cast<int>(TextId::PerfGpuPassTime)] = "%.3f ms (%dx)";
+    texts[static_cast<int>(TextId::PerfGpuTotal)] = "Total:";
+    texts[static_cast<int>(TextId::PerfGpuNoData)] = "Waiting for GPU timestamps...";
+    texts[static_cast<int>(TextId::PerfGpuThroughput)] = "GPU Rate:";
+    texts[static_cast<int>(TextId::PerfGpuThroughputTooltip)] = "Cells updated per second of GPU simulation time, excluding CPU overhead and idle time.";
+    texts[static_cast<int>(TextId::PerfGpuBandwidth)] = "Bandwidth:";
+    texts[static_cast<int>(TextId::PerfGpuBandwidthValue)] = "~%.1f GB/s";
+    texts[static_cast<int>(TextId::PerfGpuBandwidthTooltip)] = "Estimated memory traffic of the simulation: state and debug texture reads and writes per step, assuming the kernel neighbourhood is served from cache.";
+    texts[static_cast<int>(TextId::PerfGpuTimeGraphTitle)] = "GPU Time";
+    texts[static_cast<int>(TextId::PerfTraceRecord)] = "Record Trace";
+    texts[static_cast<int>(TextId::PerfTraceRecordTooltip)] = "Record CPU and GPU timings of recent frames. Saved as Chrome trace JSON in log/ with the button, F9, or on exit; open it in ui.perfetto.dev or chrome://tracing.";
+    texts[static_cast<int>(TextId::PerfTraceSave)] = "Save Trace";
+    texts[static_cast<int>(TextId::PerfTraceSaveTooltip)] = "Write the recorded timeline to log/lenia_trace_<date>.json (F9).";
+    texts[static_cast<int>(TextId::PerfRecord)] = "Record Frames";
+    texts[static_cast<int>(TextId::PerfRecordTooltip)] = "Capture frames to recordings/ while the simulation runs. Readbacks are asynchronous,\nso frames the writer cannot keep up with are dropped (and counted) instead of slowing the simulation.";
+    texts[static_cast<int>(TextId::PerfRecordSource)] = "Source";
+    texts[static_cast<int>(TextId::PerfRecordSourceTooltip)] = "Rendered frame as displayed (without the UI), or the raw state or field textures at grid resolution.";
+    texts[static_cast<int>(TextId::PerfRecordSourceFrame)] = "Rendered Frame";
+    texts[static_cast<int>(TextId::PerfRecordSourceState)] = "Raw State";
+    texts[static_cast<int>(TextId::PerfRecordFormat)] = "Format";
+    texts[static_cast<int>(TextId::PerfRecordFormatPng)] = "PNG Sequence";
+    texts[static_cast<int>(TextId::PerfRecordFormatY4m)] = "Y4M Video";
+    texts[static_cast<int>(TextId::PerfRecordEvery)] = "Every N Steps";
+    texts[static_cast<int>(TextId::PerfRecordEveryTooltip)] = "Minimum number of simulation steps between recorded frames.";
+    texts[static_cast<int>(TextId::PerfRecordStatus)] = "%d frames, %d dropped";
     
     // Grid section
     texts[static_cast<int>(TextId::GridSize)] = "Size: %d x %d (%s cells)";
@@ -272,6 +306,19 @@ void Localization::initEnglish() {
     texts[static_cast<int>(TextId::GridWidthTooltip)] = "Grid width in cells. Larger grids allow more complex patterns but are slower. Must be >= 32.";
     texts[static_cast<int>(TextId::GridHeight)] = "Height";
     texts[static_cast<int>(TextId::GridHeightTooltip)] = "Grid height in cells. The grid wraps toroidally (edges connect).";
+    texts[static_cast<int>(TextId::GridTileSize)] = "Tile Size";
+    texts[static_cast<int>(TextId::GridTileSizeTooltip)] = "Grids larger than this many cells per side are split into tiles, each its own texture. 0 tiles only grids beyond the GPU texture size limit. Tiled grids are single-channel and cannot be drawn on.";
+    texts[static_cast<int>(TextId::GridTiledInfo)] = "Tiled: %d x %d tiles, 1 texel = %d x %d cells";
+    texts[static_cast<int>(TextId::GridInPlace)] = "In-Place Update";
+    texts[static_cast<int>(TextId::GridInPlaceTooltip)] = "Keep a single state texture and update it in bands of rows.\nNearly halves state memory for the largest grids; debug views\nallocate their buffers only while shown.";
+    texts[static_cast<int>(TextId::GridCheckpointSave)] = "Save Checkpoint";
+    texts[static_cast<int>(TextId::GridCheckpointSaveTooltip)] = "Write the grid, walls, parameters and step count to checkpoints/quick.lckp (F5).\nThe file is written in the background while the simulation keeps running.";
+    texts[static_cast<int>(TextId::GridCheckpointLoad)] = "Load Checkpoint";
+    texts[static_cast<int>(TextId::GridCheckpointLoadTooltip)] = "Restore checkpoints/quick.lckp: grid size, contents, walls, parameters and step count (F8).";
+    texts[static_cast<int>(TextId::GridExportNumpy)] = "Export NumPy (.npz)";
+    texts[static_cast<int>(TextId::GridExportNumpyTooltip)] = "Write the state, wall mask, potential, growth and a crop around the largest creature to exports/ (F6).\nLoad with np.load(); the file is written in the background.";
+    texts[static_cast<int>(TextId::GridKeepDebugFields)] = "Keep Potential/Growth";
+    texts[static_cast<int>(TextId::GridKeepDebugFieldsTooltip)] = "Write the potential and growth fields every step, even when not shown, so exports include them.\nCosts some GPU bandwidth.";
     texts[static_cast<int>(TextId::GridTransformations)] = "Transformations:";
     texts[static_cast<int>(TextId::GridFlipHorizontal)] = "<->";
     texts[static_cast<int>(TextId::GridFlipHorizontalTooltip)] = "Flip horizontally (mirror left-right).";
@@ -315,6 +362,7 @@ void Localization::initEnglish() {
     texts[static_cast<int>(TextId::InfiniteNavigationTooltip)] = "Navigate between chunks. Use mouse drag to pan within a chunk.";
     texts[static_cast<int>(TextId::InfiniteChunkPosition)] = "Chunk Position: (%d, %d)";
     texts[static_cast<int>(TextId::InfiniteWorldOffset)] = "World Offset: (%.2f, %.2f)";
+    texts[static_cast<int>(TextId::InfiniteChunkStats)] = "Chunks: %d in VRAM, %d cached";
     texts[static_cast<int>(TextId::InfiniteHome)] = "Home";
     texts[static_cast<int>(TextId::InfiniteNavNorth)] = "N";
     texts[static_cast<int>(TextId::InfiniteNavWest)] = "W";
@@ -472,6 +520,21 @@ void Localization::initEnglish() {
     texts[static_cast<int>(TextId::SimStepFormat)] = "Step: %d";
     texts[static_cast<int>(TextId::SimTime)] = "Time";
     texts[static_cast<int>(TextId::SimTimeMs)] = "Sim: %.2f ms";
+    texts[static_cast<int>(TextId::SimIdleWhenPaused)] = "Idle When Paused";
+    texts[static_cast<int>(TextId::SimIdleWhenPausedTooltip)] = "Stop redrawing while paused and nothing changes.\nThe window wakes up on any input. Saves power and GPU time.";
+    texts[static_cast<int>(TextId::SimMaxSpeed)] = "Max Speed";
+    texts[static_cast<int>(TextId::SimMaxSpeedTooltip)] = "Simulate as fast as possible and redraw only a few times per second.\nRendering is also skipped entirely while the window is minimized.";
+    texts[static_cast<int>(TextId::SimThreaded)] = "Simulation Thread";
+    texts[static_cast<int>(TextId::SimThreadedTooltip)] = "Run the simulation on its own thread so its speed no longer depends on the display refresh rate.\nThe display always shows the latest finished state.";
+    texts[static_cast<int>(TextId::SimAutoSteps)] = "Auto Steps";
+    texts[static_cast<int>(TextId::SimAutoStepsTooltip)] = "Choose steps per frame automatically from the measured GPU time per step.\nFrame Budget: fill a fixed GPU time per frame.\nSteps/s: keep a fixed simulation rate whatever the frame rate.\nAdapts when the grid size, radius or rules change.";
+    texts[static_cast<int>(TextId::SimAutoStepsFrameBudget)] = "Frame Budget";
+    texts[static_cast<int>(TextId::SimAutoStepsRate)] = "Steps/s";
+    texts[static_cast<int>(TextId::SimAutoStepsBudgetMs)] = "GPU Budget (ms)";
+    texts[static_cast<int>(TextId::SimAutoStepsBudgetMsTooltip)] = "GPU time spent simulating per frame.\nKeep below the frame time (16.7 ms at 60 Hz) to leave room for rendering.";
+    texts[static_cast<int>(TextId::SimAutoStepsTargetRate)] = "Target Steps/s";
+    texts[static_cast<int>(TextId::SimAutoStepsTargetRateTooltip)] = "Simulation steps per second to sustain.\nCapped by what the GPU can actually run.";
+    texts[static_cast<int>(TextId::SimGpuStepMs)] = "GPU: %.3f ms/step";
     
     // Growth function section
     texts[static_cast<int>(TextId::GrowthType)] = "Growth Type";
@@ -639,6 +702,11 @@ void Localization::initEnglish() {
     texts[static_cast<int>(TextId::DisplayFilterBilinear)] = "Bilinear";
     texts[static_cast<int>(TextId::DisplayFilterNearest)] = "Nearest";
     texts[static_cast<int>(TextId::DisplayFilterSharpen)] = "Sharpen";
+    texts[static_cast<int>(TextId::DisplayPyramid)] = "Zoomed-Out Sampling";
+    texts[static_cast<int>(TextId::DisplayPyramidTooltip)] = "How cells are combined when several fall under one screen pixel.\nMean averages them, Max keeps thin bright structures, Min keeps gaps.";
+    texts[static_cast<int>(TextId::DisplayPyramidMean)] = "Mean";
+    texts[static_cast<int>(TextId::DisplayPyramidMax)] = "Max";
+    texts[static_cast<int>(TextId::DisplayPyramidMin)] = "Min";
     texts[static_cast<int>(TextId::DisplayEdgeDetect)] = "Edge Detection";
     texts[static_cast<int>(TextId::DisplayEdgeDetectTooltip)] = "Highlight edges in the visualization.";
     texts[static_cast<int>(TextId::DisplayGlowSettings)] = "Glow Settings";
@@ -847,7 +915,8 @@ void Localization::initFrench() {
         "+/- : Zoom | Flèches : Panoramique\n"
         "Début : Réinitialiser l'affichage | Tab : Basculer l'IU\n"
         "1-5 : Définir étapes/frame\n"
-        "F11 : Plein écran | Échap : Quitter";
+        "F5 : Sauver un point de reprise | F8 : Le recharger\n"
+        "F9 : Sauver la trace | F11 : Plein écran | Échap : Quitter";
     
     // Theory section
     texts[static_cast<int>(TextId::TheoryHeader)] = "Théorie";
@@ -969,6 +1038,39 @@ void Localization::initFrench() {
     texts[static_cast<int>(TextId::PerfFrameTimeGraphTitle)] = "Temps de Frame";
     texts[static_cast<int>(TextId::PerfFrameTimeGraphXLabel)] = "frames";
     texts[static_cast<int>(TextId::PerfFrameTimeGraphYLabel)] = "ms";
+    texts[static_cast<int>(TextId::PerfGpuPasses)] = "Passes GPU";
+    texts[static_cast<int>(TextId::PerfGpuPassesTooltip)] = "Temps GPU par passe mesuré par requêtes d'horodatage, avec quelques frames de retard. Le nombre indique combien de fois la passe a été exécutée.";
+    texts[static_cast<int>(TextId::PerfGpuPassKernelGen)] = "Noyau :";
+    texts[static_cast<int>(TextId::PerfGpuPassSimStep)] = "Simulation :";
+    texts[static_cast<int>(TextId::PerfGpuPassObstacles)] = "Obstacles :";
+    texts[static_cast<int>(TextId::PerfGpuPassAnalysis)] = "Analyse :";
+    texts[static_cast<int>(TextId::PerfGpuPassRender)] = "Rendu :";
+    texts[static_cast<int>(TextId::PerfGpuPassImGui)] = "Interface :";
+    texts[static_cast<int>(TextId::PerfGpuPassTime)] = "%.3f ms (%dx)";
+    texts[static_cast<int>(TextId::PerfGpuTotal)] = "Total :";
+    texts[static_cast<int>(TextId::PerfGpuNoData)] = "En attente des horodatages GPU...";
+    texts[static_cast<int>(TextId::PerfGpuThroughput)] = "Débit GPU :";
+    texts[static_cast<int>(TextId::PerfGpuThroughputTooltip)] = "Cellules mises à jour par seconde de temps GPU de simulation, hors surcoût CPU et temps d'attente.";
+    texts[static_cast<int>(TextId::PerfGpuBandwidth)] = "Bande passante :";
+    texts[static_cast<int>(TextId::PerfGpuBandwidthValue)] = "~%.1f Go/s";
+    texts[static_cast<int>(TextId::PerfGpuBandwidthTooltip)] = "Trafic mémoire estimé de la simulation : lectures et écritures des textures d'état et de débogage par pas, en supposant que le voisinage du noyau est servi par le cache.";
+    texts[static_cast<int>(TextId::PerfGpuTimeGraphTitle)] = "Temps GPU";
+    texts[static_cast<int>(TextId::PerfTraceRecord)] = "Enregistrer une Trace";
+    texts[static_cast<int>(TextId::PerfTraceRecordTooltip)] = "Enregistre les temps CPU et GPU des dernières frames. Sauvegardé en JSON Chrome trace dans log/ avec le bouton, F9 ou à la fermeture ; à ouvrir dans ui.perfetto.dev ou chrome://tracing.";
+    texts[static_cast<int>(TextId::PerfTraceSave)] = "Sauver la Trace";
+    texts[static_cast<int>(TextId::PerfTraceSaveTooltip)] = "Écrit la chronologie enregistrée dans log/lenia_trace_<date>.json (F9).";
+    texts[static_cast<int>(TextId::PerfRecord)] = "Enregistrer les images";
+    texts[static_cast<int>(TextId::PerfRecordTooltip)] = "Capture des images dans recordings/ pendant la simulation. Les lectures sont asynchrones :\nles images que l'écriture ne peut pas suivre sont abandonnées (et comptées) plutôt que de ralentir la simulation.";
+    texts[static_cast<int>(TextId::PerfRecordSource)] = "Source";
+    texts[static_cast<int>(TextId::PerfRecordSourceTooltip)] = "Image rendue telle qu'affichée (sans l'interface), ou textures brutes de l'état ou des champs à la résolution de la grille.";
+    texts[static_cast<int>(TextId::PerfRecordSourceFrame)] = "Image rendue";
+    texts[static_cast<int>(TextId::PerfRecordSourceState)] = "État brut";
+    texts[static_cast<int>(TextId::PerfRecordFormat)] = "Format";
+    texts[static_cast<int>(TextId::PerfRecordFormatPng)] = "Séquence PNG";
+    texts[static_cast<int>(TextId::PerfRecordFormatY4m)] = "Vidéo Y4M";
+    texts[static_cast<int>(TextId::PerfRecordEvery)] = "Toutes les N étapes";
+    texts[static_cast<int>(TextId::PerfRecordEveryTooltip)] = "Nombre minimal d'étapes de simulation entre deux images enregistrées.";
+    texts[static_cast<int>(TextId::PerfRecordStatus)] = "%d images, %d abandonnées";
     
     // Grid section - from English for brevity
     texts[static_cast<int>(TextId::GridSize)] = "Taille : %d x %d (%s cellules)";
@@ -976,6 +1078,19 @@ void Localization::initFrench() {
     texts[static_cast<int>(TextId::GridWidthTooltip)] = "Largeur de la grille en cellules. Les grilles plus grandes permettent des motifs plus complexes mais sont plus lentes. Doit être >= 32.";
     texts[static_cast<int>(TextId::GridHeight)] = "Hauteur";
     texts[static_cast<int>(TextId::GridHeightTooltip)] = "Hauteur de la grille en cellules. La grille s'enroule toroïdalement (les bords se connectent).";
+    texts[static_cast<int>(TextId::GridTileSize)] = "Taille des tuiles";
+    texts[static_cast<int>(TextId::GridTileSizeTooltip)] = "Les grilles de plus de cette taille par côté sont découpées en tuiles, chacune sa propre texture. 0 ne découpe que les grilles au-delà de la taille maximale de texture du GPU. Les grilles en tuiles n'ont qu'un canal et ne peuvent pas être dessinées.";
+    texts[static_cast<int>(TextId::GridTiledInfo)] = "En tuiles : %d x %d tuiles, 1 texel = %d x %d cellules";
+    texts[static_cast<int>(TextId::GridInPlace)] = "Mise à jour sur place";
+    texts[static_cast<int>(TextId::GridInPlaceTooltip)] = "Garde une seule texture d'état, mise à jour par bandes de lignes.\nDivise presque par deux la mémoire d'état des plus grandes grilles ;\nles vues de débogage n'allouent leurs tampons que si elles sont affichées.";
+    texts[static_cast<int>(TextId::GridCheckpointSave)] = "Sauver un point de reprise";
+    texts[static_cast<int>(TextId::GridCheckpointSaveTooltip)] = "Écrit la grille, les murs, les paramètres et le nombre d'étapes dans checkpoints/quick.lckp (F5).\nLe fichier est écrit en arrière-plan sans interrompre la simulation.";
+    texts[static_cast<int>(TextId::GridCheckpointLoad)] = "Charger le point de reprise";
+    texts[static_cast<int>(TextId::GridCheckpointLoadTooltip)] = "Restaure checkpoints/quick.lckp : taille et contenu de la grille, murs, paramètres et nombre d'étapes (F8).";
+    texts[static_cast<int>(TextId::GridExportNumpy)] = "Exporter en NumPy (.npz)";
+    texts[static_cast<int>(TextId::GridExportNumpyTooltip)] = "Écrit l'état, le masque des murs, le potentiel, la croissance et un recadrage autour de la plus grande créature dans exports/ (F6).\nÀ charger avec np.load() ; le fichier est écrit en arrière-plan.";
+    texts[static_cast<int>(TextId::GridKeepDebugFields)] = "Conserver potentiel/croissance";
+    texts[static_cast<int>(TextId::GridKeepDebugFieldsTooltip)] = "Écrit les champs de potentiel et de croissance à chaque étape, même s'ils ne sont pas affichés, pour les inclure dans les exports.\nCoûte un peu de bande passante GPU.";
     texts[static_cast<int>(TextId::GridTransformations)] = "Transformations :";
     texts[static_cast<int>(TextId::GridFlipHorizontal)] = "<->";
     texts[static_cast<int>(TextId::GridFlipHorizontalTooltip)] = "Retourner horizontalement (miroir gauche-droite).";
@@ -1019,6 +1134,7 @@ void Localization::initFrench() {
     texts[static_cast<int>(TextId::InfiniteNavigationTooltip)] = "Naviguer entre les blocs.";
     texts[static_cast<int>(TextId::InfiniteChunkPosition)] = "Position : (%d, %d)";
     texts[static_cast<int>(TextId::InfiniteWorldOffset)] = "Décalage : (%.2f, %.2f)";
+    texts[static_cast<int>(TextId::InfiniteChunkStats)] = "Blocs : %d en VRAM, %d en cache";
     texts[static_cast<int>(TextId::InfiniteHome)] = "Origine";
     texts[static_cast<int>(TextId::InfiniteNavNorth)] = "N";
     texts[static_cast<int>(TextId::InfiniteNavWest)] = "O";
@@ -1176,6 +1292,21 @@ void Localization::initFrench() {
     texts[static_cast<int>(TextId::SimStepFormat)] = "Étape : %d";
     texts[static_cast<int>(TextId::SimTime)] = "Temps";
     texts[static_cast<int>(TextId::SimTimeMs)] = "Sim : %.2f ms";
+    texts[static_cast<int>(TextId::SimIdleWhenPaused)] = "Veille en Pause";
+    texts[static_cast<int>(TextId::SimIdleWhenPausedTooltip)] = "Arrête le rendu en pause tant que rien ne change.\nLa fenêtre se réveille à la moindre entrée. Économise l'énergie et le GPU.";
+    texts[static_cast<int>(TextId::SimMaxSpeed)] = "Vitesse Max";
+    texts[static_cast<int>(TextId::SimMaxSpeedTooltip)] = "Simule le plus vite possible et ne redessine que quelques fois par seconde.\nLe rendu est aussi ignoré tant que la fenêtre est réduite.";
+    texts[static_cast<int>(TextId::SimThreaded)] = "Thread de Simulation";
+    texts[static_cast<int>(TextId::SimThreadedTooltip)] = "Exécute la simulation sur son propre thread afin que sa vitesse ne dépende plus du rafraîchissement de l'affichage.\nL'affichage montre toujours le dernier état terminé.";
+    texts[static_cast<int>(TextId::SimAutoSteps)] = "Pas Auto";
+    texts[static_cast<int>(TextId::SimAutoStepsTooltip)] = "Choisit automatiquement les pas par image selon le temps GPU mesuré par pas.\nBudget Image : remplit un temps GPU fixe par image.\nPas/s : maintient une vitesse de simulation fixe quelle que soit la fréquence d'affichage.\nS'adapte aux changements de taille de grille, de rayon ou de règles.";
+    texts[static_cast<int>(TextId::SimAutoStepsFrameBudget)] = "Budget Image";
+    texts[static_cast<int>(TextId::SimAutoStepsRate)] = "Pas/s";
+    texts[static_cast<int>(TextId::SimAutoStepsBudgetMs)] = "Budget GPU (ms)";
+    texts[static_cast<int>(TextId::SimAutoStepsBudgetMsTooltip)] = "Temps GPU consacré à la simulation par image.\nGarder sous la durée d'une image (16,7 ms à 60 Hz) pour laisser place au rendu.";
+    texts[static_cast<int>(TextId::SimAutoStepsTargetRate)] = "Pas/s Cible";
+    texts[static_cast<int>(TextId::SimAutoStepsTargetRateTooltip)] = "Nombre de pas de simulation par seconde à maintenir.\nLimité par ce que le GPU peut réellement exécuter.";
+    texts[static_cast<int>(TextId::SimGpuStepMs)] = "GPU : %.3f ms/pas";
     
     // Growth function section
     texts[static_cast<int>(TextId::GrowthType)] = "Type de Croissance";
@@ -1343,6 +1474,11 @@ void Localization::initFrench() {
     texts[static_cast<int>(TextId::DisplayFilterBilinear)] = "Bilinéaire";
     texts[static_cast<int>(TextId::DisplayFilterNearest)] = "Plus Proche";
     texts[static_cast<int>(TextId::DisplayFilterSharpen)] = "Netteté";
+    texts[static_cast<int>(TextId::DisplayPyramid)] = "Échantillonnage Dézoomé";
+    texts[static_cast<int>(TextId::DisplayPyramidTooltip)] = "Comment combiner les cellules lorsque plusieurs tombent sous un pixel.\nMoyenne les lisse, Max garde les structures fines, Min garde les vides.";
+    texts[static_cast<int>(TextId::DisplayPyramidMean)] = "Moyenne";
+    texts[static_cast<int>(TextId::DisplayPyramidMax)] = "Max";
+    texts[static_cast<int>(TextId::DisplayPyramidMin)] = "Min";
     texts[static_cast<int>(TextId::DisplayEdgeDetect)] = "Détection de Bords";
     texts[static_cast<int>(TextId::DisplayEdgeDetectTooltip)] = "Mettre en évidence les bords.";
     texts[static_cast<int>(TextId::DisplayGlowSettings)] = "Paramètres de Lueur";
@@ -130,6 +130,39 @@ enum class TextId {
     PerfFrameTimeGraphTitle,
     PerfFrameTimeGraphXLabel,
     PerfFrameTimeGraphYLabel,
+    PerfGpuPasses,
+    PerfGpuPassesTooltip,
+    PerfGpuPassKernelGen,
+    PerfGpuPassSimStep,
+    PerfGpuPassObstacles,
+    PerfGpuPassAnalysis,
+    PerfGpuPassRender,
+    PerfGpuPassImGui,
+    PerfGpuPassTime,
+    PerfGpuTotal,
+    PerfGpuNoData,
+    PerfGpuThroughput,
+    PerfGpuThroughputTooltip,
+    PerfGpuBandwidth,
+    PerfGpuBandwidthValue,
+    PerfGpuBandwidthTooltip,
+    PerfGpuTimeGraphTitle,
+    PerfTraceRecord,
+    PerfTraceRecordTooltip,
+    PerfTraceSave,
+    PerfTraceSaveTooltip,
+    PerfRecord,
+    PerfRecordTooltip,
+    PerfRecordSource,
+    PerfRecordSourceTooltip,
+    PerfRecordSourceFrame,
+    PerfRecordSourceState,
+    PerfRecordFormat,
+    PerfRecordFormatPng,
+    PerfRecordFormatY4m,
+    PerfRecordEvery,
+    PerfRecordEveryTooltip,
+    PerfRecordStatus,
     
     // Grid section
     GridSize,
@@ -137,6 +170,19 @@ enum class TextId {
     GridWidthTooltip,
     GridHeight,
     GridHeightTooltip,
+    GridTileSize,
+    GridTileSizeTooltip,
+    GridTiledInfo,
+    GridInPlace,
+    GridInPlaceTooltip,
+    GridCheckpointSave,
+    GridCheckpointSaveTooltip,
+    GridCheckpointLoad,
+    GridCheckpointLoadTooltip,
+    GridExportNumpy,
+    GridExportNumpyTooltip,
+    GridKeepDebugFields,
+    GridKeepDebugFieldsTooltip,
     GridTransformations,
     GridFlipHorizontal,
     GridFlipHorizontalTooltip,
@@ -180,6 +226,7 @@ enum class TextId {
     InfiniteNavigationTooltip,
     InfiniteChunkPosition,
     InfiniteWorldOffset,
+    InfiniteChunkStats,
     InfiniteHome,
     InfiniteNavNorth,
     InfiniteNavWest,
@@ -337,6 +384,21 @@ enum class TextId {
     SimStepFormat,
     SimTime,
     SimTimeMs,
+    SimIdleWhenPaused,
+    SimIdleWhenPausedTooltip,
+    SimMaxSpeed,
+    SimMaxSpeedTooltip,
+    SimThreaded,
+    SimThreadedTooltip,
+    SimAutoSteps,
+    SimAutoStepsTooltip,
+    SimAutoStepsFrameBudget,
+    SimAutoStepsRate,
+    SimAutoStepsBudgetMs,
+    SimAutoStepsBudgetMsTooltip,
+    SimAutoStepsTargetRate,
+    SimAutoStepsTargetRateTooltip,
+    SimGpuStepMs,
     
     // Growth function section
     GrowthType,
@@ -504,6 +566,11 @@ enum class TextId {
     DisplayFilterBilinear,
     DisplayFilterNearest,
     DisplayFilterSharpen,
+    DisplayPyramid,
+    DisplayPyramidTooltip,
+    DisplayPyramidMean,
+    DisplayPyramidMax,
+    DisplayPyramidMin,
     DisplayEdgeDetect,
     DisplayEdgeDetectTooltip,
     DisplayGlowSettings,
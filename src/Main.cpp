@@ -10,6 +10,7 @@
  */
 
 #include "Application.hpp"
+#include "HeadlessRunner.hpp"
 #include "Utils/Logger.hpp"
 #include <iostream>
 #include <exception>
@@ -72,9 +73,41 @@ static int runApplication() {
     return exitCode;
 }
 
+/**
+ * @brief Runs a windowless simulation configured from the command line.
+ * @return EXIT_SUCCESS on completion, EXIT_FAILURE on bad arguments or error.
+ */
+static int runHeadless(int argc, char** argv) {
+    lenia::HeadlessOptions opts;
+    if (!lenia::HeadlessRunner::parseArgs(argc, argv, opts)) {
+        lenia::HeadlessRunner::printUsage();
+        return EXIT_FAILURE;
+    }
+
+    lenia::Logger::init();
+    LOG_INFO("===== Lenia headless starting =====");
+    int exitCode = EXIT_FAILURE;
+    try {
+        lenia::HeadlessRunner runner;
+        exitCode = runner.run(opts);
+    } catch (const std::exception& e) {
+        LOG_FATAL("Unhandled exception: %s", e.what());
+    }
+    LOG_INFO("===== Lenia headless exiting (code %d) =====", exitCode);
+    lenia::Logger::shutdown();
+    return exitCode;
+}
+
 #ifdef _WIN32
 // Windows GUI subsystem entry point (no console window by default)
 int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
+    if (lenia::HeadlessRunner::wantsHeadless(__argc, __argv)) {
+        AttachConsole(ATTACH_PARENT_PROCESS);  // Report to the launching shell
+        FILE* fp;
+        freopen_s(&fp, "CONOUT$", "w", stdout);
+        freopen_s(&fp, "CONOUT$", "w", stderr);
+        return runHeadless(__argc, __argv);
+    }
     bool showConsole = readShowConsoleConfig();
     if (showConsole) {
         AllocConsole();  // Create console window for debug output
@@ -88,7 +121,8 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 #endif
 
 // Standard console entry point
-int main() {
+int main(int argc, char** argv) {
+    if (lenia::HeadlessRunner::wantsHeadless(argc, argv)) return runHeadless(argc, argv);
 #ifdef _WIN32
     bool showConsole = readShowConsoleConfig();
     if (showConsole) {
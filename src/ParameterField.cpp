@@ -0,0 +1,139 @@
+/**
+ * @file ParameterField.cpp
+ * @brief Implementation of the per-cell parameter maps.
+ */
+
+#include "ParameterField.hpp"
+#include "Utils/Logger.hpp"
+#include <algorithm>
+
+namespace lenia {
+
+ParameterField::~ParameterField() {
+    release();
+}
+
+void ParameterField::release() {
+    if (m_texture) glDeleteTextures(1, &m_texture);
+    m_texture = 0;
+    m_gridW = 0;
+    m_gridH = 0;
+    m_mask = 0;
+}
+
+void ParameterField::resize(int gridW, int gridH) {
+    if (gridW == m_gridW && gridH == m_gridH) return;
+    if (m_mask) LOG_INFO("Grid resized: parameter maps cleared.");
+    release();
+    m_gridW = gridW;
+    m_gridH = gridH;
+}
+
+bool ParameterField::slotIndex(FieldParam param, int channel, int& slot) const {
+    if (m_gridW <= 0 || m_gridH <= 0 || channel < 0 || channel >= MAX_CHANNELS) return false;
+    slot = channel * 3 + static_cast<int>(param);
+    return true;
+}
+
+int ParameterField::layerOf(uint32_t mask, int slot) {
+    int layer = 0;
+    for (int s = 0; s < slot; ++s)
+        if (mask & (1u << s)) ++layer;
+    return layer;
+}
+
+/**
+ * @brief Rebuild the texture with one layer per bit of @p mask, keeping the
+ *        maps that stay set; an empty mask frees it.
+ */
+void ParameterField::reallocate(uint32_t mask) {
+    GLuint texture = 0;
+    if (mask) {
+        int layers = layerOf(mask, SLOTS);
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &texture);
+        glTextureStorage3D(texture, 1, GL_R32F, m_gridW, m_gridH, layers);
+        glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        for (int s = 0; s < SLOTS; ++s) {
+            uint32_t bit = 1u << s;
+            if (!(mask & bit) || !(m_mask & bit)) continue;
+            glCopyImageSubData(m_texture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layerOf(m_mask, s),
+                               texture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layerOf(mask, s),
+                               m_gridW, m_gridH, 1);
+        }
+    }
+    if (m_texture) glDeleteTextures(1, &m_texture);
+    m_texture = texture;
+    m_mask = mask;
+}
+
+void ParameterField::upload(int slot, const float* data) {
+    if (!(m_mask & (1u << slot))) reallocate(m_mask | (1u << slot));
+    glTextureSubImage3D(m_texture, 0, 0, 0, layerOf(m_mask, slot), m_gridW, m_gridH, 1,
+                        GL_RED, GL_FLOAT, data);
+}
+
+void ParameterField::fillGradient(FieldParam param, int channel, float from, float to, int axis) {
+    int slot = 0;
+    if (!slotIndex(param, channel, slot)) return;
+
+    int n = (axis == 0) ? m_gridW : m_gridH;
+    std::vector<float> data(static_cast<size_t>(m_gridW) * m_gridH);
+    for (int y = 0; y < m_gridH; ++y) {
+        for (int x = 0; x < m_gridW; ++x) {
+            int i = (axis == 0) ? x : y;
+            float t = (n > 1) ? static_cast<float>(i) / static_cast<float>(n - 1) : 0.0f;
+            data[static_cast<size_t>(y) * m_gridW + x] = from + (to - from) * t;
+        }
+    }
+    upload(slot, data.data());
+}
+
+void ParameterField::fillTiles(FieldParam param, int channel, float from, float to, int tiles, int axis) {
+    int slot = 0;
+    if (!slotIndex(param, channel, slot)) return;
+
+    tiles = std::max(1, tiles);
+    int n = (axis == 0) ? m_gridW : m_gridH;
+    std::vector<float> data(static_cast<size_t>(m_gridW) * m_gridH);
+    for (int y = 0; y < m_gridH; ++y) {
+        for (int x = 0; x < m_gridW; ++x) {
+            int i = (axis == 0) ? x : y;
+            int tile = std::min(tiles - 1, i * tiles / std::max(1, n));
+            float t = (tiles > 1) ? static_cast<float>(tile) / static_cast<float>(tiles - 1) : 0.0f;
+            data[static_cast<size_t>(y) * m_gridW + x] = from + (to - from) * t;
+        }
+    }
+    upload(slot, data.data());
+}
+
+void ParameterField::fillData(FieldParam param, int channel, const float* data) {
+    int slot = 0;
+    if (!data || !slotIndex(param, channel, slot)) return;
+    upload(slot, data);
+}
+
+void ParameterField::clear(FieldParam param, int channel) {
+    uint32_t mask = m_mask;
+    for (int c = 0; c < MAX_CHANNELS; ++c)
+        if (channel < 0 || channel == c)
+            mask &= ~(1u << (c * 3 + static_cast<int>(param)));
+    if (mask != m_mask) reallocate(mask);
+}
+
+void ParameterField::clearAll() {
+    reallocate(0);
+}
+
+float ParameterField::valueAt(FieldParam param, int channel, int x, int y) const {
+    int slot = 0;
+    if (!slotIndex(param, channel, slot) || !(m_mask & (1u << slot))) return 0.0f;
+    if (x < 0 || y < 0 || x >= m_gridW || y >= m_gridH) return 0.0f;
+
+    float value = 0.0f;
+    glGetTextureSubImage(m_texture, 0, x, y, layerOf(m_mask, slot), 1, 1, 1,
+                         GL_RED, GL_FLOAT, sizeof(float), &value);
+    return value;
+}
+
+}
@@ -0,0 +1,84 @@
+/**
+ * @file ParameterField.hpp
+ * @brief Per-cell mu/sigma/dt maps that override the scalar growth parameters.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+namespace lenia {
+
+enum class FieldParam : int {
+    Mu    = 0,
+    Sigma = 1,
+    Dt    = 2
+};
+
+/**
+ * @brief Optional parameter maps read per cell by the simulation shaders.
+ *
+ * Maps are addressed by slot channel * 3 + param. A single-channel grid
+ * uses channel 0; in multi-channel mode every rule reads the maps of its
+ * destination channel, so a map replaces the mu/sigma/dt of all rules
+ * writing that channel.
+ *
+ * A parameter only overrides the scalar value once one of the fill helpers
+ * has written it; mask() has one bit per slot for the shaders. Only filled
+ * slots take memory: the R32F texture array holds one layer per set bit,
+ * in slot order, so slot s lives in layer bitCount(mask & ((1 << s) - 1)).
+ *
+ * Filling mu along x and sigma along y turns one grid into a continuous
+ * slice of parameter space, and the tile helper gives constant blocks so
+ * each creature lives under a single setting (phase diagrams).
+ */
+class ParameterField {
+public:
+    static constexpr int MAX_CHANNELS = 3;
+    static constexpr int SLOTS = MAX_CHANNELS * 3;
+
+    ParameterField() = default;
+    ~ParameterField();
+
+    ParameterField(const ParameterField&) = delete;
+    ParameterField& operator=(const ParameterField&) = delete;
+
+    /** @brief Size the maps to the grid; drops every map if the size changed.
+     *         Nothing is allocated until a map is filled. */
+    void resize(int gridW, int gridH);
+    void release();
+
+    /** @brief Linear ramp from @p from to @p to along x (axis 0) or y (axis 1). */
+    void fillGradient(FieldParam param, int channel, float from, float to, int axis);
+    /** @brief Like fillGradient, but in @p tiles constant bands (both ends included). */
+    void fillTiles(FieldParam param, int channel, float from, float to, int tiles, int axis);
+    /** @brief Upload an arbitrary map of gridW * gridH values, rows from y = 0. */
+    void fillData(FieldParam param, int channel, const float* data);
+    /** @brief Stop overriding @p param; channel -1 clears it on every channel. */
+    void clear(FieldParam param, int channel = -1);
+    void clearAll();
+
+    /** @brief Value a map holds at a cell (reads one texel back), e.g. to label results. */
+    float valueAt(FieldParam param, int channel, int x, int y) const;
+
+    bool   active() const { return m_mask != 0; }
+    /** @brief Bit (channel * 3 + param) set when that map overrides the scalar;
+     *         the set bits, in order, are the layers of texture(). */
+    uint32_t mask() const { return m_mask; }
+    GLuint texture() const { return m_texture; }
+
+private:
+    GLuint   m_texture{0};          // R32F array, one layer per bit of m_mask
+    int      m_gridW{0};
+    int      m_gridH{0};
+    uint32_t m_mask{0};
+
+    bool slotIndex(FieldParam param, int channel, int& slot) const;
+    static int layerOf(uint32_t mask, int slot);
+    void reallocate(uint32_t mask);
+    void upload(int slot, const float* data);
+};
+
+}
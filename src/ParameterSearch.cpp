@@ -0,0 +1,367 @@
+/**
+ * @file ParameterSearch.cpp
+ * @brief Implementation of the grid/random/evolutionary parameter search.
+ */
+
+#include "ParameterSearch.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace lenia {
+
+static constexpr int   SPEED_WINDOW = 16;        // Analysis samples for the median speed
+static constexpr float MOVING_SPEED = 0.02f;     // Cells per step
+
+const char* ParameterSearch::outcomeName(SearchOutcome outcome) {
+    switch (outcome) {
+        case SearchOutcome::Dead:     return "dead";
+        case SearchOutcome::Exploded: return "exploded";
+        case SearchOutcome::Chaotic:  return "chaotic";
+        case SearchOutcome::Stable:   return "stable";
+        case SearchOutcome::Periodic: return "periodic";
+        case SearchOutcome::Moving:   return "moving";
+        default:                      return "?";
+    }
+}
+
+/**
+ * @brief "prefix<N>rest" -> N and rest; false if the prefix or number is missing.
+ */
+static bool splitIndexed(const std::string& name, const char* prefix, int& index, std::string& rest) {
+    size_t len = std::char_traits<char>::length(prefix);
+    if (name.compare(0, len, prefix) != 0) return false;
+    size_t pos = len;
+    while (pos < name.size() && std::isdigit(static_cast<unsigned char>(name[pos]))) ++pos;
+    if (pos == len) return false;
+    index = std::atoi(name.substr(len, pos - len).c_str());
+    rest = name.substr(pos);
+    return true;
+}
+
+bool ParameterSearch::applyParam(LeniaParams& params, const std::string& name, float value) {
+    int idx = 0;
+    std::string rest;
+    if (name == "mu")     { params.mu = value; return true; }
+    if (name == "sigma")  { params.sigma = value; return true; }
+    if (name == "dt")     { params.dt = value; return true; }
+    if (name == "radius") { params.radius = std::max(1, static_cast<int>(std::lround(value))); return true; }
+    if (splitIndexed(name, "ring", idx, rest)) {
+        if (!rest.empty() || idx >= 16) return false;
+        params.ringWeights[idx] = value;
+        params.numRings = std::max(params.numRings, idx + 1);
+        return true;
+    }
+    if (splitIndexed(name, "rule", idx, rest)) {
+        if (idx >= 16) return false;
+        ChannelKernelRule& rule = params.kernelRules[idx];
+        if (rest == ".mu")       { rule.mu = value; return true; }
+        if (rest == ".sigma")    { rule.sigma = value; return true; }
+        if (rest == ".strength") { rule.growthStrength = value; return true; }
+        if (rest == ".radius")   { rule.radiusFraction = std::clamp(value, 0.05f, 1.0f); return true; }
+        int ring = 0;
+        std::string tail;
+        if (splitIndexed(rest, ".ring", ring, tail) && tail.empty() && ring < 16) {
+            rule.ringWeights[ring] = value;
+            rule.numRings = std::max(rule.numRings, ring + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParameterSearch::isKnownParam(const std::string& name) {
+    LeniaParams scratch;
+    return applyParam(scratch, name, 0.0f);
+}
+
+/**
+ * @brief Values of candidate @p index, from the seed, the index and earlier results only.
+ */
+std::vector<float> ParameterSearch::nextCandidate(const SearchOptions& opts, int index) const {
+    const auto& ranges = opts.ranges;
+    std::vector<float> values(ranges.size());
+    std::mt19937 rng(opts.seed * 2654435761u + static_cast<uint32_t>(index));
+
+    if (opts.strategy == SearchStrategy::Grid) {
+        int rem = index;
+        for (int r = static_cast<int>(ranges.size()) - 1; r >= 0; --r) {
+            int n = std::max(1, ranges[r].count);
+            int k = rem % n;
+            rem /= n;
+            values[r] = (n == 1) ? ranges[r].min
+                                 : ranges[r].min + (ranges[r].max - ranges[r].min) * static_cast<float>(k) / (n - 1);
+        }
+        return values;
+    }
+
+    // A range with min == max is a fixed value: both distributions need a nonzero width
+    auto uniform = [&](const SearchRange& r) {
+        if (r.min == r.max) return r.min;
+        return std::uniform_real_distribution<float>(std::min(r.min, r.max), std::max(r.min, r.max))(rng);
+    };
+
+    int population = std::max(2, opts.population);
+    int generation = index / population;
+    std::vector<const SearchCandidate*> parents;
+    if (opts.strategy == SearchStrategy::Evolve && generation > 0) {
+        for (const auto& c : m_results)
+            if (c.generation < generation) parents.push_back(&c);
+        std::sort(parents.begin(), parents.end(),
+                  [](const SearchCandidate* a, const SearchCandidate* b) { return a->score > b->score; });
+        parents.resize(std::min(parents.size(), static_cast<size_t>(std::max(2, population / 4))));
+    }
+
+    if (parents.empty()) {
+        for (size_t r = 0; r < ranges.size(); ++r) values[r] = uniform(ranges[r]);
+        return values;
+    }
+
+    // Best-of-history parents: optional uniform crossover, then Gaussian mutation
+    std::uniform_int_distribution<size_t> pick(0, parents.size() - 1);
+    std::uniform_real_distribution<float> coin(0.0f, 1.0f);
+    const SearchCandidate* a = parents[pick(rng)];
+    const SearchCandidate* b = parents[pick(rng)];
+    bool cross = coin(rng) < 0.3f;
+    for (size_t r = 0; r < ranges.size(); ++r) {
+        float lo = std::min(ranges[r].min, ranges[r].max);
+        float hi = std::max(ranges[r].min, ranges[r].max);
+        if (lo == hi) {
+            values[r] = lo;
+            continue;
+        }
+        float v = (cross && coin(rng) < 0.5f) ? b->values[r] : a->values[r];
+        v += std::normal_distribution<float>(0.0f, 0.1f * (hi - lo))(rng);
+        values[r] = std::clamp(v, lo, hi);
+    }
+    return values;
+}
+
+SearchCandidate ParameterSearch::evaluate(const SearchOptions& opts, const LeniaParams& base,
+                                          const std::vector<float>& values, int maxSteps) {
+    TRACE_SCOPE("ParameterSearch::evaluate");
+    LeniaParams params = base;
+    for (size_t r = 0; r < values.size(); ++r) applyParam(params, opts.ranges[r].name, values[r]);
+
+    bool multi = params.numKernelRules > 0;
+    if (multi) {
+        for (int r = 0; r < params.numKernelRules; ++r) m_engine.regenerateRuleKernel(r, params);
+    } else {
+        m_engine.regenerateKernel(params);
+    }
+    m_engine.reset(params);
+    m_engine.resetStepCount();
+    m_engine.resetAnalysis();
+
+    const AnalysisManager& mgr = m_engine.analysisMgr();
+    const float cells = static_cast<float>(m_engine.state().width()) * m_engine.state().height();
+    const int every = std::max(1, opts.analyzeEvery);
+
+    SearchCandidate c;
+    c.values = values;
+    c.outcome = SearchOutcome::Chaotic;
+    std::vector<float> speeds;
+    auto medianSpeed = [&]() {
+        if (speeds.empty()) return 0.0f;
+        std::vector<float> recent(speeds.end() - std::min<size_t>(speeds.size(), SPEED_WINDOW), speeds.end());
+        std::nth_element(recent.begin(), recent.begin() + recent.size() / 2, recent.end());
+        return recent[recent.size() / 2] / static_cast<float>(every);
+    };
+
+    bool culled = false;
+    while (c.steps < maxSteps) {
+        int n = std::min(every, maxSteps - c.steps);
+        if (multi) m_engine.updateMultiChannel(params, n);
+        else       m_engine.update(params, n);
+        c.steps += n;
+
+        m_engine.runAnalysis(params.analysisThreshold);
+        speeds.push_back(mgr.movementSpeed());
+        if (mgr.isEmpty()) {
+            c.outcome = SearchOutcome::Dead;
+            culled = true;
+            break;
+        }
+        if (static_cast<float>(mgr.data().aliveCount) > opts.explodeFraction * cells) {
+            c.outcome = SearchOutcome::Exploded;
+            culled = true;
+            break;
+        }
+        // Gliders also keep their mass; only a still blob is settled for good
+        if (mgr.isStabilized() && medianSpeed() < MOVING_SPEED) {
+            c.outcome = SearchOutcome::Stable;
+            break;
+        }
+    }
+
+    const AnalysisData& a = mgr.data();
+    c.mass   = a.totalMass;
+    c.alive  = a.aliveCount;
+    c.speed  = medianSpeed();
+    c.period = mgr.isPeriodic() ? mgr.detectedPeriod() * every : 0;
+
+    if (culled) {
+        c.score = 0.5f * static_cast<float>(c.steps) / static_cast<float>(std::max(1, maxSteps));
+        return c;
+    }
+
+    bool moving = c.speed >= MOVING_SPEED;
+    if (c.outcome != SearchOutcome::Stable) {
+        if (moving)                  c.outcome = SearchOutcome::Moving;
+        else if (mgr.isPeriodic())   c.outcome = SearchOutcome::Periodic;
+        else if (mgr.isStabilized()) c.outcome = SearchOutcome::Stable;
+    }
+    c.score = 1.0f + (moving ? 2.0f : 0.0f) + (mgr.isPeriodic() ? 1.0f : 0.0f) +
+              (mgr.isStabilized() ? 0.5f : 0.0f) + (1.0f - static_cast<float>(c.alive) / cells);
+    return c;
+}
+
+static void writeRow(std::ostream& out, const SearchCandidate& c) {
+    out << c.index << ',' << c.generation;
+    for (float v : c.values) out << ',' << v;
+    out << ',' << ParameterSearch::outcomeName(c.outcome) << ',' << c.score << ',' << c.steps << ','
+        << c.mass << ',' << c.alive << ',' << c.speed << ',' << c.period << '\n';
+}
+
+static void writeHeader(std::ostream& out, const SearchOptions& opts) {
+    out << "index,generation";
+    for (const auto& r : opts.ranges) out << ',' << r.name;
+    out << ",outcome,score,steps,mass,alive,speed,period\n";
+}
+
+bool ParameterSearch::appendLog(const SearchOptions& opts, const SearchCandidate& c, bool header) const {
+    std::ofstream log(opts.logPath, header ? (std::ios::out | std::ios::trunc) : (std::ios::out | std::ios::app));
+    if (!log.is_open()) return false;
+    if (header) writeHeader(log, opts);
+    else        writeRow(log, c);
+    return log.good();
+}
+
+/**
+ * @brief Restore earlier results; false if the log was written for other ranges.
+ */
+bool ParameterSearch::loadLog(const SearchOptions& opts) {
+    std::ifstream log(opts.logPath);
+    if (!log.is_open()) return true;  // Nothing to resume
+
+    std::ostringstream expected;
+    writeHeader(expected, opts);
+    std::string line;
+    if (!std::getline(log, line)) return true;
+    if (line + "\n" != expected.str()) {
+        LOG_ERROR("%s was written for different ranges; remove it or drop --resume.", opts.logPath.c_str());
+        return false;
+    }
+
+    while (std::getline(log, line)) {
+        std::vector<std::string> cols;
+        std::stringstream ss(line);
+        std::string col;
+        while (std::getline(ss, col, ',')) cols.push_back(col);
+        if (cols.size() != opts.ranges.size() + 9) continue;  // Torn last line
+
+        SearchCandidate c;
+        size_t k = 0;
+        c.index      = std::atoi(cols[k++].c_str());
+        c.generation = std::atoi(cols[k++].c_str());
+        for (size_t r = 0; r < opts.ranges.size(); ++r) c.values.push_back(std::strtof(cols[k++].c_str(), nullptr));
+        const std::string& outcome = cols[k++];
+        for (int o = 0; o <= static_cast<int>(SearchOutcome::Moving); ++o)
+            if (outcome == outcomeName(static_cast<SearchOutcome>(o))) c.outcome = static_cast<SearchOutcome>(o);
+        c.score  = std::strtof(cols[k++].c_str(), nullptr);
+        c.steps  = std::atoi(cols[k++].c_str());
+        c.mass   = std::strtof(cols[k++].c_str(), nullptr);
+        c.alive  = std::atoi(cols[k++].c_str());
+        c.speed  = std::strtof(cols[k++].c_str(), nullptr);
+        c.period = std::atoi(cols[k++].c_str());
+        m_results.push_back(std::move(c));
+    }
+    LOG_INFO("Resuming search: %zu candidates already in %s", m_results.size(), opts.logPath.c_str());
+    return true;
+}
+
+bool ParameterSearch::writeRanked(const SearchOptions& opts) const {
+    std::vector<const SearchCandidate*> ranked;
+    for (const auto& c : m_results) ranked.push_back(&c);
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const SearchCandidate* a, const SearchCandidate* b) { return a->score > b->score; });
+
+    std::ofstream out(opts.rankedPath, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        LOG_ERROR("Cannot write ranked results: %s", opts.rankedPath.c_str());
+        return false;
+    }
+    writeHeader(out, opts);
+    for (const auto* c : ranked) writeRow(out, *c);
+    return out.good();
+}
+
+int ParameterSearch::run(const SearchOptions& opts, const LeniaParams& base, int maxSteps) {
+    if (opts.ranges.empty()) {
+        LOG_FATAL("Search needs at least one --range.");
+        return EXIT_FAILURE;
+    }
+    for (const auto& r : opts.ranges) {
+        int idx = 0;
+        std::string rest;
+        if (splitIndexed(r.name, "rule", idx, rest) && idx >= base.numKernelRules)
+            LOG_WARN("%s has no effect: the preset has %d kernel rules.", r.name.c_str(), base.numKernelRules);
+    }
+
+    int budget = opts.budget;
+    if (opts.strategy == SearchStrategy::Grid) {
+        long long combos = 1;
+        for (const auto& r : opts.ranges) combos = std::min(combos * std::max(1, r.count), 1LL << 30);
+        budget = static_cast<int>(std::min<long long>(budget, combos));
+    }
+
+    m_results.clear();
+    if (opts.resume) {
+        if (!loadLog(opts)) return EXIT_FAILURE;
+    }
+    if (m_results.empty() && !appendLog(opts, SearchCandidate{}, true)) {
+        LOG_FATAL("Cannot write search log: %s", opts.logPath.c_str());
+        return EXIT_FAILURE;
+    }
+
+    int start = 0;
+    for (const auto& c : m_results) start = std::max(start, c.index + 1);
+    LOG_INFO("Search: %d candidates (%d to go), up to %d steps each",
+             budget, std::max(0, budget - start), maxSteps);
+
+    auto t0 = std::chrono::steady_clock::now();
+    long long stepsRun = 0;
+    int population = std::max(2, opts.population);
+    for (int index = start; index < budget; ++index) {
+        SearchCandidate c = evaluate(opts, base, nextCandidate(opts, index), maxSteps);
+        c.index = index;
+        c.generation = (opts.strategy == SearchStrategy::Evolve) ? index / population : 0;
+        stepsRun += c.steps;
+
+        std::ostringstream desc;
+        for (size_t r = 0; r < c.values.size(); ++r)
+            desc << (r ? " " : "") << opts.ranges[r].name << '=' << c.values[r];
+        LOG_INFO("[%d/%d] %-8s score %.3f after %d steps  %s", index + 1, budget,
+                 outcomeName(c.outcome), c.score, c.steps, desc.str().c_str());
+
+        m_results.push_back(c);
+        appendLog(opts, c, false);
+        if ((index + 1) % 10 == 0) writeRanked(opts);
+    }
+
+    if (!writeRanked(opts)) return EXIT_FAILURE;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    long long fullSteps = static_cast<long long>(std::max(0, budget - start)) * maxSteps;
+    LOG_INFO("Search done in %.1f s; early culling ran %lld of %lld possible steps. Ranking in %s",
+             seconds, stepsRun, fullSteps, opts.rankedPath.c_str());
+    return EXIT_SUCCESS;
+}
+
+}
@@ -0,0 +1,110 @@
+/**
+ * @file ParameterSearch.hpp
+ * @brief Unattended exploration of LeniaParams ranges with early culling.
+ */
+
+#pragma once
+
+#include "LeniaEngine.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief One searched parameter: "mu", "sigma", "dt", "radius", "ring<j>",
+ * or per rule "rule<i>.mu", ".sigma", ".strength", ".radius", ".ring<j>".
+ */
+struct SearchRange {
+    std::string name;
+    float min{0.0f};
+    float max{0.0f};
+    int   count{5};      // Grid strategy: values from min to max
+};
+
+enum class SearchStrategy : int {
+    Grid   = 0,          // Every combination of the range values
+    Random = 1,          // Uniform samples
+    Evolve = 2           // Mutations and crossovers of the best so far
+};
+
+struct SearchOptions {
+    SearchStrategy strategy{SearchStrategy::Random};
+    std::vector<SearchRange> ranges;
+    int         budget{200};             // Candidates to evaluate (including resumed ones)
+    int         population{16};          // Evolve: candidates per generation
+    int         analyzeEvery{4};         // Steps between analysis samples
+    float       explodeFraction{0.6f};   // Alive share of the grid that counts as exploded
+    uint32_t    seed{1};
+    std::string logPath{"search_log.csv"};      // Append-only progress, read back by --resume
+    std::string rankedPath{"search_ranked.csv"};
+    bool        resume{false};
+};
+
+enum class SearchOutcome : int {
+    Dead     = 0,        // Became empty
+    Exploded = 1,        // Filled the grid
+    Chaotic  = 2,        // Alive to the end, no clear structure
+    Stable   = 3,        // Constant mass and not moving
+    Periodic = 4,        // Mass oscillates with a detected period
+    Moving   = 5         // Alive and travelling (glider-like)
+};
+
+struct SearchCandidate {
+    int   index{0};
+    int   generation{0};
+    std::vector<float> values;   // One per SearchRange
+    SearchOutcome outcome{SearchOutcome::Dead};
+    float score{0.0f};
+    int   steps{0};              // Steps actually simulated
+    float mass{0.0f};
+    int   alive{0};
+    float speed{0.0f};           // Cells per step
+    int   period{0};             // In steps, 0 if none
+};
+
+/**
+ * @brief Runs candidates one after another on an initialised engine.
+ *
+ * Each candidate starts from the base parameters with the searched values
+ * applied, is reset, and is stepped up to the step budget while the
+ * AnalysisManager samples it every few steps. Empty or exploded grids are
+ * culled at the first sample that shows it, and a still blob ends as soon
+ * as it has been stable for the analysis window, so GPU time goes to the
+ * survivors.
+ *
+ * Score: culled candidates get half their surviving share of the steps;
+ * survivors get 1, plus 2 if moving, 1 if periodic, 0.5 if stable, plus
+ * the empty share of the grid (compact patterns rank higher).
+ *
+ * Every result is appended to the log as soon as it is known, so an
+ * interrupted search resumes where it stopped with --resume. Candidates
+ * are derived from the seed, the candidate index and earlier results only,
+ * which makes a resumed search continue exactly as the original would have.
+ */
+class ParameterSearch {
+public:
+    explicit ParameterSearch(LeniaEngine& engine) : m_engine(engine) {}
+
+    /** @brief True if @p name is a searchable parameter. */
+    static bool isKnownParam(const std::string& name);
+    static const char* outcomeName(SearchOutcome outcome);
+
+    /** @brief Run to the budget; returns the process exit code. */
+    int run(const SearchOptions& opts, const LeniaParams& base, int maxSteps);
+
+private:
+    LeniaEngine&                 m_engine;
+    std::vector<SearchCandidate> m_results;
+
+    static bool applyParam(LeniaParams& params, const std::string& name, float value);
+    std::vector<float> nextCandidate(const SearchOptions& opts, int index) const;
+    SearchCandidate evaluate(const SearchOptions& opts, const LeniaParams& base,
+                             const std::vector<float>& values, int maxSteps);
+    bool loadLog(const SearchOptions& opts);
+    bool appendLog(const SearchOptions& opts, const SearchCandidate& c, bool header) const;
+    bool writeRanked(const SearchOptions& opts) const;
+};
+
+}
@@ -14,6 +14,12 @@
 #include "Presets.hpp"
 #include "PresetData.inc"
 #include "AnimalData.inc"
+#include "AnimalCatalog.hpp"
+#include "Utils/Logger.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <unordered_set>
 #include <vector>
 #include <string>
 #include <cstring>
@@ -215,6 +221,8 @@ static std::vector<Preset> s_presets = {
 
 static bool s_presetsBuilt = false;
 
+static void registerCatalogPresets();
+
 static void buildUnifiedPresets() {
     if (s_presetsBuilt) return;
     s_presetsBuilt = true;
@@ -246,6 +254,7 @@ static void buildUnifiedPresets() {
         p.cellData = a.cells;
         s_presets.push_back(p);
     }
+    registerCatalogPresets();
 }
 
 const std::vector<Preset>& getPresets() {
@@ -563,8 +572,163 @@ static void initMultiChannelPresets() {
 }
 
 const std::vector<MultiChannelPreset>& getMultiChannelPresets() {
+    buildUnifiedPresets();
     initMultiChannelPresets();
     return s_multiChannelPresets;
 }
 
+static const char* CATALOG_DIR = "Initialisation";
+
+/**
+ * @brief A catalog species with a "kernels" list; its cells are decoded into
+ *        @c channels the first time the preset is used.
+ */
+struct CatalogCells {
+    const AnimalCatalog* catalog;
+    int  entry;
+    int  preset;
+    int  multiChannel;
+    bool decoded;
+    std::vector<std::vector<float>> channels;
+};
+
+static std::vector<CatalogCells> s_catalogCells;
+static std::mutex s_catalogMutex;
+static std::vector<std::string> s_catalogNames;     // Display names made unique
+
+/// Lenia's kernel cores (kn) and growth functions (gn) in this engine's terms
+static KernelType catalogKernelType(int kernelCore, int numRings) {
+    if (kernelCore == 3 || kernelCore == 4) return KernelType::StepUnimodal;
+    return numRings > 1 ? KernelType::MultiringBump4 : KernelType::Bump4;
+}
+
+static GrowthType catalogGrowthType(int growthFunc) {
+    if (growthFunc == 2) return GrowthType::Lenia;
+    if (growthFunc == 3) return GrowthType::Step;
+    return GrowthType::Quad4;
+}
+
+/**
+ * @brief Append the species of every catalog in Initialisation/ as presets.
+ *
+ * Single-kernel species point their speciesFile at "<catalog>#<index>",
+ * which the species library decodes on first use. Species with a "kernels"
+ * list get a MultiChannelPreset instead, under the Multichannel or
+ * Multi-Kernel category like the built-in ones.
+ */
+static void registerCatalogPresets() {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    std::vector<std::string> files;
+    for (const auto& item : fs::directory_iterator(CATALOG_DIR, ec))
+        if (item.path().extension() == ".json") files.push_back(item.path().filename().string());
+    std::sort(files.begin(), files.end());
+
+    std::vector<const AnimalCatalog*> catalogs;
+    size_t total = 0;
+    for (const auto& file : files) {
+        const AnimalCatalog* catalog = AnimalCatalog::shared(std::string(CATALOG_DIR) + "/" + file);
+        if (!catalog) continue;
+        catalogs.push_back(catalog);
+        total += catalog->entries().size();
+    }
+    if (catalogs.empty()) return;
+
+    // Names and cell slots are pointed into: no reallocation once filled
+    s_catalogNames.reserve(total);
+    s_catalogCells.reserve(total);
+    std::unordered_set<std::string> names;
+    for (const auto& p : s_presets) names.insert(p.name);
+
+    int skipped = 0;
+    for (const AnimalCatalog* catalog : catalogs) {
+        const auto& entries = catalog->entries();
+        for (int i = 0; i < static_cast<int>(entries.size()); ++i) {
+            const CatalogEntry& e = entries[i];
+            if (e.channels > 3) {
+                ++skipped;
+                continue;
+            }
+            std::string name = e.name;
+            if (!names.insert(name).second) name += " (" + e.code + ")";
+            names.insert(name);
+            s_catalogNames.push_back(name);
+
+            const CatalogKernel& k = e.kernels[0];
+            Preset p{};
+            p.name = s_catalogNames.back().c_str();
+            p.category = e.category.c_str();
+            p.mu = k.mu;
+            p.sigma = k.sigma;
+            p.dt = e.dt;
+            p.radius = e.radius;
+            p.numRings = k.numRings;
+            for (int j = 0; j < 16; ++j)
+                p.ringWeights[j] = k.ringWeights[j];
+            p.kernelType = catalogKernelType(e.kernelCore, k.numRings);
+            p.growthType = catalogGrowthType(e.growthFunc);
+            p.initMode = InitMode::Species;
+            p.gridW = e.multiKernel ? 256 : 350;
+            p.gridH = p.gridW;
+            p.speciesFile = e.multiKernel ? nullptr : e.reference.c_str();
+            p.placement = PlacementMode::Center;
+
+            if (e.multiKernel) {
+                p.category = (e.channels > 1) ? "Multichannel" : "Multi-Kernel";
+                MultiChannelPreset mcp{};
+                mcp.name = p.name;
+                mcp.category = p.category;
+                mcp.radius = e.radius;
+                mcp.dt = e.dt;
+                mcp.gridW = p.gridW;
+                mcp.gridH = p.gridH;
+                mcp.numChannels = (e.channels > 1) ? e.channels : 3;    // Rules run on RGBA, as for Fish
+                mcp.numRules = std::min(static_cast<int>(e.kernels.size()), 16);
+                for (int r = 0; r < mcp.numRules; ++r) {
+                    const CatalogKernel& ck = e.kernels[r];
+                    MultiChannelPresetRule& rule = mcp.rules[r];
+                    for (int j = 0; j < 16; ++j)
+                        rule.ringWeights[j] = ck.ringWeights[j];
+                    rule.mu = ck.mu;
+                    rule.sigma = ck.sigma;
+                    rule.growthStrength = ck.growthStrength;
+                    rule.radiusFraction = ck.radiusFraction;
+                    rule.numRings = ck.numRings;
+                    rule.sourceChannel = ck.sourceChannel;
+                    rule.destChannel = ck.destChannel;
+                    rule.kernelType = static_cast<int>(catalogKernelType(e.kernelCore, ck.numRings));
+                    rule.growthType = static_cast<int>(catalogGrowthType(e.growthFunc));
+                }
+                s_catalogCells.push_back({catalog, i, static_cast<int>(s_presets.size()),
+                                          static_cast<int>(s_multiChannelPresets.size()), false, {}});
+                s_multiChannelPresets.push_back(mcp);
+            }
+            s_presets.push_back(p);
+        }
+    }
+    if (skipped > 0)
+        LOG_WARN("Presets: %d catalog species with more than 3 channels skipped", skipped);
+    LOG_INFO("Presets: %zu species from %zu catalogs", s_catalogNames.size(), catalogs.size());
+}
+
+bool prepareCatalogPreset(int presetIndex) {
+    std::lock_guard<std::mutex> lock(s_catalogMutex);
+    for (auto& cells : s_catalogCells) {
+        if (cells.preset != presetIndex) continue;
+        if (cells.decoded) return true;
+        int rows = 0, cols = 0;
+        if (!cells.catalog->decode(cells.entry, cells.channels, rows, cols)) return false;
+        cells.decoded = true;
+
+        MultiChannelPreset& mcp = s_multiChannelPresets[cells.multiChannel];
+        const float** planes[3] = {&mcp.cellsCh0, &mcp.cellsCh1, &mcp.cellsCh2};
+        for (int c = 0; c < 3; ++c)
+            *planes[c] = (c < static_cast<int>(cells.channels.size())) ? cells.channels[c].data() : nullptr;
+        mcp.cellRows = rows;
+        mcp.cellCols = cols;
+        return true;
+    }
+    return false;
+}
+
 }
@@ -66,4 +66,7 @@ const std::vector<KernelPreset>& getKernelPresets();
 /// Get multi-channel presets with cross-channel interactions
 const std::vector<MultiChannelPreset>& getMultiChannelPresets();
 
+/// Decode the cells of a multi-kernel catalog preset on first use; false for other presets
+bool prepareCatalogPreset(int presetIndex);
+
 }
@@ -21,12 +21,17 @@ Renderer::~Renderer() {
     if (m_vao)            glDeleteVertexArrays(1, &m_vao);
     if (m_colormapTex)    glDeleteTextures(1, &m_colormapTex);
     if (m_displaySampler) glDeleteSamplers(1, &m_displaySampler);
+    if (m_pyramidSampler) glDeleteSamplers(1, &m_pyramidSampler);
+    if (m_postUBO)        glDeleteBuffers(1, &m_postUBO);
+    if (m_postColorTex)   glDeleteTextures(1, &m_postColorTex);
+    if (m_postGlowTex)    glDeleteTextures(1, &m_postGlowTex);
     for (auto t : m_customColormapTextures)
         if (t) glDeleteTextures(1, &t);
 }
 
-bool Renderer::init(const std::string& vertPath, const std::string& fragPath) {
+bool Renderer::init(const std::string& vertPath, const std::string& fragPath, const std::string& postPath) {
     if (!m_displayShader.loadGraphics(vertPath, fragPath)) return false;
+    if (!m_postShader.loadCompute(postPath)) return false;
     createEmptyVAO();
     generateColormap();
 
@@ -34,10 +39,133 @@ bool Renderer::init(const std::string& vertPath, const std::string& fragPath) {
     glSamplerParameteri(m_displaySampler, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glSamplerParameteri(m_displaySampler, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
+    glCreateSamplers(1, &m_pyramidSampler);
+    glSamplerParameteri(m_pyramidSampler, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glSamplerParameteri(m_pyramidSampler, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    glCreateBuffers(1, &m_postUBO);
+    glNamedBufferStorage(m_postUBO, sizeof(GPUPostParams), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
     return true;
 }
 
-void Renderer::draw(GLuint stateTexture, int viewportW, int viewportH, const LeniaParams& params) {
+/**
+ * @brief Mip level of the state texture matching the current screen density.
+ *
+ * Mirrors the aspect/zoom mapping of display.frag: returns log2 of the
+ * number of grid cells covered by one screen pixel (0 at 1:1, 1 when
+ * two cells map to a pixel, negative when magnified).
+ */
+float Renderer::minificationLod(int viewportW, int viewportH, const LeniaParams& params) {
+    if (viewportW <= 0 || viewportH <= 0 || params.gridW <= 0 || params.gridH <= 0 || params.zoom <= 0.0f)
+        return 0.0f;
+    float gridAspect = static_cast<float>(params.gridW) / static_cast<float>(params.gridH);
+    float viewAspect = static_cast<float>(viewportW) / static_cast<float>(viewportH);
+    float relAspect = viewAspect / gridAspect;
+    float spanX = (relAspect > 1.0f) ? relAspect : 1.0f;
+    float spanY = (relAspect > 1.0f) ? 1.0f : 1.0f / relAspect;
+    float cellsPerPixelX = static_cast<float>(params.gridW) * spanX / (params.zoom * static_cast<float>(viewportW));
+    float cellsPerPixelY = static_cast<float>(params.gridH) * spanY / (params.zoom * static_cast<float>(viewportH));
+    return std::log2(std::max(cellsPerPixelX, cellsPerPixelY));
+}
+
+/**
+ * @brief Bake per-cell effects into the grid-resolution color cache.
+ *
+ * Skipped entirely when neither the state revision nor any effect
+ * setting changed since the last bake, so a paused or slowly stepping
+ * simulation costs a single texture fetch per screen pixel.
+ */
+void Renderer::updatePostCache(GLuint stateTexture, GLuint cmapTex, const LeniaParams& params,
+                               uint64_t stateRevision) {
+    GLint w = 0, h = 0;
+    glGetTextureLevelParameteriv(stateTexture, 0, GL_TEXTURE_WIDTH, &w);
+    glGetTextureLevelParameteriv(stateTexture, 0, GL_TEXTURE_HEIGHT, &h);
+    if (w <= 0 || h <= 0) return;
+
+    if (w != m_postW || h != m_postH || !m_postColorTex) {
+        if (m_postColorTex) glDeleteTextures(1, &m_postColorTex);
+        if (m_postGlowTex)  glDeleteTextures(1, &m_postGlowTex);
+        m_postColorTex = createTexture2D(w, h, GL_RGBA8);
+        m_postGlowTex  = createTexture2D(w, h, GL_R32F);
+        m_postW = w;
+        m_postH = h;
+        m_postValid = false;
+    }
+
+    GPUPostParams p{};
+    p.gridW = w;
+    p.gridH = h;
+    p.displayMode = params.displayMode;
+    p.colormapMode = params.colormapMode;
+    p.filterMode = params.filterMode;
+    p.multiChannel = params.numChannels > 1 ? 1 : 0;
+    p.multiChannelBlend = params.multiChannelBlend;
+    p.useColormapForMultichannel = params.useColormapForMultichannel ? 1 : 0;
+    p.cmapReverse = params.cmapReverse ? 1 : 0;
+    p.clipNullCells = params.clipToZero ? 1 : 0;
+    p.contourLevels = params.contourLevels;
+    p.pass = 0;
+    p.brightness = params.brightness;
+    p.contrast = params.contrast;
+    p.gamma = params.gamma;
+    p.edgeStrength = params.edgeStrength;
+    p.glowStrength = params.glowStrength;
+    p.cmapOffset = params.cmapOffset;
+    p.cmapRange0 = params.cmapRange0;
+    p.cmapRange1 = params.cmapRange1;
+    p.cmapPower = params.cmapPower;
+    p.cmapHueShift = params.cmapHueShift;
+    p.cmapSaturation = params.cmapSaturation;
+    p.clipThreshold = params.clipThreshold;
+    p.contourThickness = params.contourThickness;
+    p.channelWeightR = params.channelWeightR;
+    p.channelWeightG = params.channelWeightG;
+    p.channelWeightB = params.channelWeightB;
+
+    if (m_postValid && stateRevision == m_postRevision &&
+        std::memcmp(&p, &m_postParams, sizeof(GPUPostParams)) == 0)
+        return;
+    m_postParams = p;
+    m_postRevision = stateRevision;
+    m_postValid = true;
+
+    m_postShader.use();
+    glBindBufferBase(GL_UNIFORM_BUFFER, 5, m_postUBO);
+    glBindTextureUnit(0, stateTexture);
+    glBindTextureUnit(1, cmapTex);
+    glBindImageTexture(0, m_postGlowTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    glBindImageTexture(1, m_postColorTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+
+    bool mainPath = params.displayMode < 5 || params.displayMode > 9;
+    if (mainPath && params.glowStrength > 0.0f) {
+        glNamedBufferSubData(m_postUBO, 0, sizeof(GPUPostParams), &p);
+        dispatchCompute2D(w, h);
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+    }
+
+    p.pass = 1;
+    glNamedBufferSubData(m_postUBO, 0, sizeof(GPUPostParams), &p);
+    glBindTextureUnit(2, m_postGlowTex);
+    dispatchCompute2D(w, h);
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+}
+
+void Renderer::draw(GLuint stateTexture, int viewportW, int viewportH, const LeniaParams& params,
+                    const StatePyramid* pyramid, uint64_t stateRevision) {
+    GLuint cmapTex = m_colormapTex;
+    int cmIdx = params.colormapMode;
+    if (cmIdx >= 8 && (cmIdx - 8) < static_cast<int>(m_customColormapTextures.size())) {
+        cmapTex = m_customColormapTextures[cmIdx - 8];
+    }
+
+    // Vector-field glyphs are drawn at sub-cell scale and the debug/kernel
+    // views bind other textures; minified views go through the pyramid.
+    bool usePostCache = pyramid == nullptr && params.displayMode != 1 && params.displayMode != 2 &&
+                        params.displayMode != 3 && params.displayMode != 5;
+    if (usePostCache)
+        updatePostCache(stateTexture, cmapTex, params, stateRevision);
+
     glViewport(0, 0, viewportW, viewportH);
     glClearColor(params.bgR, params.bgG, params.bgB, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
@@ -129,14 +257,30 @@ void Renderer::draw(GLuint stateTexture, int viewportW, int viewportH, const Len
         glProgramUniform3f(m_displayShader.id(), gcLoc, params.glowR, params.glowG, params.glowB);
     m_displayShader.setFloat("uGlowIntensity", params.glowIntensity);
 
-    glBindTextureUnit(0, stateTexture);
-    glBindSampler(0, m_displaySampler);
+    // Pyramid level 0 is half resolution, so state LOD 1 maps to pyramid LOD 0
+    float pyramidLod = -1.0f;
+    if (pyramid && pyramid->meanTexture() && params.displayPyramid != 0) {
+        pyramidLod = std::clamp(minificationLod(viewportW, viewportH, params) - 1.0f,
+                                0.0f, static_cast<float>(pyramid->levels() - 1));
+        GLenum pyrFilter = (params.filterMode == 1) ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR;
+        glSamplerParameteri(m_pyramidSampler, GL_TEXTURE_MIN_FILTER, pyrFilter);
+        glSamplerParameteri(m_pyramidSampler, GL_TEXTURE_MAG_FILTER, filter);
+        glBindTextureUnit(2, pyramid->meanTexture());
+        glBindSampler(2, m_pyramidSampler);
+        glBindTextureUnit(3, pyramid->extremaTexture());
+        glBindSampler(3, m_pyramidSampler);
+    }
+    m_displayShader.setFloat("uPyramidLod", pyramidLod);
+    m_displayShader.setInt("uPyramidMode", params.displayPyramid);
 
-    GLuint cmapTex = m_colormapTex;
-    int cmIdx = params.colormapMode;
-    if (cmIdx >= 8 && (cmIdx - 8) < static_cast<int>(m_customColormapTextures.size())) {
-        cmapTex = m_customColormapTextures[cmIdx - 8];
+    m_displayShader.setInt("uUsePostCache", usePostCache ? 1 : 0);
+    if (usePostCache) {
+        glBindTextureUnit(4, m_postColorTex);
+        glBindSampler(4, m_displaySampler);
     }
+
+    glBindTextureUnit(0, stateTexture);
+    glBindSampler(0, m_displaySampler);
     glBindTextureUnit(1, cmapTex);
 
     glBindVertexArray(m_vao);
@@ -144,6 +288,12 @@ void Renderer::draw(GLuint stateTexture, int viewportW, int viewportH, const Len
     glBindVertexArray(0);
 
     glBindSampler(0, 0);
+    if (pyramidLod >= 0.0f) {
+        glBindSampler(2, 0);
+        glBindSampler(3, 0);
+    }
+    if (usePostCache)
+        glBindSampler(4, 0);
 }
 
 void Renderer::createEmptyVAO() {
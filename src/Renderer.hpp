@@ -8,9 +8,11 @@
 #include <glad/glad.h>
 #include "Utils/Shader.hpp"
 #include "UIOverlay.hpp"
+#include "StatePyramid.hpp"
 #include <string>
 #include <vector>
 #include <array>
+#include <cstdint>
 
 namespace lenia {
 
@@ -30,6 +32,12 @@ struct ColormapData {
  * - Grid overlay rendering
  * - Edge detection and glow effects
  * - Zoom and pan transformations
+ * - Pre-filtered pyramid sampling when zoomed out
+ *
+ * Per-cell effects (sharpen, Sobel, glow, colormap, contours) are baked
+ * into a grid-resolution color cache by a compute pass that only reruns
+ * when the state or the effect settings change; the fragment shader then
+ * just resamples it and adds screen-space overlays.
  */
 class Renderer {
 public:
@@ -39,8 +47,10 @@ public:
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
 
-    bool init(const std::string& vertPath, const std::string& fragPath);
-    void draw(GLuint stateTexture, int viewportW, int viewportH, const LeniaParams& params);
+    bool init(const std::string& vertPath, const std::string& fragPath, const std::string& postPath);
+    void draw(GLuint stateTexture, int viewportW, int viewportH, const LeniaParams& params,
+              const StatePyramid* pyramid, uint64_t stateRevision);
+    static float minificationLod(int viewportW, int viewportH, const LeniaParams& params);
     void loadCustomColormaps(const std::string& colormapDir);
     int customColormapCount() const { return static_cast<int>(m_customColormapNames.size()); }
     const std::vector<std::string>& customColormapNames() const { return m_customColormapNames; }
@@ -50,9 +60,18 @@ public:
 
 private:
     Shader m_displayShader;
+    Shader m_postShader;
     GLuint m_vao{0};
     GLuint m_colormapTex{0};
     GLuint m_displaySampler{0};
+    GLuint m_pyramidSampler{0};
+    GLuint m_postUBO{0};
+    GLuint m_postColorTex{0};     // RGBA8 colorized world at grid resolution
+    GLuint m_postGlowTex{0};      // R32F horizontal glow pass
+    int    m_postW{0};
+    int    m_postH{0};
+    bool   m_postValid{false};
+    uint64_t m_postRevision{0};   // State revision the cache was built from
     std::vector<GLuint> m_customColormapTextures;
     std::vector<std::string> m_customColormapNames;
     std::vector<ColormapData> m_customColormapData;
@@ -60,6 +79,39 @@ private:
     void createEmptyVAO();
     void generateColormap();
     GLuint loadColormapFromFile(const std::string& path, ColormapData& outData);
+    void updatePostCache(GLuint stateTexture, GLuint cmapTex, const LeniaParams& params, uint64_t stateRevision);
+
+    struct alignas(16) GPUPostParams {
+        int32_t gridW;
+        int32_t gridH;
+        int32_t displayMode;
+        int32_t colormapMode;
+        int32_t filterMode;
+        int32_t multiChannel;
+        int32_t multiChannelBlend;
+        int32_t useColormapForMultichannel;
+        int32_t cmapReverse;
+        int32_t clipNullCells;
+        int32_t contourLevels;
+        int32_t pass;
+        float   brightness;
+        float   contrast;
+        float   gamma;
+        float   edgeStrength;
+        float   glowStrength;
+        float   cmapOffset;
+        float   cmapRange0;
+        float   cmapRange1;
+        float   cmapPower;
+        float   cmapHueShift;
+        float   cmapSaturation;
+        float   clipThreshold;
+        float   contourThickness;
+        float   channelWeightR;
+        float   channelWeightG;
+        float   channelWeightB;
+    };
+    GPUPostParams m_postParams{};
 };
 
 }
@@ -13,6 +13,7 @@ namespace lenia {
 
 SimulationState::~SimulationState() {
     destroyTextures();
+    releaseBands();
 }
 
 void SimulationState::init(int width, int height, GLenum internalFormat) {
@@ -65,29 +66,31 @@ void SimulationState::resize(int width, int height) {
 
     glTextureSubImage2D(m_textures[0], 0, offX, offY, copyW, copyH,
                         pixelFormat, GL_FLOAT, region.data());
-    glTextureSubImage2D(m_textures[1], 0, offX, offY, copyW, copyH,
-                        pixelFormat, GL_FLOAT, region.data());
+    if (!m_single)
+        glTextureSubImage2D(m_textures[1], 0, offX, offY, copyW, copyH,
+                            pixelFormat, GL_FLOAT, region.data());
 }
 
 /**
  * @brief Swap read and write textures after a simulation step.
  */
 void SimulationState::swap() {
-    m_current = 1 - m_current;
+    if (!m_single) m_current = 1 - m_current;
 }
 
 /**
  * @brief Clear both textures to zero (empty grid).
  */
 void SimulationState::clear() {
+    int count = m_single ? 1 : 2;
     if (m_format == GL_RGBA32F) {
         float zero[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-        glClearTexImage(m_textures[0], 0, GL_RGBA, GL_FLOAT, zero);
-        glClearTexImage(m_textures[1], 0, GL_RGBA, GL_FLOAT, zero);
+        for (int i = 0; i < count; ++i)
+            glClearTexImage(m_textures[i], 0, GL_RGBA, GL_FLOAT, zero);
     } else {
         float zero = 0.0f;
-        glClearTexImage(m_textures[0], 0, GL_RED, GL_FLOAT, &zero);
-        glClearTexImage(m_textures[1], 0, GL_RED, GL_FLOAT, &zero);
+        for (int i = 0; i < count; ++i)
+            glClearTexImage(m_textures[i], 0, GL_RED, GL_FLOAT, &zero);
     }
     m_current = 0;
 }
@@ -102,8 +105,9 @@ void SimulationState::uploadRegion(int dstX, int dstY, int w, int h, const float
     // Update both buffers to keep them synchronized
     glTextureSubImage2D(m_textures[m_current], 0, dstX, dstY, w, h,
                         GL_RED, GL_FLOAT, data);
-    glTextureSubImage2D(m_textures[1 - m_current], 0, dstX, dstY, w, h,
-                        GL_RED, GL_FLOAT, data);
+    if (!m_single)
+        glTextureSubImage2D(m_textures[1 - m_current], 0, dstX, dstY, w, h,
+                            GL_RED, GL_FLOAT, data);
 }
 
 /**
@@ -112,12 +116,131 @@ void SimulationState::uploadRegion(int dstX, int dstY, int w, int h, const float
 void SimulationState::uploadRegionRGBA(int dstX, int dstY, int w, int h, const float* data) {
     glTextureSubImage2D(m_textures[m_current], 0, dstX, dstY, w, h,
                         GL_RGBA, GL_FLOAT, data);
-    glTextureSubImage2D(m_textures[1 - m_current], 0, dstX, dstY, w, h,
-                        GL_RGBA, GL_FLOAT, data);
+    if (!m_single)
+        glTextureSubImage2D(m_textures[1 - m_current], 0, dstX, dstY, w, h,
+                            GL_RGBA, GL_FLOAT, data);
+}
+
+void SimulationState::setSingleBuffer(bool single) {
+    if (single == m_single) return;
+    m_single = single;
+    if (!m_textures[m_current]) return;     // Applied by the next init()
+    if (single) {
+        GLuint keep = m_textures[m_current];
+        glDeleteTextures(1, &m_textures[1 - m_current]);
+        m_textures[0] = keep;
+        m_textures[1] = 0;
+        m_current = 0;
+    } else {
+        m_textures[1] = createTexture2D(m_width, m_height, m_format);
+        glCopyImageSubData(m_textures[0], GL_TEXTURE_2D, 0, 0, 0, 0,
+                           m_textures[1], GL_TEXTURE_2D, 0, 0, 0, 0,
+                           m_width, m_height, 1);
+        releaseBands();
+    }
+}
+
+/**
+ * @brief Prepare the strips for one in-place step and save the first halo rows.
+ *
+ * The last band's lower halo wraps to rows that the first band has already
+ * overwritten, so those are copied before any band runs. Grids shorter than
+ * two halos are done as one band.
+ */
+void SimulationState::beginBands(int bandRows, int halo, GLenum wrapY) {
+    m_halo = std::max(1, halo);
+    m_wrapY = wrapY;
+    m_bandRows = (m_height < 2 * m_halo) ? m_height : std::clamp(bandRows, 1, m_height);
+
+    if (m_stripW != m_width || m_stripRows != m_bandRows ||
+        m_stripHalo != m_halo || m_stripFormat != m_format) {
+        releaseBands();
+        m_window = createTexture2D(m_width, m_bandRows + 2 * m_halo, m_format);
+        m_carry  = createTexture2D(m_width, m_halo, m_format);
+        m_wrap   = createTexture2D(m_width, m_halo, m_format);
+        m_stripW = m_width;
+        m_stripRows = m_bandRows;
+        m_stripHalo = m_halo;
+        m_stripFormat = m_format;
+    }
+
+    if (bandCount() > 1) {
+        glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+        glCopyImageSubData(m_textures[m_current], GL_TEXTURE_2D, 0, 0, 0, 0,
+                           m_wrap, GL_TEXTURE_2D, 0, 0, 0, 0,
+                           m_width, m_halo, 1);
+    }
+}
+
+/**
+ * @brief Assemble the window for band @p index from the untouched rows below
+ *        it, the carried rows above it and the saved first rows.
+ */
+SimulationState::Band SimulationState::loadBand(int index) {
+    Band band;
+    band.y = index * m_bandRows;
+    band.rows = std::min(m_bandRows, m_height - band.y);
+    band.readY = band.y - m_halo;
+
+    int carryY = band.y - m_halo;          // Grid row held by carry row 0
+    auto locate = [&](int windowRow, GLuint& tex, int& srcY) {
+        int row = sourceRow(band.readY + windowRow);
+        if (row >= band.y)      { tex = m_textures[m_current]; srcY = row; }
+        else if (row >= carryY) { tex = m_carry; srcY = row - carryY; }
+        else                    { tex = m_wrap;  srcY = row; }
+    };
+
+    glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+    int windowRows = band.rows + 2 * m_halo;
+    for (int i = 0; i < windowRows;) {
+        GLuint tex;
+        int srcY;
+        locate(i, tex, srcY);
+        int run = 1;
+        for (; i + run < windowRows; ++run) {
+            GLuint nextTex;
+            int nextY;
+            locate(i + run, nextTex, nextY);
+            if (nextTex != tex || nextY != srcY + run) break;
+        }
+        glCopyImageSubData(tex, GL_TEXTURE_2D, 0, 0, srcY, 0,
+                           m_window, GL_TEXTURE_2D, 0, 0, i, 0,
+                           m_width, run, 1);
+        i += run;
+    }
+
+    // The next band's upper halo is this band's last rows, unchanged in the window
+    if (band.y + band.rows < m_height)
+        glCopyImageSubData(m_window, GL_TEXTURE_2D, 0, 0, band.rows, 0,
+                           m_carry, GL_TEXTURE_2D, 0, 0, 0, 0,
+                           m_width, m_halo, 1);
+    return band;
+}
+
+void SimulationState::releaseBands() {
+    if (!m_window) return;
+    GLuint strips[3] = {m_window, m_carry, m_wrap};
+    glDeleteTextures(3, strips);
+    m_window = m_carry = m_wrap = 0;
+    m_stripW = m_stripRows = m_stripHalo = 0;
+    m_stripFormat = 0;
+}
+
+/**
+ * @brief Row read for grid row @p y, which may lie past an edge, per the wrap mode.
+ */
+int SimulationState::sourceRow(int y) const {
+    int h = m_height;
+    if (m_wrapY == GL_REPEAT) return ((y % h) + h) % h;
+    if (m_wrapY == GL_MIRRORED_REPEAT) {
+        int m = ((y % (2 * h)) + 2 * h) % (2 * h);
+        return (m < h) ? m : 2 * h - 1 - m;
+    }
+    return std::clamp(y, 0, h - 1);
 }
 
 void SimulationState::createTextures() {
-    for (int i = 0; i < 2; ++i) {
+    for (int i = 0; i < (m_single ? 1 : 2); ++i) {
         m_textures[i] = createTexture2D(m_width, m_height, m_format);
     }
     clear();
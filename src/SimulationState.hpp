@@ -18,9 +18,24 @@ namespace lenia {
  * and one for writing the next state. After each simulation step,
  * the textures are swapped. This allows efficient GPU-based updates
  * without read-write hazards.
+ *
+ * In single-buffer mode only one texture is kept and a step updates it in
+ * place, band by band: beginBands() saves the first halo rows, loadBand()
+ * copies a band and its halo rows (pre-step values) into a small window
+ * texture and keeps the band's last halo rows for the next one. The shader
+ * reads the window and writes the state, so memory is one state copy plus
+ * strips of bandRows + 4 halo rows.
  */
 class SimulationState {
 public:
+    static constexpr int DEFAULT_BAND_ROWS = 256;   // Rows updated per in-place dispatch
+
+    struct Band {
+        int y{0};         // First grid row updated
+        int rows{0};      // Rows updated
+        int readY{0};     // Grid row held by window row 0 (y - halo)
+    };
+
     SimulationState() = default;
     ~SimulationState();
 
@@ -34,8 +49,19 @@ public:
     void uploadRegion(int dstX, int dstY, int w, int h, const float* data);
     void uploadRegionRGBA(int dstX, int dstY, int w, int h, const float* data);
 
+    /** @brief Drop (or restore) the second texture, keeping the contents. */
+    void setSingleBuffer(bool single);
+    bool singleBuffer() const { return m_single; }
+    /** @brief Start an in-place step; @p wrapY (GL wrap mode) decides what the halos hold past the top and bottom. */
+    void beginBands(int bandRows, int halo, GLenum wrapY);
+    int  bandCount() const { return (m_height + m_bandRows - 1) / m_bandRows; }
+    /** @brief Fill the window with band @p index and its halo rows, as they were before the step. */
+    Band loadBand(int index);
+    void releaseBands();
+
     GLuint currentTexture() const { return m_textures[m_current]; }
     GLuint nextTexture()    const { return m_textures[1 - m_current]; }
+    GLuint windowTexture()  const { return m_window; }
 
     int width()  const { return m_width; }
     int height() const { return m_height; }
@@ -47,9 +73,22 @@ private:
     int    m_width{0};            // Grid width in cells
     int    m_height{0};           // Grid height in cells
     GLenum m_format{GL_R32F};     // Texture format (R32F or RGBA32F)
+    bool   m_single{false};       // Only m_textures[0] exists, updated in place
+
+    GLuint m_window{0};           // bandRows + 2 halo rows of pre-step values
+    GLuint m_carry{0};            // Last halo rows of the previous band, pre-step
+    GLuint m_wrap{0};             // First halo rows of the grid, pre-step
+    int    m_bandRows{DEFAULT_BAND_ROWS};
+    int    m_halo{0};
+    GLenum m_wrapY{GL_REPEAT};
+    int    m_stripW{0};           // Size and format the strips were made for
+    int    m_stripRows{0};
+    int    m_stripHalo{0};
+    GLenum m_stripFormat{0};
 
     void createTextures();
     void destroyTextures();
+    int  sourceRow(int y) const;
 };
 
 }
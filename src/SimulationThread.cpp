@@ -0,0 +1,341 @@
+/**
+ * @file SimulationThread.cpp
+ * @brief Implementation of the worker-thread simulation loop and frame hand-off.
+ */
+
+#include "SimulationThread.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+namespace lenia {
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+/**
+ * @brief Create the shared context and launch the worker.
+ *
+ * Must be called from the thread owning mainWindow's context. All engine
+ * resources created so far are finished before the worker starts using them.
+ */
+bool SimulationThread::start(GLFWwindow* mainWindow, LeniaEngine& engine, const LeniaParams& params) {
+    if (running()) return true;
+
+    glfwDefaultWindowHints();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, glfwGetWindowAttrib(mainWindow, GLFW_CONTEXT_VERSION_MAJOR));
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, glfwGetWindowAttrib(mainWindow, GLFW_CONTEXT_VERSION_MINOR));
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    m_context = glfwCreateWindow(1, 1, "Lenia Simulation", nullptr, mainWindow);
+    if (!m_context) {
+        LOG_ERROR("Could not create a shared GL context for the simulation thread.");
+        return false;
+    }
+
+    m_engine = &engine;
+    m_params = params;
+    m_quit.store(false);
+    glFinish();
+
+    m_thread = std::thread(&SimulationThread::threadMain, this);
+    LOG_INFO("Simulation thread started.");
+    return true;
+}
+
+/**
+ * @brief Join the worker and release the display slots.
+ *
+ * Queued commands that did not run yet are dropped.
+ */
+void SimulationThread::stop() {
+    if (!running()) return;
+
+    m_quit.store(true, std::memory_order_release);
+    notify();
+    m_thread.join();
+
+    Command pending;
+    while (m_commands.pop(pending)) {}
+
+    for (Slot& slot : m_slots) {
+        if (slot.writeFence) glDeleteSync(slot.writeFence);
+        if (slot.readFence)  glDeleteSync(slot.readFence);
+        if (slot.state.tex)  glDeleteTextures(1, &slot.state.tex);
+        if (slot.debug.tex)  glDeleteTextures(1, &slot.debug.tex);
+        slot = Slot{};
+    }
+    m_back = 0;
+    m_front = 1;
+    m_ready.store(2);
+
+    glfwDestroyWindow(m_context);
+    m_context = nullptr;
+    LOG_INFO("Simulation thread stopped.");
+}
+
+void SimulationThread::notify() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        ++m_wakeCount;
+    }
+    m_wake.notify_one();
+}
+
+void SimulationThread::post(Command cmd) {
+    while (!m_commands.push(cmd)) {
+        notify();
+        std::this_thread::yield();
+    }
+    notify();
+}
+
+/**
+ * @brief Run a command and wait until a frame reflecting it is published.
+ *
+ * Used for commands that write caller-owned params or replace textures the
+ * display reads (kernels, grid size), so the caller never sees a stale mix.
+ * When syncParams is given, the thread adopts it after the command ran.
+ */
+void SimulationThread::postAndWait(Command cmd, const LeniaParams* syncParams) {
+    struct Done {
+        std::mutex              mutex;
+        std::condition_variable cv;
+        bool                    done{false};
+    };
+    auto done = std::make_shared<Done>();
+    post([this, &cmd, syncParams, done](LeniaEngine& engine) {
+        cmd(engine);
+        if (syncParams) m_params = *syncParams;
+        publish(m_lastSimTimeMs);
+        {
+            std::lock_guard<std::mutex> lock(done->mutex);
+            done->done = true;
+        }
+        done->cv.notify_one();
+    });
+    std::unique_lock<std::mutex> lock(done->mutex);
+    done->cv.wait(lock, [&]() { return done->done; });
+}
+
+void SimulationThread::setParams(const LeniaParams& params) {
+    post([this, params](LeniaEngine&) { m_params = params; });
+}
+
+void SimulationThread::setPaused(bool paused) {
+    m_paused.store(paused, std::memory_order_release);
+    if (!paused) m_stepRequests.store(0);
+    notify();
+}
+
+void SimulationThread::requestStep() {
+    m_stepRequests.fetch_add(1);
+    notify();
+}
+
+bool SimulationThread::drainCommands() {
+    bool any = false;
+    Command cmd;
+    while (m_commands.pop(cmd)) {
+        TRACE_GL_SCOPE("SimulationThread::command");
+        cmd(*m_engine);
+        cmd = nullptr;
+        any = true;
+    }
+    return any;
+}
+
+void SimulationThread::threadMain() {
+    using Clock = std::chrono::steady_clock;
+    glfwMakeContextCurrent(m_context);
+    GpuProfiler::makeCurrent(&m_gpuProfiler);
+    Tracer::setThreadName("Simulation");
+    publish(0.0f);
+
+    const auto tick = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(TICK_SECONDS));
+    auto nextTick = Clock::now();
+    auto lastBatch = nextTick - tick;
+    while (!m_quit.load(std::memory_order_acquire)) {
+        uint32_t wake;
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            wake = m_wakeCount;
+        }
+        m_gpuProfiler.beginFrame();
+        bool changed = drainCommands();
+        m_engine->pollReadbacks();
+
+        bool paused = m_paused.load(std::memory_order_acquire);
+        bool step = !paused;
+        if (paused && m_stepRequests.load() > 0) {
+            m_stepRequests.fetch_sub(1);
+            step = true;
+        }
+
+        if (!step) {
+            m_gpuProfiler.endFrame();
+            if (changed) {
+                publish(m_lastSimTimeMs);
+            } else {
+                // A save or export in progress is polled again shortly, even when paused
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                auto woken = [&]() { return m_wakeCount != wake; };
+                if (m_engine->readbacksPending())
+                    m_wake.wait_for(lock, std::chrono::milliseconds(READBACK_POLL_MS), woken);
+                else
+                    m_wake.wait(lock, woken);
+            }
+            nextTick = Clock::now();
+            lastBatch = nextTick - tick;
+            continue;
+        }
+
+        auto t0 = Clock::now();
+        double interval = std::chrono::duration<double>(t0 - lastBatch).count();
+        lastBatch = t0;
+
+        int steps = std::max(1, m_stepsPerBatch.load(std::memory_order_relaxed));
+        if (!paused) steps = m_stepController.stepsForNextBatch(m_params, steps, interval);
+
+        if (steps > 0) {
+            m_stepController.beginBatch();
+            if (m_params.numKernelRules > 0) {
+                m_engine->updateMultiChannel(m_params, steps);
+            } else {
+                m_engine->update(m_params, steps);
+            }
+            m_stepController.endBatch(steps);
+            m_gpuProfiler.endFrame();
+            auto t1 = Clock::now();
+            m_lastSimTimeMs = std::chrono::duration<float, std::milli>(t1 - t0).count();
+            m_lastSteps = steps;
+            publish(m_lastSimTimeMs);
+
+            // Let the previous batch finish before queueing another one
+            if (m_batchFence) {
+                TRACE_SCOPE("SimulationThread::waitBatch");
+                glClientWaitSync(m_batchFence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+                glDeleteSync(m_batchFence);
+            }
+            m_batchFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        } else {
+            m_gpuProfiler.endFrame();
+            if (m_params.maxSpeed)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));  // Rate target reached
+        }
+
+        if (!m_params.maxSpeed && !paused) {
+            nextTick = std::max(nextTick + tick, t0);
+            std::this_thread::sleep_until(nextTick);
+        }
+    }
+
+    if (m_batchFence) {
+        glDeleteSync(m_batchFence);
+        m_batchFence = nullptr;
+    }
+    m_stepController.release();
+    m_gpuProfiler.release();
+    glFinish();
+    glfwMakeContextCurrent(nullptr);
+}
+
+/**
+ * @brief (Re)allocate dst to match and copy src into it.
+ */
+void SimulationThread::copyInto(CopyTarget& dst, GLuint src, int w, int h, GLenum format) {
+    if (!dst.tex || dst.w != w || dst.h != h || dst.format != format) {
+        if (dst.tex) glDeleteTextures(1, &dst.tex);
+        glCreateTextures(GL_TEXTURE_2D, 1, &dst.tex);
+        glTextureStorage2D(dst.tex, 1, format, w, h);
+        dst.w = w;
+        dst.h = h;
+        dst.format = format;
+    }
+    glCopyImageSubData(src, GL_TEXTURE_2D, 0, 0, 0, 0,
+                       dst.tex, GL_TEXTURE_2D, 0, 0, 0, 0, w, h, 1);
+}
+
+/**
+ * @brief Copy the current state into the back slot and make it the ready one.
+ */
+void SimulationThread::publish(float simTimeMs) {
+    TRACE_GL_SCOPE("SimulationThread::publish");
+    Slot& slot = m_slots[m_back];
+    if (slot.readFence) {
+        glWaitSync(slot.readFence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(slot.readFence);
+        slot.readFence = nullptr;
+    }
+    if (slot.writeFence) {
+        glDeleteSync(slot.writeFence);
+        slot.writeFence = nullptr;
+    }
+
+    StateSnapshot snap = m_engine->snapshot();
+    copyInto(slot.state, snap.stateTex, snap.gridW, snap.gridH, snap.format);
+    snap.stateTex = slot.state.tex;
+
+    // Only the debug texture on screen (or being recorded) is worth copying
+    int field = LeniaEngine::debugField(m_params);
+    GLuint debugSrc = (field == 1) ? snap.neighborSumsTex :
+                      (field == 2) ? snap.growthTex : 0;
+    snap.neighborSumsTex = 0;
+    snap.growthTex = 0;
+    GLint debugW = 0, debugH = 0;
+    if (debugSrc) {
+        glGetTextureLevelParameteriv(debugSrc, 0, GL_TEXTURE_WIDTH, &debugW);
+        glGetTextureLevelParameteriv(debugSrc, 0, GL_TEXTURE_HEIGHT, &debugH);
+    }
+    // Debug outputs lag a grid resize until the next step
+    if (debugSrc && debugW == snap.gridW && debugH == snap.gridH) {
+        copyInto(slot.debug, debugSrc, snap.gridW, snap.gridH, GL_RGBA32F);
+        if (field == 1) snap.neighborSumsTex = slot.debug.tex;
+        else                           snap.growthTex = slot.debug.tex;
+    }
+
+    slot.frame.snapshot = snap;
+    slot.frame.simTimeMs = simTimeMs;
+    slot.frame.stepsPerBatch = m_lastSteps;
+    slot.frame.gpuStepMs = m_stepController.gpuStepMs();
+    slot.frame.gpuTimes = m_gpuProfiler.latest();
+    slot.writeFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    int prev = m_ready.exchange(m_back | NEW_FRAME_BIT, std::memory_order_acq_rel);
+    m_back = prev & ~NEW_FRAME_BIT;
+}
+
+/**
+ * @brief Take the newest published frame for display.
+ *
+ * The wait on the copy fence is queued on the GPU, so the CPU never blocks.
+ */
+bool SimulationThread::acquireFrame(SimFrame& out) {
+    if (m_ready.load(std::memory_order_acquire) & NEW_FRAME_BIT) {
+        int prev = m_ready.exchange(m_front, std::memory_order_acq_rel);
+        m_front = prev & ~NEW_FRAME_BIT;
+    }
+
+    Slot& slot = m_slots[m_front];
+    if (!slot.state.tex) return false;
+    if (slot.writeFence) {
+        glWaitSync(slot.writeFence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(slot.writeFence);
+        slot.writeFence = nullptr;
+    }
+    out = slot.frame;
+    return true;
+}
+
+void SimulationThread::releaseFrame() {
+    Slot& slot = m_slots[m_front];
+    if (slot.readFence) glDeleteSync(slot.readFence);
+    slot.readFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();  // The simulation context waits on this fence
+}
+
+}
@@ -0,0 +1,132 @@
+/**
+ * @file SimulationThread.hpp
+ * @brief Runs the simulation on a worker thread with its own shared GL context.
+ */
+
+#pragma once
+
+#define GLFW_INCLUDE_NONE
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include "LeniaEngine.hpp"
+#include "GpuProfiler.hpp"
+#include "StepController.hpp"
+#include "Utils/SpscQueue.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace lenia {
+
+/**
+ * @brief One state published by the simulation thread for display.
+ */
+struct SimFrame {
+    StateSnapshot snapshot;      // stateTex is a private copy owned by the thread
+    float         simTimeMs{0};  // Duration of the batch that produced it
+    int           stepsPerBatch{0};  // Steps the last batch ran (auto steps may change it)
+    float         gpuStepMs{0};  // Measured GPU time per step
+    GpuPassTimes  gpuTimes;      // Per-pass GPU time of a recent batch
+};
+
+/**
+ * @brief Decouples simulation stepping from the render/UI loop.
+ *
+ * Once started, the worker thread owns the LeniaEngine's simulation side:
+ * every engine mutation must go through post()/postAndWait(), which push
+ * onto a lock-free SPSC queue drained between batches. After each batch
+ * the current state is copied into one of three display textures and
+ * handed over with a fence, so the main thread always draws a complete
+ * state without ever waiting for the simulation:
+ *
+ *   sim:  step -> copy into back slot -> fence -> swap back/ready
+ *   main: swap ready/front if new -> wait fence (GPU side) -> draw -> fence
+ *
+ * Batches run at a fixed tick rate (or back to back in max-speed mode)
+ * regardless of the display refresh rate.
+ */
+class SimulationThread {
+public:
+    using Command = std::function<void(LeniaEngine&)>;
+
+    SimulationThread() = default;
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    bool start(GLFWwindow* mainWindow, LeniaEngine& engine, const LeniaParams& params);
+    void stop();
+    bool running() const { return m_thread.joinable(); }
+
+    /** @brief Queue an engine command; runs on the simulation thread. */
+    void post(Command cmd);
+    /** @brief Queue a command and block until it ran; optionally adopt params afterwards. */
+    void postAndWait(Command cmd, const LeniaParams* syncParams = nullptr);
+
+    void setParams(const LeniaParams& params);
+    void setPaused(bool paused);
+    void setStepsPerBatch(int steps) { m_stepsPerBatch.store(steps, std::memory_order_relaxed); }
+    void requestStep();
+
+    /** @brief Latest published frame; returns false until the first one exists. */
+    bool acquireFrame(SimFrame& out);
+    /** @brief Mark the acquired frame as no longer read by queued GL commands. */
+    void releaseFrame();
+
+private:
+    struct CopyTarget {
+        GLuint tex{0};
+        int    w{0};
+        int    h{0};
+        GLenum format{0};
+    };
+
+    struct Slot {
+        CopyTarget state;                 // Copy of the simulation state
+        CopyTarget debug;                 // Copy of the displayed debug texture (modes 1/2)
+        GLsync     writeFence{nullptr};   // Signalled when the copies are complete
+        GLsync     readFence{nullptr};    // Signalled when display reads are complete
+        SimFrame   frame;
+    };
+
+    static constexpr int    SLOT_COUNT = 3;
+    static constexpr int    NEW_FRAME_BIT = 4;
+    static constexpr size_t QUEUE_CAPACITY = 1024;
+    static constexpr double TICK_SECONDS = 1.0 / 60.0;  // Batch rate when not in max-speed mode
+    static constexpr int    READBACK_POLL_MS = 5;       // Paused wait while a save or export is pending
+
+    GLFWwindow*       m_context{nullptr};  // Hidden window sharing the main context
+    LeniaEngine*      m_engine{nullptr};
+    std::thread       m_thread;
+    LeniaParams       m_params;            // Simulation thread copy
+    StepController    m_stepController;    // Queries live in this thread's context
+    GpuProfiler       m_gpuProfiler;       // Likewise; current on the simulation thread
+
+    SpscQueue<Command, QUEUE_CAPACITY> m_commands;
+    std::mutex              m_wakeMutex;
+    std::condition_variable m_wake;
+    uint32_t                m_wakeCount{0};  // Bumped on every post, waited on when idle (m_wakeMutex)
+    std::atomic<bool>     m_quit{false};
+    std::atomic<bool>     m_paused{true};
+    std::atomic<int>      m_stepsPerBatch{1};
+    std::atomic<int>      m_stepRequests{0};
+
+    Slot             m_slots[SLOT_COUNT];
+    int              m_back{0};            // Simulation thread only
+    int              m_front{1};           // Main thread only
+    std::atomic<int> m_ready{2};           // Latest finished slot, | NEW_FRAME_BIT if unseen
+    GLsync           m_batchFence{nullptr};  // Keeps at most one batch queued on the GPU
+    float            m_lastSimTimeMs{0.0f};
+    int              m_lastSteps{0};
+
+    void threadMain();
+    bool drainCommands();
+    void publish(float simTimeMs);
+    static void copyInto(CopyTarget& dst, GLuint src, int w, int h, GLenum format);
+    void notify();
+};
+
+}
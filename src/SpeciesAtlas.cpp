@@ -0,0 +1,191 @@
+/**
+ * @file SpeciesAtlas.cpp
+ * @brief Background species decoding and shelf packing into an R32F atlas.
+ */
+
+#include "SpeciesAtlas.hpp"
+#include "AnimalCatalog.hpp"
+#include "Utils/GLUtils.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+
+namespace lenia {
+
+bool SpeciesAtlas::decode(const std::string& path, std::vector<float>& cells, int& rows, int& cols) {
+    if (path.find(".json") != std::string::npos)
+        return AnimalCatalog::decodeReference(path, cells, rows, cols);
+    NpyView view;
+    if (!view.open(path)) return false;
+    rows = view.rows();
+    cols = view.cols();
+    cells.resize(static_cast<size_t>(rows) * cols);
+    view.decode(cells.data(), 0);
+    return true;
+}
+
+/**
+ * @brief Decode @p path into @p entry, or keep its mapping when the payload
+ *        can be uploaded as stored.
+ */
+static bool decodeSpecies(const std::string& path, SpeciesAtlas::Entry& entry) {
+    if (path.find(".json") == std::string::npos) {
+        auto view = std::make_unique<NpyView>();
+        if (!view->open(path)) return false;
+        entry.rows = view->rows();
+        entry.cols = view->cols();
+        if (view->floats()) {
+            entry.mapped = std::move(view);
+            return true;
+        }
+        entry.cells.resize(static_cast<size_t>(entry.rows) * entry.cols);
+        view->decode(entry.cells.data(), 0);
+        return true;
+    }
+    return SpeciesAtlas::decode(path, entry.cells, entry.rows, entry.cols);
+}
+
+SpeciesAtlas::~SpeciesAtlas() {
+    release();
+}
+
+void SpeciesAtlas::start(const std::string& dir, const std::vector<std::string>& files) {
+    release();
+    m_dir = dir;
+    for (const auto& file : files) {
+        if (m_index.count(file)) continue;
+        m_index[file] = static_cast<int>(m_entries.size());
+        m_entries.emplace_back();
+        m_entries.back().file = file;
+    }
+    if (m_entries.empty()) return;
+
+    m_decoded = std::vector<std::atomic<bool>>(m_entries.size());
+    m_nextJob = 0;
+    m_pending = static_cast<int>(m_entries.size());
+    m_cancel = false;
+    int workers = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, MAX_WORKERS);
+    workers = std::min(workers, static_cast<int>(m_entries.size()));
+    for (int i = 0; i < workers; ++i)
+        m_workers.emplace_back(&SpeciesAtlas::worker, this);
+    LOG_INFO("SpeciesAtlas: decoding %zu species on %d threads", m_entries.size(), workers);
+}
+
+void SpeciesAtlas::worker() {
+    for (;;) {
+        int i = m_nextJob.fetch_add(1);
+        if (i >= static_cast<int>(m_entries.size()) || m_cancel) return;
+        Entry& entry = m_entries[i];
+        entry.ok = decodeSpecies(m_dir + "/" + entry.file, entry);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_decoded[i].store(true, std::memory_order_release);
+            --m_pending;
+        }
+        m_done.notify_all();
+    }
+}
+
+void SpeciesAtlas::join() {
+    for (auto& t : m_workers)
+        if (t.joinable()) t.join();
+    m_workers.clear();
+}
+
+void SpeciesAtlas::poll() {
+    if (m_packed || m_entries.empty() || m_pending.load() > 0) return;
+    join();
+    pack();
+    m_packed = true;
+}
+
+/**
+ * @brief Shelf packing: tallest patterns first, left to right, a new shelf
+ *        whenever a row of the atlas is full.
+ */
+void SpeciesAtlas::pack() {
+    TRACE_GL_SCOPE("SpeciesAtlas::pack");
+    std::vector<int> order;
+    m_width = WIDTH;
+    for (int i = 0; i < static_cast<int>(m_entries.size()); ++i) {
+        if (!m_entries[i].ok) continue;
+        order.push_back(i);
+        m_width = std::max(m_width, m_entries[i].cols);
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return m_entries[a].rows > m_entries[b].rows;
+    });
+
+    int x = 0, y = 0, shelf = 0;
+    for (int i : order) {
+        Entry& e = m_entries[i];
+        if (x > 0 && x + e.cols > m_width) {
+            x = 0;
+            y += shelf + PADDING;
+            shelf = 0;
+        }
+        e.x = x;
+        e.y = y;
+        x += e.cols + PADDING;
+        shelf = std::max(shelf, e.rows);
+    }
+    m_height = y + shelf;
+    if (m_height == 0) return;
+
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (m_width > maxSize || m_height > maxSize) {
+        LOG_WARN("SpeciesAtlas: %dx%d exceeds the texture limit, species stay on the CPU", m_width, m_height);
+        return;
+    }
+
+    m_texture = createTexture2D(m_width, m_height, GL_R32F);
+    for (int i : order) {
+        Entry& e = m_entries[i];
+        glTextureSubImage2D(m_texture, 0, e.x, e.y, e.cols, e.rows, GL_RED, GL_FLOAT, e.data());
+        e.inAtlas = true;
+        std::vector<float>().swap(e.cells);
+        e.mapped.reset();
+    }
+    LOG_INFO("SpeciesAtlas: %zu species in a %dx%d atlas", order.size(), m_width, m_height);
+}
+
+const SpeciesAtlas::Entry* SpeciesAtlas::find(const std::string& file) {
+    poll();
+    auto it = m_index.find(file);
+    if (it == m_index.end()) {
+        // Not part of the library: decode once, keep it on the CPU
+        auto extra = m_extra.find(file);
+        if (extra == m_extra.end()) {
+            extra = m_extra.emplace(file, Entry()).first;
+            extra->second.file = file;
+            extra->second.ok = decodeSpecies(m_dir + "/" + file, extra->second);
+        }
+        return extra->second.ok ? &extra->second : nullptr;
+    }
+
+    int i = it->second;
+    if (!m_decoded[i].load(std::memory_order_acquire)) {
+        TRACE_SCOPE("SpeciesAtlas::wait");
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&]() { return m_decoded[i].load(std::memory_order_acquire); });
+    }
+    const Entry& entry = m_entries[i];
+    return entry.ok ? &entry : nullptr;
+}
+
+void SpeciesAtlas::release() {
+    m_cancel = true;
+    join();
+    if (m_texture) glDeleteTextures(1, &m_texture);
+    m_texture = 0;
+    m_width = m_height = 0;
+    m_packed = false;
+    m_pending = 0;
+    m_entries.clear();
+    m_extra.clear();
+    m_index.clear();
+    m_decoded = std::vector<std::atomic<bool>>();
+}
+
+}
@@ -0,0 +1,102 @@
+/**
+ * @file SpeciesAtlas.hpp
+ * @brief Species library decoded in the background and packed into one texture.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include "Utils/NpyLoader.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief Decoded species patterns plus an R32F atlas holding all of them.
+ *
+ * start() decodes every file on worker threads; poll(), on the GL thread,
+ * packs the patterns into shelves once they are all decoded, uploads them
+ * in one texture and drops the CPU copies. A .npy that already holds
+ * native float32 is not decoded: its mapping stays open and is uploaded
+ * as is. Placing a species then samples its rectangle on the GPU.
+ */
+class SpeciesAtlas {
+public:
+    static constexpr int WIDTH = 1024;       // Atlas width; the height fits the library
+    static constexpr int PADDING = 1;        // Empty texels between patterns
+    static constexpr int MAX_WORKERS = 4;
+
+    struct Entry {
+        std::string        file;
+        std::vector<float> cells;            // Row-major, first channel; emptied once in the atlas
+        std::unique_ptr<NpyView> mapped;     // Instead of cells when the file is native float32
+        int  rows{0};
+        int  cols{0};
+        int  x{0};                           // Rectangle in the atlas texture
+        int  y{0};
+        bool ok{false};                      // Decoded
+        bool inAtlas{false};                 // Uploaded to the atlas texture
+
+        /** @brief rows x cols cells, from the mapping or the decoded copy. */
+        const float* data() const { return mapped ? mapped->floats() : cells.data(); }
+    };
+
+    SpeciesAtlas() = default;
+    ~SpeciesAtlas();
+
+    SpeciesAtlas(const SpeciesAtlas&) = delete;
+    SpeciesAtlas& operator=(const SpeciesAtlas&) = delete;
+
+    /** @brief Decode @p files (relative to @p dir) on worker threads. */
+    void start(const std::string& dir, const std::vector<std::string>& files);
+    /** @brief GL thread: build the atlas texture once every file is decoded. */
+    void poll();
+    /**
+     * @brief Decoded pattern of @p file, waiting for its worker if needed;
+     *        files outside the library are decoded on the spot. nullptr on error.
+     */
+    const Entry* find(const std::string& file);
+
+    /**
+     * @brief Decode one species file without an atlas: a .npy, a catalog
+     *        reference "<catalog>.json#<index>" or a bare-array .json.
+     */
+    static bool decode(const std::string& path, std::vector<float>& cells, int& rows, int& cols);
+
+    GLuint texture() const { return m_texture; }     // 0 until poll() built it
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    void release();
+
+private:
+    std::string        m_dir;
+    std::vector<Entry> m_entries;                    // Fixed while workers run
+    std::unordered_map<std::string, int> m_index;
+    std::vector<std::atomic<bool>> m_decoded;        // Per entry, set by the workers
+    std::unordered_map<std::string, Entry> m_extra;  // Files found outside the library
+
+    std::vector<std::thread> m_workers;
+    std::atomic<int>  m_nextJob{0};
+    std::atomic<int>  m_pending{0};                  // Entries not decoded yet
+    std::atomic<bool> m_cancel{false};
+    std::mutex              m_mutex;
+    std::condition_variable m_done;
+
+    GLuint m_texture{0};
+    int    m_width{0};
+    int    m_height{0};
+    bool   m_packed{false};
+
+    void worker();
+    void join();
+    void pack();
+};
+
+}
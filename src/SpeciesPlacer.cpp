@@ -0,0 +1,290 @@
+/**
+ * @file SpeciesPlacer.cpp
+ * @brief Placement layouts, staging and the place_species.comp dispatch.
+ */
+
+#include "SpeciesPlacer.hpp"
+#include "LeniaEngine.hpp"
+#include "Utils/GLUtils.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace lenia {
+
+SpeciesPlacer::~SpeciesPlacer() {
+    if (m_ubo)            glDeleteBuffers(1, &m_ubo);
+    if (m_instanceBuffer) glDeleteBuffers(1, &m_instanceBuffer);
+    if (m_stage)          glDeleteTextures(1, &m_stage);
+}
+
+bool SpeciesPlacer::init(const std::string& shaderDir) {
+    if (!m_shader.loadCompute(shaderDir + "place_species.comp")) {
+        LOG_ERROR("Failed to load place_species.comp");
+        return false;
+    }
+    glCreateBuffers(1, &m_ubo);
+    glNamedBufferStorage(m_ubo, sizeof(GPUPlaceParams), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    return true;
+}
+
+static bool isQuarterTurn(float angle, float scale) {
+    const float quarter = 1.57079632679f;
+    return scale == 1.0f && std::fabs(std::remainder(angle, quarter)) < 1e-4f;
+}
+
+void SpeciesPlacer::footprint(int w, int h, float angle, float scale, int& outW, int& outH) {
+    float c = std::fabs(std::cos(angle));
+    float s = std::fabs(std::sin(angle));
+    if (isQuarterTurn(angle, scale)) {
+        c = std::round(c);
+        s = std::round(s);
+    }
+    outW = std::max(1, static_cast<int>((c * w + s * h) * scale + 1e-4f));
+    outH = std::max(1, static_cast<int>((s * w + c * h) * scale + 1e-4f));
+}
+
+std::vector<PlacementSpot> SpeciesPlacer::layout(const PlacementLayout& settings, int w, int h,
+                                                 int gridW, int gridH, std::mt19937& rng) {
+    std::vector<PlacementSpot> spots;
+    int count = std::max(1, settings.count);
+    int marginPxX = static_cast<int>(settings.margin * gridW);
+    int marginPxY = static_cast<int>(settings.margin * gridH);
+
+    auto add = [&](int x, int y, bool flip) {
+        PlacementSpot spot{x, y, false, false};
+        if (flip) {
+            spot.flipH = rng() % 2 == 0;
+            spot.flipV = rng() % 2 == 0;
+        }
+        spots.push_back(spot);
+    };
+
+    auto getPosition = [&](PlacementMode pm) -> std::pair<int, int> {
+        switch (pm) {
+            case PlacementMode::Center:      return {(gridW - w) / 2, (gridH - h) / 2};
+            case PlacementMode::TopLeft:     return {marginPxX, marginPxY};
+            case PlacementMode::TopRight:    return {gridW - marginPxX - w, marginPxY};
+            case PlacementMode::BottomLeft:  return {marginPxX, gridH - marginPxY - h};
+            case PlacementMode::BottomRight: return {gridW - marginPxX - w, gridH - marginPxY - h};
+            case PlacementMode::Top:         return {(gridW - w) / 2, marginPxY};
+            case PlacementMode::Bottom:      return {(gridW - w) / 2, gridH - marginPxY - h};
+            case PlacementMode::Left:        return {marginPxX, (gridH - h) / 2};
+            case PlacementMode::Right:       return {gridW - marginPxX - w, (gridH - h) / 2};
+            default:                         return {(gridW - w) / 2, (gridH - h) / 2};
+        }
+    };
+
+    switch (settings.mode) {
+        case PlacementMode::Random: {
+            int rangeX = std::max(1, gridW - w - 2 * marginPxX);
+            int rangeY = std::max(1, gridH - h - 2 * marginPxY);
+            for (int i = 0; i < count; ++i) {
+                int x = marginPxX + static_cast<int>(rng() % static_cast<unsigned>(rangeX));
+                int y = marginPxY + static_cast<int>(rng() % static_cast<unsigned>(rangeY));
+                add(x, y, settings.randomFlip);
+            }
+            break;
+        }
+        case PlacementMode::Grid: {
+            int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+            int cellW = gridW / side;
+            int cellH = gridH / side;
+            for (int i = 0; i < count; ++i) {
+                int cx = (i % side) * cellW + (cellW - w) / 2;
+                int cy = (i / side) * cellH + (cellH - h) / 2;
+                add(std::max(0, cx), std::max(0, cy), settings.randomFlip);
+            }
+            break;
+        }
+        case PlacementMode::TwoPlace: {
+            auto [p1x, p1y] = getPosition(PlacementMode::TopLeft);
+            add(p1x, p1y, settings.randomFlip && count > 1);
+            auto [p2x, p2y] = getPosition(PlacementMode::BottomRight);
+            if (p2x > 0 && p2y > 0) add(p2x, p2y, settings.randomFlip);
+            break;
+        }
+        case PlacementMode::Scatter: {
+            // Dart throwing against a grid of cells one footprint plus the
+            // separation wide: two spots in one cell would conflict, so each
+            // cell holds at most one and a candidate checks only 3x3 cells.
+            int rangeX = std::max(1, gridW - w - 2 * marginPxX);
+            int rangeY = std::max(1, gridH - h - 2 * marginPxY);
+            int cellW = std::max(1, w + settings.minSeparation);
+            int cellH = std::max(1, h + settings.minSeparation);
+            int cols = rangeX / cellW + 1;
+            int rows = rangeY / cellH + 1;
+            std::vector<int> owner(static_cast<size_t>(cols) * rows, -1);
+            int maxAttempts = count * 200;
+            for (int attempt = 0; attempt < maxAttempts && static_cast<int>(spots.size()) < count; ++attempt) {
+                int x = marginPxX + static_cast<int>(rng() % static_cast<unsigned>(rangeX));
+                int y = marginPxY + static_cast<int>(rng() % static_cast<unsigned>(rangeY));
+                int cx = (x - marginPxX) / cellW;
+                int cy = (y - marginPxY) / cellH;
+                bool overlaps = false;
+                for (int ny = std::max(0, cy - 1); ny <= std::min(rows - 1, cy + 1) && !overlaps; ++ny) {
+                    for (int nx = std::max(0, cx - 1); nx <= std::min(cols - 1, cx + 1); ++nx) {
+                        int other = owner[ny * cols + nx];
+                        if (other < 0) continue;
+                        int sepX = std::abs(x - spots[other].x) - w;
+                        int sepY = std::abs(y - spots[other].y) - h;
+                        if (std::max(sepX, sepY) < settings.minSeparation) {
+                            overlaps = true;
+                            break;
+                        }
+                    }
+                }
+                if (overlaps) continue;
+                owner[cy * cols + cx] = static_cast<int>(spots.size());
+                add(x, y, settings.randomFlip);
+            }
+            break;
+        }
+        default: {
+            auto [bx, by] = getPosition(settings.mode);
+            if (count == 1) {
+                add(std::max(0, bx), std::max(0, by), false);
+                break;
+            }
+            int spacePx = static_cast<int>(settings.spacing * static_cast<float>(std::min(gridW, gridH)));
+            for (int i = 0; i < count; ++i) {
+                int ox = bx + i * spacePx;
+                int oy = by;
+                if (ox + w > gridW) {
+                    ox = bx;
+                    oy += i * spacePx;
+                }
+                add(std::max(0, ox), std::max(0, oy), settings.randomFlip);
+            }
+            break;
+        }
+    }
+    return spots;
+}
+
+PlacementSource SpeciesPlacer::stage(const float* const* channels, int channelCount, int rows, int cols) {
+    PlacementSource source;
+    if (rows <= 0 || cols <= 0) return source;
+    if (!m_stage || cols > m_stageW || rows > m_stageH) {
+        if (m_stage) glDeleteTextures(1, &m_stage);
+        m_stageW = std::max(cols, m_stageW);
+        m_stageH = std::max(rows, m_stageH);
+        m_stage = createTexture2D(m_stageW, m_stageH, GL_RGBA32F);
+    }
+
+    size_t cells = static_cast<size_t>(rows) * cols;
+    std::vector<float> rgba(cells * 4, 0.0f);
+    for (size_t i = 0; i < cells; ++i) {
+        for (int c = 0; c < channelCount && c < 3; ++c)
+            rgba[i * 4 + c] = channels[c] ? channels[c][i] : 0.0f;
+        rgba[i * 4 + 3] = 1.0f;
+    }
+    glTextureSubImage2D(m_stage, 0, 0, 0, cols, rows, GL_RGBA, GL_FLOAT, rgba.data());
+
+    source.texture = m_stage;
+    source.w = cols;
+    source.h = rows;
+    for (int c = 0; c < 3; ++c)
+        source.channelMap[c] = (c < channelCount) ? c : -1;
+    return source;
+}
+
+void SpeciesPlacer::setInstances(const PlacementSource& source, const std::vector<PlacementSpot>& spots,
+                                 float angle, float scale, bool flipH, bool flipV) {
+    m_instances.clear();
+    m_sourceTexture = source.texture;
+    m_maxExtentW = 0;
+    m_maxExtentH = 0;
+    if (!source.texture || spots.empty()) return;
+
+    bool quarter = isQuarterTurn(angle, scale);
+    int fw, fh;
+    footprint(source.w, source.h, angle, scale, fw, fh);
+    float extentW = static_cast<float>(fw);
+    float extentH = static_cast<float>(fh);
+    if (!quarter) {
+        float c = std::fabs(std::cos(angle));
+        float s = std::fabs(std::sin(angle));
+        extentW = (c * source.w + s * source.h) * scale;
+        extentH = (s * source.w + c * source.h) * scale;
+    }
+
+    m_instances.reserve(spots.size());
+    for (const auto& spot : spots) {
+        GPUInstance g{};
+        g.srcRect[0] = static_cast<float>(source.x);
+        g.srcRect[1] = static_cast<float>(source.y);
+        g.srcRect[2] = static_cast<float>(source.w);
+        g.srcRect[3] = static_cast<float>(source.h);
+        g.center[0]  = spot.x + 0.5f * fw;
+        g.center[1]  = spot.y + 0.5f * fh;
+        g.extent[0]  = extentW;
+        g.extent[1]  = extentH;
+        g.angle      = angle;
+        g.scale      = scale;
+        g.flags      = ((flipH != spot.flipH) ? 1 : 0) | ((flipV != spot.flipV) ? 2 : 0) | (quarter ? 4 : 0);
+        for (int c = 0; c < 3; ++c) g.channelMap[c] = source.channelMap[c];
+        g.channelMap[3] = -1;
+        m_instances.push_back(g);
+    }
+    m_maxExtentW = static_cast<int>(std::ceil(extentW)) + 1;
+    m_maxExtentH = static_cast<int>(std::ceil(extentH)) + 1;
+
+    size_t bytes = m_instances.size() * sizeof(GPUInstance);
+    if (bytes > m_instanceCapacity) {
+        if (m_instanceBuffer) glDeleteBuffers(1, &m_instanceBuffer);
+        m_instanceCapacity = std::max(bytes, static_cast<size_t>(64) * sizeof(GPUInstance));
+        glCreateBuffers(1, &m_instanceBuffer);
+        glNamedBufferStorage(m_instanceBuffer, static_cast<GLsizeiptr>(m_instanceCapacity), nullptr,
+                             GL_DYNAMIC_STORAGE_BIT);
+    }
+    glNamedBufferSubData(m_instanceBuffer, 0, static_cast<GLsizeiptr>(bytes), m_instances.data());
+}
+
+bool SpeciesPlacer::bounds(int& x0, int& y0, int& x1, int& y1) const {
+    if (m_instances.empty()) return false;
+    x0 = y0 = INT32_MAX;
+    x1 = y1 = INT32_MIN;
+    for (const auto& g : m_instances) {
+        int lx = static_cast<int>(std::floor(g.center[0] - 0.5f * g.extent[0]));
+        int ly = static_cast<int>(std::floor(g.center[1] - 0.5f * g.extent[1]));
+        x0 = std::min(x0, lx);
+        y0 = std::min(y0, ly);
+        x1 = std::max(x1, lx + m_maxExtentW);
+        y1 = std::max(y1, ly + m_maxExtentH);
+    }
+    return true;
+}
+
+void SpeciesPlacer::dispatch(GLuint target, GLenum format, int originX, int originY,
+                             int extentW, int extentH, int storeOffset) {
+    if (m_instances.empty()) return;
+    TRACE_GL_SCOPE("SpeciesPlacer::dispatch");
+
+    GPUPlaceParams gpu{};
+    gpu.originX       = originX;
+    gpu.originY       = originY;
+    gpu.extentW       = extentW;
+    gpu.extentH       = extentH;
+    gpu.storeOffset   = storeOffset;
+    gpu.rgba          = (format == GL_RGBA32F) ? 1 : 0;
+    gpu.instanceCount = static_cast<int32_t>(m_instances.size());
+
+    m_shader.use();
+    glBindBufferBase(GL_UNIFORM_BUFFER, 9, m_ubo);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, m_instanceBuffer);
+    glBindTextureUnit(0, m_sourceTexture);
+    glBindSampler(0, 0);
+    glBindImageTexture(gpu.rgba ? 2 : 1, target, 0, GL_FALSE, 0, GL_WRITE_ONLY, format);
+
+    GLuint groupsX = static_cast<GLuint>((m_maxExtentW + 15) / 16);
+    GLuint groupsY = static_cast<GLuint>((m_maxExtentH + 15) / 16);
+    for (int first = 0; first < gpu.instanceCount; first += MAX_Z_GROUPS) {
+        gpu.firstInstance = first;
+        glNamedBufferSubData(m_ubo, 0, sizeof(GPUPlaceParams), &gpu);
+        glDispatchCompute(groupsX, groupsY, static_cast<GLuint>(std::min(MAX_Z_GROUPS, gpu.instanceCount - first)));
+    }
+}
+
+}
@@ -0,0 +1,136 @@
+/**
+ * @file SpeciesPlacer.hpp
+ * @brief GPU placement of species patterns: instance layout and stamping.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include "Utils/Shader.hpp"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+enum class PlacementMode : int;
+
+/**
+ * @brief Rectangle of an R32F or RGBA32F texture a pattern is read from.
+ */
+struct PlacementSource {
+    GLuint texture{0};
+    int    x{0};
+    int    y{0};
+    int    w{0};
+    int    h{0};
+    int    channelMap[3]{0, -1, -1};     // Source channel per grid channel, -1 = 0
+};
+
+/**
+ * @brief How copies are spread over the grid.
+ */
+struct PlacementLayout {
+    PlacementMode mode{};
+    int   count{1};
+    float spacing{0.1f};                 // Fraction of the smaller grid edge
+    float margin{0.05f};                 // Fraction of each grid edge
+    int   minSeparation{0};              // Scatter: cells between footprints
+    bool  randomFlip{false};
+};
+
+/**
+ * @brief Top-left corner of one copy's footprint, in grid cells.
+ */
+struct PlacementSpot {
+    int  x{0};
+    int  y{0};
+    bool flipH{false};
+    bool flipV{false};
+};
+
+/**
+ * @brief Stamps rotated, scaled and flipped copies of a pattern.
+ *
+ * Every copy is an instance in a shader storage buffer; place_species.comp
+ * covers one instance per z slice, so all copies land in a single dispatch
+ * per target texture. Patterns held on the CPU are staged in an RGBA32F
+ * texture first.
+ */
+class SpeciesPlacer {
+public:
+    SpeciesPlacer() = default;
+    ~SpeciesPlacer();
+
+    static constexpr int MAX_Z_GROUPS = 65535;      // Instances per dispatch
+
+    SpeciesPlacer(const SpeciesPlacer&) = delete;
+    SpeciesPlacer& operator=(const SpeciesPlacer&) = delete;
+
+    bool init(const std::string& shaderDir);
+
+    /** @brief Footprint in cells of a @p w x @p h pattern turned by @p angle and scaled. */
+    static void footprint(int w, int h, float angle, float scale, int& outW, int& outH);
+    /** @brief Positions of the copies of a @p w x @p h footprint on a @p gridW x @p gridH grid. */
+    static std::vector<PlacementSpot> layout(const PlacementLayout& settings, int w, int h,
+                                             int gridW, int gridH, std::mt19937& rng);
+
+    /** @brief Upload up to three planar channels of a CPU pattern into the staging texture. */
+    PlacementSource stage(const float* const* channels, int channelCount, int rows, int cols);
+
+    /**
+     * @brief Build the instances: @p source turned by @p angle (radians, clockwise
+     *        on screen), scaled, flipped, then each spot's own flips on top.
+     */
+    void setInstances(const PlacementSource& source, const std::vector<PlacementSpot>& spots,
+                      float angle, float scale, bool flipH, bool flipV);
+    /** @brief Union of the instances' footprints; false when there are none. */
+    bool bounds(int& x0, int& y0, int& x1, int& y1) const;
+    int  instanceCount() const { return static_cast<int>(m_instances.size()); }
+
+    /**
+     * @brief Stamp every instance into @p target (R32F or RGBA32F), which holds
+     *        the grid cells [origin, origin + extent) from texel @p storeOffset.
+     */
+    void dispatch(GLuint target, GLenum format, int originX, int originY,
+                  int extentW, int extentH, int storeOffset);
+
+private:
+    struct alignas(16) GPUInstance {
+        float   srcRect[4];      // x, y, w, h in source texels
+        float   center[2];       // Footprint center, grid cells
+        float   extent[2];       // Footprint bounding box, grid cells
+        float   angle;
+        float   scale;
+        int32_t flags;           // 1 flip H, 2 flip V, 4 nearest (quarter turns, unscaled)
+        int32_t _pad0;
+        int32_t channelMap[4];
+    };
+
+    struct alignas(16) GPUPlaceParams {
+        int32_t originX;
+        int32_t originY;
+        int32_t extentW;
+        int32_t extentH;
+        int32_t storeOffset;
+        int32_t rgba;
+        int32_t instanceCount;
+        int32_t firstInstance;   // Of this dispatch, past the z limit
+    };
+
+    Shader m_shader;
+    GLuint m_ubo{0};
+    GLuint m_instanceBuffer{0};
+    size_t m_instanceCapacity{0};
+    GLuint m_stage{0};
+    int    m_stageW{0};
+    int    m_stageH{0};
+
+    std::vector<GPUInstance> m_instances;
+    GLuint m_sourceTexture{0};
+    int    m_maxExtentW{0};
+    int    m_maxExtentH{0};
+};
+
+}
@@ -0,0 +1,109 @@
+/**
+ * @file StatePyramid.cpp
+ * @brief Implementation of the state reduction pyramid.
+ */
+
+#include "StatePyramid.hpp"
+#include "Utils/GLUtils.hpp"
+#include <algorithm>
+
+namespace lenia {
+
+StatePyramid::~StatePyramid() {
+    release();
+    if (m_ubo) glDeleteBuffers(1, &m_ubo);
+}
+
+bool StatePyramid::init(const std::string& shaderPath) {
+    if (!m_shader.loadCompute(shaderPath)) return false;
+
+    glCreateBuffers(1, &m_ubo);
+    glNamedBufferStorage(m_ubo, sizeof(GPUPyramidParams), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    return true;
+}
+
+void StatePyramid::release() {
+    if (m_meanTex)    glDeleteTextures(1, &m_meanTex);
+    if (m_extremaTex) glDeleteTextures(1, &m_extremaTex);
+    m_meanTex = 0;
+    m_extremaTex = 0;
+    m_gridW = 0;
+    m_gridH = 0;
+    m_levels = 0;
+    m_revision = ~0ull;
+}
+
+void StatePyramid::allocate(int gridW, int gridH) {
+    release();
+
+    int baseW = std::max(1, gridW / 2);
+    int baseH = std::max(1, gridH / 2);
+    int levels = 1;
+    for (int s = std::max(baseW, baseH); s > 1; s /= 2) ++levels;
+
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_meanTex);
+    glTextureStorage2D(m_meanTex, levels, GL_RGBA32F, baseW, baseH);
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_extremaTex);
+    glTextureStorage2D(m_extremaTex, levels, GL_RG32F, baseW, baseH);
+
+    m_gridW = gridW;
+    m_gridH = gridH;
+    m_levels = levels;
+}
+
+/**
+ * @brief Rebuild every level of the pyramid from the current state.
+ *
+ * The first pass reduces the state texture into level 0; each following
+ * pass reduces level N into level N+1 through image load/store so no
+ * level is ever sampled while it is being written.
+ */
+void StatePyramid::build(GLuint stateTexture, int gridW, int gridH, bool multiChannel, uint64_t revision) {
+    if (gridW < 2 && gridH < 2) return;
+    if (gridW != m_gridW || gridH != m_gridH || !m_meanTex)
+        allocate(gridW, gridH);
+    else if (revision == m_revision && multiChannel == m_multiChannel)
+        return;
+    m_revision = revision;
+    m_multiChannel = multiChannel;
+
+    m_shader.use();
+    glBindBufferBase(GL_UNIFORM_BUFFER, 4, m_ubo);
+    glBindTextureUnit(0, stateTexture);
+
+    int srcW = gridW;
+    int srcH = gridH;
+    int srcScale = 1;
+    for (int level = 0; level < m_levels; ++level) {
+        int dstW = std::max(1, srcW / 2);
+        int dstH = std::max(1, srcH / 2);
+
+        GPUPyramidParams p{};
+        p.srcW = srcW;
+        p.srcH = srcH;
+        p.dstW = dstW;
+        p.dstH = dstH;
+        p.fromState = (level == 0) ? 1 : 0;
+        p.multiChannel = multiChannel ? 1 : 0;
+        p.srcScale = srcScale;
+        p.gridW = gridW;
+        p.gridH = gridH;
+        glNamedBufferSubData(m_ubo, 0, sizeof(p), &p);
+
+        if (level > 0) {
+            glBindImageTexture(0, m_meanTex, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA32F);
+            glBindImageTexture(1, m_extremaTex, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_RG32F);
+        }
+        glBindImageTexture(2, m_meanTex, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
+        glBindImageTexture(3, m_extremaTex, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG32F);
+
+        dispatchCompute2D(dstW, dstH);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+
+        srcW = dstW;
+        srcH = dstH;
+        srcScale *= 2;
+    }
+}
+
+}
@@ -0,0 +1,77 @@
+/**
+ * @file StatePyramid.hpp
+ * @brief Mean/max/min reduction pyramid of the simulation state.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include "Utils/Shader.hpp"
+#include <string>
+#include <cstdint>
+
+namespace lenia {
+
+/**
+ * @brief GPU mip chain of 2x2 reductions used for zoomed-out display.
+ *
+ * Level 0 is half the grid resolution and each following level halves
+ * it again. Two mip-mapped textures are kept:
+ * - Mean: per-channel average (RGBA32F, single-channel data in .r)
+ * - Extrema: max/min of the displayed scalar (RG32F)
+ *
+ * The last row and column of each level absorb the leftover texel of an
+ * odd-sized source, and means are weighted by the grid cells behind each
+ * source texel, so every texel is the exact mean of its cells.
+ *
+ * When many cells fall under one screen pixel, the renderer samples the
+ * matching level instead of point-sampling the full-resolution grid,
+ * which removes aliasing and keeps texture fetches cache-friendly.
+ */
+class StatePyramid {
+public:
+    StatePyramid() = default;
+    ~StatePyramid();
+
+    StatePyramid(const StatePyramid&) = delete;
+    StatePyramid& operator=(const StatePyramid&) = delete;
+
+    bool init(const std::string& shaderPath);
+    /** @brief Reduce @p stateTexture; nothing to do while @p revision and the grid are unchanged. */
+    void build(GLuint stateTexture, int gridW, int gridH, bool multiChannel, uint64_t revision);
+    void release();
+
+    GLuint meanTexture()    const { return m_meanTex; }
+    GLuint extremaTexture() const { return m_extremaTex; }
+    int levels() const { return m_levels; }
+
+private:
+    Shader   m_shader;
+    GLuint   m_ubo{0};
+    GLuint   m_meanTex{0};     // RGBA32F mip chain of per-channel means
+    GLuint   m_extremaTex{0};  // RG32F mip chain of (max, min)
+    int      m_gridW{0};       // Grid size the pyramid was allocated for
+    int      m_gridH{0};
+    int      m_levels{0};      // Number of mip levels
+    bool     m_multiChannel{false};
+    uint64_t m_revision{~0ull};  // State revision the levels were built from
+
+    void allocate(int gridW, int gridH);
+
+    struct alignas(16) GPUPyramidParams {
+        int32_t srcW;
+        int32_t srcH;
+        int32_t dstW;
+        int32_t dstH;
+        int32_t fromState;
+        int32_t multiChannel;
+        int32_t srcScale;
+        int32_t _pad0;
+        int32_t gridW;
+        int32_t gridH;
+        int32_t _pad1;
+        int32_t _pad2;
+    };
+};
+
+}
@@ -0,0 +1,154 @@
+/**
+ * @file StepController.cpp
+ * @brief Implementation of the GPU-timed steps-per-batch controller.
+ */
+
+#include "StepController.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace lenia {
+
+// Weight of a new sample in the smoothed per-step time
+static constexpr double STEP_MS_SMOOTHING = 0.2;
+// No real batch finishes this fast; drivers that cannot time GPU work
+// (software rasterizers) report ~0, and the controller then stays manual
+static constexpr GLuint64 MIN_PLAUSIBLE_BATCH_NS = 1000;
+
+void StepController::release() {
+    for (auto& p : m_ring) {
+        if (p.query) glDeleteQueries(1, &p.query);
+        p = PendingQuery{};
+    }
+    m_next = 0;
+    m_active = -1;
+    m_hasEstimate = false;
+    m_workloadCost = 0.0;
+}
+
+/**
+ * @brief Start timing a batch, unless every query is still in flight.
+ */
+void StepController::beginBatch() {
+    collect();
+    PendingQuery& p = m_ring[m_next];
+    if (p.steps > 0) return;  // Ring full: skip this batch rather than wait
+    if (!p.query) glGenQueries(1, &p.query);
+
+    glBeginQuery(GL_TIME_ELAPSED, p.query);
+    m_active = m_next;
+    m_next = (m_next + 1) % RING_SIZE;
+}
+
+void StepController::endBatch(int steps) {
+    if (m_active < 0) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    m_ring[m_active].steps = std::max(1, steps);
+    m_ring[m_active].generation = m_generation;
+    m_active = -1;
+}
+
+/**
+ * @brief Fold every finished query into the per-step estimate.
+ */
+void StepController::collect() {
+    for (int i = 0; i < RING_SIZE; ++i) {
+        PendingQuery& p = m_ring[(m_next + i) % RING_SIZE];
+        if (p.steps == 0) continue;
+
+        GLuint available = 0;
+        glGetQueryObjectuiv(p.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(p.query, GL_QUERY_RESULT, &ns);
+        // Timed before the last rescale: the old workload, not this one
+        if (ns < MIN_PLAUSIBLE_BATCH_NS || p.generation != m_generation) {
+            p.steps = 0;
+            continue;
+        }
+        double sample = static_cast<double>(ns) * 1e-6 / p.steps;
+        p.steps = 0;
+
+        if (!m_hasEstimate || m_rescaled) {
+            m_stepMs = sample;
+            m_hasEstimate = true;
+            m_rescaled = false;
+        } else {
+            m_stepMs += (sample - m_stepMs) * STEP_MS_SMOOTHING;
+        }
+    }
+}
+
+/**
+ * @brief Relative cost of one step: cells times kernel area, per rule.
+ */
+double StepController::workloadCost(const LeniaParams& params) {
+    double cells = static_cast<double>(params.gridW) * params.gridH;
+    if (params.numKernelRules <= 0) {
+        double d = 2.0 * params.radius + 1.0;
+        return cells * d * d;
+    }
+    double area = 0.0;
+    for (int r = 0; r < params.numKernelRules && r < 16; ++r) {
+        int ruleRadius = std::max(1, static_cast<int>(params.radius * params.kernelRules[r].radiusFraction));
+        double d = 2.0 * ruleRadius + 1.0;
+        area += d * d;
+    }
+    return cells * area;
+}
+
+/**
+ * @brief Steps to run in the coming batch.
+ *
+ * @param manualSteps Slider value, used when the mode is off or nothing
+ *                    has been measured yet.
+ * @param intervalSec Wall time between batches, for steps-per-second mode.
+ */
+int StepController::stepsForNextBatch(const LeniaParams& params, int manualSteps, double intervalSec) {
+    collect();
+
+    double cost = workloadCost(params);
+    if (m_workloadCost > 0.0 && cost != m_workloadCost) {
+        ++m_generation;
+        if (m_hasEstimate) {
+            m_stepMs *= cost / m_workloadCost;
+            m_rescaled = true;
+            m_stepCarry = 0.0;
+        }
+    }
+    m_workloadCost = cost;
+
+    auto mode = static_cast<AutoStepsMode>(params.autoStepsMode);
+    if (mode == AutoStepsMode::Off || !m_hasEstimate || m_stepMs <= 0.0) {
+        m_lastSteps = manualSteps;
+        return manualSteps;
+    }
+
+    int steps = manualSteps;
+    if (mode == AutoStepsMode::FrameBudget) {
+        steps = static_cast<int>(params.autoStepsFrameMs / m_stepMs);
+        // Ramp up gradually so one optimistic sample cannot blow the budget
+        steps = std::min(steps, m_lastSteps * 2 + 1);
+    } else {
+        double wanted = params.autoStepsPerSecond * std::clamp(intervalSec, 0.0, 0.25) + m_stepCarry;
+        // Never queue more GPU work than fits in the interval, or the rate backlog grows forever
+        double affordable = std::max(1.0, std::floor(intervalSec * 1000.0 * 0.9 / m_stepMs));
+        steps = static_cast<int>(std::floor(wanted));
+        if (steps > affordable) {
+            steps = static_cast<int>(affordable);
+            m_stepCarry = 0.0;
+        } else {
+            m_stepCarry = wanted - steps;
+        }
+        if (steps <= 0) {
+            m_lastSteps = 0;
+            return 0;
+        }
+    }
+
+    m_lastSteps = std::clamp(steps, 1, MAX_STEPS);
+    return m_lastSteps;
+}
+
+}
@@ -0,0 +1,79 @@
+/**
+ * @file StepController.hpp
+ * @brief Chooses steps per batch from measured GPU time per step.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include "UIOverlay.hpp"
+#include <cstdint>
+
+namespace lenia {
+
+/**
+ * @brief Automatic steps-per-frame modes (LeniaParams::autoStepsMode).
+ */
+enum class AutoStepsMode : int {
+    Off            = 0,  // Use the manual steps slider
+    FrameBudget    = 1,  // Fill a GPU time budget per batch
+    StepsPerSecond = 2   // Hold a simulation rate, independent of frame rate
+};
+
+/**
+ * @brief Adaptive steps-per-batch controller driven by GL timer queries.
+ *
+ * Each simulation batch is wrapped in a GL_TIME_ELAPSED query taken from a
+ * small ring; results are collected only once available, so measuring never
+ * stalls the pipeline. The per-step cost is smoothed, and when the workload
+ * changes (grid size, radius, rule count) the estimate is rescaled by the
+ * predicted convolution cost and then replaced by the next measurement.
+ * Queries carry the workload generation they were issued in, so results
+ * still in flight from before a change are dropped rather than folded in.
+ *
+ * Query objects are per-context: an instance must only be used from the
+ * thread whose context created its queries.
+ */
+class StepController {
+public:
+    StepController() = default;
+    ~StepController() = default;
+
+    StepController(const StepController&) = delete;
+    StepController& operator=(const StepController&) = delete;
+
+    void beginBatch();
+    void endBatch(int steps);
+    int  stepsForNextBatch(const LeniaParams& params, int manualSteps, double intervalSec);
+    void release();
+
+    /** @brief Smoothed GPU milliseconds per step, 0 until measured. */
+    float gpuStepMs() const { return m_hasEstimate ? static_cast<float>(m_stepMs) : 0.0f; }
+
+    static constexpr int MAX_STEPS = 500;
+
+private:
+    struct PendingQuery {
+        GLuint   query{0};
+        int      steps{0};       // Steps covered by the query, 0 = free
+        uint32_t generation{0};  // m_generation when the batch was issued
+    };
+
+    static constexpr int RING_SIZE = 4;
+
+    PendingQuery m_ring[RING_SIZE];
+    int    m_next{0};           // Ring slot for the next batch
+    int    m_active{-1};        // Slot between beginBatch/endBatch, -1 if none
+    double m_stepMs{0.0};       // Smoothed GPU ms per step
+    bool   m_hasEstimate{false};
+    bool   m_rescaled{false};   // Estimate was extrapolated, replace on next sample
+    uint32_t m_generation{0};   // Bumped on every workload change; older queries are stale
+    double m_workloadCost{0.0}; // Relative cost of one step for the last params
+    double m_stepCarry{0.0};    // Fractional steps owed in steps-per-second mode
+    int    m_lastSteps{1};
+
+    void collect();
+    static double workloadCost(const LeniaParams& params);
+};
+
+}
@@ -0,0 +1,332 @@
+/**
+ * @file TiledState.cpp
+ * @brief Implementation of the tiled dense grid.
+ */
+
+#include "TiledState.hpp"
+#include "GpuProfiler.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+
+namespace lenia {
+
+static int ceilDiv(int a, int b) {
+    return (a + b - 1) / b;
+}
+
+static int roundUp(int a, int multiple) {
+    return ceilDiv(a, multiple) * multiple;
+}
+
+TiledState::~TiledState() {
+    release();
+    if (m_neighborSSBO) glDeleteBuffers(1, &m_neighborSSBO);
+    if (m_overviewUBO) glDeleteBuffers(1, &m_overviewUBO);
+}
+
+bool TiledState::init(const std::string& shaderDir) {
+    if (!m_simShader.loadCompute(shaderDir + "sim_chunked.comp")) {
+        LOG_ERROR("Failed to load sim_chunked.comp"); return false;
+    }
+    if (!m_overviewShader.loadCompute(shaderDir + "tile_overview.comp")) {
+        LOG_ERROR("Failed to load tile_overview.comp"); return false;
+    }
+
+    // Each tile is dispatched alone as slot 0 of sim_chunked.comp
+    int32_t neighbors[9] = {-1, -1, -1, -1, 0, -1, -1, -1, -1};
+    glCreateBuffers(1, &m_neighborSSBO);
+    glNamedBufferStorage(m_neighborSSBO, sizeof(neighbors), neighbors, 0);
+    glCreateBuffers(1, &m_overviewUBO);
+    glNamedBufferStorage(m_overviewUBO, sizeof(GPUTileParams), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    return true;
+}
+
+int TiledState::overviewFactor(int width, int height) {
+    return std::max({1, ceilDiv(width, OVERVIEW_LIMIT), ceilDiv(height, OVERVIEW_LIMIT)});
+}
+
+/**
+ * @brief Tile starts along one axis (plus the end), multiples of @p factor.
+ *
+ * The last tile also fills its neighbors' halos, so it may not be narrower
+ * than the halo; tiles grow slightly past @p edge when that needs fixing.
+ */
+void TiledState::splitAxis(int size, int edge, int factor, int halo, std::vector<int>& starts) {
+    int limit = std::max(factor, edge / factor * factor);
+    int count = ceilDiv(size, limit);
+    int length = roundUp(ceilDiv(size, count), factor);
+    count = ceilDiv(size, length);
+    while (count > 1 && size - (count - 1) * length < halo) {
+        length = roundUp(ceilDiv(size, count - 1), factor);
+        count = ceilDiv(size, length);
+    }
+
+    starts.clear();
+    for (int i = 0; i < count; ++i) starts.push_back(i * length);
+    starts.push_back(size);
+}
+
+GLuint TiledState::createTileTexture(int w, int h, int halo) const {
+    GLuint tex = 0;
+    float zero = 0.0f;
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &tex);
+    glTextureStorage3D(tex, 1, GL_R32F, w + 2 * halo, h + 2 * halo, 1);
+    glTextureParameteri(tex, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTextureParameteri(tex, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glClearTexImage(tex, 0, GL_RED, GL_FLOAT, &zero);
+    return tex;
+}
+
+bool TiledState::allocate(int width, int height, int tileEdge, int halo) {
+    TRACE_GL_SCOPE("TiledState::allocate");
+    release();
+    m_factor = overviewFactor(width, height);
+
+    std::vector<int> xs, ys;
+    splitAxis(width, tileEdge, m_factor, halo, xs);
+    splitAxis(height, tileEdge, m_factor, halo, ys);
+    m_tilesX = static_cast<int>(xs.size()) - 1;
+    m_tilesY = static_cast<int>(ys.size()) - 1;
+
+    while (glGetError() != GL_NO_ERROR) {}
+    for (int ty = 0; ty < m_tilesY; ++ty) {
+        for (int tx = 0; tx < m_tilesX; ++tx) {
+            Tile t;
+            t.x = xs[tx];
+            t.y = ys[ty];
+            t.w = xs[tx + 1] - xs[tx];
+            t.h = ys[ty + 1] - ys[ty];
+            t.tex[0] = createTileTexture(t.w, t.h, halo);
+            t.tex[1] = createTileTexture(t.w, t.h, halo);
+            glCreateBuffers(1, &t.ubo);
+            glNamedBufferStorage(t.ubo, sizeof(GPUChunkParams), nullptr, GL_DYNAMIC_STORAGE_BIT);
+            m_tiles.push_back(t);
+        }
+    }
+    if (glGetError() == GL_OUT_OF_MEMORY) {
+        LOG_ERROR("Not enough video memory for a %dx%d grid.", width, height);
+        release();
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_halo = halo;
+    m_current = 0;
+    m_wrapX = m_wrapY = true;
+    LOG_INFO("Tiled grid %dx%d: %dx%d tiles, overview 1:%d.", width, height, m_tilesX, m_tilesY, m_factor);
+    return true;
+}
+
+void TiledState::release() {
+    for (Tile& t : m_tiles) {
+        glDeleteTextures(2, t.tex);
+        glDeleteBuffers(1, &t.ubo);
+    }
+    m_tiles.clear();
+    m_width = m_height = 0;
+    m_tilesX = m_tilesY = 0;
+    m_halo = 0;
+    m_factor = 1;
+}
+
+void TiledState::clear() {
+    float zero = 0.0f;
+    for (Tile& t : m_tiles) {
+        glClearTexImage(t.tex[0], 0, GL_RED, GL_FLOAT, &zero);
+        glClearTexImage(t.tex[1], 0, GL_RED, GL_FLOAT, &zero);
+        t.overviewDirty = true;
+    }
+}
+
+void TiledState::setHalo(int halo) {
+    if (halo == m_halo || !active()) return;
+    TRACE_GL_SCOPE("TiledState::setHalo");
+    for (Tile& t : m_tiles) {
+        GLuint fresh[2] = {createTileTexture(t.w, t.h, halo), createTileTexture(t.w, t.h, halo)};
+        glCopyImageSubData(t.tex[m_current], GL_TEXTURE_2D_ARRAY, 0, m_halo, m_halo, 0,
+                           fresh[m_current], GL_TEXTURE_2D_ARRAY, 0, halo, halo, 0, t.w, t.h, 1);
+        glDeleteTextures(2, t.tex);
+        t.tex[0] = fresh[0];
+        t.tex[1] = fresh[1];
+    }
+    m_halo = halo;
+}
+
+/**
+ * @brief Empty every halo, so non-periodic edges read as empty after a wrap mode change.
+ */
+void TiledState::clearHalos() {
+    for (Tile& t : m_tiles) {
+        int fullW = t.w + 2 * m_halo;
+        int fullH = t.h + 2 * m_halo;
+        for (GLuint tex : t.tex) {
+            glClearTexSubImage(tex, 0, 0, 0, 0, fullW, m_halo, 1, GL_RED, GL_FLOAT, nullptr);
+            glClearTexSubImage(tex, 0, 0, m_halo + t.h, 0, fullW, m_halo, 1, GL_RED, GL_FLOAT, nullptr);
+            glClearTexSubImage(tex, 0, 0, 0, 0, m_halo, fullH, 1, GL_RED, GL_FLOAT, nullptr);
+            glClearTexSubImage(tex, 0, m_halo + t.w, 0, 0, m_halo, fullH, 1, GL_RED, GL_FLOAT, nullptr);
+        }
+    }
+}
+
+void TiledState::uploadRegion(int x, int y, int w, int h, const float* data) {
+    for (Tile& t : m_tiles) {
+        int x0 = std::max(x, t.x), x1 = std::min(x + w, t.x + t.w);
+        int y0 = std::max(y, t.y), y1 = std::min(y + h, t.y + t.h);
+        if (x0 >= x1 || y0 >= y1) continue;
+
+        std::vector<float> part(static_cast<size_t>(x1 - x0) * (y1 - y0));
+        for (int r = y0; r < y1; ++r)
+            std::copy_n(data + static_cast<size_t>(r - y) * w + (x0 - x), x1 - x0,
+                        part.begin() + static_cast<size_t>(r - y0) * (x1 - x0));
+        glTextureSubImage3D(t.tex[m_current], 0, m_halo + x0 - t.x, m_halo + y0 - t.y, 0,
+                            x1 - x0, y1 - y0, 1, GL_RED, GL_FLOAT, part.data());
+        t.overviewDirty = true;
+    }
+}
+
+void TiledState::readRegion(int x, int y, int w, int h, float* data) const {
+    for (const Tile& t : m_tiles) {
+        int x0 = std::max(x, t.x), x1 = std::min(x + w, t.x + t.w);
+        int y0 = std::max(y, t.y), y1 = std::min(y + h, t.y + t.h);
+        if (x0 >= x1 || y0 >= y1) continue;
+
+        std::vector<float> part(static_cast<size_t>(x1 - x0) * (y1 - y0));
+        glGetTextureSubImage(t.tex[m_current], 0, m_halo + x0 - t.x, m_halo + y0 - t.y, 0,
+                             x1 - x0, y1 - y0, 1, GL_RED, GL_FLOAT,
+                             static_cast<GLsizei>(part.size() * sizeof(float)), part.data());
+        for (int r = y0; r < y1; ++r)
+            std::copy_n(part.begin() + static_cast<size_t>(r - y0) * (x1 - x0), x1 - x0,
+                        data + static_cast<size_t>(r - y) * w + (x0 - x));
+    }
+}
+
+float TiledState::valueAt(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return 0.0f;
+    float value = 0.0f;
+    readRegion(x, y, 1, 1, &value);
+    return value;
+}
+
+/**
+ * @brief Index of the tile at offset (dx, dy) from tile (tx, ty), or -1 past a closed edge.
+ */
+int TiledState::neighbor(int tx, int ty, int dx, int dy, bool wrapX, bool wrapY) const {
+    int nx = tx + dx, ny = ty + dy;
+    if (nx < 0 || nx >= m_tilesX) {
+        if (!wrapX) return -1;
+        nx = (nx + m_tilesX) % m_tilesX;
+    }
+    if (ny < 0 || ny >= m_tilesY) {
+        if (!wrapY) return -1;
+        ny = (ny + m_tilesY) % m_tilesY;
+    }
+    return ny * m_tilesX + nx;
+}
+
+/**
+ * @brief Copy the eight neighbors' border cells into each tile's halo.
+ */
+void TiledState::exchangeHalos(bool wrapX, bool wrapY) {
+    for (int ty = 0; ty < m_tilesY; ++ty) {
+        for (int tx = 0; tx < m_tilesX; ++tx) {
+            const Tile& t = m_tiles[ty * m_tilesX + tx];
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (!dx && !dy) continue;
+                    int n = neighbor(tx, ty, dx, dy, wrapX, wrapY);
+                    if (n < 0) continue;
+                    const Tile& s = m_tiles[n];
+
+                    // Source: the neighbor's interior cells nearest to this tile
+                    int srcX = (dx < 0) ? s.w : m_halo;
+                    int srcY = (dy < 0) ? s.h : m_halo;
+                    int dstX = (dx < 0) ? 0 : (dx > 0 ? m_halo + t.w : m_halo);
+                    int dstY = (dy < 0) ? 0 : (dy > 0 ? m_halo + t.h : m_halo);
+                    int w = dx ? m_halo : t.w;
+                    int h = dy ? m_halo : t.h;
+                    glCopyImageSubData(s.tex[m_current], GL_TEXTURE_2D_ARRAY, 0, srcX, srcY, 0,
+                                       t.tex[m_current], GL_TEXTURE_2D_ARRAY, 0, dstX, dstY, 0, w, h, 1);
+                }
+            }
+        }
+    }
+}
+
+void TiledState::uploadParams(const LeniaParams& params) {
+    for (const Tile& t : m_tiles) {
+        GPUChunkParams gpu{};
+        gpu.chunkSize   = t.w;
+        gpu.chunkHeight = t.h;
+        gpu.halo        = m_halo;
+        gpu.radius      = params.radius;
+        gpu.count       = 1;
+        gpu.growthType  = params.growthType;
+        gpu.band        = 1;
+        gpu.mu          = params.mu;
+        gpu.sigma       = params.sigma;
+        gpu.dt          = params.dt;
+        gpu.param1      = params.noiseParam1;
+        gpu.param2      = params.noiseParam2;
+        glNamedBufferSubData(t.ubo, 0, sizeof(GPUChunkParams), &gpu);
+    }
+}
+
+void TiledState::step(const LeniaParams& params, GLuint kernelTex, int steps) {
+    if (!active()) return;
+    TRACE_GL_SCOPE("TiledState::step");
+    bool wrapX = (params.edgeModeX == 0);
+    bool wrapY = (params.edgeModeY == 0);
+    if (wrapX != m_wrapX || wrapY != m_wrapY) {
+        clearHalos();
+        m_wrapX = wrapX;
+        m_wrapY = wrapY;
+    }
+    uploadParams(params);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_neighborSSBO);
+
+    for (int i = 0; i < steps; ++i) {
+        GpuPassScope gpuScope(GpuPass::SimStep);
+        exchangeHalos(wrapX, wrapY);
+
+        m_simShader.use();
+        glBindTextureUnit(2, kernelTex);
+        for (const Tile& t : m_tiles) {
+            glBindBufferBase(GL_UNIFORM_BUFFER, 7, t.ubo);
+            glBindTextureUnit(0, t.tex[m_current]);
+            glBindImageTexture(1, t.tex[m_current ^ 1], 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_R32F);
+            glDispatchCompute(ceilDiv(t.w, 16), ceilDiv(t.h, 16), 1);
+        }
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT |
+                        GL_TEXTURE_UPDATE_BARRIER_BIT);
+        m_current ^= 1;
+    }
+    for (Tile& t : m_tiles) t.overviewDirty = true;
+}
+
+void TiledState::refreshOverview(GLuint overviewTex) {
+    TRACE_GL_SCOPE("TiledState::refreshOverview");
+    m_overviewShader.use();
+    glBindBufferBase(GL_UNIFORM_BUFFER, 8, m_overviewUBO);
+    glBindImageTexture(1, overviewTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    bool any = false;
+    for (Tile& t : m_tiles) {
+        if (!t.overviewDirty) continue;
+        GPUTileParams gpu{};
+        gpu.tileW  = t.w;
+        gpu.tileH  = t.h;
+        gpu.halo   = m_halo;
+        gpu.factor = m_factor;
+        gpu.dstX   = t.x / m_factor;
+        gpu.dstY   = t.y / m_factor;
+        glNamedBufferSubData(m_overviewUBO, 0, sizeof(GPUTileParams), &gpu);
+        glBindTextureUnit(0, t.tex[m_current]);
+        glDispatchCompute(ceilDiv(ceilDiv(t.w, m_factor), 16), ceilDiv(ceilDiv(t.h, m_factor), 16), 1);
+        t.overviewDirty = false;
+        any = true;
+    }
+    if (any) glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+}
+
+}
@@ -0,0 +1,123 @@
+/**
+ * @file TiledState.hpp
+ * @brief Dense single-channel grid split into tiles, for worlds beyond one texture.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include "ChunkedWorld.hpp"
+#include "UIOverlay.hpp"
+#include "Utils/Shader.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief A finite grid stored as many tiles, each its own pair of textures.
+ *
+ * Every tile is an R32F texture (one-layer array, so sim_chunked.comp can
+ * update it) holding the tile plus a halo of kernel radius + 1 cells. Each
+ * step first copies the neighbors' border cells into every halo with
+ * glCopyImageSubData, wrapping around periodic edges; beyond a non-periodic
+ * edge the halo stays empty. No single allocation is larger than one tile,
+ * so the grid is limited by total VRAM rather than GL_MAX_TEXTURE_SIZE.
+ *
+ * Rendering and analysis keep working on an ordinary texture: the overview,
+ * where each texel is the mean of factor x factor cells (factor 1 while the
+ * grid fits in OVERVIEW_LIMIT). Tile origins are multiples of the factor.
+ */
+class TiledState {
+public:
+    static constexpr int OVERVIEW_LIMIT = 4096;    // Largest overview edge in texels
+    static constexpr int DEFAULT_TILE   = 4096;    // Tile edge when none is requested
+    static constexpr int MAX_HALO       = 129;     // Kernel radius 128 + 1
+
+    struct Tile {
+        int    x{0};                     // First world cell covered
+        int    y{0};
+        int    w{0};
+        int    h{0};
+        GLuint tex[2]{0, 0};             // Ping-pong, (w + 2 halo) x (h + 2 halo)
+        GLuint ubo{0};                   // GPUChunkParams for sim_chunked.comp
+        bool   overviewDirty{true};
+    };
+
+    TiledState() = default;
+    ~TiledState();
+
+    TiledState(const TiledState&) = delete;
+    TiledState& operator=(const TiledState&) = delete;
+
+    bool init(const std::string& shaderDir);
+    /** @brief Split a @p width x @p height grid into tiles of at most @p tileEdge; contents start empty. */
+    bool allocate(int width, int height, int tileEdge, int halo);
+    void release();
+    void clear();
+    /** @brief Change the halo width, keeping every tile's contents. */
+    void setHalo(int halo);
+
+    void uploadRegion(int x, int y, int w, int h, const float* data);
+    void readRegion(int x, int y, int w, int h, float* data) const;
+    float valueAt(int x, int y) const;
+    /** @brief Mark a tile written by a shader, so the next overview refresh picks it up. */
+    void markDirty(int index) { m_tiles[index].overviewDirty = true; }
+
+    void step(const LeniaParams& params, GLuint kernelTex, int steps);
+    /** @brief Rebuild the overview texels of tiles changed since the last refresh. */
+    void refreshOverview(GLuint overviewTex);
+
+    bool active() const { return !m_tiles.empty(); }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int halo() const { return m_halo; }
+    int factor() const { return m_factor; }
+    int overviewWidth() const { return (m_width + m_factor - 1) / m_factor; }
+    int overviewHeight() const { return (m_height + m_factor - 1) / m_factor; }
+    int tilesX() const { return m_tilesX; }
+    int tilesY() const { return m_tilesY; }
+    int tileCount() const { return static_cast<int>(m_tiles.size()); }
+    const Tile& tile(int index) const { return m_tiles[index]; }
+    GLuint currentTexture(int index) const { return m_tiles[index].tex[m_current]; }
+
+    /** @brief Smallest block size that brings both edges within OVERVIEW_LIMIT. */
+    static int overviewFactor(int width, int height);
+
+private:
+    Shader m_simShader;
+    Shader m_overviewShader;
+    GLuint m_neighborSSBO{0};            // Slot 0 is its own center neighbor
+    GLuint m_overviewUBO{0};
+    std::vector<Tile> m_tiles;           // Row-major, tilesX per row
+    int    m_current{0};
+    int    m_width{0};
+    int    m_height{0};
+    int    m_tilesX{0};
+    int    m_tilesY{0};
+    int    m_halo{0};
+    int    m_factor{1};
+    bool   m_wrapX{true};                // Edge modes the halos were filled for
+    bool   m_wrapY{true};
+
+    static void splitAxis(int size, int edge, int factor, int halo, std::vector<int>& starts);
+    GLuint createTileTexture(int w, int h, int halo) const;
+    int  neighbor(int tx, int ty, int dx, int dy, bool wrapX, bool wrapY) const;
+    void exchangeHalos(bool wrapX, bool wrapY);
+    void clearHalos();
+    void uploadParams(const LeniaParams& params);
+
+    struct alignas(16) GPUTileParams {
+        int32_t tileW;
+        int32_t tileH;
+        int32_t halo;
+        int32_t factor;
+        int32_t dstX;
+        int32_t dstY;
+        int32_t _pad0;
+        int32_t _pad1;
+    };
+};
+
+}
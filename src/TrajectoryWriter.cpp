@@ -0,0 +1,328 @@
+/**
+ * @file TrajectoryWriter.cpp
+ * @brief Region readbacks, writer thread, downsampling and quantization.
+ */
+
+#include "TrajectoryWriter.hpp"
+#include "LeniaEngine.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace lenia {
+
+static const char* const FIELD_NAMES[TrajectoryWriter::FIELD_COUNT] = {"state", "potential", "growth"};
+
+TrajectoryWriter::~TrajectoryWriter() {
+    stop();
+}
+
+bool TrajectoryWriter::start(const TrajectoryOptions& options, const StateSnapshot& snap) {
+    stop();
+    m_options = options;
+    TrajectoryOptions& o = m_options;
+    o.every = std::max(1, o.every);
+    o.downsample = std::max(1, o.downsample);
+    if (o.bits != 8 && o.bits != 16) o.bits = 32;
+    o.roiX = std::clamp(o.roiX, 0, snap.gridW - 1);
+    o.roiY = std::clamp(o.roiY, 0, snap.gridH - 1);
+    o.roiW = (o.roiW > 0) ? std::min(o.roiW, snap.gridW - o.roiX) : snap.gridW - o.roiX;
+    o.roiH = (o.roiH > 0) ? std::min(o.roiH, snap.gridH - o.roiY) : snap.gridH - o.roiY;
+    if (o.fields == 0 || o.roiW < o.downsample || o.roiH < o.downsample) {
+        LOG_ERROR("Trajectory: nothing to record (fields or region of interest empty).");
+        return false;
+    }
+
+    m_width = o.roiW;
+    m_height = o.roiH;
+    m_outWidth = m_width / o.downsample;
+    m_outHeight = m_height / o.downsample;
+    m_components = (snap.format == GL_RGBA32F) ? 3 : 1;
+    m_cellScale = std::max(1, snap.cellScale);
+    m_lo = {0.0f, 0.0f, -std::max(o.growthHi, 1e-6f)};
+    m_hi = {1.0f, std::max(o.potentialHi, 1e-6f), std::max(o.growthHi, 1e-6f)};
+    m_frameBytes = 0;
+    if (m_cellScale > 1) {
+        LOG_WARN("Trajectory: tiled grid recorded from its %dx%d overview, one value per %dx%d cells.",
+                 snap.gridW, snap.gridH, m_cellScale, m_cellScale);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(o.dir, ec);
+    const char* descr = (o.bits == 8) ? "|u1" : (o.bits == 16) ? "<u2" : "<f4";
+    std::vector<int> shape = {m_outHeight, m_outWidth};
+    if (m_components > 1) shape.push_back(m_components);
+    bool ok = !ec;
+    for (int f = 0; f < FIELD_COUNT && ok; ++f) {
+        if (!(o.fields & (1u << f))) continue;
+        std::string path = (std::filesystem::path(o.dir) / (std::string(FIELD_NAMES[f]) + ".npy")).string();
+        ok = m_files[f].open(path, descr, shape);
+        m_frameBytes += static_cast<size_t>(m_width) * m_height * m_components * sizeof(float);
+    }
+    ok = ok && m_steps.open((std::filesystem::path(o.dir) / "steps.npy").string(), "<i8", {}) && writeMetadata();
+    if (!ok) {
+        LOG_ERROR("Trajectory: cannot write to %s", o.dir.c_str());
+        for (NpyStreamWriter& file : m_files) file.close();
+        m_steps.close();
+        return false;
+    }
+
+    m_lastStep = 0;
+    m_captured = m_written = 0;
+    m_stallMs = 0.0;
+    m_failed = false;
+    m_queuedBytes = 0;
+    m_stopping = false;
+    m_recording = true;
+    m_writer = std::thread([this]() { writerLoop(); });
+    LOG_INFO("Trajectory to %s: region %d,%d %dx%d, every %d steps, %dx%d at %d bits.",
+             o.dir.c_str(), o.roiX, o.roiY, o.roiW, o.roiH, o.every, m_outWidth, m_outHeight, o.bits);
+    return true;
+}
+
+void TrajectoryWriter::stop() {
+    if (!m_recording) return;
+    poll(true);
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_writer.join();
+    for (NpyStreamWriter& file : m_files) file.close();
+    m_steps.close();
+    release();
+    m_recording = false;
+    LOG_INFO("Trajectory %s: %d frames, %.0f ms waiting for the writer.",
+             m_options.dir.c_str(), m_written, m_stallMs);
+    if (m_failed) LOG_ERROR("Trajectory %s is incomplete: a write failed.", m_options.dir.c_str());
+}
+
+bool TrajectoryWriter::due(int stepCount) const {
+    return m_recording && (m_captured == 0 || stepCount - m_lastStep >= m_options.every);
+}
+
+void TrajectoryWriter::capture(const StateSnapshot& snap) {
+    TRACE_GL_SCOPE("TrajectoryWriter::capture");
+    if (!m_recording) return;
+    GLuint textures[FIELD_COUNT] = {snap.stateTex, snap.neighborSumsTex, snap.growthTex};
+    if (snap.gridW < m_options.roiX + m_width || snap.gridH < m_options.roiY + m_height) {
+        LOG_WARN("Trajectory: the grid shrank below the recorded region; frame at step %d skipped.", snap.stepCount);
+        return;
+    }
+
+    poll();
+    if (m_inFlight == RING_SIZE) {
+        auto t0 = std::chrono::steady_clock::now();
+        poll(true);
+        m_stallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    Slot& slot = m_slots[m_next];
+    size_t fieldBytes = static_cast<size_t>(m_width) * m_height * m_components * sizeof(float);
+    glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+    for (int f = 0; f < FIELD_COUNT; ++f) {
+        if (!(m_options.fields & (1u << f))) continue;
+        if (!slot.buffers[f]) {
+            glCreateBuffers(1, &slot.buffers[f]);
+            glNamedBufferStorage(slot.buffers[f], static_cast<GLsizeiptr>(fieldBytes), nullptr, GL_MAP_READ_BIT);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffers[f]);
+        if (textures[f]) {
+            glGetTextureSubImage(textures[f], 0, m_options.roiX, m_options.roiY, 0, m_width, m_height, 1,
+                                 m_components == 3 ? GL_RGB : GL_RED, GL_FLOAT,
+                                 static_cast<GLsizei>(fieldBytes), nullptr);
+        } else {
+            // Debug outputs appear after the first step; record zeros until then
+            glClearNamedBufferData(slot.buffers[f], GL_R32F, GL_RED, GL_FLOAT, nullptr);
+        }
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.step = snap.stepCount;
+    m_next = (m_next + 1) % RING_SIZE;
+    ++m_inFlight;
+    ++m_captured;
+    m_lastStep = snap.stepCount;
+}
+
+/**
+ * @brief Queue the copied frame if the queue has a free entry and the byte budget allows it.
+ */
+bool TrajectoryWriter::pushPending() {
+    if (!m_hasPending) return true;
+    size_t queued = m_queuedBytes.load(std::memory_order_acquire);
+    if (queued > 0 && queued + m_frameBytes > m_options.maxQueuedBytes) return false;
+    m_queuedBytes.fetch_add(m_frameBytes, std::memory_order_acq_rel);
+    if (!m_queue.push(m_pending)) {
+        m_queuedBytes.fetch_sub(m_frameBytes, std::memory_order_acq_rel);
+        return false;
+    }
+    m_hasPending = false;
+    m_wake.notify_one();
+    return true;
+}
+
+void TrajectoryWriter::poll(bool wait) {
+    auto pushOrWait = [&]() {
+        while (!pushPending()) {
+            if (!wait) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    };
+    if (!pushOrWait()) return;
+
+    while (m_inFlight > 0) {
+        Slot& slot = m_slots[m_oldest];
+        GLuint64 timeout = wait ? GL_TIMEOUT_IGNORED : 0;
+        GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return;
+
+        size_t fieldFloats = static_cast<size_t>(m_width) * m_height * m_components;
+        m_pending.step = slot.step;
+        for (int f = 0; f < FIELD_COUNT; ++f) {
+            std::vector<float>& data = m_pending.fields[f];
+            if (!(m_options.fields & (1u << f))) {
+                data.clear();
+                continue;
+            }
+            data.resize(fieldFloats);
+            const void* mapped = glMapNamedBufferRange(slot.buffers[f], 0,
+                                                       static_cast<GLsizeiptr>(fieldFloats * sizeof(float)),
+                                                       GL_MAP_READ_BIT);
+            if (mapped) {
+                std::memcpy(data.data(), mapped, fieldFloats * sizeof(float));
+                glUnmapNamedBuffer(slot.buffers[f]);
+            } else {
+                std::fill(data.begin(), data.end(), 0.0f);
+            }
+        }
+        m_hasPending = true;
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        m_oldest = (m_oldest + 1) % RING_SIZE;
+        --m_inFlight;
+        if (!pushOrWait()) return;
+    }
+}
+
+void TrajectoryWriter::release() {
+    for (Slot& slot : m_slots) {
+        if (slot.fence) glDeleteSync(slot.fence);
+        for (GLuint& buffer : slot.buffers)
+            if (buffer) glDeleteBuffers(1, &buffer);
+        slot = Slot{};
+    }
+    m_next = m_oldest = m_inFlight = 0;
+    m_pending = Frame{};
+    m_hasPending = false;
+}
+
+/**
+ * @brief trajectory.json: region, sampling and how to turn stored values back into floats.
+ */
+bool TrajectoryWriter::writeMetadata() const {
+    const TrajectoryOptions& o = m_options;
+    std::ofstream file(std::filesystem::path(o.dir) / "trajectory.json", std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.precision(9);                  // Ranges round-trip exactly
+    file << "{\n"
+         << "  \"every\": " << o.every << ",\n"
+         << "  \"roi\": [" << o.roiX << ", " << o.roiY << ", " << o.roiW << ", " << o.roiH << "],\n"
+         << "  \"downsample\": " << o.downsample << ",\n"
+         << "  \"cell_scale\": " << m_cellScale << ",\n"
+         << "  \"grid_cells_per_pixel\": " << m_cellScale * o.downsample << ",\n"
+         << "  \"channels\": " << m_components << ",\n"
+         << "  \"dtype\": \"" << (o.bits == 8 ? "uint8" : o.bits == 16 ? "uint16" : "float32") << "\",\n"
+         << "  \"fields\": {";
+    bool first = true;
+    for (int f = 0; f < FIELD_COUNT; ++f) {
+        if (!(o.fields & (1u << f))) continue;
+        file << (first ? "\n" : ",\n") << "    \"" << FIELD_NAMES[f] << "\": {\"file\": \"" << FIELD_NAMES[f]
+             << ".npy\", \"lo\": " << m_lo[f] << ", \"hi\": " << m_hi[f] << "}";
+        first = false;
+    }
+    file << "\n  },\n"
+         << "  \"dequantize\": \"lo + q / (2**bits - 1) * (hi - lo)\"\n"
+         << "}\n";
+    return static_cast<bool>(file);
+}
+
+// ---------------------------------------------------------------------------
+// Writer thread
+// ---------------------------------------------------------------------------
+
+void TrajectoryWriter::writerLoop() {
+    Frame frame;
+    for (;;) {
+        if (m_queue.pop(frame)) {
+            if (!m_failed) writeFrame(frame);
+            m_queuedBytes.fetch_sub(m_frameBytes, std::memory_order_acq_rel);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        if (m_stopping && m_queue.empty()) return;
+        m_wake.wait_for(lock, std::chrono::milliseconds(50),
+                        [this]() { return m_stopping || !m_queue.empty(); });
+    }
+}
+
+/**
+ * @brief Box-average, quantize and append one record per field, then its step.
+ */
+void TrajectoryWriter::writeFrame(const Frame& frame) {
+    TRACE_SCOPE("TrajectoryWriter::writeFrame");
+    int ds = m_options.downsample;
+    int bits = m_options.bits;
+    size_t outValues = static_cast<size_t>(m_outWidth) * m_outHeight * m_components;
+    size_t valueBytes = static_cast<size_t>(bits / 8);
+    m_record.resize(outValues * valueBytes);
+    float invArea = 1.0f / static_cast<float>(ds * ds);
+    float qMax = (bits == 8) ? 255.0f : 65535.0f;
+
+    for (int f = 0; f < FIELD_COUNT; ++f) {
+        if (frame.fields[f].empty()) continue;
+        const float* src = frame.fields[f].data();
+        float scale = qMax / (m_hi[f] - m_lo[f]);
+        for (int oy = 0; oy < m_outHeight; ++oy) {
+            for (int ox = 0; ox < m_outWidth; ++ox) {
+                for (int c = 0; c < m_components; ++c) {
+                    float v = 0.0f;
+                    for (int dy = 0; dy < ds; ++dy) {
+                        const float* row = src + (static_cast<size_t>(oy * ds + dy) * m_width + ox * ds) * m_components + c;
+                        for (int dx = 0; dx < ds; ++dx) v += row[static_cast<size_t>(dx) * m_components];
+                    }
+                    v *= invArea;
+                    size_t i = (static_cast<size_t>(oy) * m_outWidth + ox) * m_components + c;
+                    if (bits == 32) {
+                        std::memcpy(m_record.data() + i * 4, &v, 4);
+                        continue;
+                    }
+                    float q = std::clamp((v - m_lo[f]) * scale, 0.0f, qMax) + 0.5f;
+                    if (bits == 8) {
+                        m_record[i] = static_cast<uint8_t>(q);
+                    } else {
+                        uint16_t q16 = static_cast<uint16_t>(q);
+                        std::memcpy(m_record.data() + i * 2, &q16, 2);
+                    }
+                }
+            }
+        }
+        if (!m_files[f].append(m_record.data())) m_failed = true;
+    }
+    if (!m_steps.append(&frame.step)) m_failed = true;
+    ++m_written;
+    if (m_written % FLUSH_FRAMES == 0) {
+        for (NpyStreamWriter& file : m_files) file.flush();
+        m_steps.flush();
+    }
+}
+
+}
@@ -0,0 +1,144 @@
+/**
+ * @file TrajectoryWriter.hpp
+ * @brief Streams time series of simulation fields to appendable .npy files.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include "Utils/NpyLoader.hpp"
+#include "Utils/SpscQueue.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lenia {
+
+struct StateSnapshot;
+
+enum TrajectoryField : uint32_t {
+    TRAJ_STATE     = 1u << 0,
+    TRAJ_POTENTIAL = 1u << 1,      // Neighbor sums
+    TRAJ_GROWTH    = 1u << 2
+};
+
+struct TrajectoryOptions {
+    std::string dir;                    // Output directory
+    uint32_t    fields{TRAJ_STATE};     // TrajectoryField mask
+    int         every{10};              // Steps between frames
+    int         roiX{0};                // Region of interest in state texels
+    int         roiY{0};
+    int         roiW{0};                // 0 = to the grid edge
+    int         roiH{0};
+    int         downsample{1};          // Box average over n x n texels
+    int         bits{32};               // 8 or 16 quantize; 32 keeps float32
+    float       potentialHi{1.0f};      // Quantization range 0..potentialHi, see LeniaEngine::potentialBound()
+    float       growthHi{1.0f};         // Quantization range -growthHi..growthHi, see LeniaEngine::growthBound()
+    size_t      maxQueuedBytes{256u << 20};  // Readbacks waiting for the writer
+};
+
+/**
+ * @brief Writes <dir>/<field>.npy of shape (T, H, W) or (T, H, W, 3) plus
+ *        steps.npy and trajectory.json.
+ *
+ * capture() queues readbacks of the region of interest of each selected
+ * texture into a ring of pixel pack buffers; poll() hands finished ones to
+ * a writer thread that downsamples, quantizes and appends them. Frames are
+ * never dropped: when the ring or the bounded queue is full the caller
+ * waits, and the time spent waiting is reported. Headers are rewritten
+ * every FLUSH_FRAMES frames, so an interrupted run stays loadable.
+ *
+ * 8 and 16 bit frames map each field's range onto the integers; the
+ * ranges are recorded in trajectory.json. The caller sets the potential
+ * and growth ranges from the rules (a Game of Life potential counts up to
+ * 8 neighbors); values outside them are clamped.
+ *
+ * Tiled grids only expose their overview texture, so beyond 4096 cells per
+ * edge frames hold one mean per cellScale x cellScale cells; start() warns
+ * and trajectory.json records the grid cells per stored pixel.
+ */
+class TrajectoryWriter {
+public:
+    static constexpr int RING_SIZE = 3;
+    static constexpr int QUEUE_SIZE = 17;
+    static constexpr int FLUSH_FRAMES = 32;
+    static constexpr int FIELD_COUNT = 3;
+
+    TrajectoryWriter() = default;
+    ~TrajectoryWriter();
+
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+    /** @brief Open the output for the grid of @p snap; the region is clamped to it. */
+    bool start(const TrajectoryOptions& options, const StateSnapshot& snap);
+    void stop();
+    bool recording() const { return m_recording; }
+
+    bool due(int stepCount) const;
+    /** @brief Queue readbacks of the selected fields of @p snap. */
+    void capture(const StateSnapshot& snap);
+    /** @brief Hand finished readbacks to the writer; @p wait blocks on all of them. */
+    void poll(bool wait = false);
+
+private:
+    struct Frame {
+        std::array<std::vector<float>, FIELD_COUNT> fields;
+        int64_t step{0};
+    };
+
+    struct Slot {
+        std::array<GLuint, FIELD_COUNT> buffers{};
+        GLsync  fence{nullptr};
+        int64_t step{0};
+    };
+
+    TrajectoryOptions m_options;
+    bool   m_recording{false};
+    int    m_width{0};               // Region read back
+    int    m_height{0};
+    int    m_outWidth{0};            // After downsampling
+    int    m_outHeight{0};
+    int    m_components{1};
+    int    m_cellScale{1};           // Grid cells per state texel (tiled overview)
+    std::array<float, FIELD_COUNT> m_lo{};   // Quantization range per field
+    std::array<float, FIELD_COUNT> m_hi{};
+    size_t m_frameBytes{0};          // Floats of one frame, all fields
+    int    m_lastStep{0};
+    int    m_captured{0};
+    double m_stallMs{0.0};
+
+    std::array<Slot, RING_SIZE> m_slots{};
+    int   m_next{0};
+    int   m_oldest{0};
+    int   m_inFlight{0};
+    Frame m_pending;
+    bool  m_hasPending{false};
+
+    SpscQueue<Frame, QUEUE_SIZE> m_queue;
+    std::atomic<size_t>     m_queuedBytes{0};
+    std::thread             m_writer;
+    std::mutex              m_wakeMutex;
+    std::condition_variable m_wake;
+    bool                    m_stopping{false};  // Guarded by m_wakeMutex
+
+    // Writer thread only
+    std::array<NpyStreamWriter, FIELD_COUNT> m_files;
+    NpyStreamWriter      m_steps;
+    std::vector<uint8_t> m_record;
+    int                  m_written{0};
+    bool                 m_failed{false};
+
+    bool pushPending();
+    void writerLoop();
+    void writeFrame(const Frame& frame);
+    bool writeMetadata() const;
+    void release();
+};
+
+}
@@ -29,6 +29,18 @@
 
 namespace lenia {
 
+/**
+ * @brief Persist the settings read back at startup to lenia_config.txt.
+ */
+static void saveStartupConfig(const LeniaParams& params) {
+    std::ofstream cfg("lenia_config.txt");
+    if (cfg.is_open()) {
+        cfg << "showConsole=" << (params.showConsoleOnStartup ? "1" : "0") << "\n";
+        cfg << "threadedSimulation=" << (params.threadedSimulation ? "1" : "0") << "\n";
+        cfg.close();
+    }
+}
+
 /**
  * @brief Apply subtle color tinting to UI section headers.
  * Different sections get unique colors for visual distinction.
@@ -346,6 +358,17 @@ bool UIOverlay::init(GLFWwindow* window) {
     return true;
 }
 
+/**
+ * @brief Latest per-pass GPU timings, sampled once per UI frame for the graph.
+ */
+void UIOverlay::setGpuTimings(const GpuPassTimes& times) {
+    if (!times.valid) return;
+    m_gpuTimes = times;
+    m_gpuTimeHistory[m_gpuTimeHead] = times.totalMs;
+    m_gpuTimeHead = (m_gpuTimeHead + 1) % 120;
+    if (m_gpuTimeCount < 120) m_gpuTimeCount++;
+}
+
 void UIOverlay::beginFrame() {
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
@@ -978,13 +1001,8 @@ void UIOverlay::render(LeniaParams& params, bool& paused, int& stepsPerFrame, bo
         ImGui::Text(TR(InfoChannels), params.numChannels, params.numKernelRules);
 
         ImGui::Separator();
-        if (ImGui::Checkbox(TR(InfoShowConsoleStartup), &params.showConsoleOnStartup)) {
-            std::ofstream cfg("lenia_config.txt");
-            if (cfg.is_open()) {
-                cfg << "showConsole=" << (params.showConsoleOnStartup ? "1" : "0") << "\n";
-                cfg.close();
-            }
-        }
+        if (ImGui::Checkbox(TR(InfoShowConsoleStartup), &params.showConsoleOnStartup))
+            saveStartupConfig(params);
         Tooltip(TR(InfoShowConsoleTooltip));
 
         ImGui::SeparatorText(TR(KeybindsHeader));
@@ -1106,6 +1124,73 @@ void UIOverlay::render(LeniaParams& params, bool& paused, int& stepsPerFrame, bo
         ImGui::SameLine(120);
         ImGui::Text("%d", stepCount);
 
+        ImGui::SeparatorText(TR(PerfGpuPasses));
+        Tooltip(TR(PerfGpuPassesTooltip));
+        if (!m_gpuTimes.valid) {
+            ImGui::TextDisabled(TR(PerfGpuNoData));
+        } else {
+            static const TextId passNames[] = {
+                TextId::PerfGpuPassKernelGen, TextId::PerfGpuPassSimStep, TextId::PerfGpuPassObstacles,
+                TextId::PerfGpuPassAnalysis, TextId::PerfGpuPassRender, TextId::PerfGpuPassImGui
+            };
+            for (int p = 0; p < static_cast<int>(GpuPass::Count); ++p) {
+                if (m_gpuTimes.spans[p] == 0) continue;
+                ImGui::Text("%s", Localization::instance().get(passNames[p]));
+                ImGui::SameLine(120);
+                ImGui::Text(TR(PerfGpuPassTime), m_gpuTimes.ms[p], m_gpuTimes.spans[p]);
+            }
+            ImGui::Text(TR(PerfGpuTotal));
+            ImGui::SameLine(120);
+            ImGui::Text("%.3f ms", m_gpuTimes.totalMs);
+
+            float gpuSimMs = m_gpuTimes.ms[static_cast<int>(GpuPass::SimStep)];
+            if (gpuSimMs > 0.0f) {
+                float gpuStepMs = gpuSimMs / std::max(1, stepsPerFrame);
+                float gpuCellsPerSec = static_cast<float>(totalCells) / (gpuStepMs / 1000.0f);
+                ImGui::Text(TR(PerfGpuThroughput));
+                ImGui::SameLine(120);
+                if (gpuCellsPerSec >= 1e9f)
+                    ImGui::Text(TR(PerfThroughputG), gpuCellsPerSec / 1e9f);
+                else if (gpuCellsPerSec >= 1e6f)
+                    ImGui::Text(TR(PerfThroughputM), gpuCellsPerSec / 1e6f);
+                else
+                    ImGui::Text(TR(PerfThroughputK), gpuCellsPerSec / 1e3f);
+                Tooltip(TR(PerfGpuThroughputTooltip));
+
+                // Minimum texture traffic per step; kernel taps are assumed to hit the cache
+                double cells = static_cast<double>(totalCells);
+                double stateBytes = (params.numChannels > 1 || params.numKernelRules > 0) ? 16.0 : 4.0;
+                double stepBytes;
+                if (params.numKernelRules > 0) {
+                    // Copy current->next, clear both debug textures, then per rule:
+                    // read current and next, write next and both debug textures
+                    stepBytes = cells * (2.0 * stateBytes + 2.0 * 16.0 +
+                                         params.numKernelRules * (3.0 * stateBytes + 2.0 * 16.0));
+                } else {
+                    stepBytes = cells * (2.0 * stateBytes + (params.displayMode != 0 ? 2.0 * 16.0 : 0.0));
+                }
+                double gbPerSec = stepBytes / (gpuStepMs / 1000.0) / 1e9;
+                ImGui::Text(TR(PerfGpuBandwidth));
+                ImGui::SameLine(120);
+                ImGui::Text(TR(PerfGpuBandwidthValue), gbPerSec);
+                Tooltip(TR(PerfGpuBandwidthTooltip));
+            }
+
+            if (m_gpuTimeCount > 1) {
+                float gpuPlot[120];
+                float maxGpu = 0.0f;
+                for (int i = 0; i < m_gpuTimeCount; ++i) {
+                    int idx = (m_gpuTimeHead - m_gpuTimeCount + i + 120) % 120;
+                    gpuPlot[i] = m_gpuTimeHistory[idx];
+                    maxGpu = std::max(maxGpu, gpuPlot[i]);
+                }
+                drawGraphWithAxes(TR(PerfGpuTimeGraphTitle), gpuPlot, m_gpuTimeCount, 0.0f,
+                                  std::max(0.1f, maxGpu * 1.2f),
+                                  TR(PerfFrameTimeGraphXLabel), TR(PerfFrameTimeGraphYLabel), 70.0f,
+                                  IM_COL32(255, 170, 80, 220));
+            }
+        }
+
         ImGui::Separator();
         const char* perfLevel;
         ImVec4 perfColor;
@@ -1133,6 +1218,34 @@ void UIOverlay::render(LeniaParams& params, bool& paused, int& stepsPerFrame, bo
         }
         
         ImGui::Spacing();
+        ImGui::Checkbox(TR(PerfTraceRecord), &params.traceRecording);
+        Tooltip(TR(PerfTraceRecordTooltip));
+        ImGui::SameLine();
+        ImGui::BeginDisabled(!params.traceRecording);
+        if (ImGui::Button(TR(PerfTraceSave)) && m_callbacks.onSaveTrace)
+            m_callbacks.onSaveTrace();
+        ImGui::EndDisabled();
+        Tooltip(TR(PerfTraceSaveTooltip));
+
+        ImGui::Checkbox(TR(PerfRecord), &params.recordVideo);
+        Tooltip(TR(PerfRecordTooltip));
+        if (params.recordVideo) {
+            ImGui::SameLine();
+            ImGui::TextDisabled(TR(PerfRecordStatus), params.recordFrames, params.recordDropped);
+        }
+        ImGui::BeginDisabled(params.recordVideo);
+        const char* recordSources[] = {
+            TR(PerfRecordSourceFrame), TR(PerfRecordSourceState), TR(DisplayNeighborSums), TR(DisplayGrowthValues)
+        };
+        ImGui::Combo(TR(PerfRecordSource), &params.recordSource, recordSources, 4);
+        Tooltip(TR(PerfRecordSourceTooltip));
+        const char* recordFormats[] = { TR(PerfRecordFormatPng), TR(PerfRecordFormatY4m) };
+        ImGui::Combo(TR(PerfRecordFormat), &params.recordFormat, recordFormats, 2);
+        ImGui::InputInt(TR(PerfRecordEvery), &params.recordEvery, 1, 10);
+        Tooltip(TR(PerfRecordEveryTooltip));
+        params.recordEvery = std::max(1, params.recordEvery);
+        ImGui::EndDisabled();
+
         ImGui::Checkbox(TR(PerfShowResourceMonitor), &params.showResourceMonitor);
         if (params.showResourceMonitor) {
             ImGui::Separator();
@@ -1154,7 +1267,8 @@ void UIOverlay::render(LeniaParams& params, bool& paused, int& stepsPerFrame, bo
                 ImGui::Text(TR(PerfCPUMemory), params.cpuMemoryUsedMB);
             }
             
-            int gridMemBytes = params.gridW * params.gridH * (params.numChannels > 1 ? 16 : 4) * 2;
+            double gridMemBytes = static_cast<double>(params.gridW) * params.gridH * (params.numChannels > 1 ? 16 : 4) *
+                                  (params.inPlaceUpdate ? 1 : 2);
             int kernelMemBytes = (params.radius * 2) * (params.radius * 2) * 4;
             float totalTexMB = (gridMemBytes + kernelMemBytes) / (1024.0f * 1024.0f);
             ImGui::Text(TR(PerfTextureMemory), totalTexMB);
@@ -1184,6 +1298,32 @@ void UIOverlay::render(LeniaParams& params, bool& paused, int& stepsPerFrame, bo
         params.gridH = std::max(32, params.gridH);
         if (params.gridW != prevW || params.gridH != prevH) gridDirty = true;
 
+        int prevTile = params.tileSize;
+        std::string tileLabel = std::string(TR(GridTileSize)) + "##grid";
+        ImGui::InputInt(tileLabel.c_str(), &params.tileSize, 256, 1024);
+        Tooltip(TR(GridTileSizeTooltip));
+        params.tileSize = std::max(0, params.tileSize);
+        if (params.tileSize != prevTile) gridDirty = true;
+        if (params.gridTilesX > 0)
+            ImGui::TextDisabled(TR(GridTiledInfo), params.gridTilesX, params.gridTilesY,
+                                params.gridOverviewScale, params.gridOverviewScale);
+        ImGui::Checkbox(TR(GridInPlace), &params.inPlaceUpdate);
+        Tooltip(TR(GridInPlaceTooltip));
+
+        float halfW = (ImGui::GetContentRegionAvail().x - ImGui::GetStyle().ItemSpacing.x) / 2.0f;
+        if (ImGui::Button(TR(GridCheckpointSave), ImVec2(halfW, 0)) && m_callbacks.onSaveCheckpoint)
+            m_callbacks.onSaveCheckpoint();
+        Tooltip(TR(GridCheckpointSaveTooltip));
+        ImGui::SameLine();
+        if (ImGui::Button(TR(GridCheckpointLoad), ImVec2(halfW, 0)) && m_callbacks.onLoadCheckpoint)
+            m_callbacks.onLoadCheckpoint();
+        Tooltip(TR(GridCheckpointLoadTooltip));
+        if (ImGui::Button(TR(GridExportNumpy), ImVec2(-1, 0)) && m_callbacks.onExportFields)
+            m_callbacks.onExportFields();
+        Tooltip(TR(GridExportNumpyTooltip));
+        ImGui::Checkbox(TR(GridKeepDebugFields), &params.keepDebugFields);
+        Tooltip(TR(GridKeepDebugFieldsTooltip));
+
         if (gridDirty && m_callbacks.onGridResized)
             m_callbacks.onGridResized();
 
@@ -1298,6 +1438,7 @@ void UIOverlay::render(LeniaParams& params, bool& paused, int& stepsPerFrame, bo
                 
                 ImGui::Text(TR(InfiniteChunkPosition), params.viewChunkX, params.viewChunkY);
                 ImGui::Text(TR(InfiniteWorldOffset), params.panX, params.panY);
+                ImGui::Text(TR(InfiniteChunkStats), params.worldResidentChunks, params.worldCachedChunks);
                 
                 float navBtnW = (ImGui::GetContentRegionAvail().x - ImGui::GetStyle().ItemSpacing.x * 2) / 3.0f;
                 
@@ -1700,13 +1841,40 @@ void UIOverlay::render(LeniaParams& params, bool& paused, int& stepsPerFrame, bo
         ImGui::SameLine();
         ImGui::TextDisabled(TR(SimHoldToStep));
 
+        bool autoSteps = (params.autoStepsMode != 0);
+        if (autoSteps) ImGui::BeginDisabled();
         SliderIntWithInput(TR(SimStepsPerFrame), &stepsPerFrame, 1, 50);
         { int r[] = {1}; int g[] = {5, 10, 20}; drawSliderMarkersInt(1, 50, r, 1, g, 3); snapInt(stepsPerFrame, 1, 50, r, 1); snapInt(stepsPerFrame, 1, 50, g, 3); }
+        if (autoSteps) ImGui::EndDisabled();
         Tooltip(TR(SimStepsPerFrameTooltip));
 
+        const char* autoStepsNames[] = { TR(CommonOff), TR(SimAutoStepsFrameBudget), TR(SimAutoStepsRate) };
+        ImGui::Combo(TR(SimAutoSteps), &params.autoStepsMode, autoStepsNames, 3);
+        Tooltip(TR(SimAutoStepsTooltip));
+        if (params.autoStepsMode == 1) {
+            SliderFloatWithInput(TR(SimAutoStepsBudgetMs), &params.autoStepsFrameMs, 1.0f, 100.0f, "%.1f");
+            Tooltip(TR(SimAutoStepsBudgetMsTooltip));
+        } else if (params.autoStepsMode == 2) {
+            SliderFloatWithInput(TR(SimAutoStepsTargetRate), &params.autoStepsPerSecond, 1.0f, 10000.0f, "%.0f");
+            Tooltip(TR(SimAutoStepsTargetRateTooltip));
+        }
+
         ImGui::Text(TR(SimStepFormat), stepCount);
         ImGui::SameLine();
         ImGui::Text(TR(SimTimeMs), simTimeMs);
+        if (params.gpuStepMs > 0.0f) {
+            ImGui::SameLine();
+            ImGui::Text(TR(SimGpuStepMs), params.gpuStepMs);
+        }
+
+        ImGui::Checkbox(TR(SimIdleWhenPaused), &params.idleWhenPaused);
+        Tooltip(TR(SimIdleWhenPausedTooltip));
+        ImGui::SameLine();
+        ImGui::Checkbox(TR(SimMaxSpeed), &params.maxSpeed);
+        Tooltip(TR(SimMaxSpeedTooltip));
+        if (ImGui::Checkbox(TR(SimThreaded), &params.threadedSimulation))
+            saveStartupConfig(params);
+        Tooltip(TR(SimThreadedTooltip));
     }
     popSectionColor();
     pushSectionColor(sec++);
@@ -2146,6 +2314,9 @@ void UIOverlay::render(LeniaParams& params, bool& paused, int& stepsPerFrame, bo
         const char* filterNames[] = {TR(DisplayFilterBilinear), TR(DisplayFilterNearest), TR(DisplayFilterSharpen)};
         ImGui::Combo(TR(DisplayFilterMode), &params.filterMode, filterNames, 3);
         Tooltip(TR(DisplayFilterModeTooltip));
+        const char* pyramidNames[] = {TR(CommonOff), TR(DisplayPyramidMean), TR(DisplayPyramidMax), TR(DisplayPyramidMin)};
+        ImGui::Combo(TR(DisplayPyramid), &params.displayPyramid, pyramidNames, 4);
+        Tooltip(TR(DisplayPyramidTooltip));
         SliderFloatWithInput(TR(DisplayEdgeDetect), &params.edgeStrength, 0.0f, 1.0f, "%.2f");
         { float r[] = {0.0f}; drawSliderMarkers(0.0f, 1.0f, r, 1, nullptr, 0); snapFloat(params.edgeStrength, 0.0f, 1.0f, r, 1); }
         Tooltip(TR(DisplayEdgeDetectTooltip));
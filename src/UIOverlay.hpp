@@ -11,6 +11,7 @@
 #include <glad/glad.h>
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
+#include "GpuProfiler.hpp"
 #include <functional>
 #include <utility>
 #include <vector>
@@ -107,6 +108,11 @@ struct LeniaParams {
     // === Grid Settings ===
     int   gridW{478};             // Grid width in cells
     int   gridH{478};             // Grid height in cells
+    int   tileSize{0};            // Tile edge for tiled grids (0 = tile only past the texture size limit)
+    int   gridTilesX{0};          // Tiles of a tiled grid, 0 if it is one texture (filled by the app)
+    int   gridTilesY{0};
+    int   gridOverviewScale{1};   // Grid cells per displayed texel (filled by the app)
+    bool  inPlaceUpdate{false};   // One state texture updated in bands instead of ping-pong
     
     // === Initialization ===
     int   noiseMode{0};           // Initialization mode
@@ -123,6 +129,7 @@ struct LeniaParams {
     float brightness{0.5f};       // Display brightness
     float contrast{1.0f};         // Display contrast
     int   filterMode{0};
+    int   displayPyramid{1};      // Zoomed-out sampling: 0=Off, 1=Mean, 2=Max, 3=Min
     float glowStrength{0.0f};
     float edgeStrength{0.0f};
     float trailDecay{0.0f};
@@ -239,6 +246,22 @@ struct LeniaParams {
     int   gpuMemoryTotalMB{0};
     float gpuUtilization{0.0f};
     float cpuMemoryUsedMB{0.0f};
+    bool  traceRecording{false};  // Record CPU/GPU spans for Chrome trace export
+    bool  recordVideo{false};     // Frame recorder running
+    int   recordSource{0};        // RecordSource: 0=Display, 1=State, 2=Potential, 3=Growth
+    int   recordFormat{0};        // RecordFormat: 0=PNG sequence, 1=Y4M
+    int   recordEvery{1};         // Steps between recorded frames
+    int   recordFrames{0};        // Frames captured (filled by the app)
+    int   recordDropped{0};       // Frames dropped (filled by the app)
+    bool  keepDebugFields{false}; // Write neighbor sums and growth every step (trajectories, exports)
+
+    bool  idleWhenPaused{true};   // Block on window events while paused and untouched
+    bool  maxSpeed{false};        // Simulate flat out, redraw only a few times per second
+    bool  threadedSimulation{false};  // Step the simulation on its own thread and GL context
+    int   autoStepsMode{0};           // 0=Off, 1=Frame budget, 2=Steps per second (AutoStepsMode)
+    float autoStepsFrameMs{12.0f};    // GPU milliseconds per batch in frame budget mode
+    float autoStepsPerSecond{600.0f}; // Target simulation rate in steps per second mode
+    float gpuStepMs{0.0f};            // Measured GPU time per step (filled by the app)
 
     bool  infiniteWorldMode{false};
     int   chunkSize{128};
@@ -251,6 +274,8 @@ struct LeniaParams {
     bool  chunkBoundaryVisible{false};
     int   chunkPersistence{0};
     float chunkFadeDistance{2.0f};
+    int   worldResidentChunks{0};    // Chunks in VRAM (filled by the app)
+    int   worldCachedChunks{0};      // Chunks in the compressed cache (filled by the app)
 
     int   brushShape{0};
     int   brushSize{10};
@@ -384,6 +409,10 @@ struct UICallbacks {
     std::function<void(int, int, int, int, const LeniaParams&)> onWallLine;
     std::function<void(const std::vector<std::pair<int,int>>&, const LeniaParams&)> onWallCurve;
     std::function<void()> onClearWalls;
+    std::function<void()> onSaveTrace;
+    std::function<void()> onSaveCheckpoint;
+    std::function<void()> onLoadCheckpoint;
+    std::function<void()> onExportFields;
 };
 
 class UIOverlay {
@@ -410,10 +439,12 @@ public:
     void setCustomColormapData(const std::vector<std::vector<std::array<float, 4>>>& data) { m_customColormapData = data; }
     int selectedPreset() const { return m_selectedPreset; }
     void setSelectedPreset(int idx) { m_selectedPreset = idx; }
+    void setGpuTimings(const GpuPassTimes& times);
     void setSelectedCategory(int idx) { m_selectedCategory = idx; }
     void triggerPauseOverlay(bool isPaused);
     void updatePauseOverlay(float deltaTime);
     void renderPauseOverlay(int windowW, int windowH);
+    bool pauseOverlayActive() const { return m_pauseOverlayAlpha > 0.0f; }
     
     AccessibilitySettings& getAccessibilitySettings() { return m_accessibilitySettings; }
     const AccessibilitySettings& getAccessibilitySettings() const { return m_accessibilitySettings; }
@@ -441,6 +472,8 @@ private:
     int   m_frameTimeCount{0};
     float m_gpuTimeHistory[120]{};
     int   m_gpuTimeHead{0};
+    int   m_gpuTimeCount{0};
+    GpuPassTimes m_gpuTimes;
 
     bool  m_sectionDetached[12]{};
     float m_pauseOverlayAlpha{0.0f};
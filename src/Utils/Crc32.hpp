@@ -0,0 +1,32 @@
+/**
+ * @file Crc32.hpp
+ * @brief CRC-32 (IEEE 802.3) as used by PNG chunks and ZIP archives.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace lenia {
+
+/**
+ * @brief Continue the checksum @p crc (0 to start) over @p size bytes.
+ */
+inline uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size) {
+    static const auto table = []() {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+}
@@ -0,0 +1,42 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Read-only memory mapping of a whole file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace lenia {
+
+/**
+ * @brief Maps a file into the address space so large data can be read
+ *        (or handed to GL uploads) without copying it into a buffer first.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool isOpen() const { return m_data != nullptr; }
+
+private:
+    const uint8_t* m_data{nullptr};
+    size_t         m_size{0};
+#ifdef _WIN32
+    void*          m_file{nullptr};     // HANDLE of the file
+    void*          m_mapping{nullptr};  // HANDLE of the mapping object
+#endif
+};
+
+}
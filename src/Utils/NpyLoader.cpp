@@ -1,142 +1,540 @@
 /**
  * @file NpyLoader.cpp
- * @brief Implementation of NumPy .npy file loading.
+ * @brief Implementation of NumPy .npy file loading and saving.
  * 
  * NPY format specification: https://numpy.org/devdocs/reference/generated/numpy.lib.format.html
  */
 
 #include "NpyLoader.hpp"
+#include "Crc32.hpp"
 #include "Logger.hpp"
 #include <fstream>
 #include <cstring>
 #include <algorithm>
+#include <cstdlib>
 
 namespace lenia {
 
+namespace {
+
+template <typename T>
+T loadValue(const uint8_t* p, bool swap) {
+    uint8_t bytes[sizeof(T)];
+    if (swap) {
+        for (size_t i = 0; i < sizeof(T); ++i) bytes[i] = p[sizeof(T) - 1 - i];
+        p = bytes;
+    }
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+float halfToFloat(uint16_t h) {
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+    uint32_t exp  = (h >> 10) & 0x1Fu;
+    uint32_t mant = h & 0x3FFu;
+    uint32_t bits;
+    if (exp == 0) {
+        if (mant == 0) {
+            bits = sign;
+        } else {
+            // Subnormal: renormalize into the float32 range
+            exp = 127 - 15 + 1;
+            while (!(mant & 0x400u)) { mant <<= 1; --exp; }
+            bits = sign | (exp << 23) | ((mant & 0x3FFu) << 13);
+        }
+    } else if (exp == 31) {
+        bits = sign | 0x7F800000u | (mant << 13);
+    } else {
+        bits = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+bool littleEndianHost() {
+    const uint16_t one = 1;
+    uint8_t first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+/** @brief Text of the quoted value following @p key in a header dictionary. */
+std::string quotedValue(const std::string& header, const char* key) {
+    size_t pos = header.find(key);
+    if (pos == std::string::npos) return {};
+    pos = header.find(':', pos);
+    if (pos == std::string::npos) return {};
+    size_t open = header.find_first_of("'\"", pos);
+    if (open == std::string::npos) return {};
+    size_t close = header.find(header[open], open + 1);
+    if (close == std::string::npos) return {};
+    return header.substr(open + 1, close - open - 1);
+}
+
+}
+
 /**
- * @brief Load a NumPy .npy file.
- * 
- * Handles both v1.0 and v2.0 NPY format headers.
- * Converts float64 to float32 and handles Fortran order arrays.
+ * @brief Map @p path and parse its header.
+ *
+ * Handles v1.0, v2.0 and v3.0 headers. 3D arrays are (H, W, C) when the
+ * last axis has at most 4 entries and the first more, (C, H, W) otherwise.
  */
-bool loadNpy(const std::string& path, NpyArray& out) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+bool NpyView::open(const std::string& path) {
+    close();
+    if (!m_file.open(path)) {
         LOG_ERROR("NpyLoader: cannot open %s", path.c_str());
         return false;
     }
 
+    const uint8_t* bytes = m_file.data();
+    size_t size = m_file.size();
     // Check magic number: "\x93NUMPY"
-    char magic[6];
-    file.read(magic, 6);
-    if (magic[0] != '\x93' || std::string(magic + 1, 4) != "NUMP") {
+    if (size < 10 || bytes[0] != 0x93 || std::memcmp(bytes + 1, "NUMPY", 5) != 0) {
         LOG_ERROR("NpyLoader: invalid magic in %s", path.c_str());
+        close();
         return false;
     }
 
-    // Read version and header length
-    uint8_t majorVer, minorVer;
-    file.read(reinterpret_cast<char*>(&majorVer), 1);
-    file.read(reinterpret_cast<char*>(&minorVer), 1);
-
-    uint32_t headerLen = 0;
-    if (majorVer == 1) {
-        uint16_t hl;
-        file.read(reinterpret_cast<char*>(&hl), 2);
-        headerLen = hl;
-    } else {
-        file.read(reinterpret_cast<char*>(&headerLen), 4);
+    uint8_t majorVer = bytes[6];
+    size_t headerStart = (majorVer == 1) ? 10 : 12;
+    if (size < headerStart) {
+        LOG_ERROR("NpyLoader: truncated header in %s", path.c_str());
+        close();
+        return false;
+    }
+    size_t headerLen = (majorVer == 1)
+        ? static_cast<size_t>(bytes[8] | (bytes[9] << 8))
+        : static_cast<size_t>(bytes[8] | (bytes[9] << 8) | (bytes[10] << 16)) |
+          (static_cast<size_t>(bytes[11]) << 24);
+    if (headerStart + headerLen > size) {
+        LOG_ERROR("NpyLoader: truncated header in %s", path.c_str());
+        close();
+        return false;
     }
 
-    std::string header(headerLen, '\0');
-    file.read(&header[0], headerLen);
-
-    bool isFortranOrder = false;
-    if (header.find("'fortran_order': True") != std::string::npos ||
-        header.find("\"fortran_order\": True") != std::string::npos) {
-        isFortranOrder = true;
+    std::string header(reinterpret_cast<const char*>(bytes + headerStart), headerLen);
+    if (!parseHeader(header, path)) {
+        close();
+        return false;
     }
 
-    bool isFloat64 = header.find("'<f8'") != std::string::npos ||
-                     header.find("\"<f8\"") != std::string::npos ||
-                     header.find("'float64'") != std::string::npos;
-    bool isFloat32 = header.find("'<f4'") != std::string::npos ||
-                     header.find("\"<f4\"") != std::string::npos ||
-                     header.find("'float32'") != std::string::npos;
+    size_t count = 1;
+    for (int d : m_shape) count *= static_cast<size_t>(d);
+    size_t payloadStart = headerStart + headerLen;
+    if (count > (size - payloadStart) / static_cast<size_t>(m_itemSize)) {
+        LOG_ERROR("NpyLoader: %s holds less data than its shape", path.c_str());
+        close();
+        return false;
+    }
+    m_payload = bytes + payloadStart;
+    return true;
+}
 
-    if (!isFloat64 && !isFloat32) {
+bool NpyView::parseHeader(const std::string& header, const std::string& path) {
+    std::string descr = quotedValue(header, "descr");
+    if (descr.size() < 3) {
         LOG_ERROR("NpyLoader: unsupported dtype in %s: %s", path.c_str(), header.c_str());
         return false;
     }
+    char order = descr[0];
+    std::string code = descr.substr(1);
+    if (code == "f2") { m_type = NpyType::F16; m_itemSize = 2; }
+    else if (code == "f4") { m_type = NpyType::F32; m_itemSize = 4; }
+    else if (code == "f8") { m_type = NpyType::F64; m_itemSize = 8; }
+    else if (code == "u1") { m_type = NpyType::U8;  m_itemSize = 1; }
+    else {
+        LOG_ERROR("NpyLoader: unsupported dtype in %s: %s", path.c_str(), descr.c_str());
+        return false;
+    }
+    if (order != '<' && order != '>' && order != '|' && order != '=') {
+        LOG_ERROR("NpyLoader: unsupported byte order in %s: %s", path.c_str(), descr.c_str());
+        return false;
+    }
+    const bool littleHost = littleEndianHost();
+    m_swap = m_itemSize > 1 && ((order == '>' && littleHost) || (order == '<' && !littleHost));
 
-    auto shapeStart = header.find("(");
-    auto shapeEnd   = header.find(")");
-    if (shapeStart == std::string::npos || shapeEnd == std::string::npos) {
+    m_fortran = false;
+    size_t fortranPos = header.find("fortran_order");
+    if (fortranPos != std::string::npos) {
+        size_t value = header.find_first_not_of(" :'\"", fortranPos + 13);
+        m_fortran = value != std::string::npos && header.compare(value, 4, "True") == 0;
+    }
+
+    size_t shapePos = header.find("shape");
+    size_t shapeStart = (shapePos == std::string::npos) ? shapePos : header.find('(', shapePos);
+    size_t shapeEnd = (shapeStart == std::string::npos) ? shapeStart : header.find(')', shapeStart);
+    if (shapeEnd == std::string::npos) {
         LOG_ERROR("NpyLoader: cannot parse shape in %s", path.c_str());
         return false;
     }
+    m_shape.clear();
+    const char* p = header.c_str() + shapeStart + 1;
+    const char* end = header.c_str() + shapeEnd;
+    while (p < end) {
+        char* next = nullptr;
+        long d = std::strtol(p, &next, 10);
+        if (next == p) { ++p; continue; }
+        if (d <= 0 || d > (1L << 30)) {
+            LOG_ERROR("NpyLoader: invalid shape in %s", path.c_str());
+            return false;
+        }
+        m_shape.push_back(static_cast<int>(d));
+        p = next;
+    }
 
-    std::string shapeStr = header.substr(shapeStart + 1, shapeEnd - shapeStart - 1);
-    shapeStr.erase(std::remove(shapeStr.begin(), shapeStr.end(), ' '), shapeStr.end());
+    // Element strides of each axis in the file
+    size_t dims = m_shape.size();
+    std::vector<size_t> strides(dims, 1);
+    for (size_t i = 1; i < dims; ++i) {
+        if (m_fortran) strides[i] = strides[i - 1] * m_shape[i - 1];
+        else strides[dims - 1 - i] = strides[dims - i] * m_shape[dims - i];
+    }
 
-    std::vector<int> dims;
-    size_t pos = 0;
-    while (pos < shapeStr.size()) {
-        size_t comma = shapeStr.find(',', pos);
-        std::string token = shapeStr.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
-        if (!token.empty()) {
-            dims.push_back(std::stoi(token));
-        }
-        if (comma == std::string::npos) break;
-        pos = comma + 1;
-    }
-
-    if (dims.size() == 2) {
-        out.rows = dims[0];
-        out.cols = dims[1];
-    } else if (dims.size() == 1) {
-        out.rows = 1;
-        out.cols = dims[0];
-    } else if (dims.size() == 3) {
-        out.rows = dims[1];
-        out.cols = dims[2];
-        LOG_WARN("NpyLoader: 3D array in %s, using first channel (%dx%d)", path.c_str(), out.rows, out.cols);
+    m_channels = 1;
+    m_channelStride = 0;
+    if (dims == 1) {
+        m_rows = 1;
+        m_cols = m_shape[0];
+        m_rowStride = 0;
+        m_colStride = strides[0];
+    } else if (dims == 2) {
+        m_rows = m_shape[0];
+        m_cols = m_shape[1];
+        m_rowStride = strides[0];
+        m_colStride = strides[1];
+    } else if (dims == 3) {
+        bool channelsLast = m_shape[2] <= 4 && m_shape[0] > 4;
+        int rowAxis = channelsLast ? 0 : 1;
+        int channelAxis = channelsLast ? 2 : 0;
+        m_rows = m_shape[rowAxis];
+        m_cols = m_shape[rowAxis + 1];
+        m_channels = m_shape[channelAxis];
+        m_rowStride = strides[rowAxis];
+        m_colStride = strides[rowAxis + 1];
+        m_channelStride = strides[channelAxis];
     } else {
-        LOG_ERROR("NpyLoader: unsupported %d-dim array in %s", static_cast<int>(dims.size()), path.c_str());
+        LOG_ERROR("NpyLoader: unsupported %d-dim array in %s", static_cast<int>(dims), path.c_str());
         return false;
     }
+    return true;
+}
 
-    int totalElements = 1;
-    for (int d : dims) totalElements *= d;
+void NpyView::close() {
+    m_file.close();
+    m_payload = nullptr;
+    m_shape.clear();
+    m_rows = m_cols = 0;
+    m_channels = 1;
+}
 
-    out.data.resize(out.rows * out.cols);
+const float* NpyView::floats() const {
+    if (!m_payload || m_type != NpyType::F32 || m_swap || m_channels != 1) return nullptr;
+    if (m_colStride != 1 || (m_rows > 1 && m_rowStride != static_cast<size_t>(m_cols))) return nullptr;
+    if (reinterpret_cast<uintptr_t>(m_payload) % alignof(float) != 0) return nullptr;
+    return reinterpret_cast<const float*>(m_payload);
+}
 
-    if (isFloat64) {
-        std::vector<double> raw(totalElements);
-        file.read(reinterpret_cast<char*>(raw.data()), totalElements * sizeof(double));
-        int slice = out.rows * out.cols;
-        for (int i = 0; i < slice; ++i) {
-            out.data[i] = static_cast<float>(raw[i]);
+/**
+ * @brief Walk the output in TILE x TILE blocks so a Fortran-order source
+ *        is read a few columns at a time instead of striding the whole file
+ *        per output row.
+ */
+template <typename Load>
+void NpyView::decodeWith(Load load, float* dst, int channel) const {
+    int outChannels = (channel < 0) ? m_channels : 1;
+    size_t firstChannel = (channel < 0) ? 0 : static_cast<size_t>(channel);
+    size_t item = static_cast<size_t>(m_itemSize);
+    for (int r0 = 0; r0 < m_rows; r0 += TILE) {
+        int r1 = std::min(r0 + TILE, m_rows);
+        for (int c0 = 0; c0 < m_cols; c0 += TILE) {
+            int c1 = std::min(c0 + TILE, m_cols);
+            for (int r = r0; r < r1; ++r) {
+                float* out = dst + (static_cast<size_t>(r) * m_cols + c0) * outChannels;
+                for (int c = c0; c < c1; ++c) {
+                    const uint8_t* cell = m_payload +
+                        (r * m_rowStride + c * m_colStride + firstChannel * m_channelStride) * item;
+                    for (int ch = 0; ch < outChannels; ++ch)
+                        *out++ = load(cell + ch * m_channelStride * item);
+                }
+            }
         }
-    } else {
-        std::vector<float> raw(totalElements);
-        file.read(reinterpret_cast<char*>(raw.data()), totalElements * sizeof(float));
-        int slice = out.rows * out.cols;
-        for (int i = 0; i < slice; ++i) {
-            out.data[i] = raw[i];
+    }
+}
+
+void NpyView::decode(float* dst, int channel) const {
+    if (!m_payload) return;
+    if (channel >= m_channels) channel = 0;
+    if (const float* direct = floats()) {
+        std::memcpy(dst, direct, static_cast<size_t>(m_rows) * m_cols * sizeof(float));
+        return;
+    }
+    bool swap = m_swap;
+    switch (m_type) {
+        case NpyType::F16:
+            decodeWith([swap](const uint8_t* p) { return halfToFloat(loadValue<uint16_t>(p, swap)); }, dst, channel);
+            break;
+        case NpyType::F32:
+            decodeWith([swap](const uint8_t* p) { return loadValue<float>(p, swap); }, dst, channel);
+            break;
+        case NpyType::F64:
+            decodeWith([swap](const uint8_t* p) { return static_cast<float>(loadValue<double>(p, swap)); }, dst, channel);
+            break;
+        case NpyType::U8:
+            decodeWith([](const uint8_t* p) { return *p * (1.0f / 255.0f); }, dst, channel);
+            break;
+    }
+}
+
+/**
+ * @brief Load a NumPy .npy file.
+ *
+ * Decodes straight from the mapping into @p out, so the payload is copied
+ * once whatever its dtype or memory order.
+ */
+bool loadNpy(const std::string& path, NpyArray& out, bool allChannels) {
+    NpyView view;
+    if (!view.open(path)) return false;
+
+    out.rows = view.rows();
+    out.cols = view.cols();
+    out.channels = allChannels ? view.channels() : 1;
+    if (!allChannels && view.channels() > 1) {
+        LOG_WARN("NpyLoader: %d-channel array in %s, using first channel (%dx%d)",
+                 view.channels(), path.c_str(), out.rows, out.cols);
+    }
+    out.data.resize(static_cast<size_t>(out.rows) * out.cols * out.channels);
+    view.decode(out.data.data(), allChannels ? -1 : 0);
+
+    LOG_INFO("NpyLoader: loaded %s (%dx%dx%d)", path.c_str(), out.rows, out.cols, out.channels);
+    return true;
+}
+
+/**
+ * @brief Magic, version, header length and header of an NPY v1.0 file.
+ *
+ * The header is padded with spaces to a multiple of 64 bytes, ending in '\n'.
+ */
+static std::string npyPreamble(const char* descr, const std::vector<int>& shape) {
+    std::string dims;
+    for (size_t i = 0; i < shape.size(); ++i)
+        dims += (i ? ", " : "") + std::to_string(shape[i]);
+    if (shape.size() == 1) dims += ",";
+    std::string header = std::string("{'descr': '") + descr + "', 'fortran_order': False, 'shape': (" + dims + "), }";
+    size_t total = 10 + header.size() + 1;
+    header.append((64 - total % 64) % 64, ' ');
+    header.push_back('\n');
+
+    uint16_t headerLen = static_cast<uint16_t>(header.size());
+    std::string out("\x93NUMPY\x01\x00", 8);
+    out.push_back(static_cast<char>(headerLen & 0xFF));
+    out.push_back(static_cast<char>(headerLen >> 8));
+    return out + header;
+}
+
+static size_t npyBytes(const NpyRecord& array) {
+    size_t bytes = static_cast<size_t>(std::atoi(array.descr + 2));
+    for (int d : array.shape) bytes *= static_cast<size_t>(d);
+    return bytes;
+}
+
+/**
+ * @brief Save a C-order little-endian float32 array in NPY v1.0 format.
+ */
+bool saveNpy(const std::string& path, const float* data, int rows, int cols, int channels) {
+    NpyRecord array;
+    array.shape = {rows, cols};
+    if (channels > 1) array.shape.push_back(channels);
+    array.data = data;
+    if (!saveNpy(path, array)) return false;
+    LOG_INFO("NpyLoader: saved %s (%dx%dx%d)", path.c_str(), rows, cols, channels);
+    return true;
+}
+
+bool saveNpy(const std::string& path, const NpyRecord& array) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("NpyLoader: cannot create %s", path.c_str());
+        return false;
+    }
+    std::string preamble = npyPreamble(array.descr, array.shape);
+    file.write(preamble.data(), static_cast<std::streamsize>(preamble.size()));
+    file.write(static_cast<const char*>(array.data), static_cast<std::streamsize>(npyBytes(array)));
+    if (!file) {
+        LOG_ERROR("NpyLoader: failed writing %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief ZIP archive of stored (uncompressed) .npy members.
+ *
+ * Local headers carry the checksum and sizes up front, so each member is
+ * written in one go: local header, .npy preamble, data. The central
+ * directory follows the last member.
+ */
+bool saveNpz(const std::string& path, const std::vector<NpyRecord>& arrays) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("NpyLoader: cannot create %s", path.c_str());
+        return false;
+    }
+
+    auto put16 = [](std::string& out, uint32_t v) {
+        out.push_back(static_cast<char>(v & 0xFF));
+        out.push_back(static_cast<char>((v >> 8) & 0xFF));
+    };
+    auto put32 = [&](std::string& out, uint32_t v) {
+        put16(out, v & 0xFFFF);
+        put16(out, v >> 16);
+    };
+    constexpr uint32_t DOS_DATE = (1 << 5) | 1;      // 1980-01-01; np.load ignores it
+    constexpr uint64_t ZIP_LIMIT = 0xFFFFFFFFull;
+
+    std::string directory;
+    uint64_t offset = 0;
+    for (const NpyRecord& array : arrays) {
+        std::string name = array.name + ".npy";
+        std::string preamble = npyPreamble(array.descr, array.shape);
+        size_t dataBytes = npyBytes(array);
+        uint64_t size = preamble.size() + dataBytes;
+        if (size >= ZIP_LIMIT || offset >= ZIP_LIMIT) {
+            LOG_ERROR("NpyLoader: %s exceeds 4 GB in %s; write separate .npy files instead",
+                      name.c_str(), path.c_str());
+            return false;
         }
+        uint32_t crc = crc32(0, reinterpret_cast<const uint8_t*>(preamble.data()), preamble.size());
+        crc = crc32(crc, static_cast<const uint8_t*>(array.data), dataBytes);
+
+        // Fields shared by the local header and the directory entry, from "version needed"
+        std::string common;
+        put16(common, 20);                           // Version needed: 2.0
+        put16(common, 0);                            // Flags
+        put16(common, 0);                            // Stored
+        put16(common, 0);                            // Time
+        put16(common, DOS_DATE);
+        put32(common, crc);
+        put32(common, static_cast<uint32_t>(size));  // Compressed
+        put32(common, static_cast<uint32_t>(size));  // Uncompressed
+        put16(common, static_cast<uint32_t>(name.size()));
+        put16(common, 0);                            // Extra field
+
+        std::string local;
+        put32(local, 0x04034B50);
+        local += common + name;
+        file.write(local.data(), static_cast<std::streamsize>(local.size()));
+        file.write(preamble.data(), static_cast<std::streamsize>(preamble.size()));
+        file.write(static_cast<const char*>(array.data), static_cast<std::streamsize>(dataBytes));
+
+        put32(directory, 0x02014B50);
+        put16(directory, 20);                        // Made by: 2.0
+        directory += common;
+        put16(directory, 0);                         // Comment
+        put16(directory, 0);                         // Disk
+        put16(directory, 0);                         // Internal attributes
+        put32(directory, 0);                         // External attributes
+        put32(directory, static_cast<uint32_t>(offset));
+        directory += name;
+        offset += local.size() + size;
+    }
+    if (offset >= ZIP_LIMIT) {
+        LOG_ERROR("NpyLoader: %s exceeds 4 GB; write separate .npy files instead", path.c_str());
+        return false;
+    }
+
+    std::string end;
+    put32(end, 0x06054B50);
+    put16(end, 0);                                   // This disk
+    put16(end, 0);                                   // Directory disk
+    put16(end, static_cast<uint32_t>(arrays.size()));
+    put16(end, static_cast<uint32_t>(arrays.size()));
+    put32(end, static_cast<uint32_t>(directory.size()));
+    put32(end, static_cast<uint32_t>(offset));
+    put16(end, 0);                                   // Comment
+    file.write(directory.data(), static_cast<std::streamsize>(directory.size()));
+    file.write(end.data(), static_cast<std::streamsize>(end.size()));
+    if (!file) {
+        LOG_ERROR("NpyLoader: failed writing %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Header for @p count records, always padded to the same length.
+ *
+ * The count is left-aligned in a 20-character field (any size_t fits), so
+ * rewriting it never moves the data.
+ */
+std::string NpyStreamWriter::header(size_t count) const {
+    std::string countText = std::to_string(count);
+    countText.append(20 - countText.size(), ' ');
+    std::string shape = countText + ",";
+    for (size_t i = 0; i < m_recordShape.size(); ++i)
+        shape += (i ? ", " : " ") + std::to_string(m_recordShape[i]);
+    std::string header = "{'descr': '" + m_descr + "', 'fortran_order': False, 'shape': (" + shape + "), }";
+    size_t total = 10 + header.size() + 1;
+    header.append((64 - total % 64) % 64, ' ');
+    header.push_back('\n');
+    return header;
+}
+
+bool NpyStreamWriter::open(const std::string& path, const char* descr, const std::vector<int>& recordShape) {
+    close();
+    m_path = path;
+    m_descr = descr;
+    m_recordShape = recordShape;
+    m_count = 0;
+    m_recordBytes = (m_descr.size() > 2) ? static_cast<size_t>(std::atoi(m_descr.c_str() + 2)) : 0;
+    for (int d : recordShape) m_recordBytes *= static_cast<size_t>(d);
+    if (m_recordBytes == 0) {
+        LOG_ERROR("NpyLoader: invalid record layout for %s", path.c_str());
+        return false;
     }
 
-    if (isFortranOrder) {
-        std::vector<float> transposed(out.rows * out.cols);
-        for (int r = 0; r < out.rows; ++r)
-            for (int c = 0; c < out.cols; ++c)
-                transposed[r * out.cols + c] = out.data[c * out.rows + r];
-        out.data = std::move(transposed);
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) {
+        LOG_ERROR("NpyLoader: cannot create %s", path.c_str());
+        return false;
     }
+    const char magic[8] = {'\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0};
+    std::string text = header(0);
+    uint16_t headerLen = static_cast<uint16_t>(text.size());
+    m_file.write(magic, 8);
+    m_file.write(reinterpret_cast<const char*>(&headerLen), 2);
+    m_file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(m_file);
+}
 
-    LOG_INFO("NpyLoader: loaded %s (%dx%d)", path.c_str(), out.rows, out.cols);
+bool NpyStreamWriter::append(const void* data) {
+    if (!m_file.is_open()) return false;
+    m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(m_recordBytes));
+    if (!m_file) {
+        LOG_ERROR("NpyLoader: failed writing %s", m_path.c_str());
+        return false;
+    }
+    ++m_count;
     return true;
 }
 
+bool NpyStreamWriter::flush() {
+    if (!m_file.is_open()) return false;
+    std::streampos end = m_file.tellp();
+    std::string text = header(m_count);
+    m_file.seekp(10);
+    m_file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    m_file.seekp(end);
+    m_file.flush();
+    return static_cast<bool>(m_file);
+}
+
+bool NpyStreamWriter::close() {
+    if (!m_file.is_open()) return true;
+    bool ok = flush();
+    m_file.close();
+    return ok;
+}
+
 }
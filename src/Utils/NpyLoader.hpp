@@ -2,15 +2,19 @@
  * @file NpyLoader.hpp
  * @brief Loader for NumPy .npy files containing species patterns.
  * 
- * Supports float32 and float64 arrays in 1D, 2D, or 3D (first channel only).
- * Used to load pre-defined Lenia creature patterns.
+ * Reads float16, float32, float64 and uint8 arrays of either byte order and
+ * memory order in 1D, 2D, or 3D ((C, H, W) or (H, W, C)) through a memory
+ * mapping. Used to load pre-defined Lenia creature patterns, and to save
+ * grids, field exports and trajectories.
  */
 
 #pragma once
 
+#include "MappedFile.hpp"
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <fstream>
 
 namespace lenia {
 
@@ -18,17 +22,150 @@ namespace lenia {
  * @brief Container for loaded NPY array data.
  */
 struct NpyArray {
-    std::vector<float> data;  // Cell values (row-major order)
+    std::vector<float> data;  // Cell values (row-major order, channels interleaved)
     int rows{0};              // Height of pattern
     int cols{0};              // Width of pattern
+    int channels{1};          // Values per cell
+};
+
+enum class NpyType : uint8_t {
+    F16,
+    F32,
+    F64,
+    U8                        // Mapped to [0, 1]
+};
+
+/**
+ * @brief Read-only view of a memory-mapped .npy file.
+ *
+ * The payload stays in the mapping: floats() hands a native float32 array
+ * straight to glTextureSubImage2D, and decode() converts any other layout
+ * to float32 in a single pass, with Fortran-order arrays transposed in
+ * cache-sized tiles.
+ */
+class NpyView {
+public:
+    static constexpr int TILE = 32;      // Transpose block edge, in elements
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_payload != nullptr; }
+
+    int rows() const { return m_rows; }
+    int cols() const { return m_cols; }
+    int channels() const { return m_channels; }
+    NpyType type() const { return m_type; }
+    bool fortranOrder() const { return m_fortran; }
+    const std::vector<int>& shape() const { return m_shape; }
+
+    /**
+     * @brief The mapped payload when it is already row-major float32 in host
+     *        byte order with one channel, nullptr otherwise.
+     */
+    const float* floats() const;
+
+    /**
+     * @brief Convert to float32, rows x cols values of one channel, or with
+     *        @p channel = -1 rows x cols x channels values interleaved.
+     */
+    void decode(float* dst, int channel = -1) const;
+
+private:
+    MappedFile       m_file;
+    const uint8_t*   m_payload{nullptr};
+    std::vector<int> m_shape;
+    NpyType m_type{NpyType::F32};
+    int     m_itemSize{4};
+    bool    m_swap{false};           // Stored in the other byte order
+    bool    m_fortran{false};
+    int     m_rows{0};
+    int     m_cols{0};
+    int     m_channels{1};
+    size_t  m_rowStride{0};          // In elements
+    size_t  m_colStride{0};
+    size_t  m_channelStride{0};
+
+    bool parseHeader(const std::string& header, const std::string& path);
+    template <typename Load>
+    void decodeWith(Load load, float* dst, int channel) const;
 };
 
 /**
  * @brief Load a NumPy .npy file into memory.
  * @param path Path to .npy file
  * @param out Output array structure
+ * @param allChannels Keep every channel of a 3D array instead of the first
+ * @return true on success, false on error
+ */
+bool loadNpy(const std::string& path, NpyArray& out, bool allChannels = false);
+
+/**
+ * @brief Write a float32 array as a NumPy .npy file.
+ * @param channels 1 writes shape (rows, cols), more writes (rows, cols, channels)
  * @return true on success, false on error
  */
-bool loadNpy(const std::string& path, NpyArray& out);
+bool saveNpy(const std::string& path, const float* data, int rows, int cols, int channels = 1);
+
+/**
+ * @brief One array written to an .npy file or an .npz archive.
+ */
+struct NpyRecord {
+    std::string      name;             // Member name in an archive, without ".npy"
+    const char*      descr{"<f4"};     // NumPy dtype string
+    std::vector<int> shape;            // Empty for a scalar
+    const void*      data{nullptr};
+};
+
+/** @brief Write any C-order array as a NumPy .npy file. */
+bool saveNpy(const std::string& path, const NpyRecord& array);
+
+/**
+ * @brief Write several arrays as an uncompressed .npz archive (np.load returns a dict).
+ *
+ * Members are stored without deflate, so the archive costs one pass over
+ * the data for the checksum; each member must stay below 4 GB (no ZIP64).
+ */
+bool saveNpz(const std::string& path, const std::vector<NpyRecord>& arrays);
+
+/**
+ * @brief .npy file grown one record at a time along a leading axis.
+ *
+ * The header reserves room for the record count and is rewritten by
+ * flush() and close(), so a file cut short still loads (with
+ * np.load(..., mmap_mode='r')) up to the last flush.
+ */
+class NpyStreamWriter {
+public:
+    NpyStreamWriter() = default;
+    ~NpyStreamWriter() { close(); }
+
+    NpyStreamWriter(const NpyStreamWriter&) = delete;
+    NpyStreamWriter& operator=(const NpyStreamWriter&) = delete;
+
+    /**
+     * @param descr NumPy dtype string, e.g. "<f4", "<u2", "|u1", "<i8"
+     * @param recordShape Shape of one record; the file's shape is (count, recordShape...)
+     */
+    bool open(const std::string& path, const char* descr, const std::vector<int>& recordShape);
+    /** @brief Append one record of recordBytes() bytes. */
+    bool append(const void* data);
+    /** @brief Rewrite the header with the current count and flush the stream. */
+    bool flush();
+    bool close();
+
+    bool isOpen() const { return m_file.is_open(); }
+    size_t count() const { return m_count; }
+    size_t recordBytes() const { return m_recordBytes; }
+
+private:
+    std::ofstream    m_file;
+    std::string      m_path;
+    std::string      m_descr;
+    std::vector<int> m_recordShape;
+    size_t           m_recordBytes{0};
+    size_t           m_count{0};
+
+    std::string header(size_t count) const;
+};
 
 }
@@ -0,0 +1,58 @@
+/**
+ * @file SpscQueue.hpp
+ * @brief Bounded lock-free single-producer/single-consumer ring buffer.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace lenia {
+
+/**
+ * @brief Fixed-capacity FIFO for exactly one producer and one consumer thread.
+ *
+ * Push and pop never block or allocate; the head and tail indices sit on
+ * separate cache lines so the two threads do not contend on them. One slot
+ * is kept empty to tell "full" from "empty", so at most Capacity - 1 items
+ * are queued at once.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2, "SpscQueue needs at least two slots");
+
+public:
+    /** @brief Producer side. Returns false (leaving item untouched) when full. */
+    bool push(T& item) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t next = (head + 1) % Capacity;
+        if (next == m_tail.load(std::memory_order_acquire)) return false;
+        m_items[head] = std::move(item);
+        m_head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief Consumer side. Returns false when empty. */
+    bool pop(T& out) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) return false;
+        out = std::move(m_items[tail]);
+        m_items[tail] = T{};  // Release captured resources now, not on wrap-around
+        m_tail.store((tail + 1) % Capacity, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<T, Capacity> m_items{};
+    alignas(64) std::atomic<size_t> m_head{0};  // Next slot to write (producer)
+    alignas(64) std::atomic<size_t> m_tail{0};  // Next slot to read (consumer)
+};
+
+}
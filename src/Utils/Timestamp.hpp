@@ -0,0 +1,32 @@
+/**
+ * @file Timestamp.hpp
+ * @brief Date-stamped output file names.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+namespace lenia {
+
+/**
+ * @brief @p prefix + local date and time + @p suffix,
+ *        e.g. "exports/lenia_" + "2025-01-31_14-05-09" + ".npz".
+ */
+inline std::string timestampedPath(const char* prefix, const char* suffix) {
+    std::time_t now = std::time(nullptr);
+    std::tm     tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &now);
+#else
+    localtime_r(&now, &tm);
+#endif
+    char stamp[32];
+    std::snprintf(stamp, sizeof(stamp), "%04d-%02d-%02d_%02d-%02d-%02d",
+                  tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+    return std::string(prefix) + stamp + suffix;
+}
+
+}
@@ -0,0 +1,168 @@
+/**
+ * @file Trace.cpp
+ * @brief Implementation of the per-thread trace buffers and Chrome trace export.
+ */
+
+#include "Trace.hpp"
+#include "Logger.hpp"
+#include "Timestamp.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace lenia {
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    int64_t     startNs;
+    int64_t     durationNs;
+    bool        gpu;
+};
+
+/**
+ * @brief Single-writer event ring owned by one thread.
+ *
+ * The owner writes the slot and then publishes the new count; the exporter
+ * reads up to the published count, skipping the oldest stretch of the ring
+ * that the owner could be overwriting meanwhile.
+ */
+struct ThreadBuffer {
+    std::unique_ptr<TraceEvent[]> events{new TraceEvent[Tracer::BUFFER_EVENTS]};
+    std::atomic<uint64_t>         written{0};
+    std::string                   name;
+    int                           tid{0};
+};
+
+struct Registry {
+    std::mutex                                 mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;  // Never freed: threads may exit before export
+    std::atomic<int64_t>                       enabledSinceNs{0};
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if (!t_buffer) {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lk(reg.mutex);
+        reg.buffers.push_back(std::make_unique<ThreadBuffer>());
+        t_buffer = reg.buffers.back().get();
+        t_buffer->tid = static_cast<int>(reg.buffers.size());
+        t_buffer->name = "Thread " + std::to_string(t_buffer->tid);
+    }
+    return *t_buffer;
+}
+
+// Entries the owner may overwrite while an export is reading
+constexpr uint64_t EXPORT_GUARD_EVENTS = 1024;
+
+void writeEscaped(std::FILE* f, const std::string& s) {
+    for (char c : s) {
+        if (c == '"' || c == '\\') std::fputc('\\', f);
+        if (static_cast<unsigned char>(c) >= 0x20) std::fputc(c, f);
+    }
+}
+
+}
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+int64_t Tracer::nowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::setEnabled(bool enabled) {
+    if (enabled == Tracer::enabled()) return;
+    if (enabled) registry().enabledSinceNs.store(nowNs(), std::memory_order_relaxed);
+    s_enabled.store(enabled, std::memory_order_relaxed);
+    LOG_INFO("Trace recording %s.", enabled ? "started" : "stopped");
+}
+
+void Tracer::record(const char* name, int64_t startNs, int64_t durationNs, bool gpu) {
+    ThreadBuffer& buf = threadBuffer();
+    uint64_t n = buf.written.load(std::memory_order_relaxed);
+    buf.events[n & (BUFFER_EVENTS - 1)] = TraceEvent{name, startNs, durationNs, gpu};
+    buf.written.store(n + 1, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const char* name) {
+    ThreadBuffer& buf = threadBuffer();
+    std::lock_guard<std::mutex> lk(registry().mutex);
+    buf.name = name;
+}
+
+/**
+ * @brief Export as Chrome trace JSON.
+ *
+ * CPU spans go to process 1 and GPU spans to process 2, with one track per
+ * recording thread in each, so GPU work sits under the CPU calls that
+ * submitted it on a shared time axis.
+ */
+bool Tracer::writeChromeTrace(const std::string& path) {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        LOG_ERROR("Cannot write trace file: %s", path.c_str());
+        return false;
+    }
+
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mutex);
+    int64_t sinceNs = reg.enabledSinceNs.load(std::memory_order_relaxed);
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Lenia CPU\"}},\n");
+    std::fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"Lenia GPU\"}}");
+
+    size_t count = 0;
+    for (const auto& buf : reg.buffers) {
+        for (int pid = 1; pid <= 2; ++pid) {
+            std::fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"",
+                         pid, buf->tid);
+            writeEscaped(f, buf->name);
+            std::fprintf(f, "%s\"}}", pid == 2 ? " GPU" : "");
+        }
+
+        uint64_t end = buf->written.load(std::memory_order_acquire);
+        uint64_t keep = BUFFER_EVENTS - EXPORT_GUARD_EVENTS;
+        uint64_t begin = end > keep ? end - keep : 0;
+        for (uint64_t i = begin; i < end; ++i) {
+            TraceEvent e = buf->events[i & (BUFFER_EVENTS - 1)];
+            if (e.startNs < sinceNs || !e.name) continue;
+            std::fprintf(f, ",\n{\"name\":\"");
+            writeEscaped(f, e.name);
+            std::fprintf(f, "\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                         e.gpu ? "gpu" : "cpu", e.gpu ? 2 : 1, buf->tid,
+                         (e.startNs - sinceNs) * 1e-3, e.durationNs * 1e-3);
+            ++count;
+        }
+    }
+    std::fprintf(f, "\n]}\n");
+    bool ok = std::ferror(f) == 0;
+    std::fclose(f);
+
+    if (ok) LOG_INFO("Wrote %zu trace events to %s", count, path.c_str());
+    else    LOG_ERROR("Failed writing trace file: %s", path.c_str());
+    return ok;
+}
+
+std::string Tracer::saveTimestamped() {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories("log", ec);
+
+    std::string path = timestampedPath("log/lenia_trace_", ".json");
+    return writeChromeTrace(path) ? path : std::string();
+}
+
+}
@@ -0,0 +1,88 @@
+/**
+ * @file Trace.hpp
+ * @brief Timeline tracing of CPU and GPU spans, exported as Chrome trace JSON.
+ *
+ * Usage: TRACE_SCOPE("Application::present");     // CPU span
+ *        TRACE_GL_SCOPE("LeniaEngine::update");   // CPU span + GL debug group
+ * The JSON opens in chrome://tracing and ui.perfetto.dev.
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace lenia {
+
+/**
+ * @brief Process-wide trace recorder with lock-free per-thread buffers.
+ *
+ * Each thread appends to its own ring of events without locking; only the
+ * first event of a thread (buffer registration) and export take a mutex.
+ * Rings keep the most recent events, so a capture taken right after a
+ * hitch covers the seconds leading up to it. Names must be string literals
+ * or otherwise outlive the tracer.
+ */
+class Tracer {
+public:
+    static void setEnabled(bool enabled);
+    static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /** @brief Nanoseconds on the trace clock (steady_clock). */
+    static int64_t nowNs();
+
+    static void record(const char* name, int64_t startNs, int64_t durationNs, bool gpu = false);
+    static void setThreadName(const char* name);
+
+    /** @brief Write every event recorded since tracing was enabled. */
+    static bool writeChromeTrace(const std::string& path);
+    /** @brief writeChromeTrace to a timestamped file in log/; returns its path or "". */
+    static std::string saveTimestamped();
+
+    static constexpr size_t BUFFER_EVENTS = 1 << 16;  // Per thread, oldest overwritten
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @brief RAII CPU span; costs one relaxed load when tracing is off.
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : m_name(name), m_startNs(Tracer::enabled() ? Tracer::nowNs() : -1) {}
+    ~TraceScope() {
+        if (m_startNs >= 0) Tracer::record(m_name, m_startNs, Tracer::nowNs() - m_startNs);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    int64_t     m_startNs;
+};
+
+/**
+ * @brief CPU span that also opens a GL debug group of the same name.
+ *
+ * Debug groups are pushed even when tracing is off so captures in external
+ * GPU debuggers line up with the trace. Requires a current GL context.
+ */
+class GlTraceScope : public TraceScope {
+public:
+    explicit GlTraceScope(const char* name) : TraceScope(name) {
+        glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+    }
+    ~GlTraceScope() { glPopDebugGroup(); }
+};
+
+#define LENIA_TRACE_CONCAT_(a, b) a##b
+#define LENIA_TRACE_CONCAT(a, b)  LENIA_TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name)    ::lenia::TraceScope   LENIA_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_GL_SCOPE(name) ::lenia::GlTraceScope LENIA_TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+}
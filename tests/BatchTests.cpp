@@ -0,0 +1,108 @@
+/**
+ * @file BatchTests.cpp
+ * @brief Batched universes (sim_batch.comp) must step exactly like one grid (sim_spatial.comp).
+ */
+
+#include "TestRunner.hpp"
+#include "BatchSimulation.hpp"
+#include "LeniaEngine.hpp"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace lenia {
+
+namespace {
+
+constexpr int BATCH_W   = 128;
+constexpr int BATCH_H   = 96;
+constexpr int UNIVERSES = 2;          // Every layer gets the same start and parameters
+
+/**
+ * @brief Step the same start state @p steps times as a single grid and in
+ *        every layer of a batch, with preset 0 changed by @p configure.
+ */
+bool batchMatchesSingle(const TestContext& ctx, const std::function<void(LeniaParams&)>& configure,
+                        int steps) {
+    LeniaEngine single;
+    TEST_CHECK(single.init(ctx.assetDir));
+    LeniaParams params;
+    single.applyPreset(0, params);
+    configure(params);
+    params.gridW = BATCH_W;
+    params.gridH = BATCH_H;
+    params.tileSize = 0;
+    single.resizeGrid(params);
+    single.regenerateKernel(params);
+    single.reset(params);
+
+    std::vector<float> start(static_cast<size_t>(BATCH_W) * BATCH_H);
+    glGetTextureImage(single.state().currentTexture(), 0, GL_RED, GL_FLOAT,
+                      static_cast<GLsizei>(start.size() * sizeof(float)), start.data());
+    single.update(params, steps);
+    std::vector<float> a(start.size());
+    glGetTextureImage(single.state().currentTexture(), 0, GL_RED, GL_FLOAT,
+                      static_cast<GLsizei>(a.size() * sizeof(float)), a.data());
+
+    KernelConfig kernel;
+    kernel.radius     = params.radius;
+    kernel.numRings   = params.numRings;
+    kernel.kernelType = params.kernelType;
+    for (int i = 0; i < 16; ++i) kernel.ringWeights[i] = params.ringWeights[i];
+
+    BatchSimulation batch;
+    TEST_CHECK(batch.init(ctx.assetDir + "/shaders/"));
+    TEST_CHECK(batch.setKernels({kernel}));
+    TEST_CHECK(batch.allocate(BATCH_W, BATCH_H, UNIVERSES));
+    std::vector<BatchUniverseParams> universes(UNIVERSES);
+    for (auto& u : universes) {
+        u.mu         = params.mu;
+        u.sigma      = params.sigma;
+        u.dt         = params.dt;
+        u.growthType = params.growthType;
+    }
+    batch.setParams(universes);
+    for (int i = 0; i < UNIVERSES; ++i)
+        batch.uploadPattern(i, start.data(), BATCH_H, BATCH_W);
+    batch.step(steps);
+    std::vector<float> layers;
+    TEST_CHECK(batch.readLayers(layers));
+
+    double mass = 0.0;
+    for (float v : a) mass += v;
+    for (int i = 0; i < UNIVERSES; ++i) {
+        const float* b = layers.data() + static_cast<size_t>(i) * a.size();
+        double maxDiff = 0.0;
+        for (size_t j = 0; j < a.size(); ++j)
+            maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(a[j] - b[j])));
+        LOG_INFO("kernel %d growth %d radius %d, universe %d: mass %.3f, max difference %g",
+                 params.kernelType, params.growthType, params.radius, i, mass, maxDiff);
+        TEST_CHECK(maxDiff == 0.0);
+    }
+    TEST_CHECK(mass > 0.0);
+    return true;
+}
+
+}
+
+LENIA_TEST(batchMatchesSingleLenia) {
+    return batchMatchesSingle(ctx, [](LeniaParams&) {}, 10);
+}
+
+LENIA_TEST(batchMatchesSingleGameOfLife) {
+    // GameOfLife growth takes 2r+1 taps; the 3x3 kernel is stretched past radius 1
+    auto life = [](LeniaParams& params) {
+        params.kernelType = 4;
+        params.growthType = 2;
+        params.radius = 1;
+    };
+    auto stretched = [](LeniaParams& params) {
+        params.kernelType = 4;
+        params.radius = 3;
+    };
+    return batchMatchesSingle(ctx, life, 8) && batchMatchesSingle(ctx, stretched, 8);
+}
+
+}
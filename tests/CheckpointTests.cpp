@@ -0,0 +1,158 @@
+/**
+ * @file CheckpointTests.cpp
+ * @brief A saved and restored world must carry on exactly like the original.
+ */
+
+#include "TestRunner.hpp"
+#include "Checkpoint.hpp"
+#include "LeniaEngine.hpp"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+namespace {
+
+constexpr int GRID_W = 160;
+constexpr int GRID_H = 300;     // More than one strip of CHECKPOINT_STRIP_ROWS
+
+std::vector<float> readTexture(GLuint tex, int components) {
+    std::vector<float> cells(static_cast<size_t>(GRID_W) * GRID_H * components);
+    glGetTextureImage(tex, 0, components == 4 ? GL_RGBA : GL_RED, GL_FLOAT,
+                      static_cast<GLsizei>(cells.size() * sizeof(float)), cells.data());
+    return cells;
+}
+
+/** @brief A grid of two strips with walls across it, stepped a little. */
+bool makeWorld(const TestContext& ctx, LeniaEngine& engine, LeniaParams& params) {
+    TEST_CHECK(engine.init(ctx.assetDir));
+    engine.applyPreset(0, params);
+    params.gridW = GRID_W;
+    params.gridH = GRID_H;
+    params.tileSize = 0;
+    engine.resizeGrid(params);
+    engine.regenerateKernel(params);
+    engine.reset(params);
+    engine.applyWallLine(10, 20, 150, 280, params);
+    engine.update(params, 7);
+    return true;
+}
+
+bool save(LeniaEngine& engine, const LeniaParams& params, const std::string& path, bool compress) {
+    TEST_CHECK(engine.saveCheckpoint(path, params, compress));
+    engine.pollCheckpoint(true);
+    TEST_CHECK(engine.checkpointSucceeded());
+    return true;
+}
+
+/** @brief Save @p engine to @p path, restore it into a new engine and step both. */
+bool restoresExactly(const TestContext& ctx, LeniaEngine& engine, LeniaParams& params,
+                     const std::string& path, bool compress) {
+    TEST_CHECK(save(engine, params, path, compress));
+
+    LeniaEngine restored;
+    TEST_CHECK(restored.init(ctx.assetDir));
+    LeniaParams loaded;
+    restored.applyPreset(1, loaded);
+    TEST_CHECK(restored.loadCheckpoint(path, loaded));
+    TEST_CHECK(loaded.gridW == GRID_W && loaded.gridH == GRID_H);
+    TEST_CHECK(loaded.mu == params.mu && loaded.sigma == params.sigma && loaded.radius == params.radius);
+    TEST_CHECK(restored.stepCount() == engine.stepCount());
+    TEST_CHECK(restored.wallTexture() != 0);
+    TEST_CHECK(readTexture(restored.wallTexture(), 4) == readTexture(engine.wallTexture(), 4));
+    TEST_CHECK(readTexture(restored.state().currentTexture(), 1) ==
+               readTexture(engine.state().currentTexture(), 1));
+
+    // Stepping on must not tell them apart either
+    engine.update(params, 5);
+    restored.update(loaded, 5);
+    TEST_CHECK(readTexture(restored.state().currentTexture(), 1) ==
+               readTexture(engine.state().currentTexture(), 1));
+    return true;
+}
+
+void swapWords(std::vector<uint8_t>& bytes, size_t offset, size_t size, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t* word = bytes.data() + offset + i * size;
+        for (size_t b = 0; b < size / 2; ++b) std::swap(word[b], word[size - 1 - b]);
+    }
+}
+
+/** @brief Rewrite the checkpoint at @p path as a writer of the other byte order would have. */
+bool writeSwapped(const std::string& path, const std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    CheckpointReader reader;
+    TEST_CHECK(reader.open(path));
+    const CheckpointHeader& h = reader.header();
+
+    size_t table = h.tableOffset;
+    size_t strips = static_cast<size_t>(reader.planes()) * reader.stripCount();
+    for (size_t i = 0; i < strips; ++i) {
+        CheckpointStrip entry;
+        std::memcpy(&entry, bytes.data() + table + i * sizeof(entry), sizeof(entry));
+        swapWords(bytes, entry.offset, 4, entry.bytes / 4);
+    }
+    swapWords(bytes, table, 8, strips * 2);
+    swapWords(bytes, offsetof(CheckpointHeader, byteOrder), 4, 10);
+    swapWords(bytes, offsetof(CheckpointHeader, stepCount), 8, 4);
+
+    std::ofstream file(out, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return file.good();
+}
+
+/** @brief Every strip of the two files decodes to the same cells. */
+bool sameStrips(const CheckpointReader& a, const CheckpointReader& b) {
+    TEST_CHECK(a.planes() == b.planes() && a.stripCount() == b.stripCount());
+    std::vector<float> scratchA, scratchB;
+    for (int p = 0; p < a.planes(); ++p) {
+        for (int s = 0; s < a.stripCount(); ++s) {
+            const float* x = a.strip(p, s, scratchA);
+            const float* y = b.strip(p, s, scratchB);
+            TEST_CHECK(x && y);
+            int rows = std::min(a.header().stripRows, a.header().height - s * a.header().stripRows);
+            TEST_CHECK(std::memcmp(x, y, sizeof(float) * a.header().width * rows) == 0);
+        }
+    }
+    return true;
+}
+
+}
+
+LENIA_TEST(checkpointRoundTrip) {
+    LeniaEngine engine;
+    LeniaParams params;
+    TEST_CHECK(makeWorld(ctx, engine, params));
+    TEST_CHECK(restoresExactly(ctx, engine, params, ctx.scratchDir + "/raw.lckp", false));
+    TEST_CHECK(restoresExactly(ctx, engine, params, ctx.scratchDir + "/zero_runs.lckp", true));
+    return true;
+}
+
+LENIA_TEST(checkpointOtherByteOrder) {
+    LeniaEngine engine;
+    LeniaParams params;
+    TEST_CHECK(makeWorld(ctx, engine, params));
+    for (bool compress : {false, true}) {
+        std::string native = ctx.scratchDir + (compress ? "/native_zero_runs.lckp" : "/native_raw.lckp");
+        std::string swapped = native + ".swapped";
+        TEST_CHECK(save(engine, params, native, compress));
+        TEST_CHECK(writeSwapped(native, swapped));
+
+        CheckpointReader a, b;
+        TEST_CHECK(a.open(native) && b.open(swapped));
+        TEST_CHECK(!a.swapped() && b.swapped());
+        TEST_CHECK(std::memcmp(&a.header(), &b.header(), sizeof(CheckpointHeader)) == 0);
+        TEST_CHECK(a.params() == b.params());
+        TEST_CHECK(sameStrips(a, b));
+    }
+    return true;
+}
+
+}
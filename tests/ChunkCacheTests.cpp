@@ -0,0 +1,108 @@
+/**
+ * @file ChunkCacheTests.cpp
+ * @brief ChunkCache encoding and storage must give back exactly what was put in.
+ */
+
+#include "TestRunner.hpp"
+#include "ChunkedWorld.hpp"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace lenia {
+
+namespace {
+
+constexpr size_t CELLS = 64 * 64;
+
+/** @brief A chunk with empty space around a noise patch, as Lenia leaves them. */
+std::vector<float> patchChunk(uint32_t seed) {
+    std::vector<float> cells(CELLS, 0.0f);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> uni(0.0f, 1.0f);
+    for (int y = 20; y < 40; ++y)
+        for (int x = 10; x < 30; ++x)
+            cells[static_cast<size_t>(y) * 64 + x] = (rng() % 3 == 0) ? 0.0f : uni(rng);
+    return cells;
+}
+
+/** @brief Bitwise equality, so -0 and NaN payloads count too. */
+bool sameBits(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+bool roundTrips(const std::vector<float>& cells) {
+    std::vector<uint8_t> packed;
+    ChunkCache::compress(cells, packed);
+    std::vector<float> back;
+    TEST_CHECK(ChunkCache::decompress(packed.data(), packed.size(), back, cells.size()));
+    TEST_CHECK(sameBits(cells, back));
+    return true;
+}
+
+}
+
+LENIA_TEST(chunkCacheCompressRoundTrip) {
+    std::vector<float> edges(CELLS, 0.5f);
+    edges.front() = edges.back() = 0.0f;
+    std::vector<float> special(CELLS, 0.0f);
+    special[1] = -0.0f;
+    special[2] = std::numeric_limits<float>::denorm_min();
+    special[3] = -1.0f;
+    special[CELLS - 1] = std::numeric_limits<float>::quiet_NaN();
+
+    TEST_CHECK(roundTrips(std::vector<float>(CELLS, 0.0f)));
+    TEST_CHECK(roundTrips(std::vector<float>(CELLS, 1.0f)));
+    TEST_CHECK(roundTrips(edges));
+    TEST_CHECK(roundTrips(special));
+    TEST_CHECK(roundTrips(patchChunk(7)));
+
+    // Mostly empty chunks must actually shrink
+    std::vector<uint8_t> packed;
+    ChunkCache::compress(patchChunk(7), packed);
+    TEST_CHECK(packed.size() < CELLS * sizeof(float) / 4);
+
+    // Truncated data and the wrong cell count are rejected
+    std::vector<float> back;
+    TEST_CHECK(!ChunkCache::decompress(packed.data(), packed.size() - 1, back, CELLS));
+    TEST_CHECK(!ChunkCache::decompress(packed.data(), packed.size(), back, CELLS - 1));
+    TEST_CHECK(!ChunkCache::decompress(packed.data(), packed.size(), back, CELLS + 1));
+    return true;
+}
+
+LENIA_TEST(chunkCacheSpillRoundTrip) {
+    std::string dir = ctx.scratchDir + "/chunk_cache";
+    ChunkCache cache;
+    cache.setSpillDir(dir);
+    std::vector<uint8_t> packed;
+    ChunkCache::compress(patchChunk(0), packed);
+    cache.setBudget(packed.size() * 3);     // Room for about three chunks in memory
+
+    constexpr int CHUNKS = 10;
+    for (int i = 0; i < CHUNKS; ++i)
+        cache.put(ChunkedWorld::chunkKey(i - 5, -i), patchChunk(static_cast<uint32_t>(i)));
+    TEST_CHECK(cache.count() == CHUNKS);
+    TEST_CHECK(cache.memoryBytes() <= packed.size() * 3);
+    TEST_CHECK(!std::filesystem::is_empty(dir));
+
+    // A second put replaces the first
+    std::vector<float> replaced = patchChunk(100);
+    cache.put(ChunkedWorld::chunkKey(-5, 0), replaced);
+    TEST_CHECK(cache.count() == CHUNKS);
+
+    std::vector<float> cells;
+    for (int i = 0; i < CHUNKS; ++i) {
+        int64_t key = ChunkedWorld::chunkKey(i - 5, -i);
+        TEST_CHECK(cache.take(key, cells, CELLS));
+        TEST_CHECK(sameBits(cells, i == 0 ? replaced : patchChunk(static_cast<uint32_t>(i))));
+        TEST_CHECK(!cache.take(key, cells, CELLS));
+    }
+    TEST_CHECK(cache.count() == 0 && cache.memoryBytes() == 0);
+    TEST_CHECK(std::filesystem::is_empty(dir));
+    return true;
+}
+
+}
@@ -0,0 +1,77 @@
+/**
+ * @file HeadlessSweepTests.cpp
+ * @brief `--headless --sweep-*` must start every universe from the preset's species.
+ */
+
+#include "TestRunner.hpp"
+#include "Utils/NpyLoader.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace lenia {
+
+namespace {
+
+constexpr int SWEEP_GRID = 64;
+constexpr int UNIVERSES  = 2;
+constexpr int REACH      = 8;          // From the center: the 3x3 pattern plus one radius-5 step
+
+/** @brief A catalog holding one 3x3 block species, the only preset of its name. */
+const char* SWEEP_CATALOG =
+    "[{\"code\": \">1\", \"name\": \"Probes\"},\n"
+    " {\"code\": \"SP1\", \"name\": \"Sweep Probe\", "
+    "\"params\": {\"R\": 5, \"T\": 10, \"b\": \"1\", \"m\": 0.15, \"s\": 0.015, \"kn\": 1, \"gn\": 1}, "
+    "\"cells\": \"3yO$3yO$3yO!\"}]\n";
+
+}
+
+LENIA_TEST(sweepCatalogPreset) {
+    // The child reads Initialisation/ from its working directory
+    namespace fs = std::filesystem;
+    fs::path dir = fs::path(ctx.scratchDir) / "sweep";
+    std::error_code ec;
+    fs::create_directories(dir / "Initialisation", ec);
+    TEST_CHECK(!ec);
+    {
+        std::ofstream out(dir / "Initialisation" / "probes.json", std::ios::binary);
+        out << SWEEP_CATALOG;
+        TEST_CHECK(out.good());
+    }
+
+    std::string command = "cd \"" + dir.string() + "\" && \"" + ctx.executable + "\" --headless"
+                          " --preset \"Sweep Probe\" --sweep-mu 0.1:0.3:" + std::to_string(UNIVERSES) +
+                          " --steps 1 --grid " + std::to_string(SWEEP_GRID) + "x" + std::to_string(SWEEP_GRID) +
+                          " --out sweep.npy --assets \"" + ctx.assetDir + "\"";
+    LOG_INFO("Running: %s", command.c_str());
+    TEST_CHECK(std::system(command.c_str()) == 0);
+
+    NpyView view;
+    TEST_CHECK(view.open((dir / "sweep.npy").string()));
+    TEST_CHECK(view.shape() == std::vector<int>({UNIVERSES, SWEEP_GRID, SWEEP_GRID}));
+    TEST_CHECK(view.channels() == UNIVERSES);
+
+    // Noise would fill the central half of the grid; one step of the species stays near the center
+    const int n = SWEEP_GRID;
+    std::vector<float> layer(static_cast<size_t>(n) * n);
+    for (int u = 0; u < UNIVERSES; ++u) {
+        view.decode(layer.data(), u);        // (N,H,W) reads as channel-first
+        double mass = 0.0, outside = 0.0;
+        for (int y = 0; y < n; ++y) {
+            for (int x = 0; x < n; ++x) {
+                float v = layer[y * n + x];
+                mass += v;
+                if (std::abs(x - n / 2) > REACH || std::abs(y - n / 2) > REACH) outside += v;
+            }
+        }
+        LOG_INFO("universe %d: mass %.3f, mass away from the species %g", u, mass, outside);
+        TEST_CHECK(mass > 0.0);
+        TEST_CHECK(outside == 0.0);
+    }
+    return true;
+}
+
+}
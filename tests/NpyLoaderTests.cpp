@@ -0,0 +1,180 @@
+/**
+ * @file NpyLoaderTests.cpp
+ * @brief NpyView dtype, byte order and memory order decoding, and the mapped species upload.
+ */
+
+#include "TestRunner.hpp"
+#include "SpeciesAtlas.hpp"
+#include "Utils/NpyLoader.hpp"
+#include <glad/glad.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+namespace {
+
+/** @brief Write an NPY v1.0 file with a hand-made header and raw @p payload. */
+bool writeNpy(const std::string& path, const char* descr, const std::string& shape, bool fortran,
+              const std::vector<uint8_t>& payload) {
+    std::string header = std::string("{'descr': '") + descr + "', 'fortran_order': " +
+                         (fortran ? "True" : "False") + ", 'shape': " + shape + ", }";
+    header.append((64 - (10 + header.size() + 1) % 64) % 64, ' ');
+    header.push_back('\n');
+    std::ofstream out(path, std::ios::binary);
+    out.write("\x93NUMPY\x01\x00", 8);
+    char len[2] = {static_cast<char>(header.size() & 0xFF), static_cast<char>(header.size() >> 8)};
+    out.write(len, 2);
+    out << header;
+    out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    return out.good();
+}
+
+/** @brief @p values as little- or big-endian bytes of their own type. */
+template <typename T>
+std::vector<uint8_t> bytesOf(const std::vector<T>& values, bool bigEndian) {
+    std::vector<uint8_t> out;
+    for (T v : values) {
+        uint8_t b[sizeof(T)];
+        std::memcpy(b, &v, sizeof(T));
+        uint16_t probe = 1;
+        bool littleHost = *reinterpret_cast<uint8_t*>(&probe) == 1;
+        for (size_t i = 0; i < sizeof(T); ++i)
+            out.push_back(b[(littleHost != bigEndian) ? i : sizeof(T) - 1 - i]);
+    }
+    return out;
+}
+
+/** @brief Open @p path and decode @p channel; true if it reads as @p expected. */
+bool decodesTo(const std::string& path, const std::vector<float>& expected, int rows, int cols,
+               int channel = 0) {
+    NpyView view;
+    TEST_CHECK(view.open(path));
+    TEST_CHECK(view.rows() == rows && view.cols() == cols);
+    std::vector<float> cells(static_cast<size_t>(rows) * cols);
+    view.decode(cells.data(), channel);
+    TEST_CHECK(cells == expected);
+    return true;
+}
+
+// A 2x3 array, row-major, whose values are exact in every dtype below
+const std::vector<float> CELLS = {0.0f, 0.25f, 0.5f, 0.75f, 1.0f, 0.125f};
+
+}
+
+LENIA_TEST(npyDtypesAndByteOrder) {
+    std::string dir = ctx.scratchDir + "/npy";
+    std::filesystem::create_directories(dir);
+
+    // Native float32 is served from the mapping without decoding
+    std::string native = dir + "/f4_le.npy";
+    TEST_CHECK(writeNpy(native, "<f4", "(2, 3)", false, bytesOf(CELLS, false)));
+    {
+        NpyView view;
+        TEST_CHECK(view.open(native));
+        uint16_t probe = 1;
+        bool littleHost = *reinterpret_cast<uint8_t*>(&probe) == 1;
+        TEST_CHECK((view.floats() != nullptr) == littleHost);
+    }
+    TEST_CHECK(decodesTo(native, CELLS, 2, 3));
+
+    std::string big = dir + "/f4_be.npy";
+    TEST_CHECK(writeNpy(big, ">f4", "(2, 3)", false, bytesOf(CELLS, true)));
+    TEST_CHECK(decodesTo(big, CELLS, 2, 3));
+
+    std::vector<double> wide(CELLS.begin(), CELLS.end());
+    std::string f8 = dir + "/f8_be.npy";
+    TEST_CHECK(writeNpy(f8, ">f8", "(2, 3)", false, bytesOf(wide, true)));
+    TEST_CHECK(decodesTo(f8, CELLS, 2, 3));
+
+    // float16 bit patterns of CELLS
+    std::vector<uint16_t> half = {0x0000, 0x3400, 0x3800, 0x3A00, 0x3C00, 0x3000};
+    std::string f2 = dir + "/f2_le.npy";
+    TEST_CHECK(writeNpy(f2, "<f2", "(2, 3)", false, bytesOf(half, false)));
+    TEST_CHECK(decodesTo(f2, CELLS, 2, 3));
+
+    // uint8 is scaled to 0..1
+    std::vector<uint8_t> bytes = {0, 51, 102, 153, 204, 255};
+    std::vector<float> scaled;
+    for (uint8_t b : bytes) scaled.push_back(b * (1.0f / 255.0f));
+    std::string u1 = dir + "/u1.npy";
+    TEST_CHECK(writeNpy(u1, "|u1", "(2, 3)", false, bytes));
+    TEST_CHECK(decodesTo(u1, scaled, 2, 3));
+    return true;
+}
+
+LENIA_TEST(npyMemoryOrderAndChannels) {
+    std::string dir = ctx.scratchDir + "/npy";
+    std::filesystem::create_directories(dir);
+
+    // Fortran order stores the 2x3 array column by column
+    std::vector<float> columns = {CELLS[0], CELLS[3], CELLS[1], CELLS[4], CELLS[2], CELLS[5]};
+    std::string fortran = dir + "/fortran.npy";
+    TEST_CHECK(writeNpy(fortran, "<f4", "(2, 3)", true, bytesOf(columns, false)));
+    {
+        NpyView view;
+        TEST_CHECK(view.open(fortran));
+        TEST_CHECK(view.floats() == nullptr);
+    }
+    TEST_CHECK(decodesTo(fortran, CELLS, 2, 3));
+
+    // (C, H, W): channel 1 is the second plane
+    std::vector<float> planes(CELLS.size(), 0.0f);
+    planes.insert(planes.end(), CELLS.begin(), CELLS.end());
+    std::string chw = dir + "/chw.npy";
+    TEST_CHECK(writeNpy(chw, "<f4", "(2, 2, 3)", false, bytesOf(planes, false)));
+    TEST_CHECK(decodesTo(chw, CELLS, 2, 3, 1));
+
+    // (H, W, C) when the last axis is short and the first is not: channel 1 is every second value
+    std::vector<float> interleaved;
+    for (float v : CELLS) {
+        interleaved.push_back(0.0f);
+        interleaved.push_back(v);
+    }
+    std::string hwc = dir + "/hwc.npy";
+    TEST_CHECK(writeNpy(hwc, "<f4", "(6, 1, 2)", false, bytesOf(interleaved, false)));
+    TEST_CHECK(decodesTo(hwc, CELLS, 6, 1, 1));
+    return true;
+}
+
+LENIA_TEST(speciesAtlasUploadsMappedFloats) {
+    std::string dir = ctx.scratchDir + "/atlas";
+    std::filesystem::create_directories(dir);
+    TEST_CHECK(writeNpy(dir + "/native.npy", "<f4", "(2, 3)", false, bytesOf(CELLS, false)));
+    TEST_CHECK(writeNpy(dir + "/swapped.npy", ">f4", "(2, 3)", false, bytesOf(CELLS, true)));
+    TEST_CHECK(writeNpy(dir + "/outside.npy", "<f4", "(2, 3)", false, bytesOf(CELLS, false)));
+
+    SpeciesAtlas atlas;
+    atlas.start(dir, {"native.npy", "swapped.npy"});
+
+    // Files outside the library stay on the CPU: native float32 as its mapping
+    const SpeciesAtlas::Entry* outside = atlas.find("outside.npy");
+    TEST_CHECK(outside != nullptr);
+    uint16_t probe = 1;
+    if (*reinterpret_cast<uint8_t*>(&probe) == 1) {
+        TEST_CHECK(outside->mapped && outside->cells.empty());
+    }
+    TEST_CHECK(std::vector<float>(outside->data(), outside->data() + CELLS.size()) == CELLS);
+
+    // Library files are in the atlas once find() has polled it
+    const SpeciesAtlas::Entry* native = atlas.find("native.npy");
+    const SpeciesAtlas::Entry* swapped = atlas.find("swapped.npy");
+    TEST_CHECK(native && swapped);
+    TEST_CHECK(atlas.texture() != 0);
+    std::vector<float> texels(static_cast<size_t>(atlas.width()) * atlas.height());
+    glGetTextureImage(atlas.texture(), 0, GL_RED, GL_FLOAT,
+                      static_cast<GLsizei>(texels.size() * sizeof(float)), texels.data());
+    for (const SpeciesAtlas::Entry* e : {native, swapped}) {
+        TEST_CHECK(e->inAtlas && !e->mapped);
+        for (int y = 0; y < e->rows; ++y)
+            for (int x = 0; x < e->cols; ++x)
+                TEST_CHECK(texels[static_cast<size_t>(e->y + y) * atlas.width() + e->x + x] == CELLS[y * 3 + x]);
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,80 @@
+/**
+ * @file StatePyramidTests.cpp
+ * @brief Every pyramid level must hold the exact mean and extrema of its cells.
+ */
+
+#include "TestRunner.hpp"
+#include "StatePyramid.hpp"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace lenia {
+
+namespace {
+
+// Odd sizes, so the last row and column of several levels absorb a leftover texel
+constexpr int GRID_W = 101;
+constexpr int GRID_H = 77;
+
+}
+
+LENIA_TEST(pyramidMeansAreAreaWeighted) {
+    std::vector<float> cells(static_cast<size_t>(GRID_W) * GRID_H);
+    std::mt19937 rng(26);
+    std::uniform_real_distribution<float> uni(0.0f, 1.0f);
+    for (float& v : cells) v = uni(rng);
+    // A bright last column and row weigh only as much as their cells
+    for (int y = 0; y < GRID_H; ++y) cells[static_cast<size_t>(y) * GRID_W + GRID_W - 1] = 1.0f;
+    for (int x = 0; x < GRID_W; ++x) cells[static_cast<size_t>(GRID_H - 1) * GRID_W + x] = 1.0f;
+
+    GLuint state = 0;
+    glCreateTextures(GL_TEXTURE_2D, 1, &state);
+    glTextureStorage2D(state, 1, GL_R32F, GRID_W, GRID_H);
+    glTextureSubImage2D(state, 0, 0, 0, GRID_W, GRID_H, GL_RED, GL_FLOAT, cells.data());
+
+    StatePyramid pyramid;
+    TEST_CHECK(pyramid.init(ctx.assetDir + "/shaders/state_pyramid.comp"));
+    pyramid.build(state, GRID_W, GRID_H, false, 1);
+    TEST_CHECK(pyramid.levels() > 3);
+
+    // Level 1 (25 x 19 texels of 4 x 4 cells, the last ones wider) against the cells
+    int level = 1, scale = 4;
+    int w = GRID_W / 2 / 2, h = GRID_H / 2 / 2;
+    std::vector<float> mean(static_cast<size_t>(w) * h * 4);
+    glGetTextureImage(pyramid.meanTexture(), level, GL_RGBA, GL_FLOAT,
+                      static_cast<GLsizei>(mean.size() * sizeof(float)), mean.data());
+    double worst = 0.0;
+    for (int ty = 0; ty < h; ++ty) {
+        for (int tx = 0; tx < w; ++tx) {
+            int x1 = (tx == w - 1) ? GRID_W : (tx + 1) * scale;
+            int y1 = (ty == h - 1) ? GRID_H : (ty + 1) * scale;
+            double sum = 0.0;
+            for (int y = ty * scale; y < y1; ++y)
+                for (int x = tx * scale; x < x1; ++x) sum += cells[static_cast<size_t>(y) * GRID_W + x];
+            double expected = sum / ((x1 - tx * scale) * (y1 - ty * scale));
+            worst = std::max(worst, std::fabs(expected - mean[(static_cast<size_t>(ty) * w + tx) * 4]));
+        }
+    }
+
+    // The top level is the mean, max and min of the whole grid
+    int top = pyramid.levels() - 1;
+    float topMean[4], topExtrema[2];
+    glGetTextureImage(pyramid.meanTexture(), top, GL_RGBA, GL_FLOAT, sizeof(topMean), topMean);
+    glGetTextureImage(pyramid.extremaTexture(), top, GL_RG, GL_FLOAT, sizeof(topExtrema), topExtrema);
+    double total = 0.0;
+    for (float v : cells) total += v;
+    double gridMean = total / cells.size();
+    LOG_INFO("level 1 worst error %g; top mean %.6f, grid mean %.6f", worst, topMean[0], gridMean);
+    glDeleteTextures(1, &state);
+
+    TEST_CHECK(worst < 1e-5);
+    TEST_CHECK(std::fabs(topMean[0] - gridMean) < 1e-5);
+    TEST_CHECK(topExtrema[0] == *std::max_element(cells.begin(), cells.end()));
+    TEST_CHECK(topExtrema[1] == *std::min_element(cells.begin(), cells.end()));
+    return true;
+}
+
+}
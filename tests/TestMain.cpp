@@ -0,0 +1,100 @@
+/**
+ * @file TestMain.cpp
+ * @brief Entry point of lenia_tests: runs the registered engine tests on an offscreen context.
+ */
+
+#include "TestRunner.hpp"
+#include "HeadlessContext.hpp"
+#include "HeadlessRunner.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief `lenia_tests --headless ...` behaves like `Lenia --headless ...`,
+ *        so tests can run command lines in a process of their own.
+ */
+static int runHeadless(int argc, char** argv) {
+    lenia::HeadlessOptions opts;
+    if (!lenia::HeadlessRunner::parseArgs(argc, argv, opts)) {
+        lenia::HeadlessRunner::printUsage();
+        return EXIT_FAILURE;
+    }
+    lenia::Logger::init();
+    int exitCode = EXIT_FAILURE;
+    try {
+        lenia::HeadlessRunner runner;
+        exitCode = runner.run(opts);
+    } catch (const std::exception& e) {
+        LOG_FATAL("Unhandled exception: %s", e.what());
+    }
+    lenia::Logger::shutdown();
+    return exitCode;
+}
+
+int main(int argc, char** argv) {
+    if (lenia::HeadlessRunner::wantsHeadless(argc, argv)) return runHeadless(argc, argv);
+
+    lenia::TestContext ctx;
+    ctx.scratchDir = "test_scratch";
+    std::vector<std::string> filters;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--assets" && i + 1 < argc) {
+            ctx.assetDir = argv[++i];
+        } else if (arg == "--scratch" && i + 1 < argc) {
+            ctx.scratchDir = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            std::printf("Usage: lenia_tests [--assets <dir>] [--scratch <dir>] [test names...]\n");
+            return EXIT_SUCCESS;
+        } else {
+            filters.push_back(arg);
+        }
+    }
+
+    lenia::Logger::init();
+    LOG_INFO("===== lenia_tests starting =====");
+    lenia::HeadlessContext context;
+    if (!context.create()) {
+        LOG_FATAL("No OpenGL 4.5 context; cannot run the tests.");
+        lenia::Logger::shutdown();
+        return EXIT_FAILURE;
+    }
+
+    std::error_code ec;
+    ctx.assetDir = fs::absolute(ctx.assetDir, ec).string();
+    ctx.scratchDir = fs::absolute(ctx.scratchDir, ec).string();
+    ctx.executable = fs::absolute(argv[0], ec).string();
+    fs::remove_all(ctx.scratchDir, ec);
+    fs::create_directories(ctx.scratchDir, ec);
+
+    int run = 0, failed = 0;
+    for (const lenia::TestCase& test : lenia::testRegistry()) {
+        bool selected = filters.empty();
+        for (const std::string& f : filters) selected = selected || f == test.name;
+        if (!selected) continue;
+
+        std::printf("[ RUN    ] %s\n", test.name);
+        std::fflush(stdout);
+        bool ok = false;
+        try {
+            ok = test.fn(ctx);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Unhandled exception: %s", e.what());
+        }
+        std::printf("%s %s\n", ok ? "[     OK ]" : "[ FAILED ]", test.name);
+        std::fflush(stdout);
+        ++run;
+        if (!ok) ++failed;
+    }
+
+    std::printf("%d test(s) run, %d failed.\n", run, failed);
+    LOG_INFO("===== lenia_tests exiting (%d failed) =====", failed);
+    lenia::Logger::shutdown();
+    return (failed == 0 && run > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file TestRunner.hpp
+ * @brief Minimal registry and checks for the lenia_tests engine tests.
+ */
+
+#pragma once
+
+#include "Utils/Logger.hpp"
+#include <string>
+#include <vector>
+
+namespace lenia {
+
+/**
+ * @brief What every test gets: where the shaders are, a scratch directory
+ *        and this executable, which also runs `--headless` command lines.
+ */
+struct TestContext {
+    std::string assetDir{"assets"};  // Absolute
+    std::string scratchDir;          // Absolute; emptied before the run, kept afterwards
+    std::string executable;          // Absolute path of lenia_tests
+};
+
+using TestFn = bool (*)(const TestContext& ctx);
+
+struct TestCase {
+    const char* name;
+    TestFn      fn;
+};
+
+/** @brief Every test registered with LENIA_TEST, in link order. */
+inline std::vector<TestCase>& testRegistry() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+struct TestRegistration {
+    TestRegistration(const char* name, TestFn fn) { testRegistry().push_back({name, fn}); }
+};
+
+}
+
+/** @brief Define a test; its body returns true on success. */
+#define LENIA_TEST(name)                                                        \
+    static bool name(const lenia::TestContext& ctx);                            \
+    static const lenia::TestRegistration name##Registration(#name, name);       \
+    static bool name([[maybe_unused]] const lenia::TestContext& ctx)
+
+/** @brief Fail the current test with @p cond and the location. */
+#define TEST_CHECK(cond)                                                        \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            LOG_ERROR("%s:%d: check failed: %s", __FILE__, __LINE__, #cond);    \
+            return false;                                                       \
+        }                                                                       \
+    } while (0)